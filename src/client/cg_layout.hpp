@@ -0,0 +1,326 @@
+// Copyright (c) ZeniMax Media Inc.
+// Licensed under the GNU General Public License 2.0.
+
+// cg_layout.hpp (Client Game Layout Programs)
+// Compiles HUD layout strings (statusbar, scoreboard, menus) into a compact
+// instruction list so `CG_ExecuteLayoutString` does not have to re-tokenize
+// the same text with `COM_Parse` and a long `strcmp` chain every frame.
+//
+// Key Responsibilities:
+// - `CG_CompileLayout`: tokenizes a layout string once into opcodes with
+//   pre-parsed integer operands and interned string operands.
+// - `layout_cache_t`: small LRU keyed by the layout text hash, so each
+//   distinct layout is compiled only once while it keeps being drawn.
+//
+// Compilation is purely syntactic; anything that depends on player state,
+// configstrings or cvars is still resolved when the program is executed.
+
+#pragma once
+
+#include "../shared/bg_local.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+enum class layout_op_t : uint8_t {
+	XL,
+	XR,
+	XV,
+	YT,
+	YB,
+	YV,
+	Pic,
+	Client,
+	CTF,
+	PicN,
+	Num,
+	LivesNum,
+	HNum,
+	ANum,
+	RNum,
+	StatString,
+	StatString2,
+	CString,
+	String,
+	CString2,
+	String2,
+	If,
+	IfGEF,
+	EndIf,
+	LocStatString,
+	LocStatRString,
+	LocStatCString,
+	LocStatCString2,
+	LocCString,
+	LocString,
+	LocCString2,
+	LocStringAligned,	// loc_string2, loc_rstring, loc_rstring2
+	TimeLimit,
+	DogTag,
+	StartTable,
+	TableRow,
+	DrawTable,
+	StatPName,
+	HealthBars,
+	Story,
+	Error				// deferred Com_Error raised at the point the parser would have failed
+};
+
+// instruction flags
+constexpr uint8_t LAYOUT_FLAG_GREEN = 1 << 0;		// LocStringAligned: alt color
+constexpr uint8_t LAYOUT_FLAG_RIGHT_ALIGN = 1 << 1;	// LocStringAligned: right aligned
+
+constexpr size_t LAYOUT_MAX_INT_ARGS = 6;
+
+struct layout_instr_t {
+	layout_op_t	op = layout_op_t::Error;
+	uint8_t		flags = 0;
+	uint16_t	num_strings = 0;
+	uint32_t	first_string = 0;	// index into layout_program_t::strings
+	std::array<int32_t, LAYOUT_MAX_INT_ARGS> args{};
+};
+
+struct layout_program_t {
+	std::vector<layout_instr_t>	code;
+	std::vector<uint32_t>		strings;	// offsets into text
+	std::vector<char>			text;		// null-terminated string operands
+
+	void clear() {
+		code.clear();
+		strings.clear();
+		text.clear();
+	}
+
+	[[nodiscard]] const char* string(const layout_instr_t& instr, size_t i) const {
+		return text.data() + strings[instr.first_string + i];
+	}
+};
+
+/*
+================
+CG_LayoutHash
+
+FNV-1a over the layout text; also reports the length so cache hits can be
+confirmed without a second strlen.
+================
+*/
+[[nodiscard]] inline uint64_t CG_LayoutHash(const char* s, size_t& length) {
+	uint64_t hash = 0xcbf29ce484222325ull;
+	const char* p = s;
+
+	for (; *p; p++) {
+		hash ^= static_cast<uint8_t>(*p);
+		hash *= 0x100000001b3ull;
+	}
+
+	length = static_cast<size_t>(p - s);
+	return hash;
+}
+
+namespace layout_detail {
+
+struct layout_keyword_t {
+	const char* name;
+	layout_op_t	op;
+	int32_t		num_ints;	// integer operands that follow the keyword
+	int32_t		num_strs;	// string operands that follow the integers
+	uint8_t		flags;
+};
+
+// keyword table, in the same precedence order the interpreter used to test them
+constexpr layout_keyword_t layout_keywords[] = {
+	{ "xl",					layout_op_t::XL,				1, 0, 0 },
+	{ "xr",					layout_op_t::XR,				1, 0, 0 },
+	{ "xv",					layout_op_t::XV,				1, 0, 0 },
+	{ "yt",					layout_op_t::YT,				1, 0, 0 },
+	{ "yb",					layout_op_t::YB,				1, 0, 0 },
+	{ "yv",					layout_op_t::YV,				1, 0, 0 },
+	{ "pic",				layout_op_t::Pic,				1, 0, 0 },
+	{ "client",				layout_op_t::Client,			6, 0, 0 },
+	{ "ctf",				layout_op_t::CTF,				5, 1, 0 },
+	{ "picn",				layout_op_t::PicN,				0, 1, 0 },
+	{ "num",				layout_op_t::Num,				2, 0, 0 },
+	{ "lives_num",			layout_op_t::LivesNum,			1, 0, 0 },
+	{ "hnum",				layout_op_t::HNum,				0, 0, 0 },
+	{ "anum",				layout_op_t::ANum,				0, 0, 0 },
+	{ "rnum",				layout_op_t::RNum,				0, 0, 0 },
+	{ "stat_string",		layout_op_t::StatString,		1, 0, 0 },
+	{ "stat_string2",		layout_op_t::StatString2,		1, 0, 0 },
+	{ "cstring",			layout_op_t::CString,			0, 1, 0 },
+	{ "string",				layout_op_t::String,			0, 1, 0 },
+	{ "cstring2",			layout_op_t::CString2,			0, 1, 0 },
+	{ "string2",			layout_op_t::String2,			0, 1, 0 },
+	{ "if",					layout_op_t::If,				1, 0, 0 },
+	{ "ifgef",				layout_op_t::IfGEF,				1, 0, 0 },
+	{ "endif",				layout_op_t::EndIf,				0, 0, 0 },
+	{ "loc_stat_string",	layout_op_t::LocStatString,		1, 0, 0 },
+	{ "loc_stat_rstring",	layout_op_t::LocStatRString,	1, 0, 0 },
+	{ "loc_stat_cstring",	layout_op_t::LocStatCString,	1, 0, 0 },
+	{ "loc_stat_cstring2",	layout_op_t::LocStatCString2,	1, 0, 0 },
+	{ "loc_cstring",		layout_op_t::LocCString,		-1, 0, 0 },
+	{ "loc_string",			layout_op_t::LocString,			-1, 0, 0 },
+	{ "loc_cstring2",		layout_op_t::LocCString2,		-1, 0, 0 },
+	{ "loc_string2",		layout_op_t::LocStringAligned,	-1, 0, LAYOUT_FLAG_GREEN },
+	{ "loc_rstring2",		layout_op_t::LocStringAligned,	-1, 0, LAYOUT_FLAG_GREEN | LAYOUT_FLAG_RIGHT_ALIGN },
+	{ "loc_rstring",		layout_op_t::LocStringAligned,	-1, 0, LAYOUT_FLAG_RIGHT_ALIGN },
+	{ "time_limit",			layout_op_t::TimeLimit,			1, 0, 0 },
+	{ "dogtag",				layout_op_t::DogTag,			1, 0, 0 },
+	{ "start_table",		layout_op_t::StartTable,		-1, 0, 0 },
+	{ "table_row",			layout_op_t::TableRow,			-1, 0, 0 },
+	{ "draw_table",			layout_op_t::DrawTable,			0, 0, 0 },
+	{ "stat_pname",			layout_op_t::StatPName,			1, 0, 0 },
+	{ "health_bars",		layout_op_t::HealthBars,		0, 0, 0 },
+	{ "story",				layout_op_t::Story,				0, 0, 0 },
+};
+
+inline void AddString(layout_program_t& program, layout_instr_t& instr, const char* token) {
+	if (!instr.num_strings)
+		instr.first_string = static_cast<uint32_t>(program.strings.size());
+
+	program.strings.push_back(static_cast<uint32_t>(program.text.size()));
+	program.text.insert(program.text.end(), token, token + strlen(token) + 1);
+	instr.num_strings++;
+}
+
+} // namespace layout_detail
+
+/*
+================
+CG_CompileLayout
+
+Tokenizes a layout string into `program`. Unknown tokens are dropped, exactly
+as the interpreter ignored them. Malformed localization argument counts are
+compiled into an Error instruction so the failure happens at the same point
+during execution.
+================
+*/
+inline void CG_CompileLayout(const char* s, layout_program_t& program) {
+	using namespace layout_detail;
+
+	program.clear();
+
+	while (s) {
+		const char* token = COM_Parse(&s);
+		const layout_keyword_t* keyword = nullptr;
+
+		for (const auto& kw : layout_keywords) {
+			if (!strcmp(token, kw.name)) {
+				keyword = &kw;
+				break;
+			}
+		}
+
+		if (!keyword)
+			continue;
+
+		layout_instr_t instr{};
+		instr.op = keyword->op;
+		instr.flags = keyword->flags;
+
+		for (int32_t i = 0; i < keyword->num_ints; i++)
+			instr.args[i] = atoi(COM_Parse(&s));
+
+		for (int32_t i = 0; i < keyword->num_strs; i++)
+			AddString(program, instr, COM_Parse(&s));
+
+		switch (instr.op) {
+		case layout_op_t::LocCString:
+		case layout_op_t::LocString:
+		case layout_op_t::LocCString2:
+		case layout_op_t::LocStringAligned: {
+			const int32_t num_args = atoi(COM_Parse(&s));
+
+			if (num_args < 0 || num_args >= static_cast<int32_t>(MAX_LOCALIZATION_ARGS)) {
+				layout_instr_t error{};
+				error.op = layout_op_t::Error;
+				AddString(program, error, "Bad loc string");
+				program.code.push_back(error);
+				return;
+			}
+
+			instr.args[0] = num_args;
+
+			// base followed by its arguments
+			for (int32_t i = 0; i <= num_args; i++)
+				AddString(program, instr, COM_Parse(&s));
+			break;
+		}
+		case layout_op_t::StartTable:
+		case layout_op_t::TableRow: {
+			const int32_t count = atoi(COM_Parse(&s));
+
+			instr.args[0] = count;
+
+			for (int32_t i = 0; i < count; i++)
+				AddString(program, instr, COM_Parse(&s));
+			break;
+		}
+		default:
+			break;
+		}
+
+		program.code.push_back(std::move(instr));
+	}
+}
+
+/*
+================
+layout_cache_t
+
+Least-recently-used set of compiled layouts. Lookups hash the text and
+confirm with a full compare, so an in-place edit of the layout buffer
+always produces a fresh program.
+================
+*/
+template<size_t N>
+struct layout_cache_t {
+	struct entry_t {
+		uint64_t			hash = 0;
+		uint64_t			last_used = 0;
+		std::string			source;
+		layout_program_t	program;
+		bool				valid = false;
+	};
+
+	std::array<entry_t, N>	entries{};
+	uint64_t				use_counter = 0;
+	uint64_t				hits = 0;
+	uint64_t				compiles = 0;
+
+	void clear() {
+		for (auto& entry : entries)
+			entry = {};
+		use_counter = hits = compiles = 0;
+	}
+
+	const layout_program_t& get(const char* s) {
+		size_t length;
+		const uint64_t hash = CG_LayoutHash(s, length);
+		entry_t* victim = &entries[0];
+
+		use_counter++;
+
+		for (auto& entry : entries) {
+			if (entry.valid && entry.hash == hash && entry.source.size() == length && !memcmp(entry.source.data(), s, length)) {
+				entry.last_used = use_counter;
+				hits++;
+				return entry.program;
+			}
+
+			if (!entry.valid || (victim->valid && entry.last_used < victim->last_used))
+				victim = &entry;
+		}
+
+		victim->hash = hash;
+		victim->last_used = use_counter;
+		victim->source.assign(s, length);
+		victim->valid = true;
+		CG_CompileLayout(victim->source.c_str(), victim->program);
+		compiles++;
+
+		return victim->program;
+	}
+};
@@ -13,6 +13,7 @@ Handles rendering of numerical stats (health, armor, ammo) using custom graphica
 - Manages accessibility features like high-contrast text backgrounds and alternate typefaces.*/
 
 #include "cg_local.hpp"
+#include "cg_layout.hpp"
 #include <array>    // for std::array
 #include <sstream>  // for std::istringstream
 #include <string>   // for std::string
@@ -792,10 +793,36 @@ static void CG_DrawTable(int x, int y, uint32_t width, uint32_t height, int32_t
 	}
 }
 
+// compiled layouts: statusbar + layout per split player, with headroom for menus
+static layout_cache_t<MAX_SPLIT_PLAYERS * 4> layout_cache;
+
+/*
+================
+CG_StatConfigString
+
+Resolves a stat_string style operand to a configstring index.
+================
+*/
+static int CG_StatConfigString(const player_state_t* ps, int index) {
+	if (index < 0 || index >= MAX_STATS)
+		cgi.Com_Error("Bad stat_string index");
+	index = ps->stats[index];
+
+	if (cgi.CL_ServerProtocol() <= PROTOCOL_VERSION_3XX)
+		index = CS_REMAP(index).start / CS_MAX_STRING_LENGTH;
+
+	if (index < 0 || index >= MAX_CONFIGSTRINGS)
+		cgi.Com_Error("Bad stat_string index");
+
+	return index;
+}
+
 /*
 ================
 CG_ExecuteLayoutString
 
+Runs the compiled program for `s`; the text is only tokenized the first
+time a given layout is seen.
 ================
 */
 static void CG_ExecuteLayoutString(const char* s, vrect_t hud_vrect, vrect_t hud_safe, int32_t scale, int32_t playernum, const player_state_t* ps) {
@@ -803,13 +830,14 @@ static void CG_ExecuteLayoutString(const char* s, vrect_t hud_vrect, vrect_t hud
 	int			w, h;
 	int			hx, hy;
 	int			value;
-	const char* token;
 	int			width;
 	int			index;
 
 	if (!s[0])
 		return;
 
+	const layout_program_t& program = layout_cache.get(s);
+
 	x = hud_vrect.x;
 	y = hud_vrect.y;
 	width = 3;
@@ -824,434 +852,329 @@ static void CG_ExecuteLayoutString(const char* s, vrect_t hud_vrect, vrect_t hud
 	int32_t endif_depth = 0; // at this depth, toggle skip_depth
 	bool skip_depth = false; // whether we're in a dead stmt or not
 
-	while (s) {
-		token = COM_Parse(&s);
-		if (!strcmp(token, "xl")) {
-			token = COM_Parse(&s);
+	static std::array<const char*, MAX_LOCALIZATION_ARGS> arg_buffers{};
+
+	for (const layout_instr_t& instr : program.code) {
+		const auto& args = instr.args;
+
+		switch (instr.op) {
+		case layout_op_t::XL:
 			if (!skip_depth)
-				x = ((hud_vrect.x + atoi(token)) * scale) + hud_safe.x;
-			continue;
-		}
-		if (!strcmp(token, "xr")) {
-			token = COM_Parse(&s);
+				x = ((hud_vrect.x + args[0]) * scale) + hud_safe.x;
+			break;
+		case layout_op_t::XR:
 			if (!skip_depth)
-				x = ((hud_vrect.x + hud_vrect.width + atoi(token)) * scale) - hud_safe.x;
-			continue;
-		}
-		if (!strcmp(token, "xv")) {
-			token = COM_Parse(&s);
+				x = ((hud_vrect.x + hud_vrect.width + args[0]) * scale) - hud_safe.x;
+			break;
+		case layout_op_t::XV:
 			if (!skip_depth)
-				x = (hud_vrect.x + hud_vrect.width / 2 + (atoi(token) - hx)) * scale;
-			continue;
-		}
+				x = (hud_vrect.x + hud_vrect.width / 2 + (args[0] - hx)) * scale;
+			break;
 
-		if (!strcmp(token, "yt")) {
-			token = COM_Parse(&s);
+		case layout_op_t::YT:
 			if (!skip_depth)
-				y = ((hud_vrect.y + atoi(token)) * scale) + hud_safe.y;
-			continue;
-		}
-		if (!strcmp(token, "yb")) {
-			token = COM_Parse(&s);
+				y = ((hud_vrect.y + args[0]) * scale) + hud_safe.y;
+			break;
+		case layout_op_t::YB:
 			if (!skip_depth)
-				y = ((hud_vrect.y + hud_vrect.height + atoi(token)) * scale) - hud_safe.y;
-			continue;
-		}
-		if (!strcmp(token, "yv")) {
-			token = COM_Parse(&s);
+				y = ((hud_vrect.y + hud_vrect.height + args[0]) * scale) - hud_safe.y;
+			break;
+		case layout_op_t::YV:
 			if (!skip_depth)
-				y = (hud_vrect.y + hud_vrect.height / 2 + (atoi(token) - hy)) * scale;
-			continue;
-		}
+				y = (hud_vrect.y + hud_vrect.height / 2 + (args[0] - hy)) * scale;
+			break;
 
-		if (!strcmp(token, "pic")) {   // draw a pic from a stat number
-			token = COM_Parse(&s);
-			if (!skip_depth) {
-				int16_t stat = atoi(token);
-				bool skip = false;
-
-				value = ps->stats[stat];
-				if (value >= MAX_IMAGES)
-					cgi.Com_Error("Pic >= MAX_IMAGES");
-
-				//muff: client-side hacky hacks - don't show vitals if spectating
-				if ((ps->stats[STAT_SPECTATOR] && !ps->stats[STAT_FOLLOWING]) && (stat == STAT_HEALTH_ICON || stat == STAT_AMMO_ICON || stat == STAT_ARMOR_ICON))
-					skip = true;
-
-				const char* const pic = cgi.get_configString(CS_IMAGES + value);
-
-				if (pic && *pic && !skip) {
-					//muff: little hacky hack! resize the player pics on miniscores for clients rockin' muffmode
-					if (stat == STAT_MINISCORE_FIRST_PIC || stat == STAT_MINISCORE_SECOND_PIC) {
-						w = 24;
-						h = 24;
-					}
-					else {
-						cgi.Draw_GetPicSize(&w, &h, pic);
-					}
-					cgi.SCR_DrawPic(x, y, w * scale, h * scale, pic);
-				}
-			}
+		case layout_op_t::Pic: {   // draw a pic from a stat number
+			if (skip_depth)
+				break;
 
-			continue;
-		}
+			int16_t stat = args[0];
+			bool skip = false;
 
-		if (!strcmp(token, "client")) {   // draw a deathmatch client block
-			token = COM_Parse(&s);
-			if (!skip_depth) {
-				x = (hud_vrect.x + hud_vrect.width / 2 + (atoi(token) - hx)) * scale;
-				x += 8 * scale;
-			}
-			token = COM_Parse(&s);
-			if (!skip_depth) {
-				y = (hud_vrect.y + hud_vrect.height / 2 + (atoi(token) - hy)) * scale;
-				y += 7 * scale;
-			}
+			value = ps->stats[stat];
+			if (value >= MAX_IMAGES)
+				cgi.Com_Error("Pic >= MAX_IMAGES");
+
+			//muff: client-side hacky hacks - don't show vitals if spectating
+			if ((ps->stats[STAT_SPECTATOR] && !ps->stats[STAT_FOLLOWING]) && (stat == STAT_HEALTH_ICON || stat == STAT_AMMO_ICON || stat == STAT_ARMOR_ICON))
+				skip = true;
 
-			token = COM_Parse(&s);
+			const char* const pic = cgi.get_configString(CS_IMAGES + value);
 
-			if (!skip_depth) {
-				value = atoi(token);
-				if (value >= MAX_CLIENTS || value < 0)
-					cgi.Com_Error("client >= MAX_CLIENTS");
+			if (pic && *pic && !skip) {
+				//muff: little hacky hack! resize the player pics on miniscores for clients rockin' muffmode
+				if (stat == STAT_MINISCORE_FIRST_PIC || stat == STAT_MINISCORE_SECOND_PIC) {
+					w = 24;
+					h = 24;
+				}
+				else {
+					cgi.Draw_GetPicSize(&w, &h, pic);
+				}
+				cgi.SCR_DrawPic(x, y, w * scale, h * scale, pic);
 			}
+			break;
+		}
 
-			int score, ping, time;
+		case layout_op_t::Client: {   // draw a deathmatch client block
+			if (skip_depth)
+				break;
 
-			token = COM_Parse(&s);
-			if (!skip_depth)
-				score = atoi(token);
+			x = (hud_vrect.x + hud_vrect.width / 2 + (args[0] - hx)) * scale;
+			x += 8 * scale;
+			y = (hud_vrect.y + hud_vrect.height / 2 + (args[1] - hy)) * scale;
+			y += 7 * scale;
 
-			token = COM_Parse(&s);
-			if (!skip_depth) {
-				ping = atoi(token);
+			value = args[2];
+			if (value >= MAX_CLIENTS || value < 0)
+				cgi.Com_Error("client >= MAX_CLIENTS");
 
-				token = COM_Parse(&s);
-				time = atoi(token);
+			const int score = args[3];
+			const int ping = args[4];
 
-				const char* scr = G_Fmt("{}", score).data();
+			const char* scr = G_Fmt("{}", score).data();
 
-				cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
-				if (!scr_usekfont->integer)
-					CG_DrawString(x + 32 * scale, y, scale, cgi.CL_GetClientName(value));
-				else
-					cgi.SCR_DrawFontString(cgi.CL_GetClientName(value), x + 32 * scale, y - (font_y_offset * scale), scale, rgba_white, true, text_align_t::LEFT);
-
-				if (!scr_usekfont->integer)
-					CG_DrawString(x + 32 * scale, y + 10 * scale, scale, scr, true);
-				else
-					cgi.SCR_DrawFontString(scr, x + 32 * scale, y + (10 - font_y_offset) * scale, scale, rgba_white, true, text_align_t::LEFT);
-
-				cgi.SCR_DrawPic(x + 32 + 96 * scale, y + 10 * scale, 9 * scale, 9 * scale, "ping");
-				if (!scr_usekfont->integer)
-					CG_DrawString(x + 32 + 73 * scale + 32 * scale, y + 10 * scale, scale, G_Fmt("{}", ping).data());
-				else
-					cgi.SCR_DrawFontString(G_Fmt("{}", ping).data(), x + 32 + 107 * scale, y + (10 - font_y_offset) * scale, scale, rgba_white, true, text_align_t::LEFT);
+			cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
+			if (!scr_usekfont->integer)
+				CG_DrawString(x + 32 * scale, y, scale, cgi.CL_GetClientName(value));
+			else
+				cgi.SCR_DrawFontString(cgi.CL_GetClientName(value), x + 32 * scale, y - (font_y_offset * scale), scale, rgba_white, true, text_align_t::LEFT);
+
+			if (!scr_usekfont->integer)
+				CG_DrawString(x + 32 * scale, y + 10 * scale, scale, scr, true);
+			else
+				cgi.SCR_DrawFontString(scr, x + 32 * scale, y + (10 - font_y_offset) * scale, scale, rgba_white, true, text_align_t::LEFT);
+
+			cgi.SCR_DrawPic(x + 32 + 96 * scale, y + 10 * scale, 9 * scale, 9 * scale, "ping");
+			if (!scr_usekfont->integer)
+				CG_DrawString(x + 32 + 73 * scale + 32 * scale, y + 10 * scale, scale, G_Fmt("{}", ping).data());
+			else
+				cgi.SCR_DrawFontString(G_Fmt("{}", ping).data(), x + 32 + 107 * scale, y + (10 - font_y_offset) * scale, scale, rgba_white, true, text_align_t::LEFT);
 
-				cgi.SCR_SetAltTypeface(false);
-			}
-			continue;
+			cgi.SCR_SetAltTypeface(false);
+			break;
 		}
 
-		if (!strcmp(token, "ctf")) {   // draw a ctf client block
-			int     score, ping;
-
-			token = COM_Parse(&s);
-			if (!skip_depth)
-				x = (hud_vrect.x + hud_vrect.width / 2 - hx + atoi(token)) * scale;
-			token = COM_Parse(&s);
-			if (!skip_depth)
-				y = (hud_vrect.y + hud_vrect.height / 2 - hy + atoi(token)) * scale;
-
-			token = COM_Parse(&s);
-			if (!skip_depth) {
-				value = atoi(token);
-				if (value >= MAX_CLIENTS || value < 0)
-					cgi.Com_Error("client >= MAX_CLIENTS");
-			}
-
-			token = COM_Parse(&s);
-			if (!skip_depth)
-				score = atoi(token);
+		case layout_op_t::CTF: {   // draw a ctf client block
+			if (skip_depth)
+				break;
 
-			token = COM_Parse(&s);
-			if (!skip_depth) {
-				ping = atoi(token);
-				if (ping > 999)
-					ping = 999;
-			}
+			x = (hud_vrect.x + hud_vrect.width / 2 - hx + args[0]) * scale;
+			y = (hud_vrect.y + hud_vrect.height / 2 - hy + args[1]) * scale;
 
-			token = COM_Parse(&s);
+			value = args[2];
+			if (value >= MAX_CLIENTS || value < 0)
+				cgi.Com_Error("client >= MAX_CLIENTS");
 
-			if (!skip_depth) {
+			const int score = args[3];
+			const int ping = std::min(args[4], 999);
+			const char* token = program.string(instr, 0);
 
-				cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
-				cgi.SCR_DrawFontString(G_Fmt("{}", score).data(), x, y - (font_y_offset * scale), scale, value == playernum ? alt_color : rgba_white, true, text_align_t::LEFT);
-				x += 3 * 9 * scale;
-				cgi.SCR_DrawFontString(G_Fmt("{}", ping).data(), x, y - (font_y_offset * scale), scale, value == playernum ? alt_color : rgba_white, true, text_align_t::LEFT);
-				x += 3 * 9 * scale;
-				cgi.SCR_DrawFontString(cgi.CL_GetClientName(value), x, y - (font_y_offset * scale), scale, value == playernum ? alt_color : rgba_white, true, text_align_t::LEFT);
-				cgi.SCR_SetAltTypeface(false);
+			cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
+			cgi.SCR_DrawFontString(G_Fmt("{}", score).data(), x, y - (font_y_offset * scale), scale, value == playernum ? alt_color : rgba_white, true, text_align_t::LEFT);
+			x += 3 * 9 * scale;
+			cgi.SCR_DrawFontString(G_Fmt("{}", ping).data(), x, y - (font_y_offset * scale), scale, value == playernum ? alt_color : rgba_white, true, text_align_t::LEFT);
+			x += 3 * 9 * scale;
+			cgi.SCR_DrawFontString(cgi.CL_GetClientName(value), x, y - (font_y_offset * scale), scale, value == playernum ? alt_color : rgba_white, true, text_align_t::LEFT);
+			cgi.SCR_SetAltTypeface(false);
 
-				if (*token) {
-					cgi.Draw_GetPicSize(&w, &h, token);
-					cgi.SCR_DrawPic(x - ((w + 2) * scale), y, w * scale, h * scale, token);
-				}
+			if (*token) {
+				cgi.Draw_GetPicSize(&w, &h, token);
+				cgi.SCR_DrawPic(x - ((w + 2) * scale), y, w * scale, h * scale, token);
 			}
-			continue;
+			break;
 		}
 
-		if (!strcmp(token, "picn")) {   // draw a pic from a name
-			token = COM_Parse(&s);
-			if (!skip_depth) {
-				//muff: hoo boy, another little hacky hack
-				if (strstr(token, "/players/")) {
-					w = h = 32;
+		case layout_op_t::PicN: {   // draw a pic from a name
+			if (skip_depth)
+				break;
 
-				}
-				else if (!strcmp(token, "wheel/p_compass_selected")) {
-					w = h = 12;
+			const char* token = program.string(instr, 0);
 
-				}
-				else {
-					cgi.Draw_GetPicSize(&w, &h, token);
-				}
-				cgi.SCR_DrawPic(x, y, w * scale, h * scale, token);
+			//muff: hoo boy, another little hacky hack
+			if (strstr(token, "/players/")) {
+				w = h = 32;
 			}
-			continue;
-		}
-
-		if (!strcmp(token, "num")) {   // draw a number
-			token = COM_Parse(&s);
-			if (!skip_depth)
-				width = atoi(token);
-			token = COM_Parse(&s);
-			if (!skip_depth) {
-				value = ps->stats[atoi(token)];
-				//muff: little hacky hack to conditionally hide text for muffmode connoisseurs
-				if (value != -999)
-					CG_DrawField(x, y, 0, width, value, scale);
+			else if (!strcmp(token, "wheel/p_compass_selected")) {
+				w = h = 12;
 			}
-			continue;
-		}
-		// [Paril-KEX] special handling for the lives number
-		else if (!strcmp(token, "lives_num")) {
-			token = COM_Parse(&s);
-			if (!skip_depth) {
-				value = ps->stats[atoi(token)];
-				CG_DrawField(x, y, value <= 2 ? flash_frame : 0, 1, max(0, value - 2), scale);
+			else {
+				cgi.Draw_GetPicSize(&w, &h, token);
 			}
+			cgi.SCR_DrawPic(x, y, w * scale, h * scale, token);
+			break;
 		}
 
-		//muff: client-side hacky hacks - don't show vitals if spectating
-		if (!ps->stats[STAT_SPECTATOR] || ps->stats[STAT_FOLLOWING]) {
-			if (!strcmp(token, "hnum")) {
-				// health number
-				if (!skip_depth) {
-					int     color;
-
-					value = ps->stats[STAT_HEALTH];
-					width = value > 999 ? 4 : 3;
-					if (value > 25)
-						color = 0;  // green
-					else if (value > 0)
-						color = flash_frame;      // flash
-					else
-						color = 1;
-					if (ps->stats[STAT_FLASHES] & 1) {
-						int delta = (width - 3) * 16;
-						//cgi.Draw_GetPicSize(&w, &h, "field_3");
-						w = 48;
-						h = 24;
-						w += delta;
-						cgi.SCR_DrawPic(x - delta, y, w * scale, h * scale, "field_3");
-					}
-
-					CG_DrawField(x, y, color, width, value, scale);
-				}
-				continue;
-			}
-
-			if (!strcmp(token, "anum")) {
-				// ammo number
-				if (!skip_depth) {
-					int     color;
+		case layout_op_t::Num:   // draw a number
+			if (skip_depth)
+				break;
 
-					width = 3;
-					value = ps->stats[STAT_AMMO];
+			width = args[0];
+			value = ps->stats[args[1]];
+			//muff: little hacky hack to conditionally hide text for muffmode connoisseurs
+			if (value != -999)
+				CG_DrawField(x, y, 0, width, value, scale);
+			break;
 
-					int32_t min_ammo = cgi.CL_GetWarnAmmoCount(ps->stats[STAT_ACTIVE_WEAPON]);
+		// [Paril-KEX] special handling for the lives number
+		case layout_op_t::LivesNum:
+			if (skip_depth)
+				break;
 
-					if (!min_ammo)
-						min_ammo = 5; // back compat
+			value = ps->stats[args[0]];
+			CG_DrawField(x, y, value <= 2 ? flash_frame : 0, 1, max(0, value - 2), scale);
+			break;
 
-					if (value > min_ammo)
-						color = 0;  // green
-					else if (value >= 0)
-						color = flash_frame;      // flash
-					else
-						continue;   // negative number = don't show
-					if (ps->stats[STAT_FLASHES] & 4) {
-						cgi.Draw_GetPicSize(&w, &h, "field_3");
-						cgi.SCR_DrawPic(x, y, w * scale, h * scale, "field_3");
-					}
+		case layout_op_t::HNum: {
+			// health number
+			//muff: client-side hacky hacks - don't show vitals if spectating
+			if (skip_depth || (ps->stats[STAT_SPECTATOR] && !ps->stats[STAT_FOLLOWING]))
+				break;
 
-					CG_DrawField(x, y, color, width, value, scale);
-				}
-				continue;
+			int     color;
+
+			value = ps->stats[STAT_HEALTH];
+			width = value > 999 ? 4 : 3;
+			if (value > 25)
+				color = 0;  // green
+			else if (value > 0)
+				color = flash_frame;      // flash
+			else
+				color = 1;
+			if (ps->stats[STAT_FLASHES] & 1) {
+				int delta = (width - 3) * 16;
+				//cgi.Draw_GetPicSize(&w, &h, "field_3");
+				w = 48;
+				h = 24;
+				w += delta;
+				cgi.SCR_DrawPic(x - delta, y, w * scale, h * scale, "field_3");
 			}
 
-			if (!strcmp(token, "rnum")) {
-				// armor number
-				if (!skip_depth) {
-					int     color;
+			CG_DrawField(x, y, color, width, value, scale);
+			break;
+		}
+
+		case layout_op_t::ANum: {
+			// ammo number
+			if (skip_depth || (ps->stats[STAT_SPECTATOR] && !ps->stats[STAT_FOLLOWING]))
+				break;
 
-					width = 3;
-					value = ps->stats[STAT_ARMOR];
-					if (value < 0)
-						continue;
+			int     color;
 
-					color = 0;  // green
-					if (ps->stats[STAT_FLASHES] & 2) {
-						cgi.Draw_GetPicSize(&w, &h, "field_3");
-						cgi.SCR_DrawPic(x, y, w * scale, h * scale, "field_3");
-					}
+			width = 3;
+			value = ps->stats[STAT_AMMO];
 
-					CG_DrawField(x, y, color, width, value, scale);
-				}
-				continue;
+			int32_t min_ammo = cgi.CL_GetWarnAmmoCount(ps->stats[STAT_ACTIVE_WEAPON]);
+
+			if (!min_ammo)
+				min_ammo = 5; // back compat
+
+			if (value > min_ammo)
+				color = 0;  // green
+			else if (value >= 0)
+				color = flash_frame;      // flash
+			else
+				break;   // negative number = don't show
+			if (ps->stats[STAT_FLASHES] & 4) {
+				cgi.Draw_GetPicSize(&w, &h, "field_3");
+				cgi.SCR_DrawPic(x, y, w * scale, h * scale, "field_3");
 			}
+
+			CG_DrawField(x, y, color, width, value, scale);
+			break;
 		}
-		if (!strcmp(token, "stat_string")) {
-			token = COM_Parse(&s);
-
-			if (!skip_depth) {
-				index = atoi(token);
-				if (index < 0 || index >= MAX_STATS)
-					cgi.Com_Error("Bad stat_string index");
-				index = ps->stats[index];
-
-				if (cgi.CL_ServerProtocol() <= PROTOCOL_VERSION_3XX)
-					index = CS_REMAP(index).start / CS_MAX_STRING_LENGTH;
-
-				if (index < 0 || index >= MAX_CONFIGSTRINGS)
-					cgi.Com_Error("Bad stat_string index");
-				if (!scr_usekfont->integer)
-					CG_DrawString(x, y, scale, cgi.get_configString(index));
-				else {
-					cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
-					cgi.SCR_DrawFontString(cgi.get_configString(index), x, y - (font_y_offset * scale), scale, rgba_white, true, text_align_t::LEFT);
-					cgi.SCR_SetAltTypeface(false);
-				}
+
+		case layout_op_t::RNum: {
+			// armor number
+			if (skip_depth || (ps->stats[STAT_SPECTATOR] && !ps->stats[STAT_FOLLOWING]))
+				break;
+
+			int     color;
+
+			width = 3;
+			value = ps->stats[STAT_ARMOR];
+			if (value < 0)
+				break;
+
+			color = 0;  // green
+			if (ps->stats[STAT_FLASHES] & 2) {
+				cgi.Draw_GetPicSize(&w, &h, "field_3");
+				cgi.SCR_DrawPic(x, y, w * scale, h * scale, "field_3");
 			}
-			continue;
+
+			CG_DrawField(x, y, color, width, value, scale);
+			break;
 		}
 
+		case layout_op_t::StatString:
 		// Q2Eaks alt color stat string
-		if (!strcmp(token, "stat_string2")) {
-			token = COM_Parse(&s);
-
-			if (!skip_depth) {
-				index = atoi(token);
-				if (index < 0 || index >= MAX_STATS)
-					cgi.Com_Error("Bad stat_string index");
-				index = ps->stats[index];
-
-				if (cgi.CL_ServerProtocol() <= PROTOCOL_VERSION_3XX)
-					index = CS_REMAP(index).start / CS_MAX_STRING_LENGTH;
-
-				if (index < 0 || index >= MAX_CONFIGSTRINGS)
-					cgi.Com_Error("Bad stat_string index");
-				if (!scr_usekfont->integer)
-					CG_DrawString(x, y, scale, cgi.get_configString(index));
-				else {
-					cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
-					cgi.SCR_DrawFontString(cgi.get_configString(index), x, y - (font_y_offset * scale), scale, alt_color, true, text_align_t::LEFT);
-					cgi.SCR_SetAltTypeface(false);
-				}
-			}
-			continue;
-		}
+		case layout_op_t::StatString2: {
+			if (skip_depth)
+				break;
 
-		if (!strcmp(token, "cstring")) {
-			token = COM_Parse(&s);
-			if (!skip_depth) {
+			const bool alt = instr.op == layout_op_t::StatString2;
+
+			index = CG_StatConfigString(ps, args[0]);
+			if (!scr_usekfont->integer)
+				CG_DrawString(x, y, scale, cgi.get_configString(index));
+			else {
 				cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
-				CG_DrawHUDString(token, x, y, hx * 2 * scale, 0, scale);
+				cgi.SCR_DrawFontString(cgi.get_configString(index), x, y - (font_y_offset * scale), scale, alt ? alt_color : rgba_white, true, text_align_t::LEFT);
 				cgi.SCR_SetAltTypeface(false);
 			}
-			continue;
+			break;
 		}
 
-		if (!strcmp(token, "string")) {
-			token = COM_Parse(&s);
-			if (!skip_depth) {
-				if (!scr_usekfont->integer)
-					CG_DrawString(x, y, scale, token);
-				else {
-					cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
-					cgi.SCR_DrawFontString(token, x, y - (font_y_offset * scale), scale, rgba_white, true, text_align_t::LEFT);
-					cgi.SCR_SetAltTypeface(false);
-				}
-			}
-			continue;
-		}
+		case layout_op_t::CString:
+		case layout_op_t::CString2:
+			if (skip_depth)
+				break;
+
+			cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
+			CG_DrawHUDString(program.string(instr, 0), x, y, hx * 2 * scale, instr.op == layout_op_t::CString2 ? 0x80 : 0, scale);
+			cgi.SCR_SetAltTypeface(false);
+			break;
+
+		case layout_op_t::String:
+		case layout_op_t::String2: {
+			if (skip_depth)
+				break;
+
+			const bool alt = instr.op == layout_op_t::String2;
+			const char* token = program.string(instr, 0);
 
-		if (!strcmp(token, "cstring2")) {
-			token = COM_Parse(&s);
-			if (!skip_depth) {
+			if (!scr_usekfont->integer)
+				CG_DrawString(x, y, scale, token, alt);
+			else {
 				cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
-				CG_DrawHUDString(token, x, y, hx * 2 * scale, 0x80, scale);
+				cgi.SCR_DrawFontString(token, x, y - (font_y_offset * scale), scale, alt ? alt_color : rgba_white, true, text_align_t::LEFT);
 				cgi.SCR_SetAltTypeface(false);
 			}
-			continue;
-		}
-
-		if (!strcmp(token, "string2")) {
-			token = COM_Parse(&s);
-			if (!skip_depth) {
-				if (!scr_usekfont->integer)
-					CG_DrawString(x, y, scale, token, true);
-				else {
-					cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
-					cgi.SCR_DrawFontString(token, x, y - (font_y_offset * scale), scale, alt_color, true, text_align_t::LEFT);
-					cgi.SCR_SetAltTypeface(false);
-				}
-			}
-			continue;
+			break;
 		}
 
-		if (!strcmp(token, "if")) {
+		case layout_op_t::If:
 			// if stmt
-			token = COM_Parse(&s);
-
 			if_depth++;
 
 			// skip to endif
-			if (!skip_depth && !ps->stats[atoi(token)]) {
+			if (!skip_depth && !ps->stats[args[0]]) {
 				skip_depth = true;
 				endif_depth = if_depth;
 			}
+			break;
 
-			continue;
-		}
-
-		if (!strcmp(token, "ifgef")) {
+		case layout_op_t::IfGEF:
 			// if stmt
-			token = COM_Parse(&s);
-
 			if_depth++;
 
 			// skip to endif
-			if (!skip_depth && cgi.CL_ServerFrame() < atoi(token)) {
+			if (!skip_depth && cgi.CL_ServerFrame() < args[0]) {
 				skip_depth = true;
 				endif_depth = if_depth;
 			}
+			break;
 
-			continue;
-		}
-
-		if (!strcmp(token, "endif")) {
+		case layout_op_t::EndIf:
 			if (skip_depth && (if_depth == endif_depth))
 				skip_depth = false;
 
@@ -1259,405 +1182,252 @@ static void CG_ExecuteLayoutString(const char* s, vrect_t hud_vrect, vrect_t hud
 
 			if (if_depth < 0)
 				cgi.Com_Error("endif without matching if");
-
-			continue;
-		}
+			break;
 
 		// localization stuff
-		if (!strcmp(token, "loc_stat_string")) {
-			token = COM_Parse(&s);
-
-			if (!skip_depth) {
-				index = atoi(token);
-				if (index < 0 || index >= MAX_STATS)
-					cgi.Com_Error("Bad stat_string index");
-				index = ps->stats[index];
-
-				if (cgi.CL_ServerProtocol() <= PROTOCOL_VERSION_3XX)
-					index = CS_REMAP(index).start / CS_MAX_STRING_LENGTH;
-
-				if (index < 0 || index >= MAX_CONFIGSTRINGS)
-					cgi.Com_Error("Bad stat_string index");
-				if (!scr_usekfont->integer)
-					CG_DrawString(x, y, scale, cgi.Localize(cgi.get_configString(index), nullptr, 0));
-				else {
-					cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
-					cgi.SCR_DrawFontString(cgi.Localize(cgi.get_configString(index), nullptr, 0), x, y - (font_y_offset * scale), scale, rgba_white, true, text_align_t::LEFT);
-					cgi.SCR_SetAltTypeface(false);
-				}
-			}
-			continue;
-		}
-
-		if (!strcmp(token, "loc_stat_rstring")) {
-			token = COM_Parse(&s);
-
-			if (!skip_depth) {
-				index = atoi(token);
-				if (index < 0 || index >= MAX_STATS)
-					cgi.Com_Error("Bad stat_string index");
-				index = ps->stats[index];
-
-				if (cgi.CL_ServerProtocol() <= PROTOCOL_VERSION_3XX)
-					index = CS_REMAP(index).start / CS_MAX_STRING_LENGTH;
-
-				if (index < 0 || index >= MAX_CONFIGSTRINGS)
-					cgi.Com_Error("Bad stat_string index");
-				const char* s = cgi.Localize(cgi.get_configString(index), nullptr, 0);
-				if (!scr_usekfont->integer)
-					CG_DrawString(x - (strlen(s) * CONCHAR_WIDTH * scale), y, scale, s);
-				else {
-					cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
-					Vector2 size = cgi.SCR_MeasureFontString(s, scale);
-					cgi.SCR_DrawFontString(s, x - size.x, y - (font_y_offset * scale), scale, rgba_white, true, text_align_t::LEFT);
-					cgi.SCR_SetAltTypeface(false);
-				}
-			}
-			continue;
-		}
-
-		if (!strcmp(token, "loc_stat_cstring")) {
-			token = COM_Parse(&s);
-
-			if (!skip_depth) {
-				index = atoi(token);
-				if (index < 0 || index >= MAX_STATS)
-					cgi.Com_Error("Bad stat_string index");
-				index = ps->stats[index];
-
-				if (cgi.CL_ServerProtocol() <= PROTOCOL_VERSION_3XX)
-					index = CS_REMAP(index).start / CS_MAX_STRING_LENGTH;
+		case layout_op_t::LocStatString: {
+			if (skip_depth)
+				break;
 
-				if (index < 0 || index >= MAX_CONFIGSTRINGS)
-					cgi.Com_Error("Bad stat_string index");
+			index = CG_StatConfigString(ps, args[0]);
+			const char* loc = cgi.Localize(cgi.get_configString(index), nullptr, 0);
+			if (!scr_usekfont->integer)
+				CG_DrawString(x, y, scale, loc);
+			else {
 				cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
-				CG_DrawHUDString(cgi.Localize(cgi.get_configString(index), nullptr, 0), x, y, hx * 2 * scale, 0, scale);
+				cgi.SCR_DrawFontString(loc, x, y - (font_y_offset * scale), scale, rgba_white, true, text_align_t::LEFT);
 				cgi.SCR_SetAltTypeface(false);
 			}
-			continue;
+			break;
 		}
 
-		if (!strcmp(token, "loc_stat_cstring2")) {
-			token = COM_Parse(&s);
-
-			if (!skip_depth) {
-				index = atoi(token);
-				if (index < 0 || index >= MAX_STATS)
-					cgi.Com_Error("Bad stat_string index");
-				index = ps->stats[index];
-
-				if (cgi.CL_ServerProtocol() <= PROTOCOL_VERSION_3XX)
-					index = CS_REMAP(index).start / CS_MAX_STRING_LENGTH;
+		case layout_op_t::LocStatRString: {
+			if (skip_depth)
+				break;
 
-				if (index < 0 || index >= MAX_CONFIGSTRINGS)
-					cgi.Com_Error("Bad stat_string index");
+			index = CG_StatConfigString(ps, args[0]);
+			const char* loc = cgi.Localize(cgi.get_configString(index), nullptr, 0);
+			if (!scr_usekfont->integer)
+				CG_DrawString(x - (strlen(loc) * CONCHAR_WIDTH * scale), y, scale, loc);
+			else {
 				cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
-				CG_DrawHUDString(cgi.Localize(cgi.get_configString(index), nullptr, 0), x, y, hx * 2 * scale, 0x80, scale);
+				Vector2 size = cgi.SCR_MeasureFontString(loc, scale);
+				cgi.SCR_DrawFontString(loc, x - size.x, y - (font_y_offset * scale), scale, rgba_white, true, text_align_t::LEFT);
 				cgi.SCR_SetAltTypeface(false);
 			}
-			continue;
-		}
-
-		static std::array<std::array<char, MAX_TOKEN_CHARS>, MAX_LOCALIZATION_ARGS + 1> arg_tokens{};
-		static std::array<const char*, MAX_LOCALIZATION_ARGS> arg_buffers{};
-
-		if (!strcmp(token, "loc_cstring")) {
-		int32_t num_args = atoi(COM_Parse(&s));
-
-		if (num_args < 0 || num_args >= MAX_LOCALIZATION_ARGS)
-		cgi.Com_Error("Bad loc string");
-
-		arg_buffers.fill(nullptr);
-
-		// parse base
-		token = COM_Parse(&s);
-		Q_strlcpy(arg_tokens[0].data(), token, arg_tokens[0].size());
-
-		// parse args
-		for (size_t i = 0; i < num_args; i++) {
-		token = COM_Parse(&s);
-		Q_strlcpy(arg_tokens[1 + i].data(), token, arg_tokens[0].size());
-		arg_buffers[i] = arg_tokens[1 + i].data();
-		}
-
-		if (!skip_depth) {
-		cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
-		CG_DrawHUDString(
-		cgi.Localize(arg_tokens[0].data(), arg_buffers.data(), num_args),
-		x,
-		y,
-		hx * 2 * scale,
-		0,
-		scale);
-		cgi.SCR_SetAltTypeface(false);
-		}
-		continue;
-		}
-
-		if (!strcmp(token, "loc_string")) {
-		int32_t num_args = atoi(COM_Parse(&s));
-
-		if (num_args < 0 || num_args >= MAX_LOCALIZATION_ARGS)
-		cgi.Com_Error("Bad loc string");
-
-		arg_buffers.fill(nullptr);
-
-		// parse base
-		token = COM_Parse(&s);
-		Q_strlcpy(arg_tokens[0].data(), token, arg_tokens[0].size());
-
-		// parse args
-		for (size_t i = 0; i < num_args; i++) {
-		token = COM_Parse(&s);
-		Q_strlcpy(arg_tokens[1 + i].data(), token, arg_tokens[0].size());
-		arg_buffers[i] = arg_tokens[1 + i].data();
-		}
-
-		if (!skip_depth) {
-		if (!scr_usekfont->integer)
-		CG_DrawString(x, y, scale, cgi.Localize(arg_tokens[0].data(), arg_buffers.data(), num_args));
-		else {
-		cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
-		cgi.SCR_DrawFontString(cgi.Localize(arg_tokens[0].data(), arg_buffers.data(), num_args), x, y - (font_y_offset * scale), scale, rgba_white, true, text_align_t::LEFT);
-		cgi.SCR_SetAltTypeface(false);
-		}
-		}
-		continue;
+			break;
 		}
 
-		if (!strcmp(token, "loc_cstring2")) {
-		int32_t num_args = atoi(COM_Parse(&s));
-
-		if (num_args < 0 || num_args >= MAX_LOCALIZATION_ARGS)
-		cgi.Com_Error("Bad loc string");
-
-		arg_buffers.fill(nullptr);
-
-		// parse base
-		token = COM_Parse(&s);
-		Q_strlcpy(arg_tokens[0].data(), token, arg_tokens[0].size());
-
-		// parse args
-		for (size_t i = 0; i < num_args; i++) {
-		token = COM_Parse(&s);
-		Q_strlcpy(arg_tokens[1 + i].data(), token, arg_tokens[0].size());
-		arg_buffers[i] = arg_tokens[1 + i].data();
-		}
+		case layout_op_t::LocStatCString:
+		case layout_op_t::LocStatCString2:
+			if (skip_depth)
+				break;
 
-		if (!skip_depth) {
-		cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
-		CG_DrawHUDString(cgi.Localize(arg_tokens[0].data(), arg_buffers.data(), num_args), x, y, hx * 2 * scale, 0x80, scale);
-		cgi.SCR_SetAltTypeface(false);
-		}
-		continue;
-		}
+			index = CG_StatConfigString(ps, args[0]);
+			cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
+			CG_DrawHUDString(cgi.Localize(cgi.get_configString(index), nullptr, 0), x, y, hx * 2 * scale, instr.op == layout_op_t::LocStatCString2 ? 0x80 : 0, scale);
+			cgi.SCR_SetAltTypeface(false);
+			break;
 
-		if (!strcmp(token, "loc_string2") || !strcmp(token, "loc_rstring2") ||
-		!strcmp(token, "loc_string") || !strcmp(token, "loc_rstring")) {
-		bool green = token[strlen(token) - 1] == '2';
-		bool rightAlign = !Q_strncasecmp(token, "loc_rstring", strlen("loc_rstring"));
-		int32_t num_args = atoi(COM_Parse(&s));
+		case layout_op_t::LocCString:
+		case layout_op_t::LocCString2:
+		case layout_op_t::LocString:
+		case layout_op_t::LocStringAligned: {
+			if (skip_depth)
+				break;
 
-		if (num_args < 0 || num_args >= MAX_LOCALIZATION_ARGS)
-		cgi.Com_Error("Bad loc string");
+			const int32_t num_args = args[0];
 
-		arg_buffers.fill(nullptr);
+			arg_buffers.fill(nullptr);
+			for (int32_t i = 0; i < num_args; i++)
+				arg_buffers[i] = program.string(instr, 1 + i);
 
-		// parse base
-		token = COM_Parse(&s);
-		Q_strlcpy(arg_tokens[0].data(), token, arg_tokens[0].size());
+			const char* locStr = cgi.Localize(program.string(instr, 0), arg_buffers.data(), num_args);
 
-		// parse args
-		for (size_t i = 0; i < num_args; i++) {
-		token = COM_Parse(&s);
-		Q_strlcpy(arg_tokens[1 + i].data(), token, arg_tokens[0].size());
-		arg_buffers[i] = arg_tokens[1 + i].data();
-		}
+			if (instr.op == layout_op_t::LocCString || instr.op == layout_op_t::LocCString2) {
+				cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
+				CG_DrawHUDString(locStr, x, y, hx * 2 * scale, instr.op == layout_op_t::LocCString2 ? 0x80 : 0, scale);
+				cgi.SCR_SetAltTypeface(false);
+				break;
+			}
 
-		if (!skip_depth) {
-		const char* locStr = cgi.Localize(arg_tokens[0].data(), arg_buffers.data(), num_args);
-		int xOffs = 0;
-		if (rightAlign) {
-		xOffs = scr_usekfont->integer ? cgi.SCR_MeasureFontString(locStr, scale).x : (strlen(locStr) * CONCHAR_WIDTH * scale);
-		}
+			const bool green = instr.flags & LAYOUT_FLAG_GREEN;
+			int xOffs = 0;
+			if (instr.flags & LAYOUT_FLAG_RIGHT_ALIGN) {
+				xOffs = scr_usekfont->integer ? cgi.SCR_MeasureFontString(locStr, scale).x : (strlen(locStr) * CONCHAR_WIDTH * scale);
+			}
 
-		if (!scr_usekfont->integer)
-		CG_DrawString(x - xOffs, y, scale, locStr, green);
-		else {
-		cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
-		cgi.SCR_DrawFontString(locStr, x - xOffs, y - (font_y_offset * scale), scale, green ? alt_color : rgba_white, true, text_align_t::LEFT);
-		cgi.SCR_SetAltTypeface(false);
-		}
-		}
-		continue;
+			if (!scr_usekfont->integer)
+				CG_DrawString(x - xOffs, y, scale, locStr, green);
+			else {
+				cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
+				cgi.SCR_DrawFontString(locStr, x - xOffs, y - (font_y_offset * scale), scale, green ? alt_color : rgba_white, true, text_align_t::LEFT);
+				cgi.SCR_SetAltTypeface(false);
+			}
+			break;
 		}
 
 		// draw time remaining
-		if (!strcmp(token, "time_limit")) {
-		// end frame
-		token = COM_Parse(&s);
+		case layout_op_t::TimeLimit: {
+			if (skip_depth)
+				break;
 
-		if (!skip_depth) {
-		arg_buffers.fill(nullptr);
+			arg_buffers.fill(nullptr);
 
-		const int32_t raw_end_frame = atoi(token);
-		const int32_t current_frame = cgi.CL_ServerFrame();
+			// end frame
+			const int32_t raw_end_frame = args[0];
+			const int32_t current_frame = cgi.CL_ServerFrame();
 
-		// skip if it's already expired
-		if (raw_end_frame < current_frame)
-		continue;
+			// skip if it's already expired
+			if (raw_end_frame < current_frame)
+				break;
 
-		// promote before subtracting to avoid signed underflow
-		const uint64_t remaining_frames = static_cast<uint64_t>(raw_end_frame) - static_cast<uint64_t>(current_frame);
-		const uint64_t remaining_ms = remaining_frames * cgi.frameTimeMs;
+			// promote before subtracting to avoid signed underflow
+			const uint64_t remaining_frames = static_cast<uint64_t>(raw_end_frame) - static_cast<uint64_t>(current_frame);
+			const uint64_t remaining_ms = remaining_frames * cgi.frameTimeMs;
 
-		const bool green = true;
-		arg_buffers[0] = G_Fmt("{:02}:{:02}", (remaining_ms / 1000) / 60, (remaining_ms / 1000) % 60).data();
+			const bool green = true;
+			arg_buffers[0] = G_Fmt("{:02}:{:02}", (remaining_ms / 1000) / 60, (remaining_ms / 1000) % 60).data();
 
-		const char* locStr = cgi.Localize("$g_score_time", arg_buffers.data(), 1);
+			const char* locStr = cgi.Localize("$g_score_time", arg_buffers.data(), 1);
 
-		const int xOffs = scr_usekfont->integer
-		? static_cast<int>(cgi.SCR_MeasureFontString(locStr, scale).x)
-		: static_cast<int>(strlen(locStr)) * CONCHAR_WIDTH * scale;
+			const int xOffs = scr_usekfont->integer
+				? static_cast<int>(cgi.SCR_MeasureFontString(locStr, scale).x)
+				: static_cast<int>(strlen(locStr)) * CONCHAR_WIDTH * scale;
 
-		if (!scr_usekfont->integer) {
-		CG_DrawString(x - xOffs, y, scale, locStr, green);
-		}
-		else {
-		cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
-		cgi.SCR_DrawFontString(
-		locStr,
-		x - xOffs,
-		y - (font_y_offset * scale),
-		scale,
-		green ? alt_color : rgba_white,
-		true,
-		text_align_t::LEFT
-		);
-		cgi.SCR_SetAltTypeface(false);
-		}
-		}
+			if (!scr_usekfont->integer) {
+				CG_DrawString(x - xOffs, y, scale, locStr, green);
+			}
+			else {
+				cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
+				cgi.SCR_DrawFontString(
+					locStr,
+					x - xOffs,
+					y - (font_y_offset * scale),
+					scale,
+					green ? alt_color : rgba_white,
+					true,
+					text_align_t::LEFT
+				);
+				cgi.SCR_SetAltTypeface(false);
+			}
+			break;
 		}
 
 		// draw client dogtag
-		if (!strcmp(token, "dogtag")) {
-			token = COM_Parse(&s);
+		case layout_op_t::DogTag: {
+			if (skip_depth)
+				break;
 
-			if (!skip_depth) {
-				value = atoi(token);
-				if (value >= MAX_CLIENTS || value < 0)
-					cgi.Com_Error("client >= MAX_CLIENTS");
+			value = args[0];
+			if (value >= MAX_CLIENTS || value < 0)
+				cgi.Com_Error("client >= MAX_CLIENTS");
 
-				const std::string_view path = G_Fmt("/tags/{}", cgi.CL_GetClientDogtag(value)).data();
-				cgi.SCR_DrawPic(x, y, 198 * scale, 32 * scale, path.data());
-			}
+			const std::string_view path = G_Fmt("/tags/{}", cgi.CL_GetClientDogtag(value)).data();
+			cgi.SCR_DrawPic(x, y, 198 * scale, 32 * scale, path.data());
+			break;
 		}
 
-		if (!strcmp(token, "start_table")) {
-			token = COM_Parse(&s);
-			value = atoi(token);
+		case layout_op_t::StartTable: {
+			if (skip_depth)
+				break;
 
-			if (!skip_depth) {
-				if (value >= q_countof(hud_temp.table_rows[0].table_cells))
-					cgi.Com_Error("table too big");
+			value = args[0];
 
-				hud_temp.num_columns = value;
-				hud_temp.num_rows = 1;
+			if (value >= q_countof(hud_temp.table_rows[0].table_cells))
+				cgi.Com_Error("table too big");
 
-				for (int i = 0; i < value; i++)
-					hud_temp.column_widths[i] = 0;
-			}
+			hud_temp.num_columns = value;
+			hud_temp.num_rows = 1;
+
+			for (int i = 0; i < value; i++)
+				hud_temp.column_widths[i] = 0;
 
 			for (int i = 0; i < value; i++) {
-				token = COM_Parse(&s);
-				if (!skip_depth) {
-					token = cgi.Localize(token, nullptr, 0);
-					Q_strlcpy(hud_temp.table_rows[0].table_cells[i].text, token, sizeof(hud_temp.table_rows[0].table_cells[i].text));
-					hud_temp.column_widths[i] = max(hud_temp.column_widths[i], (size_t)cgi.SCR_MeasureFontString(hud_temp.table_rows[0].table_cells[i].text, scale).x);
-				}
+				const char* token = cgi.Localize(program.string(instr, i), nullptr, 0);
+				Q_strlcpy(hud_temp.table_rows[0].table_cells[i].text, token, sizeof(hud_temp.table_rows[0].table_cells[i].text));
+				hud_temp.column_widths[i] = max(hud_temp.column_widths[i], (size_t)cgi.SCR_MeasureFontString(hud_temp.table_rows[0].table_cells[i].text, scale).x);
 			}
+			break;
 		}
 
-		if (!strcmp(token, "table_row")) {
-			token = COM_Parse(&s);
-			value = atoi(token);
+		case layout_op_t::TableRow: {
+			if (skip_depth)
+				break;
 
-			if (!skip_depth) {
-				if (hud_temp.num_rows >= q_countof(hud_temp.table_rows)) {
-					cgi.Com_Error("table too big");
-					return;
-				}
+			value = args[0];
+
+			if (hud_temp.num_rows >= q_countof(hud_temp.table_rows)) {
+				cgi.Com_Error("table too big");
+				return;
 			}
 
 			auto& row = hud_temp.table_rows[hud_temp.num_rows];
 
 			for (int i = 0; i < value; i++) {
-				token = COM_Parse(&s);
-				if (!skip_depth) {
-					Q_strlcpy(row.table_cells[i].text, token, sizeof(row.table_cells[i].text));
-					hud_temp.column_widths[i] = max(hud_temp.column_widths[i], (size_t)cgi.SCR_MeasureFontString(row.table_cells[i].text, scale).x);
-				}
+				Q_strlcpy(row.table_cells[i].text, program.string(instr, i), sizeof(row.table_cells[i].text));
+				hud_temp.column_widths[i] = max(hud_temp.column_widths[i], (size_t)cgi.SCR_MeasureFontString(row.table_cells[i].text, scale).x);
 			}
 
-			if (!skip_depth) {
-				for (int i = value; i < hud_temp.num_columns; i++)
-					row.table_cells[i].text[0] = '\0';
+			for (int i = value; i < hud_temp.num_columns; i++)
+				row.table_cells[i].text[0] = '\0';
 
-				hud_temp.num_rows++;
-			}
+			hud_temp.num_rows++;
+			break;
 		}
 
-		if (!strcmp(token, "draw_table")) {
-			if (!skip_depth) {
-				// in scaled pixels, incl padding between elements
-				uint32_t total_inner_table_width = 0;
-
-				for (int i = 0; i < hud_temp.num_columns; i++) {
-					if (i != 0)
-						total_inner_table_width += cgi.SCR_MeasureFontString(" ", scale).x;
+		case layout_op_t::DrawTable: {
+			if (skip_depth)
+				break;
 
-					total_inner_table_width += hud_temp.column_widths[i];
-				}
+			// in scaled pixels, incl padding between elements
+			uint32_t total_inner_table_width = 0;
 
-				// in scaled pixels
-				uint32_t total_table_height = hud_temp.num_rows * (CONCHAR_WIDTH + font_y_offset) * scale;
+			for (int i = 0; i < hud_temp.num_columns; i++) {
+				if (i != 0)
+					total_inner_table_width += cgi.SCR_MeasureFontString(" ", scale).x;
 
-				CG_DrawTable(x, y, total_inner_table_width, total_table_height, scale);
+				total_inner_table_width += hud_temp.column_widths[i];
 			}
+
+			// in scaled pixels
+			uint32_t total_table_height = hud_temp.num_rows * (CONCHAR_WIDTH + font_y_offset) * scale;
+
+			CG_DrawTable(x, y, total_inner_table_width, total_table_height, scale);
+			break;
 		}
 
-		if (!strcmp(token, "stat_pname")) {
-			token = COM_Parse(&s);
+		case layout_op_t::StatPName: {
+			if (skip_depth)
+				break;
 
-			if (!skip_depth) {
-				text_align_t align = text_align_t::LEFT;
+			text_align_t align = text_align_t::LEFT;
 
-				index = atoi(token);
-				if (index < 0 || index >= MAX_STATS)
-					cgi.Com_Error("Bad stat_string index");
+			index = args[0];
+			if (index < 0 || index >= MAX_STATS)
+				cgi.Com_Error("Bad stat_string index");
 
-				//muff: hacky hacks - move crosshair id text to 160, align centrally
-				if (index == STAT_CROSSHAIR_ID_VIEW) {
-					x = (hud_vrect.x + hud_vrect.width / 2 + 160 - hx) * scale;
-					align = text_align_t::CENTER;
-				}
+			//muff: hacky hacks - move crosshair id text to 160, align centrally
+			if (index == STAT_CROSSHAIR_ID_VIEW) {
+				x = (hud_vrect.x + hud_vrect.width / 2 + 160 - hx) * scale;
+				align = text_align_t::CENTER;
+			}
 
-				index = ps->stats[index] - 1;
+			index = ps->stats[index] - 1;
 
-				if (!scr_usekfont->integer)
-					CG_DrawString(x, y, scale, cgi.CL_GetClientName(index));
-				else {
-					cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
-					cgi.SCR_DrawFontString(cgi.CL_GetClientName(index), x, y - (font_y_offset * scale), scale, rgba_white, true, align);
-					cgi.SCR_SetAltTypeface(false);
-				}
+			if (!scr_usekfont->integer)
+				CG_DrawString(x, y, scale, cgi.CL_GetClientName(index));
+			else {
+				cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
+				cgi.SCR_DrawFontString(cgi.CL_GetClientName(index), x, y - (font_y_offset * scale), scale, rgba_white, true, align);
+				cgi.SCR_SetAltTypeface(false);
 			}
-			continue;
+			break;
 		}
 
-		if (!strcmp(token, "health_bars")) {
+		case layout_op_t::HealthBars: {
 			if (skip_depth)
-				continue;
+				break;
 
 			const byte* stat = reinterpret_cast<const byte*>(&ps->stats[STAT_HEALTH_BARS]);
 			const char* name = cgi.Localize(cgi.get_configString(CONFIG_HEALTH_BAR_NAME), nullptr, 0);
@@ -1687,13 +1457,15 @@ static void CG_ExecuteLayoutString(const char* s, vrect_t hud_vrect, vrect_t hud
 
 				y += bar_height * 3;
 			}
+			break;
 		}
 
-		if (!strcmp(token, "story")) {
+		// story is drawn even inside a false if block, as it always has been
+		case layout_op_t::Story: {
 			const char* story_str = cgi.get_configString(CONFIG_STORY);
 
 			if (!*story_str)
-				continue;
+				break;
 
 			const char* localized = cgi.Localize(story_str, nullptr, 0);
 			Vector2 size = cgi.SCR_MeasureFontString(localized, scale);
@@ -1703,6 +1475,12 @@ static void CG_ExecuteLayoutString(const char* s, vrect_t hud_vrect, vrect_t hud
 			cgi.SCR_SetAltTypeface(ui_acc_alttypeface->integer && true);
 			cgi.SCR_DrawFontString(localized, centerx, centery, scale, rgba_white, true, text_align_t::CENTER);
 			cgi.SCR_SetAltTypeface(false);
+			break;
+		}
+
+		case layout_op_t::Error:
+			cgi.Com_Error(program.string(instr, 0));
+			return;
 		}
 	}
 
@@ -1873,4 +1651,5 @@ void CG_InitScreen() {
 	ui_acc_alttypeface = cgi.cvar("ui_acc_alttypeface", "0", CVAR_NOFLAGS);
 
 	hud_data = {};
+	layout_cache.clear();
 }
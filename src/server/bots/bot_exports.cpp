@@ -138,18 +138,8 @@ int32_t Bot_GetItemID(const char *className) {
 		return ITEM_NULL;
 	}
 
-	for (int i = 0; i < IT_TOTAL; ++i) {
-		const Item *item = &itemList[i];
-		if (item->className == nullptr || item->className[0] == '\0') {
-			continue;
-		}
-
-		if (Q_strcasecmp(item->className, className) == 0) {
-			return item->id;
-		}
-	}
-
-	return Item_Invalid;
+	const Item *item = FindItemByClassname(className);
+	return item ? item->id : Item_Invalid;
 }
 
 /*
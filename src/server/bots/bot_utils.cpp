@@ -7,8 +7,12 @@ bot_utils.cpp implementation.*/
 #include "../gameplay/g_capture.hpp"
 #include "../monsters/m_player.hpp"
 #include "bot_utils.hpp"
+#include "../gameplay/g_jobs.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
 
 	constexpr int Team_Coop_Monster = 0;
 
@@ -17,7 +21,7 @@ bot_utils.cpp implementation.*/
 Player_UpdateState
 ================
 */
-static void Player_UpdateState(gentity_t *player) {
+static void Player_UpdateState(gentity_t *player, JobCommandBuffer &commands) {
 	const client_persistant_t &persistant = player->client->pers;
 
 	player->sv.entFlags = SVFL_NONE;
@@ -166,9 +170,10 @@ static void Player_UpdateState(gentity_t *player) {
 		armorInfo[2].itemID = IT_ARMOR_JACKET;
 		armorInfo[2].max_count = armor_stats[game.ruleset][Armor::Jacket].max_count;
 
-                gi.Info_ValueForKey(player->client->pers.userInfo, "name", player->sv.netName, sizeof(player->sv.netName));
-
-		gi.Bot_RegisterEntity(player);
+		commands.Defer([player]() {
+			gi.Info_ValueForKey(player->client->pers.userInfo, "name", player->sv.netName, sizeof(player->sv.netName));
+			gi.Bot_RegisterEntity(player);
+		});
 	}
 }
 
@@ -177,7 +182,7 @@ static void Player_UpdateState(gentity_t *player) {
 Monster_UpdateState
 ================
 */
-static void Monster_UpdateState(gentity_t *monster) {
+static void Monster_UpdateState(gentity_t *monster, JobCommandBuffer &commands) {
 	monster->sv.entFlags = SVFL_NONE;
 	if (monster->groundEntity != nullptr) {
 		monster->sv.entFlags |= SVFL_ONGROUND;
@@ -225,7 +230,7 @@ static void Monster_UpdateState(gentity_t *monster) {
 		monster->sv.startingHealth = monster->health;
 		monster->sv.maxHealth = monster->maxHealth;
 
-		gi.Bot_RegisterEntity(monster);
+		commands.Defer([monster]() { gi.Bot_RegisterEntity(monster); });
 	}
 }
 
@@ -234,7 +239,7 @@ static void Monster_UpdateState(gentity_t *monster) {
 Item_UpdateState
 ================
 */
-static void Item_UpdateState(gentity_t *item) {
+static void Item_UpdateState(gentity_t *item, JobCommandBuffer &commands) {
 	item->sv.entFlags = SVFL_IS_ITEM;
 	item->sv.respawnTime = 0;
 
@@ -290,7 +295,7 @@ static void Item_UpdateState(gentity_t *item) {
 		item->sv.init = true;
 		item->sv.targetName = item->targetName;
 
-		gi.Bot_RegisterEntity(item);
+		commands.Defer([item]() { gi.Bot_RegisterEntity(item); });
 	}
 }
 
@@ -299,7 +304,7 @@ static void Item_UpdateState(gentity_t *item) {
 Trap_UpdateState
 ================
 */
-static void Trap_UpdateState(gentity_t *danger) {
+static void Trap_UpdateState(gentity_t *danger, JobCommandBuffer &commands) {
 	danger->sv.entFlags = SVFL_TRAP_DANGER;
 	danger->sv.velocity = danger->velocity;
 
@@ -329,7 +334,7 @@ static void Trap_UpdateState(gentity_t *danger) {
 		danger->sv.init = true;
 		danger->sv.className = danger->className;
 
-		gi.Bot_RegisterEntity(danger);
+		commands.Defer([danger]() { gi.Bot_RegisterEntity(danger); });
 	}
 }
 
@@ -390,22 +395,277 @@ static void Mover_UpdateState(gentity_t *entity) {
 /*
 ================
 Entity_UpdateState
+
+Publishes the entity's state for the bot system. Only touches the entity
+itself; engine calls (bot registration) are recorded into 'commands' so
+this can run on a job worker.
 ================
 */
-void Entity_UpdateState(gentity_t *ent) {
+void Entity_UpdateState(gentity_t *ent, JobCommandBuffer &commands) {
 	if (ent->svFlags & SVF_MONSTER) {
-		Monster_UpdateState(ent);
+		Monster_UpdateState(ent, commands);
 	} else if (ent->flags & FL_TRAP || ent->flags & FL_TRAP_LASER_FIELD) {
-		Trap_UpdateState(ent);
+		Trap_UpdateState(ent, commands);
 	} else if (ent->item != nullptr) {
-		Item_UpdateState(ent);
+		Item_UpdateState(ent, commands);
 	} else if (ent->client != nullptr) {
-		Player_UpdateState(ent);
+		Player_UpdateState(ent, commands);
 	} else {
 		Mover_UpdateState(ent);
 	}
 }
 
+/*
+================
+Entity_UpdateState
+================
+*/
+void Entity_UpdateState(gentity_t *ent) {
+	JobCommandBuffer commands;
+	Entity_UpdateState(ent, commands);
+	commands.Flush();
+}
+
+namespace {
+
+struct bot_publish_stats_t {
+	std::atomic<size_t>	published{};
+	std::atomic<size_t>	skipped{};
+	bool				fastPath = false;
+	size_t				frames = 0;
+	size_t				totalPublished = 0;
+	size_t				totalSkipped = 0;
+	size_t				fastPathFrames = 0;
+};
+
+bot_publish_stats_t publishStats;
+
+/*
+================
+BotStateHasher
+
+FNV-1a over the raw bytes of each input mixed in.
+================
+*/
+struct BotStateHasher {
+	uint64_t hash = 0xcbf29ce484222325ull;
+
+	template <typename T>
+	void Mix(const T &value) {
+		const auto *bytes = reinterpret_cast<const uint8_t *>(&value);
+
+		for (size_t i = 0; i < sizeof(T); i++) {
+			hash ^= bytes[i];
+			hash *= 0x100000001b3ull;
+		}
+	}
+
+	[[nodiscard]] uint64_t Value() const {
+		return hash ? hash : 1; // 0 is reserved for "always publish"
+	}
+};
+
+/*
+================
+BotState_Signature
+
+Hashes every input the matching *_UpdateState reads, so an unchanged
+signature means republishing would write the same values. Returns 0 for
+entities whose state has to be rebuilt every frame: players and monsters
+move constantly, and a pending item respawn counts down with level.time.
+================
+*/
+uint64_t BotState_Signature(const gentity_t *ent) {
+	BotStateHasher hasher;
+
+	if (ent->svFlags & SVF_MONSTER) {
+		return 0;
+	} else if (ent->flags & FL_TRAP || ent->flags & FL_TRAP_LASER_FIELD) {
+		const bool ownerIsClient = ent->owner != nullptr && ent->owner->client != nullptr;
+
+		hasher.Mix(ent->velocity);
+		hasher.Mix(ownerIsClient ? ent->owner->s.skinNum : 0);
+		hasher.Mix(ent->groundEntity != nullptr);
+		hasher.Mix(ent->flags & FL_TRAP_LASER_FIELD);
+		hasher.Mix(ent->s.origin);
+		hasher.Mix(ent->s.oldOrigin);
+		hasher.Mix(ent->svFlags & SVF_NOCLIENT);
+		hasher.Mix(ent->s.renderFX & RF_BEAM);
+	} else if (ent->item != nullptr) {
+		if (ent->solid == SOLID_NOT && ent->nextThink.milliseconds() > 0 && (ent->svFlags & SVF_RESPAWNING))
+			return 0;
+
+		hasher.Mix(ent->item);
+		hasher.Mix(ent->className);
+		hasher.Mix(ent->team != nullptr);
+		hasher.Mix(ent->solid == SOLID_NOT);
+		hasher.Mix(ent->nextThink.milliseconds() > 0);
+
+		if (ent->item->id == IT_FLAG_RED || ent->item->id == IT_FLAG_BLUE)
+			hasher.Mix(GetFlagStatus(ent->item->id == IT_FLAG_RED ? Team::Red : Team::Blue));
+	} else if (ent->client != nullptr) {
+		return 0;
+	} else {
+		hasher.Mix(ent->health);
+		hasher.Mix(ent->takeDamage);
+		hasher.Mix(ent->svFlags & SVF_DOOR);
+		hasher.Mix(ent->spawnFlags.value);
+		hasher.Mix(ent->moveInfo.state);
+		hasher.Mix(ent->moveInfo.startOrigin);
+		hasher.Mix(ent->moveInfo.endOrigin);
+		hasher.Mix(ent->flags & FL_LOCKED);
+	}
+
+	return hasher.Value();
+}
+
+#ifndef NDEBUG
+/*
+================
+BotState_VerifySkip
+
+Rebuilds a skipped entity's state and checks the published copy already
+held the same values.
+================
+*/
+void BotState_VerifySkip(gentity_t *ent) {
+	const sv_entity_t before = ent->sv;
+	JobCommandBuffer commands;
+
+	Entity_UpdateState(ent, commands);
+
+	assert(ent->sv.entFlags == before.entFlags);
+	assert(ent->sv.health == before.health);
+	assert(ent->sv.team == before.team);
+	assert(ent->sv.respawnTime == before.respawnTime);
+	assert(ent->sv.itemID == before.itemID);
+	assert(ent->sv.className == before.className);
+	assert(!memcmp(&ent->sv.velocity, &before.velocity, sizeof(before.velocity)));
+	assert(!memcmp(&ent->sv.startOrigin, &before.startOrigin, sizeof(before.startOrigin)));
+	assert(!memcmp(&ent->sv.endOrigin, &before.endOrigin, sizeof(before.endOrigin)));
+}
+#endif
+
+/*
+================
+Entity_PublishState
+
+Republishes the entity only if its bot-relevant inputs changed since the
+last publish. Entities the engine has not seen yet (sv.init cleared) are
+always published so registration happens exactly as before.
+================
+*/
+bool Entity_PublishState(gentity_t *ent, JobCommandBuffer &commands, bool dirtyOnly) {
+	if (!dirtyOnly) {
+		ent->botStateSignature = 0;
+		Entity_UpdateState(ent, commands);
+		return true;
+	}
+
+	const uint64_t signature = BotState_Signature(ent);
+
+	if (ent->sv.init && signature != 0 && signature == ent->botStateSignature) {
+#ifndef NDEBUG
+		BotState_VerifySkip(ent);
+#endif
+		return false;
+	}
+
+	ent->botStateSignature = signature;
+	Entity_UpdateState(ent, commands);
+	return true;
+}
+
+/*
+================
+BotClientsPresent
+================
+*/
+bool BotClientsPresent() {
+	for (size_t i = 1; i <= game.maxClients; i++) {
+		const gentity_t *ent = &g_entities[i];
+
+		if (ent->inUse && (ent->svFlags & SVF_BOT))
+			return true;
+	}
+
+	return false;
+}
+
+} // namespace
+
+/*
+================
+Bot_PublishWorldState
+
+Publishes the per-entity state the engine's bot code reads. With
+g_bot_state_dirty set, entities whose inputs are unchanged are skipped,
+and when no bots are connected only movers are kept current, since door
+and plat states also feed monster pathing.
+================
+*/
+void Bot_PublishWorldState() {
+	const bool dirtyOnly = g_bot_state_dirty->integer != 0;
+
+	publishStats.published = 0;
+	publishStats.skipped = 0;
+	publishStats.fastPath = dirtyOnly && !BotClientsPresent();
+
+	if (publishStats.fastPath) {
+		JobCommandBuffer commands;
+		size_t published = 0;
+
+		for (gentity_t *ent : G_RegistryMembers(EntityRegistry::Mover)) {
+			if (Entity_PublishState(ent, commands, true))
+				published++;
+		}
+
+		commands.Flush();
+		publishStats.published = published;
+		publishStats.fastPathFrames++;
+	} else {
+		// each entity only writes its own sv block; registrations are replayed in entity order
+		G_Jobs().ParallelForDeferred(globals.numEntities, 64, [dirtyOnly](size_t begin, size_t end, JobCommandBuffer &commands) {
+			size_t published = 0;
+			size_t skipped = 0;
+
+			for (size_t i = begin; i < end; i++) {
+				gentity_t *e = &g_entities[i];
+
+				if (!e->inUse)
+					continue;
+
+				if (Entity_PublishState(e, commands, dirtyOnly))
+					published++;
+				else
+					skipped++;
+			}
+
+			publishStats.published += published;
+			publishStats.skipped += skipped;
+		});
+	}
+
+	publishStats.frames++;
+	publishStats.totalPublished += publishStats.published;
+	publishStats.totalSkipped += publishStats.skipped;
+}
+
+/*
+================
+Bot_PrintPublishStats
+================
+*/
+void Bot_PrintPublishStats() {
+	const size_t frames = std::max<size_t>(publishStats.frames, 1);
+
+	gi.Com_PrintFmt("Bot world state: {} published, {} skipped last frame{}\n", publishStats.published.load(),
+		publishStats.skipped.load(), publishStats.fastPath ? " (no bots, movers only)" : "");
+	gi.Com_PrintFmt("Over {} frames: {:.1f} published/frame, {:.1f} skipped/frame, {} frames without bots\n",
+		publishStats.frames, publishStats.totalPublished / static_cast<double>(frames),
+		publishStats.totalSkipped / static_cast<double>(frames), publishStats.fastPathFrames);
+}
+
 static USE(info_nav_lock_use) (gentity_t *self, gentity_t *other, gentity_t *activator) -> void {
 	gentity_t *n = nullptr;
 
@@ -13,7 +13,12 @@ inline constexpr auto DamageBoostTimers = std::to_array<PowerupTimer>({
 	PowerupTimer::DoubleDamage,
 });
 
+class JobCommandBuffer;
+
 void Entity_UpdateState(gentity_t* entity);
+void Entity_UpdateState(gentity_t* entity, JobCommandBuffer& commands);
+void Bot_PublishWorldState();
+void Bot_PrintPublishStats();
 const gentity_t* FindLocalPlayer();
 const gentity_t* FindFirstBot();
 const gentity_t* FindFirstMonster();
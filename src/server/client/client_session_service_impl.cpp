@@ -932,6 +932,7 @@ DisconnectResult ClientSessionServiceImpl::ClientDisconnect(local_game_import_t&
 	ent->inUse = false;
 	ent->sv.init = false;
 	ent->className = "disconnected";
+	G_EntityHotSync(ent);
 	cl->pers.connected = false;
 	cl->sess.inGame = false;
 	cl->sess.matchWins = 0;
@@ -1317,7 +1318,7 @@ gentity_t* ent, usercmd_t* ucmd) {
 
 			if (onLadder) {
 				if (!deathmatch->integer && cl->last_ladder_sound < level.time) {
-					ent->s.event = EV_LADDER_STEP;
+					G_SetEvent(ent, EV_LADDER_STEP);
 					cl->last_ladder_sound = level.time + LADDER_SOUND_TIME;
 				}
 			}
@@ -1428,9 +1429,7 @@ gentity_t* ent, usercmd_t* ucmd) {
 	}
 
 	// update followers if being followed
-	for (auto ec : active_clients())
-		if (ec->client->follow.target == ent)
-			ClientUpdateFollowers(ec);
+	ClientUpdateFollowersOf(ent);
 
 	// perform once-a-second actions
 	ClientTimerActions(ent);}
@@ -30,6 +30,7 @@ namespace Commands {
 	// Use a map for efficient O(1) lookup of vote commands.
 	static std::unordered_map<std::string, VoteCommand, StringViewHash, std::equal_to<>> s_voteCommands;
 	static std::vector<VoteDefinitionView> s_voteDefinitions;
+	static uint32_t s_voteDefinitionsRevision = 0;	// bumped each time the definitions are registered
 
 	bool IsVoteCommandEnabled(std::string_view name) {
 		if (!g_allowVoting || !g_allowVoting->integer) {
@@ -368,6 +369,7 @@ queue state consistent.
 		RegisterVoteCommand("cointoss", &Validate_Cointoss, &Pass_Cointoss, kVoteFlag_Cointoss, 1, "", "Flip a coin for a random decision", true);
 		RegisterVoteCommand("random", &Validate_Random, &Pass_Random, kVoteFlag_Random, 2, "<max>", "Roll a random number between 1 and <max>", true);
 		RegisterVoteCommand("arena", &Validate_Arena, &Pass_Arena, kVoteFlag_Arena, 2, "<number>", "Switches to a different arena", true);
+		s_voteDefinitionsRevision++;
 	}
 
 	static void VoteCommandStore(
@@ -417,6 +419,10 @@ queue state consistent.
 		return s_voteDefinitions;
 	}
 
+	uint32_t GetVoteDefinitionsRevision() {
+		return s_voteDefinitionsRevision;
+	}
+
         VoteLaunchResult TryLaunchVote(gentity_t* ent, std::string_view voteName, std::string_view voteArg) {
 		VoteLaunchResult result;
 		std::string validationError;
@@ -692,51 +698,6 @@ queue state consistent.
 
 } // namespace Commands
 
-void G_RevertVote(gclient_t* client) {
-	if (!client) {
-		return;
-	}
-
-	if (!level.vote.time || !level.vote.client) {
-		client->pers.voted = 0;
-		return;
-	}
-
-	if (client->pers.voted > 0) {
-		int yesVotes = std::max(0, static_cast<int>(level.vote.countYes) - 1);
-		level.vote.countYes = static_cast<int8_t>(yesVotes);
-	}
-	else if (client->pers.voted < 0) {
-		int noVotes = std::max(0, static_cast<int>(level.vote.countNo) - 1);
-		level.vote.countNo = static_cast<int8_t>(noVotes);
-	}
-
-	client->pers.voted = 0;
-
-	if (level.vote.client != client) {
-		return;
-	}
-
-	gi.Broadcast_Print(PRINT_HIGH, "Vote cancelled (caller disconnected).\n");
-
-	level.vote.client = nullptr;
-	level.vote.cmd = nullptr;
-	level.vote.arg.clear();
-	level.vote.time = 0_sec;
-	level.vote.executeTime = 0_sec;
-	level.vote.countYes = 0;
-	level.vote.countNo = 0;
-	level.vote_flags_enable = 0;
-	level.vote_flags_disable = 0;
-
-	for (auto ec : active_clients()) {
-		if (ec->client) {
-			ec->client->pers.voted = 0;
-		}
-	}
-}
-
-
 void Vote_Passed() {
 	const VoteCommand* command = level.vote.cmd;
 	if (!command) {
@@ -51,6 +51,7 @@ namespace Commands {
 
 	VoteLaunchResult TryLaunchVote(gentity_t* ent, std::string_view voteName, std::string_view voteArg);
 	std::span<const VoteDefinitionView> GetRegisteredVoteDefinitions();
+	uint32_t GetVoteDefinitionsRevision();
 
 } // namespace Commands
 
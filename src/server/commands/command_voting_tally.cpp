@@ -0,0 +1,118 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+command_voting_tally.cpp (Vote Tally) Keeps the running counts of the vote in progress, so
+CheckVote can decide it each frame from `level.vote.countYes`, `level.vote.countNo` and
+`level.pop.num_voting_clients` without walking the clients. Key Responsibilities: - Eligibility:
+`G_ClientCanVote` is the one definition of who may vote; CalculateRanks counts eligible clients
+whenever a client connects, leaves or changes team. - Casting: `G_CastVote` records a client's
+choice once, from either the `vote` command or the vote menu. - Withdrawal: a client's vote is
+taken back out of the counts when they disconnect or stop being eligible, and the vote is
+cancelled if it was the caller who left.*/
+
+#include "../g_local.hpp"
+
+/*
+=============
+G_ClientCanVote
+
+Players vote unless they are bots; spectators only when g_allowSpecVote
+lets them.
+=============
+*/
+bool G_ClientCanVote(gclient_t* cl) {
+	if (!cl)
+		return false;
+
+	if (!ClientIsPlaying(cl))
+		return g_allowSpecVote->integer != 0;
+
+	return !cl->sess.is_a_bot;
+}
+
+/*
+=============
+G_CastVote
+
+Counts a yes or no from a client who has not voted yet. Returns false,
+changing nothing, if there is no vote or the client may not vote.
+=============
+*/
+bool G_CastVote(gclient_t* cl, bool yes) {
+	if (!level.vote.time || !cl || cl->pers.voted || !G_ClientCanVote(cl))
+		return false;
+
+	if (yes) {
+		level.vote.countYes++;
+		cl->pers.voted = 1;
+	}
+	else {
+		level.vote.countNo++;
+		cl->pers.voted = -1;
+	}
+
+	return true;
+}
+
+/*
+=============
+G_WithdrawVote
+
+Takes a client's vote back out of the counts.
+=============
+*/
+void G_WithdrawVote(gclient_t* cl) {
+	if (!cl)
+		return;
+
+	if (level.vote.time && level.vote.client) {
+		if (cl->pers.voted > 0) {
+			int yesVotes = std::max(0, static_cast<int>(level.vote.countYes) - 1);
+			level.vote.countYes = static_cast<int8_t>(yesVotes);
+		}
+		else if (cl->pers.voted < 0) {
+			int noVotes = std::max(0, static_cast<int>(level.vote.countNo) - 1);
+			level.vote.countNo = static_cast<int8_t>(noVotes);
+		}
+	}
+
+	cl->pers.voted = 0;
+}
+
+/*
+=============
+G_RevertVote
+
+Called as a client disconnects; withdraws their vote, and cancels the
+vote outright if they called it.
+=============
+*/
+void G_RevertVote(gclient_t* client) {
+	if (!client) {
+		return;
+	}
+
+	G_WithdrawVote(client);
+
+	if (!level.vote.time || !level.vote.client || level.vote.client != client) {
+		return;
+	}
+
+	gi.Broadcast_Print(PRINT_HIGH, "Vote cancelled (caller disconnected).\n");
+
+	level.vote.client = nullptr;
+	level.vote.cmd = nullptr;
+	level.vote.arg.clear();
+	level.vote.time = 0_sec;
+	level.vote.executeTime = 0_sec;
+	level.vote.countYes = 0;
+	level.vote.countNo = 0;
+	level.vote_flags_enable = 0;
+	level.vote_flags_disable = 0;
+
+	for (auto ec : active_clients()) {
+		if (ec->client) {
+			ec->client->pers.voted = 0;
+		}
+	}
+}
@@ -39,17 +39,8 @@ Vote
 		return;
 	}
 
-	std::string_view vote = arg;
-	if (vote == "yes" || vote == "y") {
-		level.vote.countYes++;
-		ent->client->pers.voted = 1;
-	}
-	else if (vote == "no" || vote == "n") {
-		level.vote.countNo++;
-		ent->client->pers.voted = -1;
-	}
-	else {
-		PrintUsage(ent, args, "<yes|no>", "", "Casts your vote.");
+	if (!G_CastVote(ent->client, arg == "yes" || arg == "y")) {
+		gi.Client_Print(ent, PRINT_HIGH, "You are not eligible to vote.\n");
 		return;
 	}
 
@@ -24,6 +24,8 @@ class Menu;
 #include <cctype>
 #include <memory>
 #include <mutex>
+#include <source_location>
+#include <span>
 
 struct local_game_import_t;
 extern local_game_import_t gi;
@@ -373,6 +375,12 @@ constexpr bool is_string_like_v = std::is_convertible_v<T, std::string_view>;
 template<typename T>
 constexpr bool is_valid_loc_embed_v = std::is_floating_point_v<std::remove_reference_t<T>> || std::is_integral_v<std::remove_reference_t<T>> || is_char_ptr_v<T> || is_string_like_v<T>;
 
+// trace facade (g_trace.cpp); every gi.trace/gi.traceLine is accounted to its call site
+trace_t G_Trace(const Vector3& start, const Vector3* mins, const Vector3* maxs, const Vector3& end, const gentity_t* passent, contents_t contentmask, const std::source_location& where);
+void G_TraceWorldChanged();
+void G_RegistrySync(gentity_t* ent);
+void G_SetEvent(gentity_t* ent, entity_event_t event);
+
 struct local_game_import_t : game_import_t {
 	inline local_game_import_t() = default;
 	inline local_game_import_t(const game_import_t& imports) :
@@ -464,12 +472,28 @@ public:
 	}
 
 	// collision detection
-	[[nodiscard]] inline trace_t trace(const Vector3& start, const Vector3& mins, const Vector3& maxs, const Vector3& end, const gentity_t* passent, contents_t contentmask) const {
-		return game_import_t::trace(start, &mins, &maxs, end, passent, contentmask);
+	[[nodiscard]] inline trace_t trace(const Vector3& start, const Vector3& mins, const Vector3& maxs, const Vector3& end, const gentity_t* passent, contents_t contentmask,
+		const std::source_location& where = std::source_location::current()) const {
+		return G_Trace(start, &mins, &maxs, end, passent, contentmask, where);
+	}
+
+	[[nodiscard]] inline trace_t traceLine(const Vector3& start, const Vector3& end, const gentity_t* passent, contents_t contentmask,
+		const std::source_location& where = std::source_location::current()) const {
+		return G_Trace(start, nullptr, nullptr, end, passent, contentmask, where);
 	}
 
-	[[nodiscard]] inline trace_t traceLine(const Vector3& start, const Vector3& end, const gentity_t* passent, contents_t contentmask) const {
-		return game_import_t::trace(start, nullptr, nullptr, end, passent, contentmask);
+	// linking changes what traces can hit, so memoized results are invalidated;
+	// it is also where entity registry membership is kept up to date
+	inline void linkEntity(gentity_t* ent) const {
+		game_import_t::linkEntity(ent);
+		G_TraceWorldChanged();
+		G_RegistrySync(ent);
+	}
+
+	inline void unlinkEntity(gentity_t* ent) const {
+		game_import_t::unlinkEntity(ent);
+		G_TraceWorldChanged();
+		G_RegistrySync(ent);
 	}
 
 	// [Paril-KEX] clip the box against the specified entity
@@ -1467,6 +1491,81 @@ enum class MoveType : uint8_t {
 	FreeCam		// spectator free cam
 };
 
+// typed entity registries (g_registry.cpp)
+enum class EntityRegistry : uint8_t {
+	None,
+	Monster,
+	Projectile,
+	Item,
+	Trap,
+	Mover,
+	Total
+};
+
+// entity classes that hot paths test for (g_entity_class.cpp); keep entityClassNames in sync
+enum class EntityClass : uint8_t {
+	Other,
+	Gib,
+	PlayerNoise,
+	BodyQue,
+	Grenade,
+	Nuke,
+	ProxMine,
+	TeslaMine,
+	MiscExplobox,
+	MiscTeleporterDest,
+	MiscCamera,
+	TriggerMiscCamera,
+	PathCorner,
+	PointCombat,
+	TargetActor,
+	TargetPoi,
+	FuncTrain,
+	FuncDoor,
+	FuncDoorRotating,
+	FuncDoorSecret,
+	FuncWater,
+	FuncAreaportal,
+	FuncPlat,
+	FuncPlat2,
+	ObjectRepair,
+	BotGoal,
+	BadArea,
+	AmmoPack,
+	MonsterCarrier,
+	MonsterChthon,
+	MonsterDaedalus,
+	MonsterFixbot,
+	MonsterFlyer,
+	MonsterGekk,
+	MonsterKamikaze,
+	MonsterLavaman,
+	MonsterMedicCommander,
+	MonsterMummy,
+	MonsterOgreMarksman,
+	MonsterOgreMultiGrenade,
+	MonsterOldOne,
+	MonsterOverlord,
+	MonsterStatue,
+	MonsterTarbabyHell,
+	MonsterTurret,
+	Total
+};
+
+// families of entity classes that are matched by name prefix
+enum class EntityClassGroup : uint16_t {
+	None = 0,
+	Player = bit_v<0>,			// player*
+	PlayerSpawn = bit_v<1>,		// info_player_*
+	TeamFlag = bit_v<2>,		// item_flag_*
+	Tesla = bit_v<3>,			// tesla*
+	FoodCubeTrap = bit_v<4>,	// food_cube_trap*
+	FuncPlat = bit_v<5>,		// func_plat*
+	Medic = bit_v<6>,			// monster_medic*
+	Widow = bit_v<7>			// monster_widow*
+};
+MAKE_ENUM_BITFLAGS(EntityClassGroup);
+
 // entity->flags
 enum ent_flags_t : uint64_t {
 	FL_NONE = 0, // no flags
@@ -2114,6 +2213,7 @@ struct QueuedMap {
 
 struct MapSystem {
 	std::vector<MapEntry> mapPool;
+	uint32_t poolRevision = 0;	// changes whenever mapPool is replaced
 	std::vector<QueuedMap> playQueue;
 	std::vector<MyMapRequest> myMapQueue;
 
@@ -2447,6 +2547,57 @@ struct GameLocals {
 
 constexpr size_t MAX_HEALTH_BARS = 2;
 
+// owners of level memory, reported by sv memstats; keep levelMemInfo in sync
+enum class LevelMem : uint8_t {
+	Strings,
+	SpawnState,
+	Reinforcements,
+	PoiPaths,
+	SpawnLists,
+	MatchLog,
+	WorldSnapshot,
+	Total
+};
+
+void* G_LevelAlloc(size_t size, LevelMem owner, size_t align = alignof(std::max_align_t));
+void G_LevelMemTrack(LevelMem owner, ptrdiff_t bytes);
+
+/*
+=============
+LevelAllocator
+
+Charges a container's storage to a level memory owner. The storage itself
+comes from the heap: containers regrow, and some outlive FreeTags.
+=============
+*/
+template<typename T, LevelMem Owner>
+struct LevelAllocator {
+	using value_type = T;
+
+	template<typename U>
+	struct rebind { using other = LevelAllocator<U, Owner>; };
+
+	LevelAllocator() noexcept = default;
+	template<typename U>
+	LevelAllocator(const LevelAllocator<U, Owner>&) noexcept {}
+
+	T* allocate(size_t n) {
+		G_LevelMemTrack(Owner, static_cast<ptrdiff_t>(n * sizeof(T)));
+		return static_cast<T*>(::operator new(n * sizeof(T)));
+	}
+
+	void deallocate(T* p, size_t n) noexcept {
+		G_LevelMemTrack(Owner, -static_cast<ptrdiff_t>(n * sizeof(T)));
+		::operator delete(p);
+	}
+
+	template<typename U>
+	bool operator==(const LevelAllocator<U, Owner>&) const noexcept { return true; }
+};
+
+template<typename T, LevelMem Owner>
+using LevelVector = std::vector<T, LevelAllocator<T, Owner>>;
+
 enum class VotingType {
 	None, Match, Admin, Map
 };
@@ -2497,8 +2648,8 @@ struct MatchOverallStats {
 
 	std::array<uint32_t, static_cast<size_t>(PlayerMedal::Total)> medalCount{};
 
-	std::vector<MatchDeathEvent> deathLog{};
-	std::vector<MatchEvent> eventLog{};
+	LevelVector<MatchDeathEvent, LevelMem::MatchLog> deathLog{};
+	LevelVector<MatchEvent, LevelMem::MatchLog> eventLog{};
 
 	uint32_t pickupCounts[static_cast<size_t>(HighValueItems::Total)]{};
 	GameTime pickupDelay[static_cast<size_t>(HighValueItems::Total)]{};
@@ -2526,51 +2677,117 @@ struct MatchOverallStats {
 };
 
 //
-// this structure is cleared as each map is entered
-// it is read/written to the level.sav file for savegames
+// per-match statistics live outside gclient_t in a column per stat, so the
+// client struct stays small and a stat's counters for every player are
+// contiguous; rows [0, MAX_CLIENTS_KEX) belong to the client slots, the next
+// MAX_CLIENTS to the ghost slots in level.ghosts
 //
 
-struct ClientMatchStats {
-	uint32_t	lifeAverage;
-	uint32_t	lifeLongest;
-
-	uint32_t	totalDmgDealt;
-	uint32_t	totalDmgReceived;
-
-	uint32_t	totalShots;
-	uint32_t	totalHits;
+constexpr size_t MATCH_STATS_GHOST_ROW = MAX_CLIENTS_KEX;
+constexpr size_t MATCH_STATS_SINK_ROW = MATCH_STATS_GHOST_ROW + MAX_CLIENTS;	// clients outside game.clients
+constexpr size_t MATCH_STATS_ROWS = MATCH_STATS_SINK_ROW + 1;
 
-	uint32_t	proBallGoals;
-	uint32_t	proBallAssists;
+constexpr size_t MATCH_STATS_MODS = static_cast<size_t>(ModID::Total);
+constexpr size_t MATCH_STATS_WEAPONS = static_cast<size_t>(Weapon::Total);
+constexpr size_t MATCH_STATS_MEDALS = static_cast<size_t>(PlayerMedal::Total);
+constexpr size_t MATCH_STATS_PICKUPS = static_cast<size_t>(HighValueItems::Total);
 
-	uint32_t	totalKills;
-	uint32_t	totalTeamKills;
-	uint32_t	totalSpawnKills;
-	uint32_t	totalDeaths;
-	uint32_t	totalSpawnDeaths;
-	uint32_t	totalSuicides;
+struct MatchStatsColumns {
+	template<typename T>
+	using Column = std::array<T, MATCH_STATS_ROWS>;
+	template<typename T, size_t N>
+	using TableColumn = std::array<std::array<T, N>, MATCH_STATS_ROWS>;
+
+	Column<uint32_t>	lifeAverage{};
+	Column<uint32_t>	lifeLongest{};
+
+	Column<uint32_t>	totalDmgDealt{};
+	Column<uint32_t>	totalDmgReceived{};
+
+	Column<uint32_t>	totalShots{};
+	Column<uint32_t>	totalHits{};
+
+	Column<uint32_t>	proBallGoals{};
+	Column<uint32_t>	proBallAssists{};
+
+	Column<uint32_t>	totalKills{};
+	Column<uint32_t>	totalTeamKills{};
+	Column<uint32_t>	totalSpawnKills{};
+	Column<uint32_t>	totalDeaths{};
+	Column<uint32_t>	totalSpawnDeaths{};
+	Column<uint32_t>	totalSuicides{};
+
+	TableColumn<uint32_t, MATCH_STATS_MODS>		modTotalKills{};
+	TableColumn<uint32_t, MATCH_STATS_MODS>		modTotalDeaths{};
+	TableColumn<uint32_t, MATCH_STATS_MODS>		modTotalDmgD{};
+	TableColumn<uint32_t, MATCH_STATS_MODS>		modTotalDmgR{};
+	TableColumn<uint32_t, MATCH_STATS_WEAPONS>	totalShotsPerWeapon{};
+	TableColumn<uint32_t, MATCH_STATS_WEAPONS>	totalHitsPerWeapon{};
+
+	TableColumn<uint32_t, MATCH_STATS_MEDALS>	medalCount{};
+
+	TableColumn<uint32_t, MATCH_STATS_PICKUPS>	pickupCounts{};
+	TableColumn<GameTime, MATCH_STATS_PICKUPS>	pickupDelay{};
+
+	Column<uint32_t>	ctfFlagPickups{};
+	Column<uint32_t>	ctfFlagDrops{};
+	Column<uint32_t>	ctfFlagReturns{};
+	Column<uint32_t>	ctfFlagAssists{};
+	Column<uint32_t>	ctfFlagCaptures{};
+	Column<uint64_t>	ctfFlagCarrierTimeTotalMsec{};
+	Column<uint32_t>	ctfFlagCarrierTimeShortestMsec{};
+	Column<uint32_t>	ctfFlagCarrierTimeLongestMsec{};
+};
 
-	std::array <uint32_t, static_cast<uint8_t>(ModID::Total)>	modTotalKills;
-	std::array <uint32_t, static_cast<uint8_t>(ModID::Total)>	modTotalDeaths;
-	std::array <uint32_t, static_cast<uint8_t>(ModID::Total)>	modTotalDmgD;
-	std::array <uint32_t, static_cast<uint8_t>(ModID::Total)>	modTotalDmgR;
-	std::array <uint32_t, static_cast<uint8_t>(Weapon::Total)>	totalShotsPerWeapon;
-	std::array <uint32_t, static_cast<uint8_t>(Weapon::Total)>	totalHitsPerWeapon;
+extern MatchStatsColumns matchStatsColumns;
 
-	//uint32_t	medalCount[static_cast<uint8_t>(PlayerMedal::Total)];
-	std::array<uint32_t, static_cast<size_t>(PlayerMedal::Total)> medalCount{};
+/*
+=============
+ClientMatchStats
 
-	std::array <uint32_t, static_cast<size_t>(HighValueItems::Total)>	pickupCounts;
-	std::array <GameTime, static_cast<size_t>(HighValueItems::Total)>	pickupDelay;
-
-	uint32_t	ctfFlagPickups = 0;
-	uint32_t	ctfFlagDrops = 0;
-	uint32_t	ctfFlagReturns = 0;
-	uint32_t	ctfFlagAssists = 0;
-	uint32_t	ctfFlagCaptures = 0;
-	uint64_t	ctfFlagCarrierTimeTotalMsec = 0;
-	uint32_t	ctfFlagCarrierTimeShortestMsec = 0;
-	uint32_t	ctfFlagCarrierTimeLongestMsec = 0;
+Handle to one row of matchStatsColumns; get one from gclient_t::MatchStats()
+or Ghosts::MatchStats(). Copying the handle does not copy the stats.
+=============
+*/
+struct ClientMatchStats {
+	size_t	row = MATCH_STATS_SINK_ROW;
+
+	uint32_t& lifeAverage() const { return matchStatsColumns.lifeAverage[row]; }
+	uint32_t& lifeLongest() const { return matchStatsColumns.lifeLongest[row]; }
+	uint32_t& totalDmgDealt() const { return matchStatsColumns.totalDmgDealt[row]; }
+	uint32_t& totalDmgReceived() const { return matchStatsColumns.totalDmgReceived[row]; }
+	uint32_t& totalShots() const { return matchStatsColumns.totalShots[row]; }
+	uint32_t& totalHits() const { return matchStatsColumns.totalHits[row]; }
+	uint32_t& proBallGoals() const { return matchStatsColumns.proBallGoals[row]; }
+	uint32_t& proBallAssists() const { return matchStatsColumns.proBallAssists[row]; }
+	uint32_t& totalKills() const { return matchStatsColumns.totalKills[row]; }
+	uint32_t& totalTeamKills() const { return matchStatsColumns.totalTeamKills[row]; }
+	uint32_t& totalSpawnKills() const { return matchStatsColumns.totalSpawnKills[row]; }
+	uint32_t& totalDeaths() const { return matchStatsColumns.totalDeaths[row]; }
+	uint32_t& totalSpawnDeaths() const { return matchStatsColumns.totalSpawnDeaths[row]; }
+	uint32_t& totalSuicides() const { return matchStatsColumns.totalSuicides[row]; }
+
+	std::span<uint32_t, MATCH_STATS_MODS> modTotalKills() const { return matchStatsColumns.modTotalKills[row]; }
+	std::span<uint32_t, MATCH_STATS_MODS> modTotalDeaths() const { return matchStatsColumns.modTotalDeaths[row]; }
+	std::span<uint32_t, MATCH_STATS_MODS> modTotalDmgD() const { return matchStatsColumns.modTotalDmgD[row]; }
+	std::span<uint32_t, MATCH_STATS_MODS> modTotalDmgR() const { return matchStatsColumns.modTotalDmgR[row]; }
+	std::span<uint32_t, MATCH_STATS_WEAPONS> totalShotsPerWeapon() const { return matchStatsColumns.totalShotsPerWeapon[row]; }
+	std::span<uint32_t, MATCH_STATS_WEAPONS> totalHitsPerWeapon() const { return matchStatsColumns.totalHitsPerWeapon[row]; }
+	std::span<uint32_t, MATCH_STATS_MEDALS> medalCount() const { return matchStatsColumns.medalCount[row]; }
+	std::span<uint32_t, MATCH_STATS_PICKUPS> pickupCounts() const { return matchStatsColumns.pickupCounts[row]; }
+	std::span<GameTime, MATCH_STATS_PICKUPS> pickupDelay() const { return matchStatsColumns.pickupDelay[row]; }
+
+	uint32_t& ctfFlagPickups() const { return matchStatsColumns.ctfFlagPickups[row]; }
+	uint32_t& ctfFlagDrops() const { return matchStatsColumns.ctfFlagDrops[row]; }
+	uint32_t& ctfFlagReturns() const { return matchStatsColumns.ctfFlagReturns[row]; }
+	uint32_t& ctfFlagAssists() const { return matchStatsColumns.ctfFlagAssists[row]; }
+	uint32_t& ctfFlagCaptures() const { return matchStatsColumns.ctfFlagCaptures[row]; }
+	uint64_t& ctfFlagCarrierTimeTotalMsec() const { return matchStatsColumns.ctfFlagCarrierTimeTotalMsec[row]; }
+	uint32_t& ctfFlagCarrierTimeShortestMsec() const { return matchStatsColumns.ctfFlagCarrierTimeShortestMsec[row]; }
+	uint32_t& ctfFlagCarrierTimeLongestMsec() const { return matchStatsColumns.ctfFlagCarrierTimeLongestMsec[row]; }
+
+	void Reset() const;
+	void CopyFrom(ClientMatchStats other) const;
 };
 
 struct Ghosts {
@@ -2578,7 +2795,6 @@ struct Ghosts {
 	char				socialID[MAX_INFO_VALUE]{};		// ent->client->sess.socialID
 	std::array<int32_t, IT_TOTAL>	  inventory{};		// ent->client->inventory
 	std::array<int16_t, static_cast<int>(AmmoID::_Total)> ammoMax = {};			// ent->client->pers.ammoMax
-	ClientMatchStats match{};						// ent->client->sess.match
 	Item* weapon = nullptr;				// ent->client->pers.weapon
 	Item* lastWeapon = nullptr;			// ent->client->pers.lastWeapon
 	Team				team = Team::None;				// ent->client->sess.team
@@ -2591,6 +2807,8 @@ struct Ghosts {
 	Vector3				angles = vec3_origin;			// ent->s.angles
 
 	int64_t				totalMatchPlayRealTime;				// accumulated play time in milliseconds
+
+	ClientMatchStats MatchStats() const;			// ent->client->MatchStats(), by ghost slot
 };
 
 struct ShadowLightInfo {
@@ -2605,9 +2823,9 @@ constexpr size_t SPAWN_SPOT_INTERMISSION = NUM_SPAWN_SPOTS - 1;
 // New spawn containers
 // ----------------------------------------------------------------------------
 struct SpawnLists {
-	std::vector<gentity_t*> ffa;    // info_player_deathmatch
-	std::vector<gentity_t*> red;    // info_player_team_red
-	std::vector<gentity_t*> blue;   // info_player_team_blue
+	LevelVector<gentity_t*, LevelMem::SpawnLists> ffa;    // info_player_deathmatch
+	LevelVector<gentity_t*, LevelMem::SpawnLists> red;    // info_player_team_red
+	LevelVector<gentity_t*, LevelMem::SpawnLists> blue;   // info_player_team_blue
 	gentity_t* intermission = nullptr; // info_player_intermission
 
 	/*
@@ -2632,6 +2850,13 @@ struct SpawnLists {
 	}
 };
 
+// copies as a fresh, unlocked mutex so LevelLocals can be copied for the world snapshot
+struct LevelMutex : std::mutex {
+	LevelMutex() = default;
+	LevelMutex(const LevelMutex&) noexcept {}
+	LevelMutex& operator=(const LevelMutex&) noexcept { return *this; }
+};
+
 struct LevelLocals {
 	bool		inFrame = false;		// true if G_RunFrame is running
 	GameTime	time = 0_ms;			// time in the level, never reset
@@ -2913,7 +3138,7 @@ std::array<gentity_t*, 4> outOfBounds{};
 	MatchOverallStats	match;
 
 	// protects death/event logs while async jobs grab snapshots
-	std::mutex		matchLogMutex;
+	LevelMutex		matchLogMutex;
 
 	// new map system stuff
 	uint16_t	vote_flags_enable = 0;
@@ -3368,6 +3593,13 @@ constexpr size_t MAX_REINFORCEMENTS = 5; // max number of spawns we can do at on
 
 constexpr GameTime HOLD_FOREVER = GameTime::from_ms(std::numeric_limits<int64_t>::max());
 
+// think rate tier; see M_ScheduleLOD
+enum class MonsterLOD : uint8_t {
+	Full,		// thinks every server frame
+	Reduced,	// thinks once per 10hz animation frame
+	Total
+};
+
 struct MonsterInfo {
 	// [Paril-KEX] allow some moves to be done instantaneously, but
 	// others can wait the full frame.
@@ -3503,6 +3735,14 @@ struct MonsterInfo {
 
 	GameTime jump_time;
 
+	// think LOD; transient, so not saved
+	MonsterLOD lod;
+	bool lodScheduled; // the pending think was pushed out by the reduced rate
+	int32_t lodSteps; // server frames the current think covers
+	GameTime lodLastThink;
+	GameTime lodCheckTime; // next re-evaluation of the tier
+	GameTime lodHoldTime; // stays at full rate until then
+
 	// NOTE: if adding new elements, make sure to add them
 	// in g_save.cpp too!
 };
@@ -3846,6 +4086,18 @@ extern cvar_t* bot_name_prefix;
 
 extern cvar_t* g_autoScreenshotTool;
 
+extern cvar_t* g_trace_memo;
+extern cvar_t* g_jobs_workers;
+extern cvar_t* g_jobs_deterministic;
+extern cvar_t* g_ai_sense_parallel;
+extern cvar_t* g_spawn_danger_cache;
+extern cvar_t* g_bot_state_dirty;
+extern cvar_t* g_monster_lod;
+extern cvar_t* g_monster_lod_distance;
+extern cvar_t* g_frame_budget;
+extern cvar_t* g_frame_budget_ms;
+extern cvar_t* g_world_snapshot;
+
 #define world (&g_entities[0])
 #define host (&g_entities[1])
 
@@ -3892,6 +4144,8 @@ void		InitItems();
 void		SetItemNames();
 Item* FindItem(const char* pickupName);
 Item* FindItemByClassname(const char* className);
+Item* FindItemByAbbreviation(std::string_view abbr);
+item_id_t	WeaponItemID(Weapon weapon);
 gentity_t* Drop_Item(gentity_t* ent, Item* item);
 void		SetRespawn(gentity_t* ent, GameTime delay, bool hide_self = true);
 void		Change_Weapon(gentity_t* ent);
@@ -3939,7 +4193,13 @@ gentity_t* G_FindByString(gentity_t* from, const std::string_view& value) {
 	static_assert(std::is_same_v<member_object_type_t<decltype(M)>, const char*>, "can only use string member functions");
 
 	return FindEntity(from, [&](gentity_t* e) {
-		return e->*M && strlen(e->*M) == value.length() && !Q_strncasecmp(e->*M, value.data(), value.length());
+		const char* s = e->*M;
+		if (!s)
+			return false;
+		// entity strings are interned, so a key looked up by another entity's field is usually the same pointer
+		if (s == value.data() && s[value.length()] == '\0')
+			return true;
+		return strlen(s) == value.length() && !Q_strncasecmp(s, value.data(), value.length());
 		});
 }
 
@@ -4015,11 +4275,19 @@ int64_t GetCurrentRealTimeMillis();
 double GetRealTimeSeconds();
 bool Vote_Menu_Active(gentity_t* ent);
 
+//
+// command_voting_tally.cpp
+//
+bool G_ClientCanVote(gclient_t* cl);
+bool G_CastVote(gclient_t* cl, bool yes);
+void G_WithdrawVote(gclient_t* cl);
+void G_RevertVote(gclient_t* client);
+
 //
 // g_spawn.cpp
 //
 void  ED_CallSpawn(gentity_t* ent);
-char* ED_NewString(const char* string);
+const char* ED_NewString(const char* string);
 void GT_PrecacheAssets();
 void SpawnEntities(const char* mapname, const char* entities, const char* spawnPoint);
 bool G_ResetWorldEntitiesFromSavedString();
@@ -4046,6 +4314,11 @@ constexpr SpawnFlags SPAWNFLAG_LASER_FAT = 0x0040_spawnflag;
 constexpr SpawnFlags SPAWNFLAG_LASER_ZAP = 0x80000000_spawnflag;
 constexpr SpawnFlags SPAWNFLAG_LASER_LIGHTNING = 0x10000_spawnflag;
 
+//
+// g_target_poi.cpp
+//
+void G_PoiPathsClear();
+
 constexpr SpawnFlags SPAWNFLAG_HEALTHBAR_PVS_ONLY = 1_spawnflag;
 
 // damage flags
@@ -4146,6 +4419,8 @@ bool CanDamage(gentity_t* targ, gentity_t* inflictor);
 bool CheckTeamDamage(gentity_t* targ, gentity_t* attacker);
 void Damage(gentity_t* targ, gentity_t* inflictor, gentity_t* attacker, const Vector3& dir, const Vector3& point,
 	const Vector3& normal, int damage, int knockback, DamageFlags damageFlags, MeansOfDeath mod);
+int DamageHits(gentity_t* targ, gentity_t* inflictor, gentity_t* attacker, const Vector3& dir, const Vector3& point,
+	const Vector3& normal, int damage, int knockback, int hits, DamageFlags damageFlags, MeansOfDeath mod);
 bool RadiusDamage(gentity_t* inflictor, gentity_t* attacker, float damage, gentity_t* ignore, float radius, DamageFlags damageFlags, MeansOfDeath mod);
 void Killed(gentity_t* targ, gentity_t* inflictor, gentity_t* attacker, int damage, const Vector3& point, MeansOfDeath mod);
 
@@ -4176,6 +4451,7 @@ constexpr SpawnFlags SPAWNFLAG_DOOR_REVERSE = 2_spawnflag;
 // g_horde.cpp
 //
 void Horde_RunSpawning();
+size_t Horde_PopulateMonsters(size_t count);
 
 //
 // g_monster.cpp
@@ -4227,6 +4503,9 @@ bool M_ShouldReactToPain(gentity_t* self, const MeansOfDeath& mod);
 void M_SetAnimation(gentity_t* self, const save_mmove_t& move, bool instant = true);
 bool M_AllowSpawn(gentity_t* self);
 void M_CleanupHealTarget(gentity_t* ent);
+void M_PromoteLOD(gentity_t* self);
+void M_PromoteLODNear(const Vector3& origin);
+void M_LODPrint();
 
 // Paril: used in N64. causes them to be mad at the player
 // regardless of circumstance.
@@ -4322,6 +4601,9 @@ void FoundTarget(gentity_t* self);
 void HuntTarget(gentity_t* self, bool animate_state = true);
 bool infront(gentity_t* self, gentity_t* other);
 bool visible(gentity_t* self, gentity_t* other, bool through_glass = true);
+void AI_SensePhase();
+void AI_SenseMoverMoved(const gentity_t* mover, const Vector3& oldAbsMin, const Vector3& oldAbsMax);
+void AI_SenseBenchmark(size_t frames);
 bool FacingIdeal(gentity_t* self);
 // [Paril-KEX] generic function
 bool M_CheckAttack_Base(gentity_t* self, float stand_ground_chance, float melee_chance, float near_chance, float mid_chance, float far_chance, float strafe_scalar);
@@ -4398,7 +4680,7 @@ void pierce_trace(const Vector3& start, const Vector3& end, gentity_t* ignore, p
 //
 void PlayerTrail_Add(gentity_t* player);
 void PlayerTrail_Destroy(gentity_t* player);
-gentity_t* PlayerTrail_Pick(gentity_t* self, bool next);
+bool PlayerTrail_Pick(gentity_t* self, bool next, Vector3& origin, GameTime& timeStamp);
 
 //
 // g_client.cpp
@@ -4409,7 +4691,7 @@ constexpr SpawnFlags SPAWNFLAG_CHANGELEVEL_FADE_OUT = 32_spawnflag;
 constexpr SpawnFlags SPAWNFLAG_CHANGELEVEL_IMMEDIATE_LEAVE = 64_spawnflag;
 
 void ClientRespawn(gentity_t* ent);
-inline bool FreezeTag_IsActive();
+bool FreezeTag_IsActive();
 bool FreezeTag_IsFrozen(const gentity_t* ent);
 void FreezeTag_ForceRespawn(gentity_t* ent);
 void BeginIntermission(gentity_t* targ);
@@ -4426,6 +4708,7 @@ unsigned int P_GetLobbyUserNum(const gentity_t* player);
 std::string G_EncodedPlayerName(gentity_t* player);
 void TossClientItems(gentity_t* self);
 bool G_LimitedLivesRespawn(gentity_t* ent);
+std::tuple<gentity_t*, Vector3> G_FindSquadRespawnTarget();
 void EndOfUnitMessage();
 bool SelectSpawnPoint(gentity_t* ent, Vector3& origin, Vector3& angles, bool force_spawn, bool& landmark);
 void PCfg_WriteConfig(gentity_t* ent);
@@ -4447,6 +4730,8 @@ struct select_spawn_result_t {
 };
 
 select_spawn_result_t SelectDeathmatchSpawnPoint(gentity_t* ent, Vector3 avoid_point, bool force_spawn, bool fallback_to_ctf_or_start, bool intermission, bool initial);
+void G_SpawnDangerInvalidate();
+void G_SpawnDangerBenchmark(size_t rounds);
 void G_PostRespawn(gentity_t* self);
 
 //
@@ -4509,6 +4794,8 @@ void G_SaveIPFilters();
 // p_view.cpp
 //
 void ClientEndServerFrame(gentity_t* ent);
+class JobSystem;
+void P_EndServerFrames(JobSystem& jobs);
 void LagCompensate(gentity_t* from_player, const Vector3& start, const Vector3& dir);
 void UnLagCompensate();
 
@@ -4602,7 +4889,6 @@ void		G_Impact(gentity_t* e1, const trace_t& trace);
 void SaveClientData();
 void FetchClientEntData(gentity_t* ent);
 void FindIntermissionPoint(void);
-void G_RevertVote(gclient_t* client);
 void Vote_Passed();
 void ExitLevel(bool forceImmediate = false);
 void Teams_CalcRankings(std::array<uint32_t, MAX_CLIENTS>& playerRanks); // [Paril-KEX]
@@ -4659,6 +4945,7 @@ void Match_UpdateDuelRecords();
 void FreeFollower(gentity_t* ent);
 void FreeClientFollowers(gentity_t* ent);
 void ClientUpdateFollowers(gentity_t* ent);
+void ClientUpdateFollowersOf(gentity_t* targ);
 void FollowNext(gentity_t* ent);
 void FollowPrev(gentity_t* ent);
 void GetFollowTarget(gentity_t* ent);
@@ -4907,8 +5194,6 @@ struct client_persistant_t {
 	int				voted = false;
 	bool			readyStatus = false;
 
-	ClientMatchStats match{};
-
 	struct {
 		int			count[MAX_AWARD_QUEUE]{};       // how many times this award was earned (e.g., 1 or 2)
 		int			soundIndex[MAX_AWARD_QUEUE]{};  // announcer sound index
@@ -5033,6 +5318,9 @@ constexpr GameTime COOP_DAMAGE_RESPAWN_TIME = 2000_ms;
 // time after firing that we can't respawn on a player for
 constexpr GameTime COOP_DAMAGE_FIRING_TIME = 2500_ms;
 
+// number of breadcrumbs kept per player for monster pursuit
+constexpr size_t PLAYER_TRAIL_LENGTH = 8;
+
 // this structure is cleared on each ClientSpawn(),
 // except for 'client->pers'
 struct gclient_t {
@@ -5149,6 +5437,8 @@ struct gclient_t {
 		powerupCounts.fill(0);
 	}
 
+	ClientMatchStats MatchStats() const;
+
 	GameTime			pu_regen_time_blip = 0_ms;
 	GameTime			pu_time_spawn_protection_blip = 0_ms;
 
@@ -5218,8 +5508,16 @@ struct gclient_t {
 
 	GameTime		vampiricExpireTime = 0_ms;
 
-	// used for player trails.
-	gentity_t* trail_head = nullptr, * trail_tail = nullptr;
+	// used for player trails; a ring of recent positions, the newest
+	// one just before `head`.
+	struct {
+		std::array<Vector3, PLAYER_TRAIL_LENGTH>	origins{};
+		std::array<GameTime, PLAYER_TRAIL_LENGTH>	times{};
+		uint8_t		head = 0;
+		uint8_t		count = 0;
+		Vector3		checkOrigin{};			// player origin at the last visibility check
+		GameTime	nextCheckTime = 0_ms;
+	} trail;
 	// whether to use weapon chains
 	bool			noWeaponChains = false;
 
@@ -5322,6 +5620,24 @@ struct gclient_t {
 	int32_t			killStreakCount = 0;	// for rampage award, reset on death or team change
 };
 
+inline ClientMatchStats gclient_t::MatchStats() const {
+	const ptrdiff_t slot = game.clients ? this - game.clients : -1;
+
+	if (slot < 0 || slot >= static_cast<ptrdiff_t>(MAX_CLIENTS_KEX))
+		return {};
+
+	return { static_cast<size_t>(slot) };
+}
+
+inline ClientMatchStats Ghosts::MatchStats() const {
+	const ptrdiff_t slot = this - level.ghosts.data();
+
+	if (slot < 0 || slot >= static_cast<ptrdiff_t>(MAX_CLIENTS))
+		return {};
+
+	return { MATCH_STATS_GHOST_ROW + static_cast<size_t>(slot) };
+}
+
 /*
 =============
 ClientIsEliminatedFromLimitedLives
@@ -5411,8 +5727,19 @@ gentity_t(gentity_t&&) = default;
 	// private to game
 	int32_t spawn_count{}; // [Paril-KEX] used to differentiate different entities that may be in the same slot
 	MoveType	moveType;
+	EntityRegistry	registry{};		// registry membership; not saved, rebuilt on load
+	bool		registryAlive{};
+	uint32_t	registrySlot{};
+	uint64_t	botStateSignature{};	// bot-relevant inputs at the last publish; not saved
+	bool		eventQueued{};			// on the frame event list; see G_SetEvent
 	ent_flags_t flags{};
 
+	// read by the frame loop for every entity; kept next to the server prefix
+	GameTime	nextThink{};
+	save_think_t think{};
+	gentity_t*	groundEntity = nullptr;
+	int32_t		groundEntity_linkCount;
+
 	const char* model = nullptr;
 	GameTime		freeTime; // sv.time when the object was freed
 
@@ -5421,6 +5748,10 @@ gentity_t(gentity_t&&) = default;
 	//
 	const char* message = nullptr;
 	const char* className = nullptr;
+	// className as last resolved to a tag by G_EntityClassOf; not saved
+	mutable const char*			classTagName = nullptr;
+	mutable EntityClass			classTag{};
+	mutable EntityClassGroup	classGroups{};
 	SpawnFlags	spawnFlags;
 	bool		turretFireRequested{};
 
@@ -5457,10 +5788,8 @@ gentity_t(gentity_t&&) = default;
 	float	 yawSpeed{};
 	float	 ideal_yaw{};
 
-	GameTime nextThink{};
 	save_prethink_t preThink{};
 	save_prethink_t postThink{};
-	save_think_t think{};
 	save_touch_t touch{};
 	save_use_t use{};
 	save_pain_t pain{};
@@ -5494,8 +5823,6 @@ gentity_t(gentity_t&&) = default;
 	gentity_t* enemy = nullptr;
 	gentity_t* oldEnemy = nullptr;
 	gentity_t* activator = nullptr;
-	gentity_t* groundEntity = nullptr;
-	int32_t	 groundEntity_linkCount;
 	gentity_t* teamChain = nullptr;
 	gentity_t* teamMaster = nullptr;
 
@@ -5665,10 +5992,16 @@ struct dm_game_rt {
 	int (*CheckDMExitRules)();
 };
 
+// server frames the current monster think covers; 1 unless a reduced-rate
+// think is merging several (see M_ScheduleLOD)
+inline int32_t M_ThinkSteps(const gentity_t* self) {
+	return self->monsterInfo.lodSteps > 1 ? self->monsterInfo.lodSteps : 1;
+}
+
 // [Paril-KEX]
 inline void monster_footstep(gentity_t* self) {
 	if (self->groundEntity)
-		self->s.event = EV_OTHER_FOOTSTEP;
+		G_SetEvent(self, EV_OTHER_FOOTSTEP);
 }
 
 // [Kex] helpers
@@ -5922,6 +6255,45 @@ enum pois_t : uint16_t {
 	POI_PING_END = POI_PING + MAX_CLIENTS - 1,
 };
 
+void G_EntityClassResolve(const gentity_t* ent);
+
+/*
+=============
+G_EntityClassOf
+
+The entity's class tag. Map entities are tagged by ED_CallSpawn and others
+the first time they are asked about; after that this is a pointer compare
+until className is pointed somewhere else.
+=============
+*/
+inline EntityClass G_EntityClassOf(const gentity_t* ent) {
+	if (ent->classTagName != ent->className) [[unlikely]]
+		G_EntityClassResolve(ent);
+	return ent->classTag;
+}
+
+/*
+=============
+G_IsClass
+=============
+*/
+inline bool G_IsClass(const gentity_t* ent, EntityClass cls) {
+	return ent && G_EntityClassOf(ent) == cls;
+}
+
+/*
+=============
+G_InClassGroup
+=============
+*/
+inline bool G_InClassGroup(const gentity_t* ent, EntityClassGroup group) {
+	if (!ent)
+		return false;
+
+	G_EntityClassOf(ent);
+	return (ent->classGroups & group) != EntityClassGroup::None;
+}
+
 // implementation of pierce stuff
 inline bool pierce_args_t::mark(gentity_t* ent) {
 	// ran out of pierces
@@ -6293,3 +6665,148 @@ Optional: emit temp entities to visualize a cell (for tuning).
 void HM_Debug_Draw();
 
 float HM_DangerAt(const Vector3& pos);
+
+// ===========================================================
+
+/*
+===============
+G_TraceBeginFrame
+Rolls the per-site trace counters over and drops memoized traces.
+Called once per server frame from G_PrepFrame.
+===============
+*/
+void G_TraceBeginFrame();
+
+/*
+===============
+G_TraceStatsReset
+===============
+*/
+void G_TraceStatsReset();
+
+/*
+===============
+G_TraceStatsPrint
+Prints the busiest trace call sites (sv tracestats).
+===============
+*/
+void G_TraceStatsPrint(size_t maxSites);
+
+// ===========================================================
+
+//
+// g_registry.cpp
+//
+void G_RegistryRemove(gentity_t* ent);
+void G_RegistryClear();
+void G_RegistryRebuild();
+std::span<gentity_t* const> G_RegistryMembers(EntityRegistry kind);
+void G_RegistrySnapshot(EntityRegistry kind, std::vector<gentity_t*>& out);
+size_t G_RegistryCount(EntityRegistry kind);
+size_t G_RegistryAliveCount(EntityRegistry kind);
+bool G_RegistryVerify(bool print);
+void G_RegistryPrint();
+
+// ===========================================================
+
+//
+// g_events.cpp
+//
+void G_AddHitMarker(gentity_t* attacker, int32_t amount);
+void G_ClearEvents();
+void G_EventListClear();
+void G_EventListRebuild();
+size_t G_EventListCount();
+bool G_EventListVerify();
+void G_EventBenchmark(size_t frames);
+
+// ===========================================================
+
+//
+// g_frame_budget.cpp
+//
+// subsystems the frame budget watchdog may hold back; keep frameWorkInfo in sync
+enum class FrameWork : uint8_t {
+	BotDebug,
+	Heatmap,
+	AutoScreenshots,
+	CrosshairID,
+	MenuRefresh,
+	ScoreboardRefresh,
+	MatchReport,
+	Total
+};
+
+void G_FrameBudgetBeginFrame();
+void G_FrameBudgetEndFrame();
+bool G_FrameBudgetAllow(FrameWork work, GameTime overdue = 0_ms);
+bool G_FrameBudgetDegraded();
+void G_FrameBudgetPrint(bool reset);
+
+// ===========================================================
+
+//
+// match_stats.cpp
+//
+void G_MatchStatsClear();
+
+// ===========================================================
+
+//
+// g_entity_hot.cpp
+//
+void G_EntityHotClear();
+void G_EntityHotSync(const gentity_t* ent);
+void G_EntityHotRebuild();
+bool G_EntityHotVerify(bool print);
+size_t G_EntityHotNextInUse(size_t from);
+size_t G_EntityHotFindFree(size_t from);
+void G_EntityHotBenchmark(size_t frames);
+
+// ===========================================================
+
+//
+// g_string_arena.cpp
+//
+const char* G_InternString(std::string_view text);
+void G_StringArenaReset();
+void G_StringArenaPrint();
+
+// ===========================================================
+
+//
+// g_level_arena.cpp
+//
+void G_LevelArenaReset();
+void G_LevelArenaMapLoaded(const char* mapName, double spawnMs);
+void G_LevelArenaPrint();
+
+// ===========================================================
+
+//
+// g_save.cpp
+//
+void G_EntityShiftTimes(gentity_t* ent, GameTime delta);
+void G_LevelShiftTimes(LevelLocals* locals, GameTime delta);
+
+// ===========================================================
+
+//
+// g_world_snapshot.cpp
+//
+void G_WorldSnapshotCapture();
+void G_WorldSnapshotClear();
+bool G_WorldSnapshotValid();
+const LevelLocals* G_WorldSnapshotLevel();
+void G_WorldReleaseEntityState();
+void G_WorldSnapshotRestore();
+void G_WorldSnapshotPrint();
+
+// ===========================================================
+
+//
+// g_entity_class.cpp
+//
+EntityClass G_EntityClassFromName(const char* className, EntityClassGroup* groups = nullptr);
+const char* G_EntityClassName(EntityClass cls);
+bool G_EntityClassVerify(bool print);
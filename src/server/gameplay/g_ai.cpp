@@ -13,6 +13,11 @@ ranged attack, or continue moving. - Sensory Functions: Provides utility functio
 visibility (`visible`), field of view (`infront`), and distance checking (`range_to`).*/
 
 #include "../g_local.hpp"
+#include "g_jobs.hpp"
+
+#include <bitset>
+#include <chrono>
+#include <vector>
 
 bool FindTarget(gentity_t* self);
 bool ai_checkattack(gentity_t* self, float dist);
@@ -94,7 +99,7 @@ void ai_stand(gentity_t* self, float dist) {
 	if (self->monsterInfo.aiFlags & AI_STAND_GROUND) {
 		// [Paril-KEX] check if we've been pushed out of our point_combat
 		if (!(self->monsterInfo.aiFlags & AI_TEMP_STAND_GROUND) &&
-			self->moveTarget && self->moveTarget->className && !strcmp(self->moveTarget->className, "point_combat")) {
+			G_IsClass(self->moveTarget, EntityClass::PointCombat)) {
 			if (!boxes_intersect(self->absMin, self->absMax, self->moveTarget->absMin, self->moveTarget->absMax)) {
 				self->monsterInfo.aiFlags &= ~AI_STAND_GROUND;
 				self->monsterInfo.aiFlags |= AI_COMBAT_POINT;
@@ -104,7 +109,7 @@ void ai_stand(gentity_t* self, float dist) {
 			}
 		}
 
-		if (self->enemy && !(self->enemy->className && !strcmp(self->enemy->className, "player_noise"))) {
+		if (self->enemy && !G_IsClass(self->enemy, EntityClass::PlayerNoise)) {
 			v = self->enemy->s.origin - self->s.origin;
 			self->ideal_yaw = vectoyaw(v);
 			if (!FacingIdeal(self) && (self->monsterInfo.aiFlags & AI_TEMP_STAND_GROUND)) {
@@ -255,7 +260,7 @@ void ai_charge(gentity_t* self, float dist) {
 		// circle strafe support
 		if (self->monsterInfo.attackState == MonsterAttackState::Sliding) {
 			// if we're fighting a tesla, NEVER circle strafe
-			if ((self->enemy) && (self->enemy->className) && (!strcmp(self->enemy->className, "tesla_mine")))
+			if (G_IsClass(self->enemy, EntityClass::TeslaMine))
 				ofs = 0;
 			else if (self->monsterInfo.lefty)
 				ofs = 90;
@@ -341,6 +346,307 @@ float range_to(gentity_t* self, gentity_t* other) {
 	return distance_between_boxes(self->absMin, self->absMax, other->absMin, other->absMax);
 }
 
+//============================================================================
+
+/*
+=============
+Sense phase
+
+Line of sight is the expensive, read-only part of monster thinking. Once
+the clients have run each frame, AI_SensePhase traces it for every monster
+that is about to think and stores the results in a perception record;
+the serial act phase (the monsters' own thinks, in entity order) then
+answers visible() from the record as long as neither end has moved since
+and no door, plat or train has moved across the line in between.
+Each record depends only on its own monster, so the pass can be spread
+across job workers (g_ai_sense_parallel) without changing the outcome.
+=============
+*/
+namespace {
+
+struct monster_perception_t {
+	uint64_t					serial = 0;			// senseSerial this record was filled in
+	Vector3						eye{};				// monster eye position when sensed
+	gentity_t*					enemy = nullptr;	// non-client enemy, if any
+	Vector3						enemyEye{};
+	bool						enemyVisible = false;
+	std::bitset<MAX_CLIENTS>	sensedPlayers{};
+	std::bitset<MAX_CLIENTS>	visiblePlayers{};
+};
+
+std::vector<monster_perception_t> perceptions;		// indexed by entity number
+std::vector<gentity_t*> senseMonsters;
+std::array<Vector3, MAX_CLIENTS> senseEyes{};		// player eye positions when sensed
+uint64_t senseSerial = 0;
+GameTime senseTime = -1_ms;
+
+struct sense_box_t {
+	Vector3	mins;
+	Vector3	maxs;
+};
+
+std::vector<sense_box_t> senseMovers;				// space swept by BSP movers since the sense phase
+
+/*
+=============
+AI_EyePosition
+=============
+*/
+inline Vector3 AI_EyePosition(const gentity_t* ent) {
+	Vector3 eye = ent->s.origin;
+	eye[2] += ent->viewHeight;
+	return eye;
+}
+
+/*
+=============
+AI_LineOfSight
+
+The trace behind visible(), minus its invisibility handling.
+=============
+*/
+inline bool AI_LineOfSight(gentity_t* self, const Vector3& spot1, gentity_t* other, const Vector3& spot2, contents_t mask) {
+	const trace_t trace = gi.traceLine(spot1, spot2, self, mask);
+	return trace.fraction == 1.0f || trace.ent == other; // PGM
+}
+
+/*
+=============
+AI_SenseMonster
+
+Fills one monster's perception record. Must stay free of side effects
+and RNG use so it can run on any thread.
+=============
+*/
+void AI_SenseMonster(gentity_t* self) {
+	monster_perception_t& perception = perceptions[self->s.number];
+
+	perception.serial = senseSerial;
+	perception.eye = AI_EyePosition(self);
+	perception.enemy = nullptr;
+	perception.enemyVisible = false;
+	perception.sensedPlayers.reset();
+	perception.visiblePlayers.reset();
+
+	auto sensePlayer = [self, &perception](gentity_t* player) {
+		const size_t index = player->s.number - 1;
+
+		if (perception.sensedPlayers.test(index))
+			return;
+
+		perception.sensedPlayers.set(index);
+		perception.visiblePlayers.set(index, AI_LineOfSight(self, perception.eye, player, senseEyes[index], MASK_OPAQUE));
+	};
+
+	// the sight client candidates (AI_GetSightClient); FindTarget only
+	// looks for them without an enemy, or in coop
+	if ((!self->enemy || CooperativeModeOn()) && !level.intermission.time) {
+		for (auto player : active_clients()) {
+			if (player->health <= 0 || player->deadFlag || !player->solid)
+				continue;
+			if (player->flags & (FL_NOTARGET | FL_DISGUISED | FL_NOVISIBLE))
+				continue;
+			if (boxes_intersect(self->absMin, self->absMax, player->absMin, player->absMax))
+				continue;
+			if (!(self->monsterInfo.aiFlags & AI_THIRD_EYE) && !infront(self, player))
+				continue;
+
+			sensePlayer(player);
+		}
+	}
+
+	gentity_t* enemy = self->enemy;
+
+	if (!enemy || !enemy->inUse || (enemy->flags & FL_NOVISIBLE))
+		return;
+
+	if (enemy->client) {
+		if (enemy->s.number >= 1 && enemy->s.number <= static_cast<int32_t>(game.maxClients) && enemy->client->pers.connected)
+			sensePlayer(enemy);
+		return;
+	}
+
+	perception.enemy = enemy;
+	perception.enemyEye = AI_EyePosition(enemy);
+	perception.enemyVisible = AI_LineOfSight(self, perception.eye, enemy, perception.enemyEye, MASK_OPAQUE);
+}
+
+/*
+=============
+AI_SenseMonsterRange
+=============
+*/
+void AI_SenseMonsterRange(size_t begin, size_t end, size_t) {
+	for (size_t i = begin; i < end; i++)
+		AI_SenseMonster(senseMonsters[i]);
+}
+
+/*
+=============
+AI_SegmentCrossesBox
+=============
+*/
+inline bool AI_SegmentCrossesBox(const Vector3& start, const Vector3& end, const sense_box_t& box) {
+	float enter = 0.0f;
+	float leave = 1.0f;
+
+	for (int i = 0; i < 3; i++) {
+		const float delta = end[i] - start[i];
+
+		if (delta == 0.0f) {
+			if (start[i] < box.mins[i] || start[i] > box.maxs[i])
+				return false;
+			continue;
+		}
+
+		float t1 = (box.mins[i] - start[i]) / delta;
+		float t2 = (box.maxs[i] - start[i]) / delta;
+		if (t1 > t2)
+			std::swap(t1, t2);
+
+		enter = std::max(enter, t1);
+		leave = std::min(leave, t2);
+		if (enter > leave)
+			return false;
+	}
+
+	return true;
+}
+
+/*
+=============
+AI_SensedLineOfSight
+
+Looks up a line of sight from this frame's perception record. Only
+valid for the through-glass mask, when both eye positions are unchanged
+since the sense phase, and when no mover has since passed through the
+line between them.
+=============
+*/
+bool AI_SensedLineOfSight(const gentity_t* self, const gentity_t* other, const Vector3& spot1, const Vector3& spot2, bool& result) {
+	if (senseTime != level.time || static_cast<size_t>(self->s.number) >= perceptions.size())
+		return false;
+
+	const monster_perception_t& perception = perceptions[self->s.number];
+
+	if (perception.serial != senseSerial || perception.eye != spot1)
+		return false;
+
+	for (const sense_box_t& box : senseMovers)
+		if (AI_SegmentCrossesBox(spot1, spot2, box))
+			return false;
+
+	if (other->client) {
+		const size_t index = other->s.number - 1;
+
+		if (index >= MAX_CLIENTS || !perception.sensedPlayers.test(index) || senseEyes[index] != spot2)
+			return false;
+
+		result = perception.visiblePlayers.test(index);
+		return true;
+	}
+
+	if (other != perception.enemy || perception.enemyEye != spot2)
+		return false;
+
+	result = perception.enemyVisible;
+	return true;
+}
+
+} // namespace
+
+/*
+=============
+AI_SensePhase
+
+Called once per frame after the clients have run and before the first
+non-client entity thinks.
+=============
+*/
+void AI_SensePhase() {
+	senseSerial++;
+	senseTime = level.time;
+	senseMonsters.clear();
+	senseMovers.clear();
+
+	if (perceptions.size() < globals.numEntities)
+		perceptions.resize(globals.numEntities);
+
+	for (auto player : active_clients())
+		senseEyes[player->s.number - 1] = AI_EyePosition(player);
+
+	for (gentity_t* ent : G_RegistryMembers(EntityRegistry::Monster)) {
+		if (!ent->inUse || !(ent->svFlags & SVF_MONSTER) || ent->deadFlag || ent->health <= 0)
+			continue;
+
+		// only monsters whose think runs this frame
+		if (ent->nextThink <= 0_ms || ent->nextThink > level.time)
+			continue;
+
+		senseMonsters.push_back(ent);
+	}
+
+	if (g_ai_sense_parallel->integer)
+		G_Jobs().ParallelFor(senseMonsters.size(), 8, AI_SenseMonsterRange);
+	else
+		AI_SenseMonsterRange(0, senseMonsters.size(), 0);
+}
+
+/*
+=============
+AI_SenseMoverMoved
+
+A BSP mover was pushed after this frame's sense phase; records whose
+line of sight crosses where it was or where it is now are traced again.
+=============
+*/
+void AI_SenseMoverMoved(const gentity_t* mover, const Vector3& oldAbsMin, const Vector3& oldAbsMax) {
+	if (senseTime != level.time || mover->solid != SOLID_BSP)
+		return;
+
+	senseMovers.push_back({
+		{ std::min(oldAbsMin[0], mover->absMin[0]), std::min(oldAbsMin[1], mover->absMin[1]), std::min(oldAbsMin[2], mover->absMin[2]) },
+		{ std::max(oldAbsMax[0], mover->absMax[0]), std::max(oldAbsMax[1], mover->absMax[1]), std::max(oldAbsMax[2], mover->absMax[2]) }
+	});
+}
+
+/*
+=============
+AI_SenseBenchmark
+
+Times the sense phase over the current monsters with 1, 2, 4 and 8
+threads (the main thread plus pool workers). The act phase is serial and
+does not depend on the thread count, so this is the part of the frame
+that scales.
+=============
+*/
+void AI_SenseBenchmark(size_t frames) {
+	JobSystem& jobs = G_Jobs();
+	const bool deterministic = jobs.Deterministic();
+	const size_t workers = jobs.WorkerCount();
+
+	AI_SensePhase();
+	gi.Com_PrintFmt("AI sense benchmark: {} thinking monsters, {} frames\n", senseMonsters.size(), frames);
+
+	jobs.SetDeterministic(false);
+
+	for (size_t threads : { 1u, 2u, 4u, 8u }) {
+		jobs.Start(threads - 1);
+
+		const auto start = std::chrono::steady_clock::now();
+		for (size_t frame = 0; frame < frames; frame++) {
+			senseSerial++;
+			jobs.ParallelFor(senseMonsters.size(), 8, AI_SenseMonsterRange);
+		}
+		const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+		gi.Com_PrintFmt("  {} thread{}: {:.3f} ms/frame\n", threads, threads == 1 ? "" : "s", elapsed.count() / std::max<size_t>(frames, 1));
+	}
+
+	jobs.Start(workers);
+	jobs.SetDeterministic(deterministic);
+}
+
 /*
 =============
 visible
@@ -389,6 +695,10 @@ bool visible(gentity_t* self, gentity_t* other, bool through_glass) {
 	if (!through_glass)
 		mask |= CONTENTS_WINDOW;
 
+	bool sensed;
+	if (through_glass && AI_SensedLineOfSight(self, other, spot1, spot2, sensed))
+		return sensed;
+
 	trace = gi.traceLine(spot1, spot2, self, mask);
 	return trace.fraction == 1.0f || trace.ent == other; // PGM
 }
@@ -435,6 +745,8 @@ void HuntTarget(gentity_t* self, bool animate_state) {
 }
 
 void FoundTarget(gentity_t* self) {
+	M_PromoteLOD(self);
+
 	// let other monsters see this monster for a while
 	if (self->enemy->client) {
 		if (self->enemy->flags & FL_DISGUISED)
@@ -601,7 +913,7 @@ bool FindTarget(gentity_t* self) {
 
 	if (self->monsterInfo.aiFlags & AI_GOOD_GUY) {
 		if (self->goalEntity && self->goalEntity->inUse && self->goalEntity->className) {
-			if (strcmp(self->goalEntity->className, "target_actor") == 0)
+			if (G_IsClass(self->goalEntity, EntityClass::TargetActor))
 				return false;
 		}
 
@@ -724,7 +1036,7 @@ bool FindTarget(gentity_t* self) {
 
 		self->enemy = client;
 
-		if (strcmp(self->enemy->className, "player_noise") != 0) {
+		if (!G_IsClass(self->enemy, EntityClass::PlayerNoise)) {
 			self->monsterInfo.aiFlags &= ~AI_SOUND_TARGET;
 
 			if (!self->enemy->client) {
@@ -936,13 +1248,13 @@ bool M_CheckAttack_Base(gentity_t* self, float stand_ground_chance, float melee_
 			// originally, just 0.3
 			float strafe_chance;
 
-			if (!(strcmp(self->className, "monster_daedalus")))
+			if (G_IsClass(self, EntityClass::MonsterDaedalus))
 				strafe_chance = 0.8f;
 			else
 				strafe_chance = 0.6f;
 
 			// if enemy is tesla, never strafe
-			if ((self->enemy) && (self->enemy->className) && (!strcmp(self->enemy->className, "tesla_mine")))
+			if (G_IsClass(self->enemy, EntityClass::TeslaMine))
 				strafe_chance = 0;
 			else
 				strafe_chance *= strafe_scalar;
@@ -1240,7 +1552,9 @@ void ai_run(gentity_t* self, float dist) {
 	gentity_t* tempgoal;
 	gentity_t* save;
 	bool     newEnemy;
-	gentity_t* marker;
+	bool     marker;
+	Vector3   markerOrigin;
+	GameTime markerTime;
 	float    d1, d2;
 	trace_t  tr;
 	Vector3   vForward, v_right;
@@ -1291,7 +1605,7 @@ void ai_run(gentity_t* self, float dist) {
 		// first off, make sure we're looking for the player, not a noise he made
 		if (self->enemy) {
 			if (self->enemy->inUse) {
-				if (strcmp(self->enemy->className, "player_noise") != 0)
+				if (!G_IsClass(self->enemy, EntityClass::PlayerNoise))
 					realEnemy = self->enemy;
 				else if (self->enemy->owner)
 					realEnemy = self->enemy->owner;
@@ -1488,22 +1802,23 @@ void ai_run(gentity_t* self, float dist) {
 
 		if (self->monsterInfo.aiFlags & AI_PURSUE_TEMP) {
 			self->monsterInfo.aiFlags &= ~AI_PURSUE_TEMP;
-			marker = nullptr;
+			marker = false;
 			self->monsterInfo.lastSighting = self->monsterInfo.savedGoal;
 			newEnemy = true;
 		}
 		else if (self->monsterInfo.aiFlags & AI_PURSUIT_LAST_SEEN) {
 			self->monsterInfo.aiFlags &= ~AI_PURSUIT_LAST_SEEN;
-			marker = PlayerTrail_Pick(self, false);
+			marker = PlayerTrail_Pick(self, false, markerOrigin, markerTime);
 		}
 		else {
-			marker = PlayerTrail_Pick(self, true);
+			marker = PlayerTrail_Pick(self, true, markerOrigin, markerTime);
 		}
 
 		if (marker) {
-			self->monsterInfo.lastSighting = marker->s.origin;
-			self->monsterInfo.trailTime = marker->timeStamp;
-			self->s.angles[YAW] = self->ideal_yaw = marker->s.angles[YAW];
+			self->monsterInfo.lastSighting = markerOrigin;
+			self->monsterInfo.trailTime = markerTime;
+			// trail points carry no facing; the old marker entities never set one either
+			self->s.angles[YAW] = self->ideal_yaw = 0;
 
 			newEnemy = true;
 		}
@@ -48,7 +48,7 @@ bool blocked_checkplat(gentity_t* self, float dist) {
 
 	// see if we're already standing on a plat.
 	if (self->groundEntity && self->groundEntity != world) {
-		if (!strncmp(self->groundEntity->className, "func_plat", 8))
+		if (G_InClassGroup(self->groundEntity, EntityClassGroup::FuncPlat))
 			plat = self->groundEntity;
 	}
 
@@ -61,7 +61,7 @@ bool blocked_checkplat(gentity_t* self, float dist) {
 
 		trace = gi.traceLine(pt1, pt2, self, MASK_MONSTERSOLID);
 		if (trace.fraction < 1 && !trace.allSolid && !trace.startSolid) {
-			if (!strncmp(trace.ent->className, "func_plat", 8)) {
+			if (G_InClassGroup(trace.ent, EntityClassGroup::FuncPlat)) {
 				plat = trace.ent;
 			}
 		}
@@ -406,7 +406,7 @@ bool monsterlost_checkhint(gentity_t* self) {
 	if (self->monsterInfo.aiFlags & (AI_STAND_GROUND | AI_PATHING))
 		return false;
 
-	if (!Q_strcasecmp(self->className, "monster_turret"))
+	if (G_IsClass(self, EntityClass::MonsterTurret))
 		return false;
 
 	monster_pathchain = nullptr;
@@ -943,7 +943,7 @@ bool MarkTeslaArea(gentity_t* self, gentity_t* tesla) {
 	tail = tesla;
 	while (e) {
 		tail = tail->teamChain;
-		if (!strcmp(e->className, "bad_area"))
+		if (G_IsClass(e, EntityClass::BadArea))
 			return false;
 
 		e = e->teamChain;
@@ -463,7 +463,7 @@ namespace {
 				teammate->client->resp.ctf_lastreturnedflag + CTF::RETURN_FLAG_ASSIST_TIMEOUT > level.time) {
 				gi.LocBroadcast_Print(PRINT_HIGH, "$g_bonus_assist_return", teammate->client->sess.netName);
 				G_AdjustPlayerScore(teammate->client, CTF::RETURN_FLAG_ASSIST_BONUS, false, 0);
-				teammate->client->pers.match.ctfFlagAssists++;
+				teammate->client->MatchStats().ctfFlagAssists()++;
 				PushAward(teammate, PlayerMedal::Assist);
 			}
 
@@ -471,7 +471,7 @@ namespace {
 				teammate->client->resp.ctf_lastfraggedcarrier + CTF::FRAG_CARRIER_ASSIST_TIMEOUT > level.time) {
 				gi.LocBroadcast_Print(PRINT_HIGH, "$g_bonus_assist_frag_carrier", teammate->client->sess.netName);
 				G_AdjustPlayerScore(teammate->client, CTF::FRAG_CARRIER_ASSIST_BONUS, false, 0);
-				teammate->client->pers.match.ctfFlagAssists++;
+				teammate->client->MatchStats().ctfFlagAssists()++;
 				PushAward(teammate, PlayerMedal::Assist);
 			}
 			});
@@ -851,7 +851,7 @@ namespace {
 
 		player->client->pers.inventory[flagItem] = 1;
 		player->client->resp.ctf_flagsince = level.time;
-		player->client->pers.match.ctfFlagPickups++;
+		player->client->MatchStats().ctfFlagPickups()++;
 
 		if (flagItem == IT_FLAG_NEUTRAL) {
 			FlagStatus status = FlagStatus::Taken;
@@ -909,7 +909,7 @@ namespace {
 		ent->svFlags &= ~SVF_NOCLIENT;
 		ent->solid = SOLID_TRIGGER;
 		gi.linkEntity(ent);
-		ent->s.event = EV_ITEM_RESPAWN;
+		G_SetEvent(ent, EV_ITEM_RESPAWN);
 		if (team == Team::Free) {
 			ent->fteam = Team::Free;
 		}
@@ -946,14 +946,14 @@ static void CTF_RecordCarrierTime(gclient_t* client, GameTime pickupTime) {
 		return;
 	}
 
-	auto& match = client->pers.match;
-	match.ctfFlagCarrierTimeTotalMsec += static_cast<uint64_t>(elapsedMs);
+	const ClientMatchStats match = client->MatchStats();
+	match.ctfFlagCarrierTimeTotalMsec() += static_cast<uint64_t>(elapsedMs);
 	const uint32_t duration = static_cast<uint32_t>(elapsedMs);
-	if (match.ctfFlagCarrierTimeShortestMsec == 0 || duration < match.ctfFlagCarrierTimeShortestMsec) {
-		match.ctfFlagCarrierTimeShortestMsec = duration;
+	if (match.ctfFlagCarrierTimeShortestMsec() == 0 || duration < match.ctfFlagCarrierTimeShortestMsec()) {
+		match.ctfFlagCarrierTimeShortestMsec() = duration;
 	}
-	if (duration > match.ctfFlagCarrierTimeLongestMsec) {
-		match.ctfFlagCarrierTimeLongestMsec = duration;
+	if (duration > match.ctfFlagCarrierTimeLongestMsec()) {
+		match.ctfFlagCarrierTimeLongestMsec() = duration;
 	}
 }
 
@@ -1003,7 +1003,7 @@ void AwardFlagCapture(gentity_t* flagEntity, gentity_t* scorer, Team scoringTeam
 	Team_CaptureFlagSound_Internal(scoringTeam);
 	if (scorer && scorer->client) {
 		CTF_RecordCarrierTime(scorer->client, pickupTime);
-		scorer->client->pers.match.ctfFlagCaptures++;
+		scorer->client->MatchStats().ctfFlagCaptures()++;
 	}
 }
 
@@ -1275,7 +1275,7 @@ bool CTF_PickupFlag(gentity_t* ent, gentity_t* other) {
 			other->client->sess.netName, Teams_TeamName(flagTeam));
 		G_AdjustPlayerScore(other->client, CTF::RECOVERY_BONUS, false, 0);
 		other->client->resp.ctf_lastreturnedflag = level.time;
-		other->client->pers.match.ctfFlagReturns++;
+		other->client->MatchStats().ctfFlagReturns()++;
 		gi.sound(ent, CHAN_RELIABLE | CHAN_NO_PHS_ADD | CHAN_AUX, gi.soundIndex("ctf/flagret.wav"), 1, ATTN_NONE, 0);
 		SetFlagStatus(flagTeam, FlagStatus::AtBase);
 		CTF_ResetTeamFlag(flagTeam);
@@ -1413,7 +1413,7 @@ void CTF_DeadDropFlag(gentity_t* self) {
 			carryStart = self->client->pers.teamState.flag_pickup_time;
 		}
 		CTF_RecordCarrierTime(self->client, carryStart);
-		self->client->pers.match.ctfFlagDrops++;
+		self->client->MatchStats().ctfFlagDrops()++;
 		self->client->resp.ctf_flagsince = 0_ms;
 	}
 
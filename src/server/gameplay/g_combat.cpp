@@ -137,10 +137,11 @@ void SpawnDamage(int type, const Vector3& origin, const Vector3& normal, int dam
 ===============
 CheckPowerArmor
 Absorb incoming damage using power armor (player or monster).
-Returns the amount of damage absorbed by power armor.
+Returns the amount of damage absorbed by power armor. The screen sparks are
+sent here unless `effects` is false, for callers sending one for many hits.
 ===============
 */
-static int CheckPowerArmor(gentity_t* ent, const Vector3& point, const Vector3& normal, int damage, DamageFlags dFlags)
+static int CheckPowerArmor(gentity_t* ent, const Vector3& point, const Vector3& normal, int damage, DamageFlags dFlags, bool effects)
 {
 	if (damage <= 0 || ent->health <= 0)
 		return 0;
@@ -210,7 +211,8 @@ static int CheckPowerArmor(gentity_t* ent, const Vector3& point, const Vector3&
 
 	power_used = std::max(damagePerCell, std::max(1, power_used));
 
-	SpawnDamage(TE_SCREEN_SPARKS, point, normal, save);
+	if (effects)
+		SpawnDamage(TE_SCREEN_SPARKS, point, normal, save);
 	ent->powerArmorTime = level.time + 200_ms;
 
 	*power = std::max(0, *power - power_used);
@@ -236,10 +238,11 @@ static int CheckPowerArmor(gentity_t* ent, const Vector3& point, const Vector3&
 ===============
 CheckArmor
 Absorb incoming damage using regular armor.
-Returns the amount of damage absorbed by armor.
+Returns the amount of damage absorbed by armor. The sparks are sent here
+unless `effects` is false.
 ===============
 */
-static int CheckArmor(gentity_t* ent, const Vector3& point, const Vector3& normal, int damage, int tempEvent, DamageFlags dFlags)
+static int CheckArmor(gentity_t* ent, const Vector3& point, const Vector3& normal, int damage, int tempEvent, DamageFlags dFlags, bool effects)
 {
 	if (damage <= 0)
 		return 0;
@@ -270,7 +273,8 @@ static int CheckArmor(gentity_t* ent, const Vector3& point, const Vector3& norma
 	if (!ent->client && ent->monsterInfo.armor_power <= 0)
 		ent->monsterInfo.armorType = IT_NULL;
 
-	SpawnDamage(tempEvent, point, normal, save);
+	if (effects)
+		SpawnDamage(tempEvent, point, normal, save);
 	return save;
 }
 
@@ -286,9 +290,9 @@ static void M_ReactToDamage(gentity_t* targ, gentity_t* attacker, gentity_t* inf
 		return;
 
 	// special-case: tesla mines
-	if (inflictor && !strcmp(inflictor->className, "tesla_mine")) {
+	if (G_IsClass(inflictor, EntityClass::TeslaMine)) {
 		if ((MarkTeslaArea(targ, inflictor) || brandom()) &&
-			(!targ->enemy || !targ->enemy->className || strcmp(targ->enemy->className, "tesla_mine"))) {
+			!G_IsClass(targ->enemy, EntityClass::TeslaMine)) {
 			TargetTesla(targ, inflictor);
 		}
 		return;
@@ -627,10 +631,31 @@ static inline void AddInflictedClientDamage(
 	}
 }
 
+/*
+===============
+DamageEffectEvent
+The temp entity sent where damage is taken, or -1 for none.
+===============
+*/
+static int DamageEffectEvent(const gentity_t* targ, const gclient_t* targCl, const MeansOfDeath& mod, int tempEvent) {
+	if (targ->flags & FL_NO_DAMAGE_EFFECTS)
+		return -1;
+	if (targ->flags & FL_MECHANICAL)
+		return TE_ELECTRIC_SPARKS;
+	if (!(targ->svFlags & SVF_MONSTER) && !targCl)
+		return tempEvent;
+	if (G_IsClass(targ, EntityClass::MonsterGekk))
+		return TE_GREENBLOOD;
+	if (mod.id == ModID::Chainfist)
+		return TE_MOREBLOOD;
+	return TE_BLOOD;
+}
+
 /*
 ===============
 ApplyDamage
-Subtract health, spawn effects, handle spheres, and kill target if needed.
+Subtract health, spawn effects (unless `effects` is false), handle spheres,
+and kill target if needed.
 Returns true if the target died.
 ===============
 */
@@ -645,18 +670,19 @@ static bool ApplyDamage(
 	const Vector3& normal,
 	const MeansOfDeath& mod,
 	int tempEvent,
-	bool& sphereNotified)
+	bool& sphereNotified,
+	bool effects)
 {
 	if (take <= 0)
 		return false;
 
 	// visual damage effects
-	if (!(targ->flags & FL_NO_DAMAGE_EFFECTS)) {
+	if (effects && !(targ->flags & FL_NO_DAMAGE_EFFECTS)) {
 		if (targ->flags & FL_MECHANICAL) {
 			SpawnDamage(TE_ELECTRIC_SPARKS, point, normal, take);
 		}
 		else if ((targ->svFlags & SVF_MONSTER) || targCl) {
-			if (strcmp(targ->className, "monster_gekk") == 0) {
+			if (G_IsClass(targ, EntityClass::MonsterGekk)) {
 				SpawnDamage(TE_GREENBLOOD, point, normal, take);
 			}
 			else if (mod.id == ModID::Chainfist) {
@@ -685,7 +711,7 @@ static bool ApplyDamage(
 	}
 
 	// notify owned sphere AI early
-	if (targCl && targCl->ownedSphere) {
+	if (!sphereNotified && targCl && targCl->ownedSphere) {
 		sphereNotified = true;
 		if (targCl->ownedSphere->pain)
 			targCl->ownedSphere->pain(targCl->ownedSphere, attacker, 0, 0, mod);
@@ -713,6 +739,8 @@ static bool ApplyDamage(
 		// record monster damage meta
 		{
 			auto& dmg = targ->monsterInfo.damage;
+			if (targ->svFlags & SVF_MONSTER)
+				M_PromoteLOD(targ);
 			dmg.blood += take;
 			dmg.attacker = attacker;
 			dmg.inflictor = inflictor;
@@ -722,6 +750,7 @@ static bool ApplyDamage(
 		}
 
 		Killed(targ, inflictor, attacker, take, point, mod);
+		G_RegistrySync(targ);
 		return true;
 	}
 
@@ -776,6 +805,393 @@ static void CheckDamageProtection(
 	save = damage;
 }
 
+/*
+===============
+DamageHits
+Applies the same hit to one target several times over, as if Damage had
+been called once per hit: each hit goes through scaling, knockback, armor,
+protection, stats and death in order, while the damage effects, pain,
+monster reaction and HUD feedback are sent once for the hits the target
+survived. A single hit is passed straight to Damage. Returns the index of
+the hit that took its health to zero, or hits if none did.
+===============
+*/
+int DamageHits(gentity_t* targ, gentity_t* inflictor, gentity_t* attacker, const Vector3& dir, const Vector3& hitPoint,
+	const Vector3& hitNormal, int damage, int knockback, int hits, DamageFlags dFlags, MeansOfDeath mod)
+{
+	if (!targ || !targ->takeDamage || hits <= 0)
+		return hits;
+
+	// a single hit is exactly a Damage call, effects and all
+	if (hits == 1) {
+		Damage(targ, inflictor, attacker, dir, hitPoint, hitNormal, damage, knockback, dFlags, mod);
+		return targ->health <= 0 ? 0 : 1;
+	}
+
+	// the effects are sent after Killed, which may free whatever these point into
+	const Vector3 point = hitPoint;
+	const Vector3 normal = hitNormal;
+
+	const int tempEvent = static_cast<int>(dFlags & DamageFlags::Bullet) ? TE_BULLET_SPARKS : TE_SPARKS;
+
+	bool       sphereNotified = false;
+	gclient_t* targCl = targ->client;
+
+	const bool sameTeam = OnSameTeam(targ, attacker);
+	const int  damageEvent = DamageEffectEvent(targ, targCl, mod, tempEvent);
+	const bool wasAlive = targ->health > 0;
+
+	// global damage scale
+	const float scaleValue = (targ->svFlags & SVF_MONSTER) ? ai_damage_scale->value : g_damage_scale->value;
+	const float clampedScale = std::max(0.0f, scaleValue);
+
+	// totals for the effects sent once
+	int totalTake = 0;
+	int totalPowerArmorSave = 0;
+	int totalArmorSave = 0;
+	int hitMarker = 0;
+
+	// hits the target survived, for pain, reaction and HUD feedback
+	int  aliveTake = 0;
+	int  alivePowerArmorSave = 0;
+	int  aliveArmorSave = 0;
+	int  aliveKnockback = 0;
+	int  painTake = 0;
+	int  painKnockback = 0;
+	bool aliveHit = false;
+	bool monsterReacts = false;
+	bool respawned = false;
+
+	int hitsBeforeDeath = hits;
+
+	for (int hit = 0; hit < hits && targ->takeDamage; hit++) {
+		int hitDamage = damage;
+		int hitKnockback = knockback;
+
+#ifndef NDEBUG
+		const int originalHealth = targ->health;
+		bool      zeroDamageScaleActive = false;
+#endif
+
+		// friendly fire scaling/flagging
+		if (targ != attacker && !static_cast<int>(dFlags & DamageFlags::NoProtection)) {
+			if (sameTeam) {
+				mod.friendly_fire = true;
+
+				// scale out damage if ff disabled (except some specials like nuke)
+				if (mod.id != ModID::Nuke)
+					hitDamage = static_cast<int>(hitDamage * g_friendlyFireScale->value);
+			}
+		}
+
+		// easy skill halves damage vs players in SP
+		if (skill->integer == 0 && !deathmatch->integer && targCl && hitDamage > 0) {
+			hitDamage = std::max(1, hitDamage / 2);
+		}
+
+		const float baseDamage = std::max(0.0f, static_cast<float>(hitDamage));
+		const float scaledDamage = baseDamage * clampedScale;
+		const bool  hadPositiveScaledDamage = scaledDamage > 0.0f;
+
+#ifndef NDEBUG
+		zeroDamageScaleActive = (clampedScale == 0.0f) && (baseDamage > 0.0f);
+#endif
+
+		hitDamage = static_cast<int>(scaledDamage);
+		if (hadPositiveScaledDamage && hitDamage <= 0)
+			hitDamage = 1;
+
+		// defender sphere halves damage
+		if (hitDamage > 0 && targCl && targCl->ownedSphere && (targCl->ownedSphere->spawnFlags == SF_SPHERE_DEFENDER)) {
+			hitDamage = std::max(1, hitDamage / 2);
+		}
+
+		// surprise bonus vs monsters (non-radius, first hit)
+		if (!static_cast<int>(dFlags & DamageFlags::Radius) &&
+			(targ->svFlags & SVF_MONSTER) && attacker && attacker->client &&
+			(!targ->enemy || targ->monsterInfo.surprise_time == level.time) && (targ->health > 0)) {
+			hitDamage *= 2;
+			targ->monsterInfo.surprise_time = level.time;
+		}
+
+		// Q3A-style knockback cap
+		if (RS(Quake3Arena)) {
+			hitKnockback = std::min(hitDamage, 200);
+		}
+
+		/*freeze*/
+		if (Game::Is(GameType::FreezeTag) && targCl && targCl->eliminated)
+			hitKnockback *= 2;
+		else
+			/*freeze*/
+			if ((targ->flags & FL_NO_KNOCKBACK) ||
+				((targ->flags & FL_ALIVE_KNOCKBACK_ONLY) && (!targ->deadFlag || targ->dead_time != level.time))) {
+				hitKnockback = 0;
+			}
+
+		if (g_instaGib->integer && attacker && attacker->client && targCl && mod.id == ModID::Railgun)
+			hitKnockback = 100;
+
+		// compute momentum before self-damage halving
+		ApplyKnockback(targ, attacker, dir, hitKnockback, dFlags);
+
+		// always give half damage if hurting self (after knockback calc)
+		if (targ == attacker && hitDamage > 0)
+			hitDamage = std::max(1, hitDamage / 2);
+
+		if (hitDamage <= 0)
+			hitDamage = 0;
+
+		int take = hitDamage;
+		int save = 0;
+
+#ifndef NDEBUG
+		if (zeroDamageScaleActive)
+			assert(take == 0);
+#endif
+
+		FreezeTagDamageQuery freezeQuery{};
+		freezeQuery.freezeTagActive = Game::Is(GameType::FreezeTag);
+		freezeQuery.targetEliminated = (targCl && targCl->eliminated);
+		freezeQuery.targetThawing = (targCl && targCl->resp.thawer);
+		freezeQuery.attackerHasClient = (attacker && attacker->client);
+		freezeQuery.modIsThaw = (mod.id == ModID::Thaw);
+
+		const bool freezeSuppressed = FreezeTag_ShouldSuppressDamage(freezeQuery);
+
+		// global get-out clauses
+		CheckDamageProtection(targ, targCl, attacker, take, save, hitDamage, dFlags, point, normal, mod, tempEvent);
+
+		if (freezeSuppressed)
+			take = 0;
+
+		// vampiric healing
+		if (g_vampiric_damage->integer && targ->health > 0 &&
+			attacker && attacker != targ && !sameTeam && take > 0) {
+			const int   maxHP = std::clamp(g_vampiric_health_max->integer, 100, 9999);
+			const int   base = std::min(take, targ->health);
+			const float pct = std::clamp(g_vampiric_percentile->value, 0.0f, 1.0f);
+
+			const int heal = std::max(1, static_cast<int>(std::ceil(base * pct)));
+			attacker->health = std::min(attacker->health + heal, maxHP);
+		}
+
+		// team armor protect or normal armor flows
+		int armorSave = 0;
+		int powerArmorSave = 0;
+
+		if (!freezeSuppressed) {
+			if (Teams() && targCl && attacker && attacker->client &&
+				targCl->sess.team == attacker->client->sess.team && targ != attacker && g_teamplay_armor_protect->integer) {
+				// teammates do not drain armor under protect mode
+				powerArmorSave = 0;
+				armorSave = 0;
+			}
+			else {
+				if (targ == attacker && Game::Has(GameFlags::Arena) && !g_arenaSelfDmgArmor->integer) {
+					take = 0;
+					save = hitDamage;
+				}
+				else {
+					powerArmorSave = CheckPowerArmor(targ, point, normal, take, dFlags, false);
+					take -= powerArmorSave;
+
+					armorSave = CheckArmor(targ, point, normal, take, tempEvent, dFlags, false);
+					take -= armorSave;
+				}
+			}
+		}
+
+		totalPowerArmorSave += powerArmorSave;
+		totalArmorSave += armorSave;
+
+		// treat previous "save" like armor for HUD/indicators
+		armorSave += save;
+
+		// additional protections and powerups
+		if (!freezeSuppressed && !static_cast<int>(dFlags & DamageFlags::NoProtection)) {
+			if (targ == attacker && Game::Has(GameFlags::Arena)) {
+				take = 0;
+				save = 0;
+			}
+
+			// tech: disruptor shield, etc.
+			take = Tech_ApplyDisruptorShield(targ, take);
+
+			// spawn protection
+			if (take > 0 && targCl && targCl->PowerupTimer(PowerupTimer::SpawnProtection) > level.time) {
+				gi.sound(targ, CHAN_AUX, gi.soundIndex("items/protect3.wav"), 1, ATTN_NORM, 0);
+				take = 0;
+				targCl->pu_time_spawn_protection_blip = level.time + 100_ms;
+			}
+
+			// battle suit halves remaining damage
+			if (take > 0 && targCl && targCl->PowerupTimer(PowerupTimer::BattleSuit) > level.time) {
+				gi.sound(targ, CHAN_AUX, gi.soundIndex("items/protect3.wav"), 1, ATTN_NORM, 0);
+				take = static_cast<int>(std::ceil(static_cast<float>(take) / 2.0f));
+			}
+
+			// empathy shield halves remaining damage and inflicts the same damage to attacker
+			if (targCl && targCl->PowerupTimer(PowerupTimer::EmpathyShield) > level.time && take > 0 && attacker &&
+				targ != attacker) {
+				gi.sound(targ, CHAN_AUX, gi.soundIndex("items/empathy_hit.wav"), 1, ATTN_NORM, 0);
+				take = static_cast<int>(std::ceil(static_cast<float>(take) / 2.0f));
+
+				Damage(attacker, nullptr, targ, dir, point, normal, take, 0, DamageFlags::NoProtection | DamageFlags::NoKnockback | DamageFlags::NoIndicator, mod);
+			}
+		}
+
+		if (!freezeSuppressed)
+			CTF_CheckHurtCarrier(targ, attacker);
+
+		// DamageFlags::DestroyArmor: do full damage through armor unless explicitly protected
+		if (!freezeSuppressed && static_cast<int>(dFlags & DamageFlags::DestroyArmor)) {
+			if (!(targ->flags & FL_GODMODE) &&
+				!static_cast<int>(dFlags & DamageFlags::NoProtection) &&
+				!(targCl && targCl->PowerupTimer(PowerupTimer::BattleSuit) > level.time)) {
+				take = hitDamage;
+			}
+		}
+
+		// scoring and stat tracking for the attacker (only if target still alive here)
+		if (!freezeSuppressed && targ != attacker && attacker && attacker->client && targ->health > 0) {
+			int statTake = std::min(take, targ->health);
+
+			// arena damage scoring: +1 score per 100 dmg dealt to enemies
+			if (Game::Has(GameFlags::Arena) && !sameTeam) {
+				attacker->client->pers.dmg_scorer += statTake + powerArmorSave + armorSave;
+
+				while (attacker->client->pers.dmg_scorer >= 100) {
+					attacker->client->pers.dmg_scorer -= 100;
+					G_AdjustPlayerScore(attacker->client, 1, false, 0);
+				}
+			}
+
+			// team damage accumulation/warning
+			if (sameTeam) {
+				attacker->client->pers.dmg_team += statTake + powerArmorSave + armorSave;
+
+				while (attacker->client->pers.dmg_team >= 100) {
+					attacker->client->pers.dmg_team -= 100;
+					gi.LocClient_Print(attacker, PRINT_CENTER,
+						"You are on {} Team,\nstop attacking your team mates!\n",
+						Teams_TeamName(attacker->client->sess.team));
+				}
+			}
+
+			// hit markers (skip target_laser)
+			if (!((targ->svFlags & SVF_DEADMONSTER) || (targ->flags & FL_NO_DAMAGE_EFFECTS)) && mod.id != ModID::Laser) {
+				hitMarker += statTake + powerArmorSave + armorSave;
+			}
+
+			attacker->client->MatchStats().totalDmgDealt() += statTake + powerArmorSave + armorSave;
+			attacker->client->MatchStats().modTotalDmgD()[static_cast<int>(mod.id)] += statTake + powerArmorSave + armorSave;
+
+			if (!inflictor || (inflictor && !inflictor->skip)) {
+				attacker->client->MatchStats().totalHits()++;
+				attacker->client->MatchStats().totalHitsPerWeapon()[static_cast<int>(modr[static_cast<int>(mod.id)].weapon)]++;
+
+				// skip MG/CG inflictor skip toggle to keep continuous fire sane
+				if (inflictor && mod.id != ModID::Machinegun && mod.id != ModID::Chaingun)
+					inflictor->skip = true;
+			}
+
+			if (targCl) {
+				targCl->MatchStats().totalDmgReceived() += statTake + powerArmorSave + armorSave;
+				targCl->MatchStats().modTotalDmgR()[static_cast<int>(mod.id)] += statTake + powerArmorSave + armorSave;
+			}
+		}
+
+		if (take > 0)
+			totalTake += take;
+
+		// actually apply the damage; can kill
+		const bool died = ApplyDamage(targ, inflictor, attacker, targCl, take, hitKnockback, point, normal, mod, tempEvent, sphereNotified, false);
+
+		if (hitsBeforeDeath == hits && targ->health <= 0)
+			hitsBeforeDeath = hit;
+
+		if (died)
+			continue;
+
+#ifndef NDEBUG
+		if (zeroDamageScaleActive)
+			assert(targ->health == originalHealth);
+#endif
+
+		if (Game::Is(GameType::FreezeTag) && !level.intermission.time && targCl && targCl->eliminated &&
+			targ->health <= targ->gibHealth && (!attacker || !attacker->client)) {
+			FreezeTag_ForceRespawn(targ);
+			respawned = true;
+			break;
+		}
+
+		if (targ->svFlags & SVF_MONSTER) {
+			if (hitDamage > 0) {
+				monsterReacts = true;
+
+				auto& dmg = targ->monsterInfo.damage;
+				dmg.attacker = attacker;
+				dmg.inflictor = inflictor;
+				dmg.blood += take;
+				dmg.origin = point;
+				dmg.mod = mod;
+				dmg.knockback += hitKnockback;
+			}
+		}
+		else if (take > 0 && !painTake) {
+			painTake = take;
+			painKnockback = hitKnockback;
+		}
+
+		aliveHit = true;
+		aliveTake += take;
+		alivePowerArmorSave += powerArmorSave;
+		aliveArmorSave += armorSave;
+		aliveKnockback += hitKnockback;
+	}
+
+	// effects for all hits, as one message each
+	if (totalPowerArmorSave > 0)
+		SpawnDamage(TE_SCREEN_SPARKS, point, normal, totalPowerArmorSave);
+	if (totalArmorSave > 0)
+		SpawnDamage(tempEvent, point, normal, totalArmorSave);
+	if (damageEvent != -1 && totalTake > 0)
+		SpawnDamage(damageEvent, point, normal, totalTake);
+	if (hitMarker > 0)
+		G_AddHitMarker(attacker, hitMarker);
+
+	if (!aliveHit || respawned || !targ->inUse)
+		return hitsBeforeDeath;
+
+	// spheres need to know the attacker to retaliate
+	if (!sphereNotified && targCl && targCl->ownedSphere && targCl->ownedSphere->pain)
+		targCl->ownedSphere->pain(targCl->ownedSphere, attacker, 0, 0, mod);
+
+	if (targCl)
+		targCl->last_attacker_time = level.time;
+
+	// pain callbacks / monster reaction and cosmetic updates, unless these hits killed
+	if (!wasAlive || targ->health > 0) {
+		if (targ->svFlags & SVF_MONSTER) {
+			if (monsterReacts) {
+				M_ReactToDamage(targ, attacker, inflictor);
+				M_PromoteLOD(targ);
+			}
+		}
+		else if (painTake > 0 && targ->pain) {
+			targ->pain(targ, attacker, static_cast<float>(painKnockback), painTake, mod);
+		}
+	}
+
+	if ((targ->svFlags & SVF_MONSTER) && targ->monsterInfo.setSkin)
+		targ->monsterInfo.setSkin(targ);
+
+	// final HUD accumulation
+	AddInflictedClientDamage(targCl, point, attacker, inflictor, aliveTake, alivePowerArmorSave, aliveArmorSave, dFlags, aliveKnockback);
+	return hitsBeforeDeath;
+}
+
 /*
 ===============
 Damage
@@ -921,10 +1337,10 @@ void Damage(gentity_t* targ, gentity_t* inflictor, gentity_t* attacker, const Ve
 				save = damage;
 			}
 			else {
-				powerArmorSave = CheckPowerArmor(targ, point, normal, take, dFlags);
+				powerArmorSave = CheckPowerArmor(targ, point, normal, take, dFlags, true);
 				take -= powerArmorSave;
 
-				armorSave = CheckArmor(targ, point, normal, take, tempEvent, dFlags);
+				armorSave = CheckArmor(targ, point, normal, take, tempEvent, dFlags, true);
 				take -= armorSave;
 			}
 		}
@@ -1006,15 +1422,15 @@ void Damage(gentity_t* targ, gentity_t* inflictor, gentity_t* attacker, const Ve
 
 		// hit markers (skip target_laser)
 		if (!((targ->svFlags & SVF_DEADMONSTER) || (targ->flags & FL_NO_DAMAGE_EFFECTS)) && mod.id != ModID::Laser) {
-			attacker->client->ps.stats[STAT_HIT_MARKER] += statTake + powerArmorSave + armorSave;
+			G_AddHitMarker(attacker, statTake + powerArmorSave + armorSave);
 		}
 
-		attacker->client->pers.match.totalDmgDealt += statTake + powerArmorSave + armorSave;
-		attacker->client->pers.match.modTotalDmgD[static_cast<int>(mod.id)] += statTake + powerArmorSave + armorSave;
+		attacker->client->MatchStats().totalDmgDealt() += statTake + powerArmorSave + armorSave;
+		attacker->client->MatchStats().modTotalDmgD()[static_cast<int>(mod.id)] += statTake + powerArmorSave + armorSave;
 
 		if (!inflictor || (inflictor && !inflictor->skip)) {
-			attacker->client->pers.match.totalHits++;
-			attacker->client->pers.match.totalHitsPerWeapon[static_cast<int>(modr[static_cast<int>(mod.id)].weapon)]++;
+			attacker->client->MatchStats().totalHits()++;
+			attacker->client->MatchStats().totalHitsPerWeapon()[static_cast<int>(modr[static_cast<int>(mod.id)].weapon)]++;
 
 			// skip MG/CG inflictor skip toggle to keep continuous fire sane
 			if (inflictor && mod.id != ModID::Machinegun && mod.id != ModID::Chaingun)
@@ -1022,13 +1438,13 @@ void Damage(gentity_t* targ, gentity_t* inflictor, gentity_t* attacker, const Ve
 		}
 
 		if (targCl) {
-			targCl->pers.match.totalDmgReceived += statTake + powerArmorSave + armorSave;
-			targCl->pers.match.modTotalDmgR[static_cast<int>(mod.id)] += statTake + powerArmorSave + armorSave;
+			targCl->MatchStats().totalDmgReceived() += statTake + powerArmorSave + armorSave;
+			targCl->MatchStats().modTotalDmgR()[static_cast<int>(mod.id)] += statTake + powerArmorSave + armorSave;
 		}
 	}
 
 	// actually apply the damage; can kill
-	if (ApplyDamage(targ, inflictor, attacker, targCl, take, knockback, point, normal, mod, tempEvent, sphereNotified))
+	if (ApplyDamage(targ, inflictor, attacker, targCl, take, knockback, point, normal, mod, tempEvent, sphereNotified, true))
 		return;
 
 #ifndef NDEBUG
@@ -1053,6 +1469,7 @@ void Damage(gentity_t* targ, gentity_t* inflictor, gentity_t* attacker, const Ve
 	if (targ->svFlags & SVF_MONSTER) {
 		if (damage > 0) {
 			M_ReactToDamage(targ, attacker, inflictor);
+			M_PromoteLOD(targ);
 
 			auto& dmg = targ->monsterInfo.damage;
 			dmg.attacker = attacker;
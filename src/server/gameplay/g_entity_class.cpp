@@ -0,0 +1,191 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+g_entity_class.cpp (Entity Class Tags) Maps the class names that per-frame, per-damage and
+per-touch code asks about to a small enum, so those checks compare integers instead of strings.
+Key Responsibilities: - Resolution: `G_EntityClassResolve` looks className up once and caches
+the tag and prefix groups on the entity along with the className pointer it came from; the
+inline queries in g_local.hpp re-resolve only when that pointer changes, so entities that rename
+themselves after spawning (gibs, projectiles, freed slots) stay correct. - Tables: names are
+matched case-insensitively, like the Q_strcasecmp checks they replace. - Checking: debug builds
+cross-check every cached tag against its className each frame.*/
+
+#include "../g_local.hpp"
+
+#include <cctype>
+#include <unordered_map>
+
+namespace {
+
+constexpr size_t MAX_CLASS_NAME = 64;
+
+constexpr std::array<const char*, static_cast<size_t>(EntityClass::Total)> entityClassNames = {
+	"",
+	"gib",
+	"player_noise",
+	"bodyque",
+	"grenade",
+	"nuke",
+	"prox_mine",
+	"tesla_mine",
+	"misc_explobox",
+	"misc_teleporter_dest",
+	"misc_camera",
+	"trigger_misc_camera",
+	"path_corner",
+	"point_combat",
+	"target_actor",
+	"target_poi",
+	"func_train",
+	"func_door",
+	"func_door_rotating",
+	"func_door_secret",
+	"func_water",
+	"func_areaportal",
+	"func_plat",
+	"func_plat2",
+	"object_repair",
+	"bot_goal",
+	"bad_area",
+	"ammo_pack",
+	"monster_carrier",
+	"monster_chthon",
+	"monster_daedalus",
+	"monster_fixbot",
+	"monster_flyer",
+	"monster_gekk",
+	"monster_kamikaze",
+	"monster_lavaman",
+	"monster_medic_commander",
+	"monster_mummy",
+	"monster_ogre_marksman",
+	"monster_ogre_multigrenade",
+	"monster_oldone",
+	"monster_overlord",
+	"monster_statue",
+	"monster_tarbaby_hell",
+	"monster_turret",
+};
+
+struct class_group_prefix_t {
+	std::string_view	prefix;
+	EntityClassGroup	group;
+};
+
+constexpr class_group_prefix_t classGroupPrefixes[] = {
+	{ "player",			EntityClassGroup::Player },
+	{ "info_player_",	EntityClassGroup::PlayerSpawn },
+	{ "item_flag_",		EntityClassGroup::TeamFlag },
+	{ "tesla",			EntityClassGroup::Tesla },
+	{ "food_cube_trap",	EntityClassGroup::FoodCubeTrap },
+	{ "func_plat",		EntityClassGroup::FuncPlat },
+	{ "monster_medic",	EntityClassGroup::Medic },
+	{ "monster_widow",	EntityClassGroup::Widow },
+};
+
+/*
+=============
+ClassTable
+=============
+*/
+const std::unordered_map<std::string_view, EntityClass>& ClassTable() {
+	static const std::unordered_map<std::string_view, EntityClass> table = [] {
+		std::unordered_map<std::string_view, EntityClass> map;
+		for (size_t i = 1; i < entityClassNames.size(); i++)
+			map.emplace(entityClassNames[i], static_cast<EntityClass>(i));
+		return map;
+	}();
+
+	return table;
+}
+
+} // namespace
+
+/*
+=============
+G_EntityClassFromName
+
+Returns the tag for a class name, and optionally its prefix groups.
+=============
+*/
+EntityClass G_EntityClassFromName(const char* className, EntityClassGroup* groups) {
+	if (groups)
+		*groups = EntityClassGroup::None;
+
+	if (!className)
+		return EntityClass::Other;
+
+	char lower[MAX_CLASS_NAME];
+	size_t length = 0;
+	for (; className[length]; length++) {
+		if (length == MAX_CLASS_NAME)
+			return EntityClass::Other;
+		lower[length] = static_cast<char>(std::tolower(static_cast<unsigned char>(className[length])));
+	}
+
+	const std::string_view name(lower, length);
+
+	if (groups) {
+		for (const class_group_prefix_t& entry : classGroupPrefixes) {
+			if (name.starts_with(entry.prefix))
+				*groups |= entry.group;
+		}
+	}
+
+	const auto& table = ClassTable();
+	const auto it = table.find(name);
+	return it != table.end() ? it->second : EntityClass::Other;
+}
+
+/*
+=============
+G_EntityClassName
+=============
+*/
+const char* G_EntityClassName(EntityClass cls) {
+	const size_t index = static_cast<size_t>(cls);
+	return index < entityClassNames.size() ? entityClassNames[index] : "";
+}
+
+/*
+=============
+G_EntityClassResolve
+
+Tags the entity from its current className.
+=============
+*/
+void G_EntityClassResolve(const gentity_t* ent) {
+	ent->classTag = G_EntityClassFromName(ent->className, &ent->classGroups);
+	ent->classTagName = ent->className;
+}
+
+/*
+=============
+G_EntityClassVerify
+
+Returns false if an in-use entity's cached tag no longer matches the
+className it was resolved from; such entities are re-tagged.
+=============
+*/
+bool G_EntityClassVerify(bool print) {
+	bool ok = true;
+
+	for (size_t i = G_EntityHotNextInUse(0); i < globals.numEntities; i = G_EntityHotNextInUse(i + 1)) {
+		const gentity_t* ent = &g_entities[i];
+
+		if (ent->classTagName != ent->className)
+			continue;
+
+		EntityClassGroup groups;
+		if (G_EntityClassFromName(ent->className, &groups) == ent->classTag && groups == ent->classGroups)
+			continue;
+
+		if (print)
+			gi.Com_PrintFmt("Entity class tags: slot {} tagged {} but named {}\n", i,
+				G_EntityClassName(ent->classTag), ent->className ? ent->className : "?");
+		G_EntityClassResolve(ent);
+		ok = false;
+	}
+
+	return ok;
+}
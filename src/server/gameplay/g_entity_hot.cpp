@@ -0,0 +1,192 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+g_entity_hot.cpp (Entity Hot Columns) Mirrors the per-slot fields that whole-array scans test
+into compact arrays, so the frame loop and Spawn can walk thousands of slots without pulling a
+gentity_t into cache for each one. Key Responsibilities: - Columns: slot occupancy and free time,
+indexed by entity number. - Sync: `G_EntityHotSync` is called wherever `inUse` changes
+(InitGEntity, FreeEntity, client spawn and disconnect); the columns are cleared with the entity
+array and rebuilt after a load. - Scans: `G_EntityHotNextInUse` for the frame loop and
+`G_EntityHotFindFree` for Spawn's slot reuse policy. - Checking: debug builds cross-check the
+columns against the entity array every frame.*/
+
+#include "../g_local.hpp"
+
+#include <chrono>
+#include <vector>
+
+namespace {
+
+struct entity_hot_columns_t {
+	std::vector<uint8_t>	inUse;
+	std::vector<GameTime>	freeTime;
+};
+
+entity_hot_columns_t columns;
+
+/*
+=============
+SlotReusable
+
+Spawn's replacement policy: avoid handing out a slot freed less than half
+a second ago, so clients do not see one entity morph into another.
+=============
+*/
+inline bool SlotReusable(GameTime freeTime) {
+	return freeTime < 2_sec || level.time - freeTime > 500_ms;
+}
+
+/*
+=============
+ScanEnd
+=============
+*/
+inline size_t ScanEnd() {
+	return std::min<size_t>(globals.numEntities, columns.inUse.size());
+}
+
+} // namespace
+
+/*
+=============
+G_EntityHotClear
+
+Resets the columns to match a freshly wiped entity array.
+=============
+*/
+void G_EntityHotClear() {
+	columns.inUse.assign(game.maxEntities, 0);
+	columns.freeTime.assign(game.maxEntities, 0_ms);
+}
+
+/*
+=============
+G_EntityHotSync
+
+Copies the entity's mirrored fields into the columns. Call after changing
+inUse or freeTime.
+=============
+*/
+void G_EntityHotSync(const gentity_t* ent) {
+	const size_t slot = static_cast<size_t>(ent - g_entities);
+
+	if (slot >= columns.inUse.size())
+		return;
+
+	columns.inUse[slot] = ent->inUse ? 1 : 0;
+	columns.freeTime[slot] = ent->freeTime;
+}
+
+/*
+=============
+G_EntityHotRebuild
+
+Refills the columns from the entity array, e.g. after loading a level.
+=============
+*/
+void G_EntityHotRebuild() {
+	G_EntityHotClear();
+
+	for (size_t i = 0; i < ScanEnd(); i++)
+		G_EntityHotSync(&g_entities[i]);
+}
+
+/*
+=============
+G_EntityHotVerify
+
+Returns false if a slot's inUse or freeTime changed without a sync.
+=============
+*/
+bool G_EntityHotVerify(bool print) {
+	bool ok = columns.inUse.size() >= globals.numEntities;
+
+	for (size_t i = 0; i < ScanEnd(); i++) {
+		const gentity_t* ent = &g_entities[i];
+
+		if ((columns.inUse[i] != 0) == ent->inUse && columns.freeTime[i] == ent->freeTime)
+			continue;
+
+		if (print)
+			gi.Com_PrintFmt("Entity hot columns: slot {} out of sync ({})\n", i, ent->className ? ent->className : "?");
+		ok = false;
+	}
+
+	return ok;
+}
+
+/*
+=============
+G_EntityHotNextInUse
+
+Returns the first in-use slot at or after from, or globals.numEntities.
+=============
+*/
+size_t G_EntityHotNextInUse(size_t from) {
+	const size_t end = ScanEnd();
+
+	for (size_t i = from; i < end; i++) {
+		if (columns.inUse[i])
+			return i;
+	}
+
+	return globals.numEntities;
+}
+
+/*
+=============
+G_EntityHotFindFree
+
+Returns the first free slot at or after from that Spawn may reuse, or
+globals.numEntities if there is none.
+=============
+*/
+size_t G_EntityHotFindFree(size_t from) {
+	const size_t end = ScanEnd();
+
+	for (size_t i = from; i < end; i++) {
+		if (!columns.inUse[i] && SlotReusable(columns.freeTime[i]))
+			return i;
+	}
+
+	return globals.numEntities;
+}
+
+/*
+=============
+G_EntityHotBenchmark
+
+Times the frame loop's slot walk both ways on the current level: testing
+inUse on every gentity_t, and hopping between in-use slots via the column.
+=============
+*/
+void G_EntityHotBenchmark(size_t frames) {
+	using clock = std::chrono::steady_clock;
+
+	const size_t first = static_cast<size_t>(game.maxClients) + 1;
+	size_t sweepVisits = 0;
+	size_t columnVisits = 0;
+	double sweepMs = 0.0;
+	double columnMs = 0.0;
+
+	for (size_t frame = 0; frame < frames; frame++) {
+		auto start = clock::now();
+		for (size_t i = first; i < globals.numEntities; i++) {
+			if (g_entities[i].inUse)
+				sweepVisits++;
+		}
+		sweepMs += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+		start = clock::now();
+		for (size_t i = G_EntityHotNextInUse(first); i < globals.numEntities; i = G_EntityHotNextInUse(i + 1))
+			columnVisits++;
+		columnMs += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+	}
+
+	const double divisor = static_cast<double>(frames ? frames : 1);
+	gi.Com_PrintFmt("Entity slot walk over {} frames, {} slots, {} in use:\n", frames, globals.numEntities,
+		frames ? sweepVisits / frames : 0);
+	gi.Com_PrintFmt("  gentity_t sweep  {:.4f} ms/frame\n", sweepMs / divisor);
+	gi.Com_PrintFmt("  hot column walk  {:.4f} ms/frame{}\n", columnMs / divisor,
+		columnVisits == sweepVisits ? "" : " (MISMATCH)");
+}
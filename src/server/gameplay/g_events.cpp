@@ -0,0 +1,205 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+g_events.cpp (Frame Events) Tracks the entities that picked up per-frame transient state so the
+start-of-frame reset only touches those instead of sweeping every entity slot. Key
+Responsibilities: - Queueing: `G_SetEvent` and `G_AddHitMarker` write the value and remember the
+entity once per frame. - Reset: `G_ClearEvents` clears `s.event` and the client hit marker on the
+queued entities; debug builds cross-check that nothing outside the list still carries an event. -
+Recovery: `G_EventListRebuild` re-queues from a full scan after a level is loaded.*/
+
+#include "../g_local.hpp"
+
+#include <chrono>
+#include <vector>
+
+namespace {
+
+std::vector<gentity_t*> pendingEvents;
+
+/*
+=============
+QueueEntity
+=============
+*/
+inline void QueueEntity(gentity_t* ent) {
+	if (ent->eventQueued)
+		return;
+
+	ent->eventQueued = true;
+	pendingEvents.push_back(ent);
+}
+
+} // namespace
+
+/*
+=============
+G_SetEvent
+
+Sets the entity's impulse event for this frame. Use this rather than
+writing s.event directly so the event is cleared at the start of the
+next frame.
+=============
+*/
+void G_SetEvent(gentity_t* ent, entity_event_t event) {
+	ent->s.event = event;
+
+	if (event != EV_NONE)
+		QueueEntity(ent);
+}
+
+/*
+=============
+G_AddHitMarker
+=============
+*/
+void G_AddHitMarker(gentity_t* attacker, int32_t amount) {
+	attacker->client->ps.stats[STAT_HIT_MARKER] += amount;
+	QueueEntity(attacker);
+}
+
+/*
+=============
+G_ClearEvents
+
+Clears last frame's events and hit markers. Freed entities may still be
+listed; clearing them again is harmless.
+=============
+*/
+void G_ClearEvents() {
+	for (gentity_t* ent : pendingEvents) {
+		ent->s.event = EV_NONE;
+		ent->eventQueued = false;
+
+		if (ent->client)
+			ent->client->ps.stats[STAT_HIT_MARKER] = 0;
+	}
+
+	pendingEvents.clear();
+}
+
+/*
+=============
+G_EventListClear
+
+Forgets every queued entity; used when the entity array is wiped wholesale.
+The wipe detaches the clients, so their hit markers are cleared here.
+=============
+*/
+void G_EventListClear() {
+	pendingEvents.clear();
+
+	for (size_t i = 0; game.clients && i < game.maxClients; i++)
+		game.clients[i].ps.stats[STAT_HIT_MARKER] = 0;
+}
+
+/*
+=============
+G_EventListRebuild
+
+Re-queues every entity that currently carries an event or hit marker,
+e.g. after loading a level.
+=============
+*/
+void G_EventListRebuild() {
+	pendingEvents.clear();
+
+	for (size_t i = 0; i < globals.numEntities; i++) {
+		gentity_t* ent = &g_entities[i];
+
+		ent->eventQueued = false;
+		if (ent->s.event != EV_NONE || (ent->client && ent->client->ps.stats[STAT_HIT_MARKER]))
+			QueueEntity(ent);
+	}
+}
+
+/*
+=============
+G_EventListCount
+=============
+*/
+size_t G_EventListCount() {
+	return pendingEvents.size();
+}
+
+/*
+=============
+G_EventListVerify
+
+Returns false if an entity carries an event that was set behind the
+list's back, i.e. without G_SetEvent.
+=============
+*/
+bool G_EventListVerify() {
+	for (size_t i = 0; i < globals.numEntities; i++) {
+		const gentity_t* ent = &g_entities[i];
+
+		if (ent->s.event != EV_NONE && !ent->eventQueued)
+			return false;
+	}
+
+	return true;
+}
+
+/*
+=============
+G_EventBenchmark
+
+Times the old full sweep against the list reset on the current level,
+with one in eight in-use entities carrying an event. Events and hit
+markers are restored afterwards.
+=============
+*/
+void G_EventBenchmark(size_t frames) {
+	using clock = std::chrono::steady_clock;
+
+	std::vector<entity_event_t> savedEvents(globals.numEntities);
+	std::vector<int16_t> savedMarkers(globals.numEntities);
+	std::vector<gentity_t*> eventful;
+
+	for (size_t i = 0; i < globals.numEntities; i++) {
+		gentity_t* ent = &g_entities[i];
+
+		savedEvents[i] = ent->s.event;
+		if (ent->client)
+			savedMarkers[i] = ent->client->ps.stats[STAT_HIT_MARKER];
+		if (ent->inUse && (i % 8) == 0)
+			eventful.push_back(ent);
+	}
+
+	double sweepMs = 0.0;
+	double listMs = 0.0;
+
+	for (size_t frame = 0; frame < frames; frame++) {
+		for (gentity_t* ent : eventful)
+			G_SetEvent(ent, EV_FOOTSTEP);
+
+		auto start = clock::now();
+		for (size_t i = 0; i < globals.numEntities; i++)
+			g_entities[i].s.event = EV_NONE;
+		for (auto player : active_clients())
+			player->client->ps.stats[STAT_HIT_MARKER] = 0;
+		sweepMs += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+		for (gentity_t* ent : eventful)
+			G_SetEvent(ent, EV_FOOTSTEP);
+
+		start = clock::now();
+		G_ClearEvents();
+		listMs += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+	}
+
+	for (size_t i = 0; i < globals.numEntities; i++) {
+		gentity_t* ent = &g_entities[i];
+
+		ent->s.event = savedEvents[i];
+		if (ent->client)
+			ent->client->ps.stats[STAT_HIT_MARKER] = savedMarkers[i];
+	}
+	G_EventListRebuild();
+
+	const double divisor = static_cast<double>(frames ? frames : 1);
+	gi.Com_PrintFmt("Event reset over {} frames, {} slots, {} with events:\n", frames, globals.numEntities, eventful.size());
+	gi.Com_PrintFmt("  full sweep  {:.4f} ms/frame\n", sweepMs / divisor);
+	gi.Com_PrintFmt("  event list  {:.4f} ms/frame\n", listMs / divisor);
+}
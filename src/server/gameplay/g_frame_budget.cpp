@@ -0,0 +1,248 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+g_frame_budget.cpp (Frame Budget Watchdog) Times every game frame against a budget and, when
+frames run long, holds back the work that does not affect simulation so physics, movement and
+hit registration keep their tick rate. Key Responsibilities: - Classification: each guarded
+subsystem is either optional (skipped outright under load) or deferrable (postponed; its caller
+keeps it pending and asks again next frame). - Hysteresis: the server only enters the degraded
+state after several consecutive overruns and only leaves it after a longer run of frames
+comfortably under budget. - Spreading: while degraded, only a few deferrable jobs run per frame;
+anything overdue by more than MAX_OVERDUE runs regardless so nothing starves. - Reporting:
+transitions are logged, and `sv framebudget` prints per-subsystem run/shed/defer counters.*/
+
+#include "../g_local.hpp"
+
+#include <array>
+#include <chrono>
+
+namespace {
+
+using clock = std::chrono::steady_clock;
+
+enum class FrameWorkClass : uint8_t {
+	Optional,	// skipped while degraded
+	Deferrable	// postponed while degraded, a few per frame
+};
+
+struct frame_work_info_t {
+	const char*		name;
+	FrameWorkClass	workClass;
+};
+
+constexpr size_t FRAME_WORK_COUNT = static_cast<size_t>(FrameWork::Total);
+
+constexpr std::array<frame_work_info_t, FRAME_WORK_COUNT> frameWorkInfo = { {
+	{ "botdebug",		FrameWorkClass::Optional },
+	{ "heatmap",		FrameWorkClass::Optional },
+	{ "screenshots",	FrameWorkClass::Deferrable },
+	{ "crosshairid",	FrameWorkClass::Deferrable },
+	{ "menus",			FrameWorkClass::Deferrable },
+	{ "scoreboards",	FrameWorkClass::Deferrable },
+	{ "matchreport",	FrameWorkClass::Deferrable },
+} };
+
+constexpr int32_t ENTER_OVERRUNS = 3;		// consecutive frames over budget before degrading
+constexpr int32_t LEAVE_UNDERRUNS = 30;		// consecutive frames under LEAVE_FRACTION before recovering
+constexpr double LEAVE_FRACTION = 0.75;
+constexpr int32_t DEFERRED_PER_FRAME = 2;
+constexpr GameTime MAX_OVERDUE = 250_ms;
+
+struct frame_work_stats_t {
+	uint64_t	runs = 0;
+	uint64_t	shed = 0;
+	uint64_t	deferred = 0;
+	uint64_t	forced = 0;
+};
+
+struct frame_budget_t {
+	clock::time_point	frameStart{};
+	bool				inFrame = false;
+	bool				degraded = false;
+	int32_t				overruns = 0;
+	int32_t				underruns = 0;
+	int32_t				deferredThisFrame = 0;
+	double				lastFrameMs = 0.0;
+	double				worstFrameMs = 0.0;
+	uint64_t			frames = 0;
+	uint64_t			overrunFrames = 0;
+	uint64_t			degradedFrames = 0;
+	uint64_t			degradedEntries = 0;
+	uint64_t			episodeShed = 0;	// shed + deferred since entering the degraded state
+	std::array<frame_work_stats_t, FRAME_WORK_COUNT> work{};
+};
+
+frame_budget_t budget;
+
+/*
+=============
+BudgetMs
+=============
+*/
+double BudgetMs() {
+	if (g_frame_budget_ms->value > 0.0f)
+		return g_frame_budget_ms->value;
+
+	return gi.frameTimeMs * 0.75;
+}
+
+/*
+=============
+ElapsedMs
+=============
+*/
+double ElapsedMs() {
+	return std::chrono::duration<double, std::milli>(clock::now() - budget.frameStart).count();
+}
+
+} // namespace
+
+/*
+=============
+G_FrameBudgetBeginFrame
+=============
+*/
+void G_FrameBudgetBeginFrame() {
+	budget.frameStart = clock::now();
+	budget.inFrame = true;
+	budget.deferredThisFrame = 0;
+}
+
+/*
+=============
+G_FrameBudgetEndFrame
+
+Feeds the frame time into the hysteresis and logs state changes.
+=============
+*/
+void G_FrameBudgetEndFrame() {
+	if (!budget.inFrame)
+		return;
+
+	const double elapsed = ElapsedMs();
+	const double limit = BudgetMs();
+
+	budget.inFrame = false;
+	budget.lastFrameMs = elapsed;
+	budget.worstFrameMs = std::max(budget.worstFrameMs, elapsed);
+	budget.frames++;
+
+	if (budget.degraded)
+		budget.degradedFrames++;
+
+	if (elapsed > limit) {
+		budget.overrunFrames++;
+		budget.overruns++;
+		budget.underruns = 0;
+	} else {
+		budget.overruns = 0;
+		if (elapsed < limit * LEAVE_FRACTION)
+			budget.underruns++;
+		else
+			budget.underruns = 0;
+	}
+
+	if (!g_frame_budget->integer) {
+		budget.degraded = false;
+		return;
+	}
+
+	if (!budget.degraded && budget.overruns >= ENTER_OVERRUNS) {
+		budget.degraded = true;
+		budget.degradedEntries++;
+		budget.episodeShed = 0;
+		gi.Com_PrintFmt("Frame budget: {} frames over {:.2f} ms (last {:.2f} ms), holding back non-critical work\n",
+			budget.overruns, limit, elapsed);
+	} else if (budget.degraded && budget.underruns >= LEAVE_UNDERRUNS) {
+		budget.degraded = false;
+		gi.Com_PrintFmt("Frame budget: recovered, {} jobs shed or deferred while degraded\n", budget.episodeShed);
+	}
+}
+
+/*
+=============
+G_FrameBudgetAllow
+
+Asks whether a guarded subsystem may run now. Optional work is skipped
+while degraded or once this frame is already over budget. Deferrable
+work is then limited to a few runs per frame, unless the caller reports
+it has been pending longer than MAX_OVERDUE. A denied caller must leave
+its work pending so it asks again next frame.
+=============
+*/
+bool G_FrameBudgetAllow(FrameWork work, GameTime overdue) {
+	frame_work_stats_t& stats = budget.work[static_cast<size_t>(work)];
+
+	if (!g_frame_budget->integer) {
+		stats.runs++;
+		return true;
+	}
+
+	const bool underLoad = budget.degraded || (budget.inFrame && ElapsedMs() > BudgetMs());
+
+	if (!underLoad) {
+		stats.runs++;
+		return true;
+	}
+
+	if (frameWorkInfo[static_cast<size_t>(work)].workClass == FrameWorkClass::Optional) {
+		stats.shed++;
+		budget.episodeShed++;
+		return false;
+	}
+
+	if (overdue >= MAX_OVERDUE) {
+		stats.forced++;
+		stats.runs++;
+		return true;
+	}
+
+	if (budget.deferredThisFrame < DEFERRED_PER_FRAME) {
+		budget.deferredThisFrame++;
+		stats.runs++;
+		return true;
+	}
+
+	stats.deferred++;
+	budget.episodeShed++;
+	return false;
+}
+
+/*
+=============
+G_FrameBudgetDegraded
+=============
+*/
+bool G_FrameBudgetDegraded() {
+	return budget.degraded;
+}
+
+/*
+=============
+G_FrameBudgetPrint
+
+sv framebudget [reset]
+=============
+*/
+void G_FrameBudgetPrint(bool reset) {
+	gi.Com_PrintFmt("Frame budget {:.2f} ms ({}), {}\n", BudgetMs(), g_frame_budget->integer ? "on" : "off",
+		budget.degraded ? "DEGRADED" : "normal");
+	gi.Com_PrintFmt("  frames {}, over budget {}, degraded {} ({} times), last {:.3f} ms, worst {:.3f} ms\n",
+		budget.frames, budget.overrunFrames, budget.degradedFrames, budget.degradedEntries,
+		budget.lastFrameMs, budget.worstFrameMs);
+	gi.Com_PrintFmt("  {:<12} {:>10} {:>8} {:>8} {:>8}\n", "work", "runs", "shed", "deferred", "forced");
+
+	for (size_t i = 0; i < FRAME_WORK_COUNT; i++) {
+		const frame_work_stats_t& stats = budget.work[i];
+
+		gi.Com_PrintFmt("  {:<12} {:>10} {:>8} {:>8} {:>8}\n", frameWorkInfo[i].name, stats.runs, stats.shed,
+			stats.deferred, stats.forced);
+	}
+
+	if (reset) {
+		const bool degraded = budget.degraded;
+
+		budget = {};
+		budget.degraded = degraded;
+	}
+}
@@ -1746,7 +1746,7 @@ static void door_use_areaportals(gentity_t* self, bool open) {
 		return;
 
 	while ((t = G_FindByString<&gentity_t::targetName>(t, self->target))) {
-		if (Q_strcasecmp(t->className, "func_areaportal") == 0) {
+		if (G_IsClass(t, EntityClass::FuncAreaportal)) {
 			gi.SetAreaPortalState(t->style, open);
 		}
 	}
@@ -1827,11 +1827,11 @@ THINK(door_go_down) (gentity_t* self) -> void {
 	}
 
 	self->moveInfo.state = MoveState::Down;
-	if (strcmp(self->className, "func_door") == 0 ||
-		strcmp(self->className, "func_water") == 0 ||
-		strcmp(self->className, "func_door_secret") == 0)
+	if (G_IsClass(self, EntityClass::FuncDoor) ||
+		G_IsClass(self, EntityClass::FuncWater) ||
+		G_IsClass(self, EntityClass::FuncDoorSecret))
 		Move_Calc(self, self->moveInfo.startOrigin, door_hit_bottom);
-	else if (strcmp(self->className, "func_door_rotating") == 0)
+	else if (G_IsClass(self, EntityClass::FuncDoorRotating))
 		AngleMove_Calc(self, door_hit_bottom);
 
 	if (self->spawnFlags.has(SPAWNFLAG_DOOR_START_OPEN))
@@ -1856,11 +1856,11 @@ static void door_go_up(gentity_t* self, gentity_t* activator) {
 	self->s.sound = self->moveInfo.sound_middle;
 
 	self->moveInfo.state = MoveState::Up;
-	if (strcmp(self->className, "func_door") == 0 ||
-		strcmp(self->className, "func_water") == 0 ||
-		strcmp(self->className, "func_door_secret") == 0)
+	if (G_IsClass(self, EntityClass::FuncDoor) ||
+		G_IsClass(self, EntityClass::FuncWater) ||
+		G_IsClass(self, EntityClass::FuncDoorSecret))
 		Move_Calc(self, self->moveInfo.endOrigin, door_hit_top);
-	else if (strcmp(self->className, "func_door_rotating") == 0)
+	else if (G_IsClass(self, EntityClass::FuncDoorRotating))
 		AngleMove_Calc(self, door_hit_top);
 
 	UseTargets(self, activator);
@@ -1950,7 +1950,7 @@ static USE(door_use) (gentity_t* self, gentity_t* other, gentity_t* activator) -
 	if (self->flags & FL_TEAMSLAVE)
 		return;
 
-	if ((strcmp(self->className, "func_door_rotating") == 0) && self->spawnFlags.has(SPAWNFLAG_DOOR_ROTATING_SAFE_OPEN) &&
+	if (G_IsClass(self, EntityClass::FuncDoorRotating) && self->spawnFlags.has(SPAWNFLAG_DOOR_ROTATING_SAFE_OPEN) &&
 		(self->moveInfo.state == MoveState::Bottom || self->moveInfo.state == MoveState::Down)) {
 		if (self->moveInfo.dir) {
 			Vector3 forward = (activator->s.origin - self->s.origin).normalized();
@@ -1973,7 +1973,7 @@ static USE(door_use) (gentity_t* self, gentity_t* other, gentity_t* activator) -
 	//  smart water is different
 	center = self->mins + self->maxs;
 	center *= 0.5f;
-	if ((strcmp(self->className, "func_water") == 0) && (gi.pointContents(center) & MASK_WATER) && self->spawnFlags.has(SPAWNFLAG_WATER_SMART)) {
+	if (G_IsClass(self, EntityClass::FuncWater) && (gi.pointContents(center) & MASK_WATER) && self->spawnFlags.has(SPAWNFLAG_WATER_SMART)) {
 		self->message = nullptr;
 		self->touch = nullptr;
 		self->enemy = activator;
@@ -2734,7 +2734,7 @@ again:
 		}
 
 		self->s.oldOrigin = self->s.origin;
-		self->s.event = EV_OTHER_TELEPORT;
+		G_SetEvent(self, EV_OTHER_TELEPORT);
 		gi.linkEntity(self);
 		goto again;
 	}
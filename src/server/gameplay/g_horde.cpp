@@ -306,17 +306,43 @@ void Horde_RunSpawning() {
 	}
 }
 
-static bool Horde_AllMonstersDead() {
-	for (size_t i = 0; i < globals.maxEntities; i++) {
-		if (!g_entities[i].inUse) {
+/*
+=============
+Horde_PopulateMonsters
+
+Tops the live monster count up to the requested total using the normal
+wave picker, for load testing (sv aibench). Returns the live count.
+=============
+*/
+size_t Horde_PopulateMonsters(size_t count) {
+	size_t alive = G_RegistryAliveCount(EntityRegistry::Monster);
+
+	for (size_t attempts = 0; alive < count && attempts < count * 2; attempts++) {
+		const char* className = Horde_PickMonster();
+		const select_spawn_result_t result = SelectDeathmatchSpawnPoint(nullptr, vec3_origin, false, true, false, false);
+
+		if (!className || !result.spot)
 			continue;
-		}
-		if (g_entities[i].svFlags & SVF_MONSTER) {
-			if (!g_entities[i].deadFlag && g_entities[i].health > 0) {
-				return false;
-			}
-		}
+
+		gentity_t* e = Spawn();
+		e->className = className;
+		e->s.origin = result.spot->s.origin;
+		e->s.angles = result.spot->s.angles;
+		ED_CallSpawn(e);
+
+		if (!e->inUse)
+			continue;
+
+		e->enemy = FindClosestPlayerToPoint(e->s.origin);
+		if (e->enemy)
+			FoundTarget(e);
+
+		alive++;
 	}
 
-	return true;
+	return alive;
+}
+
+static bool Horde_AllMonstersDead() {
+	return G_RegistryAliveCount(EntityRegistry::Monster) == 0;
 }
@@ -0,0 +1,236 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+g_item_index.cpp (Item Name Index) Case-insensitive lookup of items by the names players, maps
+and bots refer to them by. Key Responsibilities: - Tables: one open-addressing table each for
+className, use name and weapon abbreviation, built from `itemList` on first use; slots hold the
+name's folded hash and item id, so a probe only compares strings on a hash match. - Lookup:
+`FindItemByClassname`, `FindItem` and `FindItemByAbbreviation` return the first item in list
+order with that name, as the linear scans they replace did. - Weapons: `WeaponItemID` maps a
+weapon preference slot to the item that provides it.*/
+
+#include "../g_local.hpp"
+
+namespace {
+
+constexpr size_t ITEM_INDEX_SLOTS = 512;	// must be a power of two
+static_assert(ITEM_INDEX_SLOTS >= static_cast<size_t>(IT_TOTAL) * 2, "item index should stay under half full");
+
+enum class ItemKey : uint8_t {
+	ClassName,
+	UseName,
+	Abbreviation,
+	Total
+};
+
+struct item_index_slot_t {
+	uint32_t	hash = 0;
+	item_id_t	id = IT_NULL;	// IT_NULL marks an empty slot
+};
+
+using item_index_table_t = std::array<item_index_slot_t, ITEM_INDEX_SLOTS>;
+
+/*
+=============
+FoldASCII
+=============
+*/
+inline char FoldASCII(char c) {
+	return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+/*
+=============
+HashName
+
+FNV-1a over the case-folded name.
+=============
+*/
+inline uint32_t HashName(std::string_view name) {
+	uint32_t hash = 2166136261u;
+
+	for (char c : name) {
+		hash ^= static_cast<uint8_t>(FoldASCII(c));
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+/*
+=============
+NamesEqual
+=============
+*/
+inline bool NamesEqual(std::string_view a, std::string_view b) {
+	if (a.size() != b.size())
+		return false;
+
+	for (size_t i = 0; i < a.size(); i++) {
+		if (FoldASCII(a[i]) != FoldASCII(b[i]))
+			return false;
+	}
+
+	return true;
+}
+
+/*
+=============
+ItemKeyName
+
+The name an item is filed under for a key, or empty if it has none.
+=============
+*/
+std::string_view ItemKeyName(const Item& item, ItemKey key) {
+	switch (key) {
+	case ItemKey::ClassName:
+		return item.className ? item.className : std::string_view{};
+	case ItemKey::UseName:
+		return item.useName ? item.useName : std::string_view{};
+	case ItemKey::Abbreviation:
+		for (size_t i = static_cast<size_t>(Weapon::None) + 1; i < weaponAbbreviations.size(); i++) {
+			if (WeaponItemID(static_cast<Weapon>(i)) == item.id)
+				return weaponAbbreviations[i];
+		}
+		return {};
+	default:
+		return {};
+	}
+}
+
+/*
+=============
+Insert
+
+Files an item under a name unless an earlier item already has it.
+=============
+*/
+void Insert(item_index_table_t& table, const Item& item, ItemKey key) {
+	const std::string_view name = ItemKeyName(item, key);
+	if (name.empty())
+		return;
+
+	const uint32_t hash = HashName(name);
+
+	for (size_t probe = 0, slot = hash & (ITEM_INDEX_SLOTS - 1); probe < ITEM_INDEX_SLOTS; probe++, slot = (slot + 1) & (ITEM_INDEX_SLOTS - 1)) {
+		item_index_slot_t& entry = table[slot];
+
+		if (entry.id == IT_NULL) {
+			entry.hash = hash;
+			entry.id = item.id;
+			return;
+		}
+
+		if (entry.hash == hash && NamesEqual(ItemKeyName(itemList[entry.id], key), name))
+			return;
+	}
+}
+
+/*
+=============
+ItemIndex
+=============
+*/
+const std::array<item_index_table_t, static_cast<size_t>(ItemKey::Total)>& ItemIndex() {
+	static const std::array<item_index_table_t, static_cast<size_t>(ItemKey::Total)> tables = [] {
+		std::array<item_index_table_t, static_cast<size_t>(ItemKey::Total)> built{};
+
+		for (size_t key = 0; key < built.size(); key++) {
+			for (size_t i = static_cast<size_t>(IT_NULL) + 1; i < itemList.size(); i++)
+				Insert(built[key], itemList[i], static_cast<ItemKey>(key));
+		}
+
+		return built;
+	}();
+
+	return tables;
+}
+
+/*
+=============
+Lookup
+=============
+*/
+Item* Lookup(ItemKey key, std::string_view name) {
+	if (name.empty())
+		return nullptr;
+
+	const item_index_table_t& table = ItemIndex()[static_cast<size_t>(key)];
+	const uint32_t hash = HashName(name);
+
+	for (size_t probe = 0, slot = hash & (ITEM_INDEX_SLOTS - 1); probe < ITEM_INDEX_SLOTS; probe++, slot = (slot + 1) & (ITEM_INDEX_SLOTS - 1)) {
+		const item_index_slot_t& entry = table[slot];
+
+		if (entry.id == IT_NULL)
+			return nullptr;
+
+		if (entry.hash == hash && NamesEqual(ItemKeyName(itemList[entry.id], key), name))
+			return &itemList[entry.id];
+	}
+
+	return nullptr;
+}
+
+} // namespace
+
+/*
+=============
+WeaponItemID
+=============
+*/
+item_id_t WeaponItemID(Weapon weapon) {
+	switch (weapon) {
+		using enum Weapon;
+	case Blaster:			return IT_WEAPON_BLASTER;
+	case Chainfist:			return IT_WEAPON_CHAINFIST;
+	case Shotgun:			return IT_WEAPON_SHOTGUN;
+	case SuperShotgun:		return IT_WEAPON_SSHOTGUN;
+	case Machinegun:		return IT_WEAPON_MACHINEGUN;
+	case ETFRifle:			return IT_WEAPON_ETF_RIFLE;
+	case Chaingun:			return IT_WEAPON_CHAINGUN;
+	case HandGrenades:		return IT_AMMO_GRENADES;
+	case Trap:				return IT_AMMO_TRAP;
+	case TeslaMine:			return IT_AMMO_TESLA;
+	case GrenadeLauncher:	return IT_WEAPON_GLAUNCHER;
+	case ProxLauncher:		return IT_WEAPON_PROXLAUNCHER;
+	case RocketLauncher:	return IT_WEAPON_RLAUNCHER;
+	case HyperBlaster:		return IT_WEAPON_HYPERBLASTER;
+	case IonRipper:			return IT_WEAPON_IONRIPPER;
+	case PlasmaBeam:		return IT_WEAPON_PLASMABEAM;
+	case Thunderbolt:		return IT_WEAPON_THUNDERBOLT;
+	case Railgun:			return IT_WEAPON_RAILGUN;
+	case Phalanx:			return IT_WEAPON_PHALANX;
+	case BFG10K:			return IT_WEAPON_BFG;
+	case Disruptor:			return IT_WEAPON_DISRUPTOR;
+	default:				return IT_NULL;
+	}
+}
+
+/*
+===============
+FindItemByClassname
+===============
+*/
+Item* FindItemByClassname(const char* className) {
+	return className ? Lookup(ItemKey::ClassName, className) : nullptr;
+}
+
+/*
+===============
+FindItem
+===============
+*/
+Item* FindItem(const char* pickupName) {
+	return pickupName ? Lookup(ItemKey::UseName, pickupName) : nullptr;
+}
+
+/*
+===============
+FindItemByAbbreviation
+
+Finds the weapon item for a preference abbreviation such as "RL".
+===============
+*/
+Item* FindItemByAbbreviation(std::string_view abbr) {
+	return Lookup(ItemKey::Abbreviation, abbr);
+}
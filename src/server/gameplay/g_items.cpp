@@ -173,7 +173,7 @@ static TOUCH(drop_temp_touch) (gentity_t* ent, gentity_t* other, const trace_t&
 static THINK(drop_make_touchable) (gentity_t* ent) -> void {
 	ent->touch = Touch_Item;
 	if (deathmatch->integer) {
-		if (!strcmp(ent->className, "ammo_pack"))
+		if (G_IsClass(ent, EntityClass::AmmoPack))
 			ent->nextThink = level.time + 119_sec;
 		else
 			ent->nextThink = level.time + 29_sec;
@@ -295,8 +295,8 @@ static void HighValuePickupCounter(gentity_t* ent, gentity_t* other) {
 	const GameTime delay = level.time - ent->timeStamp;
 
 	// Per-client stats
-	other->client->pers.match.pickupCounts[index]++;
-	other->client->pers.match.pickupDelay[index] += delay;
+	other->client->MatchStats().pickupCounts()[index]++;
+	other->client->MatchStats().pickupDelay()[index] += delay;
 
 	// Global match stats
 	level.match.pickupCounts[index]++;
@@ -607,7 +607,7 @@ static void sphere_touch(gentity_t* self, gentity_t* other, const trace_t& tr, M
 		if (other == self->owner)
 			return;
 		// PMM - don't blow up on bodies
-		if (!strcmp(other->className, "bodyque"))
+		if (G_IsClass(other, EntityClass::BodyQue))
 			return;
 	}
 
@@ -1652,40 +1652,6 @@ Item* GetItemByPowerup(powerup_t powerup) {
 	return powerupList[powerup];
 }
 
-/*
-===============
-FindItemByClassname
-
-===============
-*/
-Item* FindItemByClassname(const char* className) {
-	for (auto& item : itemList) {
-		if (!item.className)
-			continue;
-		if (!Q_strcasecmp(item.className, className))
-			return &item;
-	}
-
-	return nullptr;
-}
-
-/*
-===============
-FindItem
-
-===============
-*/
-Item* FindItem(const char* pickupName) {
-	for (auto& item : itemList) {
-		if (!item.useName)
-			continue;
-		if (!Q_strcasecmp(item.useName, pickupName))
-			return &item;
-	}
-
-	return nullptr;
-}
-
 //======================================================================
 
 static inline item_flags_t GetSubstituteItemFlags(item_id_t id) {
@@ -1903,7 +1869,7 @@ THINK(RespawnItem)(gentity_t* ent) -> void {
 
 	// Trigger visual effect unless match just began
 	if (level.time > level.levelStartTime + 100_ms)
-		ent->s.event = EV_ITEM_RESPAWN;
+		G_SetEvent(ent, EV_ITEM_RESPAWN);
 
 	// Random item respawn handling
 	if (g_dm_random_items->integer) {
@@ -1967,7 +1933,7 @@ void SetRespawn(gentity_t* ent, GameTime delay, bool hide_self) {
 void Use_Teleporter(gentity_t* ent, Item* item) {
 	gentity_t* fx = Spawn();
 	fx->className = "telefx";
-	fx->s.event = EV_PLAYER_TELEPORT;
+	G_SetEvent(fx, EV_PLAYER_TELEPORT);
 	fx->s.origin = ent->s.origin;
 	fx->s.origin[_Z] += 1.0f;
 	fx->s.angles = ent->s.angles;
@@ -4380,7 +4346,7 @@ void Use_Compass(gentity_t* ent, Item* inv) {
 	Vector3*& points = level.poi.points[ent->s.number - 1];
 	if (!points) {
 		points = static_cast<Vector3*>(
-			gi.TagMalloc(sizeof(Vector3) * (MAX_TEMP_POI_POINTS + 1), TAG_LEVEL));
+			G_LevelAlloc(sizeof(Vector3) * (MAX_TEMP_POI_POINTS + 1), LevelMem::PoiPaths, alignof(Vector3)));
 	}
 
 	// Build path request
@@ -0,0 +1,458 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+g_jobs.hpp (Game Job System) A small work-stealing thread pool for per-frame passes whose
+items do not touch each other. Key Responsibilities: - ParallelFor: fork-join over an index
+range split into grains; each thread owns a deque and idle threads steal from the others. -
+JobGraph: tasks with dependencies, released as their prerequisites complete. -
+JobCommandBuffer: per-task queues of deferred side effects, flushed on the calling thread in
+task order so engine imports are only ever called from the main thread. - Deterministic
+mode: every task runs inline on the calling thread in index order. Because command buffers
+are always flushed in task order, results do not depend on the worker count.*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+===============
+JobCommandBuffer
+
+Records work that must not run on a worker (anything calling into the
+engine) so the owner can replay it once the parallel section has joined.
+===============
+*/
+class JobCommandBuffer {
+public:
+	template<typename Fn>
+	void Defer(Fn&& fn) {
+		commands_.emplace_back(std::forward<Fn>(fn));
+	}
+
+	void Flush() {
+		for (auto& command : commands_)
+			command();
+		commands_.clear();
+	}
+
+	[[nodiscard]] bool Empty() const { return commands_.empty(); }
+	[[nodiscard]] size_t Size() const { return commands_.size(); }
+
+private:
+	std::vector<std::function<void()>> commands_;
+};
+
+/*
+===============
+JobGraph
+
+A set of tasks and "runs before" edges. Task ids are insertion indices;
+deterministic execution runs ready tasks lowest id first.
+===============
+*/
+class JobGraph {
+public:
+	using TaskId = size_t;
+	using TaskFn = std::function<void(JobCommandBuffer&)>;
+
+	TaskId Add(TaskFn fn) {
+		nodes_.emplace_back();
+		nodes_.back().fn = std::move(fn);
+		return nodes_.size() - 1;
+	}
+
+	// 'after' will not start until 'before' has finished
+	void Precede(TaskId before, TaskId after) {
+		nodes_[before].successors.push_back(after);
+		nodes_[after].predecessorCount++;
+	}
+
+	void Clear() { nodes_.clear(); }
+	[[nodiscard]] size_t Size() const { return nodes_.size(); }
+
+private:
+	friend class JobSystem;
+
+	struct Node {
+		TaskFn					fn;
+		std::vector<TaskId>		successors;
+		size_t					predecessorCount = 0;
+		std::atomic<size_t>		remaining{ 0 };
+		JobCommandBuffer		commands;
+	};
+
+	std::deque<Node> nodes_;	// deque: nodes hold atomics and must never move
+};
+
+/*
+===============
+JobSystem
+===============
+*/
+class JobSystem {
+public:
+	struct Stats {
+		uint64_t	jobsRun = 0;
+		uint64_t	jobsStolen = 0;
+	};
+
+	JobSystem() = default;
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+	~JobSystem() { Stop(); }
+
+	/*
+	===============
+	Start
+
+	Spawns workerCount threads. Zero workers is valid: everything then
+	runs on the calling thread.
+	===============
+	*/
+	void Start(size_t workerCount) {
+		Stop();
+
+		stopping_.store(false);
+		// one deque per worker plus one for threads outside the pool
+		queues_.clear();
+		for (size_t i = 0; i < workerCount + 1; i++)
+			queues_.push_back(std::make_unique<Queue>());
+
+		workers_.reserve(workerCount);
+		for (size_t i = 0; i < workerCount; i++)
+			workers_.emplace_back([this, i]() { WorkerMain(i); });
+	}
+
+	/*
+	===============
+	Stop
+	===============
+	*/
+	void Stop() {
+		if (workers_.empty())
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(sleepLock_);
+			stopping_.store(true);
+		}
+		wake_.notify_all();
+
+		for (auto& worker : workers_)
+			worker.join();
+
+		workers_.clear();
+		queues_.clear();
+		queued_.store(0);
+	}
+
+	[[nodiscard]] size_t WorkerCount() const { return workers_.size(); }
+
+	void SetDeterministic(bool deterministic) { deterministic_ = deterministic; }
+	[[nodiscard]] bool Deterministic() const { return deterministic_; }
+
+	// true when tasks will run inline, in index order, on the calling thread
+	[[nodiscard]] bool RunsInline() const { return deterministic_ || workers_.empty(); }
+
+	[[nodiscard]] Stats GetStats() const {
+		return { jobsRun_.load(std::memory_order_relaxed), jobsStolen_.load(std::memory_order_relaxed) };
+	}
+
+	/*
+	===============
+	ParallelFor
+
+	Calls fn(begin, end, rangeIndex) for consecutive ranges of at most
+	'grain' indices covering [0, count) and returns once all have run.
+	The calling thread works on the ranges too.
+	===============
+	*/
+	template<typename Fn>
+	void ParallelFor(size_t count, size_t grain, Fn&& fn) {
+		if (!count)
+			return;
+
+		grain = std::max<size_t>(grain, 1);
+		const size_t ranges = (count + grain - 1) / grain;
+
+		if (ranges == 1 || RunsInline()) {
+			for (size_t r = 0; r < ranges; r++)
+				fn(r * grain, std::min(count, (r + 1) * grain), r);
+			return;
+		}
+
+		auto call = [&fn](size_t begin, size_t end, size_t index) { fn(begin, end, index); };
+		using Call = decltype(call);
+
+		std::atomic<size_t> pending{ ranges };
+		const size_t home = HomeQueue();
+
+		for (size_t r = 0; r < ranges; r++) {
+			Job job;
+			job.invoke = [](void* context, size_t begin, size_t end, size_t index) {
+				(*static_cast<Call*>(context))(begin, end, index);
+			};
+			job.context = &call;
+			job.begin = r * grain;
+			job.end = std::min(count, (r + 1) * grain);
+			job.index = r;
+			job.pending = &pending;
+			// deal ranges round-robin, starting with our own deque
+			Push((home + r) % queues_.size(), job);
+		}
+
+		Wait(pending);
+	}
+
+	/*
+	===============
+	ParallelForDeferred
+
+	ParallelFor where each range gets its own command buffer; buffers are
+	flushed on the calling thread in range order after the join.
+	===============
+	*/
+	template<typename Fn>
+	void ParallelForDeferred(size_t count, size_t grain, Fn&& fn) {
+		if (!count)
+			return;
+
+		grain = std::max<size_t>(grain, 1);
+		std::vector<JobCommandBuffer> commands((count + grain - 1) / grain);
+
+		ParallelFor(count, grain, [&](size_t begin, size_t end, size_t index) {
+			fn(begin, end, commands[index]);
+		});
+
+		for (auto& buffer : commands)
+			buffer.Flush();
+	}
+
+	/*
+	===============
+	Run
+
+	Executes every task of the graph, respecting dependencies, then
+	flushes the tasks' command buffers in task id order. Returns false
+	without running anything if the graph contains a cycle.
+	===============
+	*/
+	bool Run(JobGraph& graph) {
+		const size_t count = graph.nodes_.size();
+		if (!count)
+			return true;
+
+		// Kahn's algorithm, lowest ready id first; doubles as cycle detection
+		// and as the execution order for deterministic runs
+		std::vector<size_t> indegree(count);
+		std::vector<JobGraph::TaskId> order;
+		order.reserve(count);
+		for (size_t i = 0; i < count; i++)
+			indegree[i] = graph.nodes_[i].predecessorCount;
+
+		std::vector<JobGraph::TaskId> ready;
+		for (size_t i = count; i-- > 0;)
+			if (!indegree[i])
+				ready.push_back(i);
+
+		while (!ready.empty()) {
+			auto lowest = std::min_element(ready.begin(), ready.end());
+			const JobGraph::TaskId id = *lowest;
+			ready.erase(lowest);
+			order.push_back(id);
+
+			for (JobGraph::TaskId next : graph.nodes_[id].successors)
+				if (!--indegree[next])
+					ready.push_back(next);
+		}
+
+		if (order.size() != count)
+			return false;
+
+		if (RunsInline()) {
+			for (JobGraph::TaskId id : order)
+				graph.nodes_[id].fn(graph.nodes_[id].commands);
+		}
+		else {
+			GraphRun run{ this, &graph, { count } };
+
+			for (auto& node : graph.nodes_)
+				node.remaining.store(node.predecessorCount, std::memory_order_relaxed);
+
+			const size_t home = HomeQueue();
+			for (size_t i = 0; i < count; i++)
+				if (!graph.nodes_[i].predecessorCount)
+					Push(home, MakeGraphJob(run, i));
+
+			Wait(run.pending);
+		}
+
+		for (auto& node : graph.nodes_)
+			node.commands.Flush();
+
+		return true;
+	}
+
+private:
+	struct Job {
+		void				(*invoke)(void* context, size_t begin, size_t end, size_t index) = nullptr;
+		void*				context = nullptr;
+		size_t				begin = 0;
+		size_t				end = 0;
+		size_t				index = 0;
+		std::atomic<size_t>* pending = nullptr;
+	};
+
+	struct Queue {
+		std::mutex			lock;
+		std::deque<Job>		jobs;
+	};
+
+	struct GraphRun {
+		JobSystem*			system;
+		JobGraph*			graph;
+		std::atomic<size_t>	pending;
+	};
+
+	static Job MakeGraphJob(GraphRun& run, size_t id) {
+		Job job;
+		job.invoke = [](void* context, size_t, size_t, size_t index) {
+			GraphRun& run = *static_cast<GraphRun*>(context);
+			JobGraph::Node& node = run.graph->nodes_[index];
+
+			node.fn(node.commands);
+
+			// release successors before this job counts as done so the
+			// waiter can never observe zero while work is still unqueued
+			const size_t home = run.system->HomeQueue();
+			for (JobGraph::TaskId next : node.successors)
+				if (run.graph->nodes_[next].remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+					run.system->Push(home, MakeGraphJob(run, next));
+		};
+		job.context = &run;
+		job.index = id;
+		job.pending = &run.pending;
+		return job;
+	}
+
+	// deque owned by the current thread; threads outside the pool share the last one
+	size_t HomeQueue() const {
+		return (threadOwner_ == this) ? threadQueue_ : queues_.size() - 1;
+	}
+
+	void Push(size_t queue, const Job& job) {
+		{
+			std::lock_guard<std::mutex> lock(queues_[queue]->lock);
+			queues_[queue]->jobs.push_back(job);
+		}
+		queued_.fetch_add(1, std::memory_order_release);
+
+		// taking the lock orders this against a worker about to sleep
+		{
+			std::lock_guard<std::mutex> lock(sleepLock_);
+		}
+		wake_.notify_one();
+	}
+
+	// own deque is LIFO for locality, stealing takes the oldest job
+	bool TryTake(size_t home, Job& job) {
+		if (!queued_.load(std::memory_order_acquire))
+			return false;
+
+		const size_t count = queues_.size();
+		for (size_t i = 0; i < count; i++) {
+			Queue& queue = *queues_[(home + i) % count];
+			std::lock_guard<std::mutex> lock(queue.lock);
+
+			if (queue.jobs.empty())
+				continue;
+
+			if (i == 0) {
+				job = queue.jobs.back();
+				queue.jobs.pop_back();
+			}
+			else {
+				job = queue.jobs.front();
+				queue.jobs.pop_front();
+				jobsStolen_.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			queued_.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		return false;
+	}
+
+	void Execute(const Job& job) {
+		job.invoke(job.context, job.begin, job.end, job.index);
+		jobsRun_.fetch_add(1, std::memory_order_relaxed);
+		job.pending->fetch_sub(1, std::memory_order_acq_rel);
+	}
+
+	// help out until every job counted by 'pending' has finished
+	void Wait(std::atomic<size_t>& pending) {
+		const size_t home = HomeQueue();
+		Job job;
+
+		while (pending.load(std::memory_order_acquire)) {
+			if (TryTake(home, job))
+				Execute(job);
+			else
+				std::this_thread::yield();
+		}
+	}
+
+	void WorkerMain(size_t index) {
+		threadOwner_ = this;
+		threadQueue_ = index;
+
+		Job job;
+		while (!stopping_.load(std::memory_order_acquire)) {
+			if (TryTake(index, job)) {
+				Execute(job);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(sleepLock_);
+			wake_.wait(lock, [this]() {
+				return stopping_.load(std::memory_order_acquire) || queued_.load(std::memory_order_acquire) != 0;
+			});
+		}
+
+		threadOwner_ = nullptr;
+	}
+
+	std::vector<std::thread>			workers_;
+	std::vector<std::unique_ptr<Queue>>	queues_{};
+	std::mutex							sleepLock_;
+	std::condition_variable				wake_;
+	std::atomic<size_t>					queued_{ 0 };
+	std::atomic<bool>					stopping_{ false };
+	std::atomic<uint64_t>				jobsRun_{ 0 };
+	std::atomic<uint64_t>				jobsStolen_{ 0 };
+	bool								deterministic_ = false;
+
+	static inline thread_local const JobSystem* threadOwner_ = nullptr;
+	static inline thread_local size_t threadQueue_ = 0;
+};
+
+/*
+===============
+G_Jobs
+
+The game module's pool, sized by g_jobs_workers (g_main.cpp).
+===============
+*/
+JobSystem& G_Jobs();
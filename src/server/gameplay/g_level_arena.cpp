@@ -0,0 +1,265 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+g_level_arena.cpp (Level Memory Arena) Bump allocator and accounting for level-lifetime
+memory. Key Responsibilities: - Arena: `G_LevelAlloc` carves zeroed blocks out of TAG_LEVEL
+chunks; nothing is freed individually, the chunks go with the engine's `FreeTags(TAG_LEVEL)`
+and `G_LevelArenaReset` must follow every such call. - Accounting: every allocation and every
+`LevelAllocator` container is charged to a `LevelMem` owner, with live and peak bytes. -
+Reporting: a line per map load (spawn time, arena use, peak RSS) and the `sv memstats`
+report.*/
+
+#include "../g_local.hpp"
+
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+constexpr size_t LEVEL_CHUNK_SIZE = 64 * 1024;
+constexpr size_t LEVEL_LARGE_ALLOC = LEVEL_CHUNK_SIZE / 4;
+constexpr size_t MAP_HISTORY = 8;
+
+struct level_mem_info_t {
+	const char*	name;
+	bool		arena;		// freed with the level rather than tracked per container
+};
+
+constexpr std::array<level_mem_info_t, static_cast<size_t>(LevelMem::Total)> levelMemInfo{ {
+	{ "strings",		true },
+	{ "spawn state",	true },
+	{ "reinforcements",	true },
+	{ "poi paths",		true },
+	{ "spawn lists",	false },
+	{ "match log",		false },
+	{ "world snapshot",	false },
+} };
+
+struct level_mem_stats_t {
+	size_t		allocations = 0;
+	size_t		liveBytes = 0;
+	size_t		peakBytes = 0;
+};
+
+struct map_load_t {
+	std::array<char, MAX_QPATH> mapName{};
+	double		spawnMs = 0.0;
+	size_t		arenaBytes = 0;
+	size_t		peakResidentKB = 0;
+};
+
+struct level_arena_t {
+	char*		chunk = nullptr;
+	size_t		chunkUsed = 0;
+	size_t		chunkSize = 0;
+
+	size_t		chunks = 0;
+	size_t		reservedBytes = 0;
+	size_t		usedBytes = 0;
+	size_t		peakReservedBytes = 0;
+
+	std::array<level_mem_stats_t, static_cast<size_t>(LevelMem::Total)> owners{};
+
+	std::array<map_load_t, MAP_HISTORY> maps{};
+	size_t		mapLoads = 0;
+};
+
+level_arena_t arena;
+
+/*
+=============
+Charge
+=============
+*/
+void Charge(LevelMem owner, size_t bytes) {
+	level_mem_stats_t& stats = arena.owners[static_cast<size_t>(owner)];
+
+	stats.allocations++;
+	stats.liveBytes += bytes;
+	stats.peakBytes = std::max(stats.peakBytes, stats.liveBytes);
+}
+
+/*
+=============
+Reserve
+
+Takes a fresh block from the engine and accounts for it.
+=============
+*/
+char* Reserve(size_t size) {
+	char* block = static_cast<char*>(gi.TagMalloc(size, TAG_LEVEL));
+
+	arena.chunks++;
+	arena.reservedBytes += size;
+	arena.peakReservedBytes = std::max(arena.peakReservedBytes, arena.reservedBytes);
+	return block;
+}
+
+/*
+=============
+PeakResidentKB
+
+The process's peak resident set so far, or 0 where it cannot be read.
+=============
+*/
+size_t PeakResidentKB() {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters{};
+	if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return counters.PeakWorkingSetSize / 1024;
+	return 0;
+#else
+	rusage usage{};
+	if (getrusage(RUSAGE_SELF, &usage))
+		return 0;
+#ifdef __APPLE__
+	return static_cast<size_t>(usage.ru_maxrss) / 1024;
+#else
+	return static_cast<size_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+} // namespace
+
+/*
+=============
+G_LevelAlloc
+
+Returns zeroed level-lifetime memory charged to owner. Blocks are never
+freed individually; keep anything that is TagFree'd on gi.TagMalloc.
+=============
+*/
+void* G_LevelAlloc(size_t size, LevelMem owner, size_t align) {
+	if (!size)
+		size = 1;
+
+	char* out;
+
+	if (size > LEVEL_LARGE_ALLOC) {
+		out = Reserve(size);
+		arena.usedBytes += size;
+	} else {
+		size_t offset = (arena.chunkUsed + align - 1) & ~(align - 1);
+
+		if (!arena.chunk || offset + size > arena.chunkSize) {
+			arena.chunk = Reserve(LEVEL_CHUNK_SIZE);
+			arena.chunkUsed = 0;
+			arena.chunkSize = LEVEL_CHUNK_SIZE;
+			offset = 0;
+		}
+
+		out = arena.chunk + offset;
+		arena.usedBytes += offset + size - arena.chunkUsed;
+		arena.chunkUsed = offset + size;
+	}
+
+	std::memset(out, 0, size);
+	Charge(owner, size);
+	return out;
+}
+
+/*
+=============
+G_LevelMemTrack
+
+Charges (bytes > 0) or credits (bytes < 0) container storage that lives on
+the heap rather than in the arena.
+=============
+*/
+void G_LevelMemTrack(LevelMem owner, ptrdiff_t bytes) {
+	level_mem_stats_t& stats = arena.owners[static_cast<size_t>(owner)];
+
+	if (bytes >= 0) {
+		Charge(owner, static_cast<size_t>(bytes));
+		return;
+	}
+
+	stats.liveBytes -= std::min(stats.liveBytes, static_cast<size_t>(-bytes));
+}
+
+/*
+=============
+G_LevelArenaReset
+
+Forgets the arena's chunks and everything stored in or pointing into them,
+including the string arena and the world snapshot; call right after
+gi.FreeTags(TAG_LEVEL) has released them.
+Peaks and the map load history carry over.
+=============
+*/
+void G_LevelArenaReset() {
+	arena.chunk = nullptr;
+	arena.chunkUsed = 0;
+	arena.chunkSize = 0;
+	arena.chunks = 0;
+	arena.reservedBytes = 0;
+	arena.usedBytes = 0;
+
+	for (size_t i = 0; i < arena.owners.size(); i++) {
+		if (levelMemInfo[i].arena)
+			arena.owners[i].liveBytes = 0;
+	}
+
+	G_StringArenaReset();
+	G_WorldSnapshotClear();
+}
+
+/*
+=============
+G_LevelArenaMapLoaded
+
+Records a finished map load and prints its memory summary.
+=============
+*/
+void G_LevelArenaMapLoaded(const char* mapName, double spawnMs) {
+	map_load_t& load = arena.maps[arena.mapLoads++ % MAP_HISTORY];
+
+	Q_strlcpy(load.mapName.data(), mapName ? mapName : "", load.mapName.size());
+	load.spawnMs = spawnMs;
+	load.arenaBytes = arena.usedBytes;
+	load.peakResidentKB = PeakResidentKB();
+
+	gi.Com_PrintFmt("Level memory: {} bytes used in {} blocks ({} reserved), spawned in {:.1f} ms, peak RSS {} KB\n",
+		arena.usedBytes, arena.chunks, arena.reservedBytes, spawnMs, load.peakResidentKB);
+}
+
+/*
+=============
+G_LevelArenaPrint
+
+The sv memstats report.
+=============
+*/
+void G_LevelArenaPrint() {
+	gi.Com_PrintFmt("Level arena: {} bytes used, {} reserved in {} blocks, peak {} reserved\n",
+		arena.usedBytes, arena.reservedBytes, arena.chunks, arena.peakReservedBytes);
+
+	gi.Com_Print("owner            allocs        live        peak\n");
+	for (size_t i = 0; i < arena.owners.size(); i++) {
+		const level_mem_stats_t& stats = arena.owners[i];
+		gi.Com_PrintFmt("{:<14} {:>8} {:>11} {:>11}{}\n", levelMemInfo[i].name,
+			stats.allocations, stats.liveBytes, stats.peakBytes, levelMemInfo[i].arena ? "" : " (heap)");
+	}
+
+	G_StringArenaPrint();
+
+	if (!arena.mapLoads)
+		return;
+
+	gi.Com_Print("recent map loads:\n");
+	const size_t count = std::min(arena.mapLoads, MAP_HISTORY);
+	for (size_t i = arena.mapLoads - count; i < arena.mapLoads; i++) {
+		const map_load_t& load = arena.maps[i % MAP_HISTORY];
+		gi.Com_PrintFmt("  {:<16} {:>8.1f} ms {:>11} bytes  peak RSS {} KB\n",
+			load.mapName.data(), load.spawnMs, load.arenaBytes, load.peakResidentKB);
+	}
+}
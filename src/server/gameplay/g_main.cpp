@@ -20,7 +20,9 @@ various cvars that can change game behavior on the fly.*/
 #include "../commands/commands.hpp"
 #include "g_clients.hpp"
 #include "g_headhunters.hpp"
+#include "g_jobs.hpp"
 #include <algorithm>
+#include <cassert>
 #include <cstring>
 #include <array>
 #include <ctime>
@@ -291,6 +293,18 @@ cvar_t* bot_name_prefix;
 
 cvar_t* g_autoScreenshotTool;
 
+cvar_t* g_trace_memo;
+cvar_t* g_jobs_workers;
+cvar_t* g_jobs_deterministic;
+cvar_t* g_ai_sense_parallel;
+cvar_t* g_spawn_danger_cache;
+cvar_t* g_bot_state_dirty;
+cvar_t* g_monster_lod;
+cvar_t* g_monster_lod_distance;
+cvar_t* g_frame_budget;
+cvar_t* g_frame_budget_ms;
+cvar_t* g_world_snapshot;
+
 static cvar_t* g_framesPerFrame;
 
 int ii_duel_header;
@@ -1129,6 +1143,18 @@ static void InitGame() {
 	g_blueTeamName = gi.cvar("g_blue_team_name", "Team BLUE", CVAR_NOFLAGS);
 	g_redTeamName = gi.cvar("g_red_team_name", "Team RED", CVAR_NOFLAGS);
 
+	g_trace_memo = gi.cvar("g_trace_memo", "0", CVAR_NOFLAGS);
+	g_jobs_workers = gi.cvar("g_jobs_workers", "0", CVAR_NOFLAGS);
+	g_jobs_deterministic = gi.cvar("g_jobs_deterministic", "0", CVAR_NOFLAGS);
+	g_ai_sense_parallel = gi.cvar("g_ai_sense_parallel", "0", CVAR_NOFLAGS);
+	g_spawn_danger_cache = gi.cvar("g_spawn_danger_cache", "1", CVAR_NOFLAGS);
+	g_bot_state_dirty = gi.cvar("g_bot_state_dirty", "1", CVAR_NOFLAGS);
+	g_monster_lod = gi.cvar("g_monster_lod", "1", CVAR_NOFLAGS);
+	g_monster_lod_distance = gi.cvar("g_monster_lod_distance", "1536", CVAR_NOFLAGS);
+	g_frame_budget = gi.cvar("g_frame_budget", "1", CVAR_NOFLAGS);
+	g_frame_budget_ms = gi.cvar("g_frame_budget_ms", "0", CVAR_NOFLAGS);
+	g_world_snapshot = gi.cvar("g_world_snapshot", "1", CVAR_NOFLAGS);
+
 	// items
 	InitItems();
 
@@ -1139,11 +1165,16 @@ static void InitGame() {
 	game.maxEntities = maxentities->integer;
 	g_entities = (gentity_t*)gi.TagMalloc(game.maxEntities * sizeof(g_entities[0]), TAG_GAME);
 	std::memset(g_entities, 0, game.maxEntities * sizeof(g_entities[0]));
+	G_RegistryClear();
+	G_EventListClear();
+	G_EntityHotClear();
+	G_PoiPathsClear();
 	globals.gentities = g_entities;
 	globals.maxEntities = game.maxEntities;
 
 	// initialize all clients for this game
 	AllocateClientArray(maxclients->integer);
+	G_MatchStatsClear();
 
 	level.levelStartTime = level.time;
 	game.serverStartTime = time(nullptr);
@@ -1242,9 +1273,12 @@ void FindIntermissionPoint(void) {
 static void ShutdownGame() {
 	gi.Com_Print("==== ShutdownGame ====\n");
 
+	G_Jobs().Stop();
+
 	FreeClientArray();
 
 	gi.FreeTags(TAG_LEVEL);
+	G_LevelArenaReset();
 	gi.FreeTags(TAG_GAME);
 }
 
@@ -1325,8 +1359,44 @@ ClientEndServerFrames
 static void ClientEndServerFrames() {
 	// calc the player views now that all pushing
 	// and damage has been added
-	for (auto ec : active_clients())
-		ClientEndServerFrame(ec);
+	P_EndServerFrames(G_Jobs());
+}
+
+/*
+=================
+G_Jobs
+=================
+*/
+JobSystem& G_Jobs() {
+	static JobSystem jobs;
+	return jobs;
+}
+
+/*
+=================
+G_UpdateJobWorkers
+
+Resizes the job pool when g_jobs_workers changes. 0 runs all jobs on the
+main thread, -1 uses one worker per spare hardware thread.
+=================
+*/
+static void G_UpdateJobWorkers() {
+	constexpr int32_t MAX_JOB_WORKERS = 16;
+	static const int32_t spareThreads = static_cast<int32_t>(std::thread::hardware_concurrency()) - 1;
+
+	JobSystem& jobs = G_Jobs();
+	jobs.SetDeterministic(g_jobs_deterministic->integer != 0);
+
+	int32_t workers = g_jobs_workers->integer;
+	if (workers < 0)
+		workers = spareThreads;
+	workers = std::clamp(workers, 0, MAX_JOB_WORKERS);
+
+	if (static_cast<size_t>(workers) == jobs.WorkerCount())
+		return;
+
+	jobs.Start(static_cast<size_t>(workers));
+	gi.Com_PrintFmt("Game job system: {} worker thread{}\n", workers, workers == 1 ? "" : "s");
 }
 
 /*
@@ -1697,6 +1767,7 @@ void ExitLevel(bool forceImmediate) {
 
 			cl.pers = {};
 			cl.resp.coopRespawn = {};
+			cl.MatchStats().Reset();
 			ec->health = 0;
 
 			Q_strlcpy(cl.pers.userInfo, userInfo, sizeof(cl.pers.userInfo));
@@ -1887,6 +1958,20 @@ static bool G_AnyDeadPlayersWithoutLives() {
 	return false;
 }
 
+/*
+=============
+HostAutoScreenshotsOverdue
+
+How long the next auto screenshot step has been due: from the end of its
+delay, or from the level settling for the first step. Negative while it
+is still waiting.
+=============
+*/
+static GameTime HostAutoScreenshotsOverdue() {
+	const GameTime due = level.autoScreenshotTool_delayTime ? level.autoScreenshotTool_delayTime : 300_ms;
+	return level.time - due;
+}
+
 static void HostAutoScreenshotsRun() {
 	//gi.Com_Print("==== HostAutoScreenshotsRun ====\n");
 	if (!g_autoScreenshotTool->integer)
@@ -2042,7 +2127,8 @@ static inline void G_RunFrame_(bool main_loop) {
 	CheckCvars();              // check for updated cvars
 	CheckPowerupsDisabled();   // disable unwanted powerups
 	CheckRuleset();            // ruleset enforcement
-	Bot_UpdateDebug();         // debug AI states
+	if (G_FrameBudgetAllow(FrameWork::BotDebug))
+		Bot_UpdateDebug();     // debug AI states
 
 	level.time += FRAME_TIME_MS;
 
@@ -2111,8 +2197,21 @@ static inline void G_RunFrame_(bool main_loop) {
 	}
 
 	// --- Entity Loop ---
-	gentity_t* ent = world;
-	for (size_t i = 0; i < globals.numEntities; ++i, ++ent) {
+	const size_t firstEntity = 1 + static_cast<size_t>(game.maxClients);
+	for (size_t i = 0; i < globals.numEntities; ++i) {
+		// clients have moved; sense for every monster before any of them act
+		if (i == firstEntity)
+			AI_SensePhase();
+
+		// past the client slots, hop straight to the next entity in use
+		if (i >= firstEntity) {
+			i = G_EntityHotNextInUse(i);
+			if (i >= globals.numEntities)
+				break;
+		}
+
+		gentity_t* ent = &g_entities[i];
+
 		if (!ent->inUse) {
 			if (i >= 1 && i < 1 + static_cast<size_t>(game.maxClients) && ent->timeStamp && level.time >= ent->timeStamp) {
 				int32_t playernum = static_cast<int32_t>(i - 1);
@@ -2176,8 +2275,6 @@ static inline void G_RunFrame_(bool main_loop) {
 			}
 		}
 
-		Entity_UpdateState(ent);
-
 		if (i >= 1 && i < 1 + static_cast<size_t>(game.maxClients)) {
 			ClientBeginServerFrame(ent);
 			continue;
@@ -2186,6 +2283,9 @@ static inline void G_RunFrame_(bool main_loop) {
 		G_RunEntity(ent);
 	}
 
+	// --- Publish bot world state ---
+	Bot_PublishWorldState();
+
 	// --- Check for Match End / DM Logic ---
 	CheckDMEndFrame();
 	CheckNeedPass();
@@ -2207,10 +2307,13 @@ static inline void G_RunFrame_(bool main_loop) {
 
 	// --- Finalize Frame ---
 	ClientEndServerFrames();
-	HostAutoScreenshotsRun();
+	if (g_autoScreenshotTool->integer && HostAutoScreenshotsOverdue() >= 0_ms &&
+		G_FrameBudgetAllow(FrameWork::AutoScreenshots, HostAutoScreenshotsOverdue()))
+		HostAutoScreenshotsRun();
 
 	// --- Heatmap thinking ---
-	HM_Think();
+	if (G_FrameBudgetAllow(FrameWork::Heatmap))
+		HM_Think();
 
 	// --- Entry timer tracking ---
 	if (level.entry && !level.intermission.time && g_entities[1].inUse &&
@@ -2219,14 +2322,30 @@ static inline void G_RunFrame_(bool main_loop) {
 	}
 
 	// --- Process monster pain ---
-	size_t total = std::min(static_cast<size_t>(MAX_ENTITIES), static_cast<size_t>(globals.numEntities));
-	for (size_t i = 0; i < total; ++i) {
-		gentity_t* e = &g_entities[i];
+	// pain can kill, gib or spawn monsters, so walk a copy of the registry;
+	// every member is resynced so the alive count is exact at frame end
+	static std::vector<gentity_t*> monsters;
+	G_RegistrySnapshot(EntityRegistry::Monster, monsters);
+	for (gentity_t* e : monsters) {
 		if (!e->inUse || !(e->svFlags & SVF_MONSTER))
 			continue;
 
 		M_ProcessPain(e);
+		G_RegistrySync(e);
+	}
+
+#ifndef NDEBUG
+	if (!G_RegistryVerify(true)) {
+		assert(!"entity registries out of sync with the entity array");
+		G_RegistryRebuild();
+	}
+	if (!G_EntityHotVerify(true)) {
+		assert(!"entity hot columns out of sync with the entity array");
+		G_EntityHotRebuild();
 	}
+	if (!G_EntityClassVerify(true))
+		assert(!"entity class tags out of sync with className");
+#endif
 
 	level.inFrame = false;
 }
@@ -2243,15 +2362,21 @@ void G_RunFrame(bool main_loop) {
 	if (main_loop && !G_AnyClientsSpawned())
 		return;
 
-	for (size_t i = 0; i < g_framesPerFrame->integer; i++)
+	G_UpdateJobWorkers();
+
+	for (size_t i = 0; i < g_framesPerFrame->integer; i++) {
+		G_FrameBudgetBeginFrame();
 		G_RunFrame_(main_loop);
+		G_FrameBudgetEndFrame();
+	}
 
 	// match details.. only bother if there's at least 1 player in-game
 	// and not already end of game
 	if (G_AnyClientsSpawned() && !level.intermission.time) {
 		constexpr GameTime report_time = 45_sec;
 
-		if (level.time - level.campaign.next_match_report > report_time) {
+		if (level.time - level.campaign.next_match_report > report_time &&
+			G_FrameBudgetAllow(FrameWork::MatchReport, level.time - level.campaign.next_match_report - report_time)) {
 			level.campaign.next_match_report = level.time + report_time;
 			ReportMatchDetails(false);
 		}
@@ -2267,11 +2392,12 @@ player processing happens outside RunFrame
 ================
 */
 void G_PrepFrame() {
-	for (size_t i = 0; i < globals.numEntities; i++)
-		g_entities[i].s.event = EV_NONE;
+	G_TraceBeginFrame();
 
-	for (auto player : active_clients())
-		player->client->ps.stats[STAT_HIT_MARKER] = 0;
+#ifndef NDEBUG
+	assert(G_EventListVerify() && "s.event written without G_SetEvent");
+#endif
+	G_ClearEvents();
 
 	globals.serverFlags &= ~SERVER_FLAG_INTERMISSION;
 
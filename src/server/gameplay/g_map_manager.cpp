@@ -497,6 +497,9 @@ void MapSystem::PruneQueuesToMapPool(std::vector<std::string>* removedRequests)
 	myMapQueue.erase(myMapEnd, myMapQueue.end());
 }
 
+// never reset, so a revision is not reused after the game state is cleared
+static uint32_t mapPoolRevisions = 0;
+
 /*
 ==================
 LoadMapPool
@@ -636,6 +639,7 @@ void LoadMapPool(gentity_t* ent) {
 		loaded++;
 	}
 	game.mapSystem.mapPool.swap(newPool);
+	game.mapSystem.poolRevision = ++mapPoolRevisions;
 
 	std::vector<std::string> removedRequests;
 	game.mapSystem.PruneQueuesToMapPool(&removedRequests);
@@ -252,7 +252,7 @@ gentity_t* ThrowGib(gentity_t* self, std::string gibname, int damage, gib_type_t
 
 	if (type & GIB_HEAD) {
 		gib = self;
-		gib->s.event = EV_OTHER_TELEPORT;
+		G_SetEvent(gib, EV_OTHER_TELEPORT);
 		// remove setSkin so that it doesn't set the skin wrongly later
 		self->monsterInfo.setSkin = nullptr;
 	}
@@ -498,13 +498,13 @@ static TOUCH(path_corner_touch) (gentity_t* self, gentity_t* other, const trace_
 		next = nullptr;
 
 	// [Paril-KEX] don't teleport to a point_combat, it means HOLD for them.
-	if ((next) && !strcmp(next->className, "path_corner") && next->spawnFlags.has(SPAWNFLAG_PATH_CORNER_TELEPORT)) {
+	if (G_IsClass(next, EntityClass::PathCorner) && next->spawnFlags.has(SPAWNFLAG_PATH_CORNER_TELEPORT)) {
 		v = next->s.origin;
 		v[2] += next->mins[2];
 		v[2] -= other->mins[2];
 		other->s.origin = v;
 		next = PickTarget(next->target);
-		other->s.event = EV_OTHER_TELEPORT;
+		G_SetEvent(other, EV_OTHER_TELEPORT);
 	}
 
 	other->goalEntity = other->moveTarget = next;
@@ -1569,8 +1569,8 @@ static TOUCH(teleporter_touch) (gentity_t* self, gentity_t* other, const trace_t
 
 	// draw the teleport splash at source and on the player
 	if (ClientIsPlaying(other->client)) {
-		self->owner->s.event = fx ? EV_PLAYER_TELEPORT : EV_OTHER_TELEPORT;
-		other->s.event = fx ? EV_PLAYER_TELEPORT : EV_OTHER_TELEPORT;
+		G_SetEvent(self->owner, fx ? EV_PLAYER_TELEPORT : EV_OTHER_TELEPORT);
+		G_SetEvent(other, fx ? EV_PLAYER_TELEPORT : EV_OTHER_TELEPORT);
 	}
 }
 
@@ -2394,7 +2394,7 @@ static USE(misc_camera_use) (gentity_t* self, gentity_t* other, gentity_t* activ
 	const char* lookAtTargetName = self->killTarget; // Default look-at from camera's "target" key
 	bool lookAtIsActivator = false;
 
-	if (other && !Q_strcasecmp(other->className, "trigger_misc_camera")) {
+	if (G_IsClass(other, EntityClass::TriggerMiscCamera)) {
 		// Override camera's wait time with the trigger's wait time
 		if (other->wait != 0) // 0 is default from map editor if key isn't present
 			self->wait = other->wait;
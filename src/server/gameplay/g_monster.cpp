@@ -722,6 +722,8 @@ static void M_MoveFrame(gentity_t* self) {
 		if (!(self->monsterInfo.aiFlags & AI_HOLD_FRAME)) {
 			float dist = move->frame[index].dist * self->monsterInfo.scale;
 			dist /= static_cast<float>(gi.tickRate) / 10.0f;
+			// a reduced-rate think covers several server frames
+			dist *= static_cast<float>(M_ThinkSteps(self));
 			move->frame[index].aiFunc(self, dist);
 		}
 		else
@@ -788,14 +790,14 @@ void M_ProcessPain(gentity_t* e) {
 			// free up slot for spawned monster if it's spawned
 			if (e->monsterInfo.aiFlags & AI_SPAWNED_CARRIER) {
 				if (e->monsterInfo.commander && e->monsterInfo.commander->inUse &&
-					!strcmp(e->monsterInfo.commander->className, "monster_carrier"))
+					G_IsClass(e->monsterInfo.commander, EntityClass::MonsterCarrier))
 					e->monsterInfo.commander->monsterInfo.monster_slots++;
 				e->monsterInfo.commander = nullptr;
 			}
 			if (e->monsterInfo.aiFlags & AI_SPAWNED_WIDOW) {
 				// need to check this because we can have variable numbers of coop players
 				if (e->monsterInfo.commander && e->monsterInfo.commander->inUse &&
-					!strncmp(e->monsterInfo.commander->className, "monster_widow", 13)) {
+					G_InClassGroup(e->monsterInfo.commander, EntityClassGroup::Widow)) {
 					if (e->monsterInfo.commander->monsterInfo.monster_used > 0)
 						e->monsterInfo.commander->monsterInfo.monster_used--;
 					e->monsterInfo.commander = nullptr;
@@ -803,7 +805,7 @@ void M_ProcessPain(gentity_t* e) {
 			}
 			if (e->monsterInfo.aiFlags & AI_SPAWNED_OLDONE) {
 				if (e->monsterInfo.commander && e->monsterInfo.commander->inUse &&
-					!strcmp(e->monsterInfo.commander->className, "monster_oldone")) {
+					G_IsClass(e->monsterInfo.commander, EntityClass::MonsterOldOne)) {
 					if (e->monsterInfo.commander->monsterInfo.monster_used > 0) {
 						e->monsterInfo.commander->monsterInfo.monster_used -= e->monsterInfo.monster_slots;
 						if (e->monsterInfo.commander->monsterInfo.monster_used < 0)
@@ -814,7 +816,7 @@ void M_ProcessPain(gentity_t* e) {
 			}
 			if (e->monsterInfo.aiFlags & AI_SPAWNED_OVERLORD) {
 				if (e->monsterInfo.commander && e->monsterInfo.commander->inUse &&
-					!strcmp(e->monsterInfo.commander->className, "monster_overlord")) {
+					G_IsClass(e->monsterInfo.commander, EntityClass::MonsterOverlord)) {
 					if (e->monsterInfo.commander->monsterInfo.monster_used > 0)
 						e->monsterInfo.commander->monsterInfo.monster_used--;
 					e->monsterInfo.commander = nullptr;
@@ -838,7 +840,7 @@ void M_ProcessPain(gentity_t* e) {
 		// [Paril-KEX] medic commander only gets his slots back after the monster is gibbed, since we can revive them
 		if (e->health <= e->gibHealth) {
 			if (e->monsterInfo.aiFlags & AI_SPAWNED_MEDIC_C) {
-				if (e->monsterInfo.commander && e->monsterInfo.commander->inUse && !strcmp(e->monsterInfo.commander->className, "monster_medic_commander"))
+				if (e->monsterInfo.commander && e->monsterInfo.commander->inUse && G_IsClass(e->monsterInfo.commander, EntityClass::MonsterMedicCommander))
 					e->monsterInfo.commander->monsterInfo.monster_used -= e->monsterInfo.monster_slots;
 
 				e->monsterInfo.commander = nullptr;
@@ -1049,6 +1051,121 @@ static bool CheckPathVisibility(const Vector3& start, const Vector3& end) {
 	return valid;
 }
 
+/*
+=============
+Think LOD
+
+Monsters no player can see, or that are too far away to matter, drop to
+one think per 10hz animation frame in coop and Horde. Animation frames and
+frame thinkFuncs already step at 10hz, so only the per-server-frame aiFunc
+calls are merged: the merged think moves and turns for every frame it
+covers (lodSteps). Physics still runs at the full rate. Damage, player
+noise and acquiring a target promote a monster back to full rate at once.
+=============
+*/
+namespace {
+
+constexpr GameTime MONSTER_LOD_CHECK = 100_ms;
+constexpr GameTime MONSTER_LOD_HOLD = 2_sec;
+
+std::array<uint64_t, static_cast<size_t>(MonsterLOD::Total)> lodThinks{};
+
+/*
+=============
+M_LODInterval
+
+Server frames per 10hz animation frame.
+=============
+*/
+int32_t M_LODInterval() {
+	return std::max(1, static_cast<int32_t>(gi.tickRate / 10));
+}
+
+/*
+=============
+M_CanThinkReduced
+=============
+*/
+bool M_CanThinkReduced(const gentity_t* self) {
+	if (!g_monster_lod->integer || M_LODInterval() <= 1)
+		return false;
+
+	if (!CooperativeModeOn() && !Game::Is(GameType::Horde))
+		return false;
+
+	const MonsterInfo& info = self->monsterInfo;
+
+	if (self->deadFlag || self->health <= 0 || info.damage.blood || info.lodHoldTime > level.time)
+		return false;
+
+	if (info.aiFlags & AI_HIGH_TICK_RATE)
+		return false;
+
+	// still fighting someone it may be able to see
+	if (self->enemy && self->enemy->client && gi.inPVS(self->s.origin, self->enemy->s.origin, false))
+		return false;
+
+	const float range = g_monster_lod_distance->value;
+	const float rangeSquared = range * range;
+
+	for (auto player : active_players()) {
+		if ((player->s.origin - self->s.origin).lengthSquared() <= rangeSquared &&
+			gi.inPVS(player->s.origin, self->s.origin, false))
+			return false;
+	}
+
+	return true;
+}
+
+/*
+=============
+M_LODSteps
+
+How many server frames the think about to run has to cover.
+=============
+*/
+int32_t M_LODSteps(const gentity_t* self) {
+	const MonsterInfo& info = self->monsterInfo;
+
+	if (!info.lodScheduled)
+		return 1;
+
+	const int64_t elapsed = (level.time - info.lodLastThink).milliseconds() / FRAME_TIME_MS.milliseconds();
+
+	return static_cast<int32_t>(std::clamp<int64_t>(elapsed, 1, M_LODInterval()));
+}
+
+/*
+=============
+M_ScheduleLOD
+
+Re-evaluates the tier at most every MONSTER_LOD_CHECK and, at the reduced
+rate, pushes the next think out to the next animation frame.
+=============
+*/
+void M_ScheduleLOD(gentity_t* self) {
+	MonsterInfo& info = self->monsterInfo;
+
+	if (info.lodCheckTime <= level.time) {
+		info.lodCheckTime = level.time + MONSTER_LOD_CHECK;
+		info.lod = M_CanThinkReduced(self) ? MonsterLOD::Reduced : MonsterLOD::Full;
+	}
+
+	info.lodLastThink = level.time;
+	info.lodScheduled = false;
+
+	// leave alone anything that rescheduled itself this think
+	if (info.lod != MonsterLOD::Reduced || self->think != monster_think || self->nextThink != level.time + FRAME_TIME_S)
+		return;
+
+	const GameTime latest = level.time + FRAME_TIME_S * M_LODInterval();
+
+	self->nextThink = std::clamp(info.next_move_time, level.time + FRAME_TIME_S, latest);
+	info.lodScheduled = self->nextThink > level.time + FRAME_TIME_S;
+}
+
+} // namespace
+
 THINK(monster_think) (gentity_t* self) -> void {
 	// [Paril-KEX] monster sniff testing; if we can make an unobstructed path to the player, murder ourselves.
 	if (g_debug_monster_kills->integer) {
@@ -1130,7 +1247,11 @@ THINK(monster_think) (gentity_t* self) -> void {
 	if (self->health > 0 && self->monsterInfo.dodge && !(globals.serverFlags & SERVER_FLAG_LOADING))
 		M_CheckDodge(self);
 
+	lodThinks[static_cast<size_t>(self->monsterInfo.lod)]++;
+	self->monsterInfo.lodSteps = M_LODSteps(self);
 	M_MoveFrame(self);
+	self->monsterInfo.lodSteps = 1;
+	M_ScheduleLOD(self);
 	if (self->linkCount != self->monsterInfo.linkCount) {
 		self->monsterInfo.linkCount = self->linkCount;
 		M_CheckGround(self, G_GetClipMask(self));
@@ -1140,6 +1261,64 @@ THINK(monster_think) (gentity_t* self) -> void {
 	M_SetEffects(self);
 }
 
+/*
+=============
+M_PromoteLOD
+
+Puts the monster back on full-rate thinking for at least MONSTER_LOD_HOLD;
+if it was waiting out a reduced-rate interval it thinks this frame (or
+the next, if its slot has already run).
+=============
+*/
+void M_PromoteLOD(gentity_t* self) {
+	MonsterInfo& info = self->monsterInfo;
+
+	info.lodHoldTime = level.time + MONSTER_LOD_HOLD;
+
+	if (info.lod == MonsterLOD::Full)
+		return;
+
+	info.lod = MonsterLOD::Full;
+
+	if (info.lodScheduled && self->think == monster_think && self->nextThink > level.time)
+		self->nextThink = level.time;
+}
+
+/*
+=============
+M_PromoteLODNear
+
+Promotes every reduced-rate monster that can hear a noise at origin.
+=============
+*/
+void M_PromoteLODNear(const Vector3& origin) {
+	for (gentity_t* ent : G_RegistryMembers(EntityRegistry::Monster)) {
+		if (ent->monsterInfo.lod == MonsterLOD::Reduced && gi.inPHS(origin, ent->s.origin, false))
+			M_PromoteLOD(ent);
+	}
+}
+
+/*
+=============
+M_LODPrint
+
+sv monsterlod: monsters per tier right now, and thinks per tier so far.
+=============
+*/
+void M_LODPrint() {
+	std::array<size_t, static_cast<size_t>(MonsterLOD::Total)> counts{};
+
+	for (gentity_t* ent : G_RegistryMembers(EntityRegistry::Monster)) {
+		if (ent->registryAlive)
+			counts[static_cast<size_t>(ent->monsterInfo.lod)]++;
+	}
+
+	gi.Com_PrintFmt("Monster think LOD ({}, {} server frames per reduced think):\n",
+		g_monster_lod->integer ? "on" : "off", M_LODInterval());
+	gi.Com_PrintFmt("  full     {:>5} monsters, {} thinks\n", counts[0], lodThinks[0]);
+	gi.Com_PrintFmt("  reduced  {:>5} monsters, {} thinks\n", counts[1], lodThinks[1]);
+}
+
 /*
 ================
 monster_use
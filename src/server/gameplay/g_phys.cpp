@@ -269,10 +269,15 @@ static bool G_Push(gentity_t* pusher, Vector3& move, Vector3& amove) {
 	pushed_p++;
 
 	// move the pusher to it's final position
+	const Vector3 oldAbsMin = pusher->absMin;
+	const Vector3 oldAbsMax = pusher->absMax;
 	pusher->s.origin += move;
 	pusher->s.angles += amove;
 	gi.linkEntity(pusher);
 
+	// monsters that sensed across its path this frame must look again
+	AI_SenseMoverMoved(pusher, oldAbsMin, oldAbsMax);
+
 	// see if any solid entities are inside the final position
 	check = g_entities + 1;
 	for (uint32_t e = 1; e < globals.numEntities; e++, check++) {
@@ -908,7 +913,7 @@ static void G_Physics_Step(gentity_t* ent) {
 		if (ent->groundEntity)
 			if (!wasonground)
 				if (hitsound && !(RS(Quake1)))
-					ent->s.event = EV_FOOTSTEP;
+					G_SetEvent(ent, EV_FOOTSTEP);
 	}
 
 	if (!ent->inUse) // PGM g_touchtrigger free problem
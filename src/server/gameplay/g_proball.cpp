@@ -670,7 +670,7 @@ void AwardAssist(LevelLocals::ProBallState& state, gentity_t* scorer,
 		return;
 
 	G_AdjustPlayerScore(assistPlayer->client, 1, false, 0);
-	assistPlayer->client->pers.match.proBallAssists++;
+	assistPlayer->client->MatchStats().proBallAssists()++;
 	level.match.proBallAssists++;
 
 	gi.LocBroadcast_Print(PRINT_HIGH, "Assist: {}\n",
@@ -699,7 +699,7 @@ void AwardGoal(gentity_t* scorer, Team team, gentity_t* goalEnt) {
 
 	if (ValidPlayer(scorer)) {
 		G_AdjustPlayerScore(scorer->client, 1, false, 0);
-		scorer->client->pers.match.proBallGoals++;
+		scorer->client->MatchStats().proBallGoals()++;
 		scorer->client->pers.inventory[IT_BALL] = 0;
 	}
 
@@ -0,0 +1,319 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+g_registry.cpp (Entity Registries) Typed membership lists for the entity categories that
+per-frame and per-round logic asks about, so those passes walk only the members instead of the
+whole entity array. Key Responsibilities: - Classification: monsters, projectiles, items, traps
+and movers are recognised from the entity's flags, move type and class. - Maintenance:
+membership is re-evaluated whenever an entity is linked or unlinked, after damage, and once per
+frame for monsters; `FreeEntity` drops an entity before its slot is wiped. - Counters: each
+registry keeps a live member count, and the monster registry a count of living monsters, so
+questions such as "are all monsters dead?" are O(1). - Verification: `G_RegistryVerify`
+cross-checks every registry against a full entity scan; debug builds assert on it every frame.*/
+
+#include "../g_local.hpp"
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr size_t REGISTRY_COUNT = static_cast<size_t>(EntityRegistry::Total);
+
+struct EntityRegistryList {
+	std::vector<gentity_t*>	members;
+	size_t					alive = 0;
+};
+
+std::array<EntityRegistryList, REGISTRY_COUNT> registries{};
+
+constexpr std::array<const char*, REGISTRY_COUNT> registryNames = {
+	"none", "monsters", "projectiles", "items", "traps", "movers"
+};
+
+/*
+=============
+IsTrapClass
+=============
+*/
+inline bool IsTrapClass(const gentity_t* ent) {
+	return G_IsClass(ent, EntityClass::ProxMine) ||
+		G_InClassGroup(ent, EntityClassGroup::Tesla | EntityClassGroup::FoodCubeTrap);
+}
+
+/*
+=============
+Classify
+
+Works out which registry, if any, an entity belongs in right now.
+=============
+*/
+EntityRegistry Classify(const gentity_t* ent) {
+	if (!ent->inUse || ent->client || ent->s.number <= static_cast<int32_t>(game.maxClients))
+		return EntityRegistry::None;
+
+	if (ent->svFlags & SVF_MONSTER)
+		return EntityRegistry::Monster;
+
+	if (ent->solid == SOLID_BSP && (ent->moveType == MoveType::Push || ent->moveType == MoveType::Stop))
+		return EntityRegistry::Mover;
+
+	if (ent->item)
+		return EntityRegistry::Item;
+
+	if (IsTrapClass(ent))
+		return EntityRegistry::Trap;
+
+	if (ent->owner && (ent->moveType == MoveType::FlyMissile || ent->moveType == MoveType::Bounce || ent->moveType == MoveType::WallBounce))
+		return EntityRegistry::Projectile;
+
+	return EntityRegistry::None;
+}
+
+/*
+=============
+IsAlive
+
+Only monsters can be dead members; everything else counts as alive.
+=============
+*/
+inline bool IsAlive(const gentity_t* ent, EntityRegistry kind) {
+	return kind != EntityRegistry::Monster || (!ent->deadFlag && ent->health > 0);
+}
+
+/*
+=============
+Insert
+=============
+*/
+void Insert(gentity_t* ent, EntityRegistry kind) {
+	EntityRegistryList& list = registries[static_cast<size_t>(kind)];
+
+	ent->registry = kind;
+	ent->registrySlot = static_cast<uint32_t>(list.members.size());
+	ent->registryAlive = IsAlive(ent, kind);
+	list.members.push_back(ent);
+
+	if (ent->registryAlive)
+		list.alive++;
+}
+
+/*
+=============
+Erase
+
+Swap-removes the entity from its registry.
+=============
+*/
+void Erase(gentity_t* ent) {
+	EntityRegistryList& list = registries[static_cast<size_t>(ent->registry)];
+	gentity_t* last = list.members.back();
+
+	list.members[ent->registrySlot] = last;
+	last->registrySlot = ent->registrySlot;
+	list.members.pop_back();
+
+	if (ent->registryAlive)
+		list.alive--;
+
+	ent->registry = EntityRegistry::None;
+	ent->registrySlot = 0;
+	ent->registryAlive = false;
+}
+
+} // namespace
+
+/*
+=============
+G_RegistrySync
+
+Re-evaluates an entity's registry membership and alive state.
+=============
+*/
+void G_RegistrySync(gentity_t* ent) {
+	if (!ent)
+		return;
+
+	const EntityRegistry kind = Classify(ent);
+
+	if (kind != ent->registry) {
+		if (ent->registry != EntityRegistry::None)
+			Erase(ent);
+		if (kind != EntityRegistry::None)
+			Insert(ent, kind);
+		return;
+	}
+
+	if (kind == EntityRegistry::None)
+		return;
+
+	const bool alive = IsAlive(ent, kind);
+
+	if (alive != ent->registryAlive) {
+		EntityRegistryList& list = registries[static_cast<size_t>(kind)];
+
+		ent->registryAlive = alive;
+		if (alive)
+			list.alive++;
+		else
+			list.alive--;
+	}
+}
+
+/*
+=============
+G_RegistryRemove
+
+Called from FreeEntity before the slot is cleared.
+=============
+*/
+void G_RegistryRemove(gentity_t* ent) {
+	if (ent && ent->registry != EntityRegistry::None)
+		Erase(ent);
+}
+
+/*
+=============
+G_RegistryClear
+
+Forgets every member; used when the entity array is wiped wholesale.
+=============
+*/
+void G_RegistryClear() {
+	for (auto& list : registries) {
+		list.members.clear();
+		list.alive = 0;
+	}
+}
+
+/*
+=============
+G_RegistryRebuild
+
+Rebuilds every registry from a full scan, e.g. after loading a level.
+=============
+*/
+void G_RegistryRebuild() {
+	G_RegistryClear();
+
+	for (size_t i = 0; i < globals.numEntities; i++) {
+		gentity_t* ent = &g_entities[i];
+
+		ent->registry = EntityRegistry::None;
+		ent->registrySlot = 0;
+		ent->registryAlive = false;
+		G_RegistrySync(ent);
+	}
+}
+
+/*
+=============
+G_RegistryMembers
+=============
+*/
+std::span<gentity_t* const> G_RegistryMembers(EntityRegistry kind) {
+	return registries[static_cast<size_t>(kind)].members;
+}
+
+/*
+=============
+G_RegistrySnapshot
+
+Copies the members into `out` so the caller can free or spawn entities
+while walking them.
+=============
+*/
+void G_RegistrySnapshot(EntityRegistry kind, std::vector<gentity_t*>& out) {
+	const auto& members = registries[static_cast<size_t>(kind)].members;
+
+	out.assign(members.begin(), members.end());
+}
+
+/*
+=============
+G_RegistryCount
+=============
+*/
+size_t G_RegistryCount(EntityRegistry kind) {
+	return registries[static_cast<size_t>(kind)].members.size();
+}
+
+/*
+=============
+G_RegistryAliveCount
+=============
+*/
+size_t G_RegistryAliveCount(EntityRegistry kind) {
+	return registries[static_cast<size_t>(kind)].alive;
+}
+
+/*
+=============
+G_RegistryVerify
+
+Cross-checks every registry against a full entity scan. Returns false
+and, if asked, prints the first few mismatches.
+=============
+*/
+bool G_RegistryVerify(bool print) {
+	constexpr size_t MAX_REPORTS = 8;
+
+	std::array<size_t, REGISTRY_COUNT> counts{};
+	std::array<size_t, REGISTRY_COUNT> alive{};
+	size_t errors = 0;
+
+	// counts every mismatch, but only the first few are printed
+	auto report = [&errors, print]() {
+		return errors++ < MAX_REPORTS && print;
+	};
+
+	for (size_t i = 0; i < globals.numEntities; i++) {
+		const gentity_t* ent = &g_entities[i];
+		const EntityRegistry kind = Classify(ent);
+		const size_t index = static_cast<size_t>(kind);
+
+		if (kind != ent->registry) {
+			if (report())
+				gi.Com_PrintFmt("Registry: #{} ({}) is {} but registered as {}\n", i, ent->className ? ent->className : "<unset>",
+					registryNames[index], registryNames[static_cast<size_t>(ent->registry)]);
+			continue;
+		}
+
+		if (kind == EntityRegistry::None)
+			continue;
+
+		const auto& members = registries[index].members;
+
+		if ((ent->registrySlot >= members.size() || members[ent->registrySlot] != ent) && report())
+			gi.Com_PrintFmt("Registry: #{} has a stale {} slot {}\n", i, registryNames[index], ent->registrySlot);
+
+		if (ent->registryAlive != IsAlive(ent, kind) && report())
+			gi.Com_PrintFmt("Registry: #{} has a stale alive state\n", i);
+
+		counts[index]++;
+		if (IsAlive(ent, kind))
+			alive[index]++;
+	}
+
+	for (size_t i = 1; i < REGISTRY_COUNT; i++) {
+		if ((registries[i].members.size() != counts[i] || registries[i].alive != alive[i]) && report())
+			gi.Com_PrintFmt("Registry: {} holds {} ({} alive), scan found {} ({} alive)\n", registryNames[i],
+				registries[i].members.size(), registries[i].alive, counts[i], alive[i]);
+	}
+
+	return errors == 0;
+}
+
+/*
+=============
+G_RegistryPrint
+=============
+*/
+void G_RegistryPrint() {
+	for (size_t i = 1; i < REGISTRY_COUNT; i++)
+		gi.Com_PrintFmt("{:<12} {:>5} ({} alive)\n", registryNames[i], registries[i].members.size(), registries[i].alive);
+
+	if (G_RegistryVerify(true))
+		gi.Com_PrintFmt("Registries match a full entity scan.\n");
+}
@@ -866,8 +866,12 @@ FIELD_AUTO(trackerPainTime),
 // ownedSphere is DM only
 
 FIELD_AUTO(emptyClickSound),
-FIELD_AUTO(trail_head),
-FIELD_AUTO(trail_tail),
+FIELD_AUTO(trail.origins),
+FIELD_AUTO(trail.times),
+FIELD_AUTO(trail.head),
+FIELD_AUTO(trail.count),
+FIELD_AUTO(trail.checkOrigin),
+FIELD_AUTO(trail.nextCheckTime),
 
 FIELD_GAME_STRING(landmark_name),
 FIELD_AUTO(landmark_rel_pos),
@@ -1337,6 +1341,81 @@ static size_t get_complex_type_size(const save_type_t& type) {
 	return 0;
 }
 
+static void shift_save_struct_times(void* data, const save_struct_t* structure, GameTime delta);
+
+/*
+=============
+shift_save_type_times
+
+Moves every set timestamp inside data by delta, following the same type
+descriptions the save code uses.
+=============
+*/
+static void shift_save_type_times(void* data, const save_type_t& type, GameTime delta) {
+	switch (type.id) {
+	case SaveTypeID::Time: {
+		GameTime& time = *static_cast<GameTime*>(data);
+		if (time && time != HOLD_FOREVER)
+			time += delta;
+		return;
+	}
+	case SaveTypeID::Struct:
+		shift_save_struct_times(data, type.structure, delta);
+		return;
+	case SaveTypeID::FixedArray: {
+		if (!type.type_resolver && static_cast<SaveTypeID>(type.tag) != SaveTypeID::Time)
+			return;
+
+		const save_type_t element_type = type.type_resolver ? type.type_resolver() : save_type_t{ SaveTypeID::Time };
+		if (element_type.id != SaveTypeID::Time && element_type.id != SaveTypeID::Struct && element_type.id != SaveTypeID::FixedArray)
+			return;
+
+		const size_t element_size = get_complex_type_size(element_type);
+		uint8_t* element = static_cast<uint8_t*>(data);
+		for (size_t i = 0; i < type.count; i++, element += element_size)
+			shift_save_type_times(element, element_type, delta);
+		return;
+	}
+	default:
+		return;
+	}
+}
+
+/*
+=============
+shift_save_struct_times
+=============
+*/
+static void shift_save_struct_times(void* data, const save_struct_t* structure, GameTime delta) {
+	for (const save_field_t& field : structure->fields)
+		shift_save_type_times(static_cast<uint8_t*>(data) + field.offset, field.type, delta);
+}
+
+/*
+=============
+G_EntityShiftTimes
+
+Moves an entity's saved timestamps (think times, debounces, monster timers)
+by delta, as if it had been spawned that much later.
+=============
+*/
+void G_EntityShiftTimes(gentity_t* ent, GameTime delta) {
+	if (delta)
+		shift_save_struct_times(ent, &gentity_t_savestruct, delta);
+}
+
+/*
+=============
+G_LevelShiftTimes
+
+The same for a copy of the level locals.
+=============
+*/
+void G_LevelShiftTimes(LevelLocals* locals, GameTime delta) {
+	if (delta)
+		shift_save_struct_times(locals, &LevelLocals_savestruct, delta);
+}
+
 void read_save_struct_json(const Json::Value& json, void* data, const save_struct_t* structure);
 
 static void read_save_type_json(const Json::Value& json, void* data, const save_type_t* type, const char* field) {
@@ -1503,6 +1582,8 @@ static void read_save_type_json(const Json::Value& json, void* data, const save_
 		else if (json.isString()) {
 			if (type->count && strlen(json.asCString()) >= type->count)
 				json_print_error(field, "static-length dynamic string overrun", false);
+			else if (type->tag == TAG_LEVEL && !type->count)
+				*((const char**)data) = G_InternString(json.asCString());
 			else {
 				size_t len = strlen(json.asCString());
 				char* str = *((char**)data) = (char*)gi.TagMalloc(type->count ? type->count : (len + 1), static_cast<int>(type->tag));
@@ -1749,8 +1830,8 @@ static void read_save_type_json(const Json::Value& json, void* data, const save_
 			}
 
 			list_ptr->num_reinforcements = entries->size();
-			list_ptr->reinforcements = (reinforcement_t*)gi.TagMalloc(sizeof(reinforcement_t) * list_ptr->num_reinforcements, TAG_LEVEL);
-			list_ptr->spawn_counts = (uint32_t*)gi.TagMalloc(sizeof(uint32_t) * list_ptr->num_reinforcements, TAG_LEVEL);
+			list_ptr->reinforcements = (reinforcement_t*)G_LevelAlloc(sizeof(reinforcement_t) * list_ptr->num_reinforcements, LevelMem::Reinforcements);
+			list_ptr->spawn_counts = (uint32_t*)G_LevelAlloc(sizeof(uint32_t) * list_ptr->num_reinforcements, LevelMem::Reinforcements);
 			memset(list_ptr->spawn_counts, 0, sizeof(uint32_t) * list_ptr->num_reinforcements);
 
 			reinforcement_t* p = list_ptr->reinforcements;
@@ -1802,7 +1883,7 @@ static void read_save_type_json(const Json::Value& json, void* data, const save_
 						json_print_error(field, "expected unsigned count", false);
 				}
 
-				p->className = CopyString(value["classname"].asCString(), TAG_LEVEL);
+				p->className = G_InternString(value["classname"].asCString());
 				p->strength = value["strength"].asInt();
 
 				for (int32_t x = 0; x < 3; x++) {
@@ -2481,6 +2562,7 @@ void ReadGameJson(const char* jsonString) {
 	globals.maxEntities = game.maxEntities;
 
 	AllocateClientArray(static_cast<int>(max_clients));
+	G_MatchStatsClear();
 
 	// read game
 	json_push_stack("game");
@@ -2555,6 +2637,7 @@ void ReadLevelJson(const char* jsonString) {
 	// free any dynamic memory allocated by loading the level
 	// base state
 	gi.FreeTags(TAG_LEVEL);
+	G_LevelArenaReset();
 
 	Json::Value json = parseJson(jsonString);
 
@@ -2563,6 +2646,10 @@ void ReadLevelJson(const char* jsonString) {
 
 	// wipe all the entities
 	memset(g_entities, 0, game.maxEntities * sizeof(g_entities[0]));
+	G_RegistryClear();
+	G_EventListClear();
+	G_EntityHotClear();
+	G_PoiPathsClear();
 	globals.numEntities = game.maxClients + 1;
 
 	// read level
@@ -2618,6 +2705,11 @@ void ReadLevelJson(const char* jsonString) {
 				ent->nextThink = level.time + GameTime::from_sec(ent->delay);
 	}
 
+	// entities that were loaded unlinked never passed through linkEntity
+	G_RegistryRebuild();
+	G_EventListRebuild();
+	G_EntityHotRebuild();
+
 	PrecacheInventoryItems();
 
 	// clear cached indices
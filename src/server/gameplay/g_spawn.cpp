@@ -23,6 +23,7 @@ rules.*/
 #include <sstream>	// for ent overrides
 #include <fstream>	// for ent overrides
 #include <algorithm>	// for std::fill
+#include <chrono>
 
 #include <format>
 #include <new>
@@ -782,6 +783,15 @@ void ED_CallSpawn(gentity_t* ent) {
 		return;
 	}
 
+	// tag the entity by the className it is left with, whichever way this returns
+	struct ClassTagOnReturn {
+		gentity_t* ent;
+		~ClassTagOnReturn() {
+			if (ent->inUse)
+				G_EntityClassResolve(ent);
+		}
+	} classTagOnReturn{ ent };
+
 	// do this before calling the spawn function so it can be overridden.
 	ent->gravityVector[0] = 0.0;
 	ent->gravityVector[1] = 0.0;
@@ -855,29 +865,23 @@ void ED_CallSpawn(gentity_t* ent) {
 
 	SpawnEnt_MapFixes(ent);
 
-	// check item spawn functions
-	for (size_t index = static_cast<size_t>(IT_NULL + 1); index < itemList.size(); ++index) {
-		Item* item = &itemList[index];
-		if (!item->className)
-			continue;
-		if (!strcmp(item->className, ent->className)) {
-			// found it
-			// before spawning, pick random item replacement
-			if (g_dm_random_items->integer) {
-				ent->item = item;
-				item_id_t new_item = DoRandomRespawn(ent);
-
-				if (new_item) {
-					item = GetItemByIndex(new_item);
-					ent->className = item->className;
-					worr::Logf(worr::LogLevel::Debug, "{}: random respawn mapped to {} for {}", __FUNCTION__, ent->className, LogEntityLabel(ent));
-				}
-			}
+	// check item spawn functions; the index ignores case, spawning does not
+	if (Item* item = FindItemByClassname(ent->className); item && !strcmp(item->className, ent->className)) {
+		// before spawning, pick random item replacement
+		if (g_dm_random_items->integer) {
+			ent->item = item;
+			item_id_t new_item = DoRandomRespawn(ent);
 
-			SpawnItem(ent, item);
-			worr::Logf(worr::LogLevel::Trace, "{}: spawned item {}", __FUNCTION__, LogEntityLabel(ent));
-			return;
+			if (new_item) {
+				item = GetItemByIndex(new_item);
+				ent->className = item->className;
+				worr::Logf(worr::LogLevel::Debug, "{}: random respawn mapped to {} for {}", __FUNCTION__, ent->className, LogEntityLabel(ent));
+			}
 		}
+
+		SpawnItem(ent, item);
+		worr::Logf(worr::LogLevel::Trace, "{}: spawned item {}", __FUNCTION__, LogEntityLabel(ent));
+		return;
 	}
 
 	// check normal spawn functions
@@ -890,7 +894,7 @@ void ED_CallSpawn(gentity_t* ent) {
 				ent->className = s.name;
 
 			if (deathmatch->integer && !ent->saved) {
-				saved_spawn_t* spawn = (saved_spawn_t*)gi.TagMalloc(sizeof(saved_spawn_t), TAG_LEVEL);
+				saved_spawn_t* spawn = static_cast<saved_spawn_t*>(G_LevelAlloc(sizeof(saved_spawn_t), LevelMem::SpawnState, alignof(saved_spawn_t)));
 				*spawn = {
 					ent->s.origin,
 					ent->s.angles,
@@ -932,32 +936,33 @@ void ED_CallSpawn(gentity_t* ent) {
 /*
 =============
 ED_NewString
+
+Expands "\\n" escapes and interns the result in the level string arena, so
+repeated keys across the map share one copy.
 =============
 */
-char* ED_NewString(const char* string) {
-	char* newb, * new_p;
-	int		i;
-	size_t	l;
+const char* ED_NewString(const char* string) {
+	if (!strchr(string, '\\'))
+		return G_InternString(string);
 
-	l = strlen(string) + 1;
+	std::string expanded;
+	const size_t l = strlen(string);
 
-	newb = (char*)gi.TagMalloc(l, TAG_LEVEL);
+	expanded.reserve(l);
 
-	new_p = newb;
-
-	for (i = 0; i < l; i++) {
+	for (size_t i = 0; i < l; i++) {
 		if (string[i] == '\\' && i < l - 1) {
 			i++;
 			if (string[i] == 'n')
-				*new_p++ = '\n';
+				expanded.push_back('\n');
 			else
-				*new_p++ = '\\';
+				expanded.push_back('\\');
 		}
 		else
-			*new_p++ = string[i];
+			expanded.push_back(string[i]);
 	}
 
-	return newb;
+	return G_InternString(expanded);
 }
 //
 // fields are used for spawning from the entity string
@@ -2079,6 +2084,7 @@ parsing textual entity definitions out of an ent file.
 ===============
 */
 void SpawnEntities(const char* mapName, const char* entities, const char* spawnPoint) {
+	const auto spawnStart = std::chrono::steady_clock::now();
 	std::string entityStringStorage;
 	if (entities && *entities) {
 		bool overrideAllocated = false;
@@ -2109,6 +2115,7 @@ void SpawnEntities(const char* mapName, const char* entities, const char* spawnP
 	// Reset all persistent game state
 	SaveClientData();
 	gi.FreeTags(TAG_LEVEL);
+	G_LevelArenaReset();
 	ResetLevelLocals();
 	Domination_ClearState();
 	HeadHunters::ClearState();
@@ -2116,6 +2123,10 @@ void SpawnEntities(const char* mapName, const char* entities, const char* spawnP
 	neutralObelisk = nullptr;
 	level.entityReloadGraceUntil = level.time + FRAME_TIME_MS * 2;
 	std::memset(g_entities, 0, sizeof(g_entities[0]) * game.maxEntities);
+	G_RegistryClear();
+	G_EventListClear();
+	G_EntityHotClear();
+	G_PoiPathsClear();
 	globals.numEntities = game.maxClients + 1;
 	std::memset(world, 0, sizeof(*world));
 	world->s.number = 0;
@@ -2198,6 +2209,8 @@ void SpawnEntities(const char* mapName, const char* entities, const char* spawnP
 	if (inhibited > 0 && g_verbose->integer)
 		gi.Com_PrintFmt("{} entities inhibited.\n", inhibited);
 
+	G_StringArenaPrint();
+
 	if (!EnsureWorldspawnPresent())
 		gi.Com_ErrorFmt("{}: worldspawn failed to initialize after entity parse.\n", __FUNCTION__);
 
@@ -2232,82 +2245,83 @@ void SpawnEntities(const char* mapName, const char* entities, const char* spawnP
 	level.init = true;
 
 	globals.serverFlags &= ~SERVER_FLAG_LOADING;
+
+	if (deathmatch->integer && g_world_snapshot->integer)
+		G_WorldSnapshotCapture();
+
+	G_LevelArenaMapLoaded(mapName, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - spawnStart).count());
 }
 
 
+using MapSelectorState = std::remove_reference_t<decltype(level.mapSelector)>;
+
+// level fields a world reset carries over rather than rebuilding
+struct LevelPersistentState {
+	GameTime		time;
+	GameTime		levelStartTime;
+	int64_t		matchStartRealTime;
+	int64_t		matchEndRealTime;
+	GameTime		exitTime;
+	bool			readyToExit;
+	std::array<char, MAX_QPATH> mapName;
+	std::array<char, MAX_QPATH> longName;
+	std::array<char, MAX_QPATH> nextMap;
+	std::array<char, MAX_QPATH> forceMap;
+	std::string		changeMap;
+	std::string		achievement;
+	std::string		savedEntityString;
+	LevelLocals::Intermission intermission;
+	bool			isN64;
+	LevelLocals::Voting vote;
+	LevelEntry* entry;
+	LevelLocals::Population pop;
+	MatchState		matchState;
+	WarmupState		warmupState;
+	GameTime		warmupNoticeTime;
+	GameTime		matchStateTimer;
+	int32_t		warmupModificationCount;
+	GameTime		countdownTimerCheck;
+	GameTime		matchEndWarnTimerCheck;
+	int				roundNumber;
+	RoundState		roundState;
+	int				roundStateQueued;
+	GameTime		roundStateTimer;
+	bool			restarted;
+	GameTime		overtime;
+	bool			suddenDeath;
+	std::array<int, static_cast<int>(Team::Total)> locked;
+	GameTime		ctf_last_flag_capture;
+	Team			ctf_last_capture_team;
+	std::array<int, LAST_WEAPON - FIRST_WEAPON + 1> weaponCount;
+	GameTime		no_players_time;
+	bool			strike_red_attacks;
+	bool			strike_flag_touch;
+	bool			strike_turn_red;
+	bool			strike_turn_blue;
+	GameTime		timeoutActive;
+	std::string		matchID;
+	std::array<bool, 3> fragWarning;
+	bool			prepare_to_fight;
+	GameTime		endmatch_grace;
+	MatchOverallStats match;
+	uint16_t		vote_flags_enable;
+	uint16_t		vote_flags_disable;
+	MapSelectorState mapSelector;
+	int				arenaActive;
+	int				arenaTotal;
+	std::array<Ghosts, MAX_CLIENTS> ghosts;
+	int				autoScreenshotTool_index;
+	bool			autoScreenshotTool_initialised;
+	GameTime		autoScreenshotTool_delayTime;
+};
+
 /*
 =============
-G_ResetWorldEntitiesFromSavedString
-
-Restores world entities from the saved entity string.
+CaptureLevelPersistentState
 =============
 */
-bool G_ResetWorldEntitiesFromSavedString() {
-	if (level.savedEntityString.empty())
-		return false;
-
-	using MapSelectorState = std::remove_reference_t<decltype(level.mapSelector)>;
-
-	struct LevelPersistentState {
-		GameTime		time;
-		GameTime		levelStartTime;
-		int64_t		matchStartRealTime;
-		int64_t		matchEndRealTime;
-		GameTime		exitTime;
-		bool			readyToExit;
-		std::array<char, MAX_QPATH> mapName;
-		std::array<char, MAX_QPATH> longName;
-		std::array<char, MAX_QPATH> nextMap;
-		std::array<char, MAX_QPATH> forceMap;
-		std::string		changeMap;
-		std::string		achievement;
-		std::string		savedEntityString;
-		LevelLocals::Intermission intermission;
-		bool			isN64;
-		LevelLocals::Voting vote;
-		LevelEntry* entry;
-		LevelLocals::Population pop;
-		MatchState		matchState;
-		WarmupState		warmupState;
-		GameTime		warmupNoticeTime;
-		GameTime		matchStateTimer;
-		int32_t		warmupModificationCount;
-		GameTime		countdownTimerCheck;
-		GameTime		matchEndWarnTimerCheck;
-		int				roundNumber;
-		RoundState		roundState;
-		int				roundStateQueued;
-		GameTime		roundStateTimer;
-		bool			restarted;
-		GameTime		overtime;
-		bool			suddenDeath;
-		std::array<int, static_cast<int>(Team::Total)> locked;
-		GameTime		ctf_last_flag_capture;
-		Team			ctf_last_capture_team;
-		std::array<int, LAST_WEAPON - FIRST_WEAPON + 1> weaponCount;
-		GameTime		no_players_time;
-		bool			strike_red_attacks;
-		bool			strike_flag_touch;
-		bool			strike_turn_red;
-		bool			strike_turn_blue;
-		GameTime		timeoutActive;
-		std::string		matchID;
-		std::array<bool, 3> fragWarning;
-		bool			prepare_to_fight;
-		GameTime		endmatch_grace;
-		MatchOverallStats match;
-		uint16_t		vote_flags_enable;
-		uint16_t		vote_flags_disable;
-		MapSelectorState mapSelector;
-		int				arenaActive;
-		int				arenaTotal;
-		std::array<Ghosts, MAX_CLIENTS> ghosts;
-		int				autoScreenshotTool_index;
-		bool			autoScreenshotTool_initialised;
-		GameTime		autoScreenshotTool_delayTime;
-	};
-
-const auto persistent = std::make_unique<LevelPersistentState>(LevelPersistentState{
+static std::unique_ptr<LevelPersistentState> CaptureLevelPersistentState() {
+	return std::make_unique<LevelPersistentState>(LevelPersistentState{
 		level.time,
 		level.levelStartTime,
 		level.matchStartRealTime,
@@ -2365,24 +2379,14 @@ const auto persistent = std::make_unique<LevelPersistentState>(LevelPersistentSt
 		level.autoScreenshotTool_initialised,
 		level.autoScreenshotTool_delayTime
 	});
-	LevelPersistentState& state = *persistent;
-
-	globals.serverFlags |= SERVER_FLAG_LOADING;
-
-	const GameTime reloadGraceUntil = state.time + FRAME_TIME_MS * 2;
-
-	for (size_t i = static_cast<size_t>(game.maxClients) + BODY_QUEUE_SIZE + 1; i < globals.numEntities; ++i) {
-		gentity_t* ent = &g_entities[i];
-		if (!ent->inUse)
-			continue;
-
-		FreeEntity(ent);
-	}
-
-	gi.FreeTags(TAG_LEVEL);
-
-	ResetLevelLocals();
+}
 
+/*
+=============
+RestoreLevelPersistentState
+=============
+*/
+static void RestoreLevelPersistentState(LevelPersistentState& state) {
 	level.time = state.time;
 	level.levelStartTime = state.levelStartTime;
 	level.matchStartRealTime = state.matchStartRealTime;
@@ -2444,6 +2448,30 @@ const auto persistent = std::make_unique<LevelPersistentState>(LevelPersistentSt
 		level.isN64 = mapView.starts_with("q64/");
 	else
 		level.isN64 = state.isN64;
+}
+
+/*
+=============
+ReparseWorldEntities
+
+Frees the world and the level memory, then spawns the world again from the
+saved entity string.
+=============
+*/
+static void ReparseWorldEntities(LevelPersistentState& state, GameTime reloadGraceUntil) {
+	for (size_t i = static_cast<size_t>(game.maxClients) + BODY_QUEUE_SIZE + 1; i < globals.numEntities; ++i) {
+		gentity_t* ent = &g_entities[i];
+		if (!ent->inUse)
+			continue;
+
+		FreeEntity(ent);
+	}
+
+	gi.FreeTags(TAG_LEVEL);
+	G_LevelArenaReset();
+
+	ResetLevelLocals();
+	RestoreLevelPersistentState(state);
 
 	level.spawn.Clear();
 	level.spawnSpots.fill(nullptr);
@@ -2460,9 +2488,7 @@ const auto persistent = std::make_unique<LevelPersistentState>(LevelPersistentSt
 	level.timeoutOwner = nullptr;
 	level.entityReloadGraceUntil = reloadGraceUntil;
 
-	Domination_ClearState();
-	HeadHunters::ClearState();
-	ProBall::ClearState();
+	G_WorldReleaseEntityState();
 
 	globals.numEntities = game.maxClients + 1;
 
@@ -2512,6 +2538,7 @@ const auto persistent = std::make_unique<LevelPersistentState>(LevelPersistentSt
 	if (inhibited > 0 && g_verbose->integer) {
 		gi.Com_PrintFmt("{} entities inhibited.\n", inhibited);
 	}
+	G_StringArenaPrint();
 	if (!EnsureWorldspawnPresent()) {
 		gi.Com_ErrorFmt("{}: worldspawn failed to initialize after entity reload.\n", __FUNCTION__);
 	}
@@ -2525,6 +2552,57 @@ const auto persistent = std::make_unique<LevelPersistentState>(LevelPersistentSt
 		if (g_dm_random_items->integer) {
 			PrecacheForRandomRespawn();
 		}
+	}
+	else {
+		InitHintPaths();
+	}
+}
+
+/*
+=============
+RestoreWorldSnapshot
+
+Puts back the level locals and world entities captured after the map was
+spawned, moved forward to the current time, then the persistent level
+state. Level memory is kept, since the snapshot points into it.
+=============
+*/
+static void RestoreWorldSnapshot(LevelPersistentState& state, GameTime reloadGraceUntil) {
+	G_WorldSnapshotRestore();
+	G_PoiPathsClear();
+
+	RestoreLevelPersistentState(state);
+	level.entityReloadGraceUntil = reloadGraceUntil;
+}
+
+/*
+=============
+G_ResetWorldEntitiesFromSavedString
+
+Restores world entities to their state after the map was spawned, from the
+world snapshot when there is one taken under the current spawn settings,
+and from the saved entity string otherwise.
+=============
+*/
+bool G_ResetWorldEntitiesFromSavedString() {
+	if (level.savedEntityString.empty())
+		return false;
+
+	const auto resetStart = std::chrono::steady_clock::now();
+	const auto persistent = CaptureLevelPersistentState();
+	LevelPersistentState& state = *persistent;
+
+	globals.serverFlags |= SERVER_FLAG_LOADING;
+
+	const GameTime reloadGraceUntil = state.time + FRAME_TIME_MS * 2;
+	const bool fromSnapshot = g_world_snapshot->integer && G_WorldSnapshotValid();
+
+	if (fromSnapshot)
+		RestoreWorldSnapshot(state, reloadGraceUntil);
+	else
+		ReparseWorldEntities(state, reloadGraceUntil);
+
+	if (deathmatch->integer) {
 		game.item_inhibit_pu = 0;
 		game.item_inhibit_pa = 0;
 		game.item_inhibit_ht = 0;
@@ -2532,9 +2610,6 @@ const auto persistent = std::make_unique<LevelPersistentState>(LevelPersistentSt
 		game.item_inhibit_am = 0;
 		game.item_inhibit_wp = 0;
 	}
-	else {
-		InitHintPaths();
-	}
 
 	G_LocateSpawnSpots();
 	setup_shadow_lights();
@@ -2547,6 +2622,15 @@ const auto persistent = std::make_unique<LevelPersistentState>(LevelPersistentSt
 
 	globals.serverFlags &= ~SERVER_FLAG_LOADING;
 
+	// the re-parse released the memory the old snapshot pointed into
+	if (!fromSnapshot && deathmatch->integer && g_world_snapshot->integer)
+		G_WorldSnapshotCapture();
+
+	if (g_verbose->integer) {
+		gi.Com_PrintFmt("World reset from {} in {:.2f} ms.\n", fromSnapshot ? "snapshot" : "entity string",
+			std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - resetStart).count());
+	}
+
 	return true;
 }
 
@@ -2731,6 +2815,7 @@ void SP_worldspawn(gentity_t* ent) {
 	ent->moveType = MoveType::Push;
 	ent->solid = SOLID_BSP;
 	ent->inUse = true; // since the world doesn't use Spawn()
+	G_EntityHotSync(ent);
 	ent->s.modelIndex = MODELINDEX_WORLD;
 	ent->gravity = 1.0f;
 
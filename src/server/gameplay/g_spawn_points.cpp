@@ -18,6 +18,7 @@ compatibility with older parts of the codebase that have not yet been migrated.*
 #include "g_headhunters.hpp"
 #include "../../shared/logger.hpp"
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <format>
 
@@ -203,7 +204,7 @@ static void G_SpawnSpots_FlattenLegacy() {
 	level.spawnSpots.fill(nullptr);
 
 	int n = 0;
-	auto push_all = [&](const std::vector<gentity_t*>& v) {
+	auto push_all = [&](std::span<gentity_t* const> v) {
 		for (gentity_t* e : v) {
 			if (n >= static_cast<int>(level.spawnSpots.size())) return;
 			level.spawnSpots[static_cast<size_t>(n++)] = e;
@@ -219,6 +220,8 @@ static void G_SpawnSpots_FlattenLegacy() {
 	}
 }
 
+static void SpawnDanger_Build();
+
 /*
 ===============
 G_LocateSpawnSpots
@@ -245,6 +248,8 @@ void G_LocateSpawnSpots() {
 	// Optional: keep legacy fields in sync while you migrate call sites.
 	G_SpawnSpots_FlattenLegacy();
 
+	SpawnDanger_Build();
+
 	const size_t ffa_count = level.spawn.ffa.size();
 	const size_t red_count = level.spawn.red.size();
 	const size_t blue_count = level.spawn.blue.size();
@@ -261,7 +266,7 @@ IsProxMine
 ===============
 */
 static inline bool IsProxMine(const gentity_t* e) {
-	return e && e->className && strcmp(e->className, "prox_mine") == 0;
+	return G_IsClass(e, EntityClass::ProxMine);
 }
 
 /*
@@ -270,7 +275,7 @@ IsTeslaMine
 ===============
 */
 static inline bool IsTeslaMine(const gentity_t* e) {
-	return e && e->className && strncmp(e->className, "tesla", 5) == 0;
+	return G_InClassGroup(e, EntityClassGroup::Tesla);
 }
 
 /*
@@ -279,7 +284,7 @@ IsTrap
 ===============
 */
 static inline bool IsTrap(const gentity_t* e) {
-	return e && e->className && strncmp(e->className, "food_cube_trap", 14) == 0;
+	return G_InClassGroup(e, EntityClassGroup::FoodCubeTrap);
 }
 
 /*
@@ -361,6 +366,259 @@ static bool AnyDirectEnemyLoS(const gentity_t* requester, const Vector3& spot, f
 	return false;
 }
 
+// ==============================================================================
+// Spawn danger cache
+// ==============================================================================
+
+/*
+Every registered spawn gets an entry built at map load. The parts of its
+danger score that are expensive to evaluate are cached on it:
+
+- enemy line of sight, per player: the result is kept with the eye
+  position it was traced from and reused until that player moves more
+  than SPAWN_LOS_RESAMPLE_DIST or it is older than SPAWN_LOS_TTL. Pairs
+  whose clusters cannot see each other are rejected through the PVS
+  before any trace.
+- heat and nearby mines, per frame: heat is sampled once per spawn, and
+  mines are gathered from the trap registry once for all spawns instead
+  of a FindRadius per candidate.
+
+g_spawn_danger_cache 0 evaluates everything live, as before.
+*/
+namespace {
+
+constexpr float SPAWN_LOS_MAX_DIST = 2048.0f;		// consider LoS threats up to this range
+constexpr float SPAWN_MINE_RADIUS = 196.0f;			// avoid mines/traps around spot
+constexpr float SPAWN_LOS_RESAMPLE_DIST = 32.0f;
+constexpr GameTime SPAWN_LOS_TTL = 500_ms;
+
+struct SpawnLoSSample {
+	Vector3		from{};
+	GameTime	time = 0_ms;
+	bool		valid = false;
+	bool		visible = false;
+};
+
+struct SpawnDangerEntry {
+	gentity_t*					spot = nullptr;
+	Vector3						eye{};
+	GameTime					heatTime = -1_ms;
+	float						heat = 0.0f;
+	bool						mines = false;
+	std::vector<SpawnLoSSample>	los;				// indexed by client number
+};
+
+struct SpawnDangerStats {
+	uint64_t	queries = 0;		// enemy LoS pairs considered
+	uint64_t	cached = 0;			// answered from a sample
+	uint64_t	pvsRejects = 0;
+	uint64_t	traces = 0;
+};
+
+std::vector<SpawnDangerEntry> spawnDanger;
+std::vector<int32_t> spawnDangerIndex;				// by entity number, -1 if not a spawn
+std::vector<Vector3> spawnMineScratch;
+GameTime spawnMinesTime = -1_ms;
+SpawnDangerStats spawnDangerStats;
+bool spawnDangerBypass = false;						// forced off by the benchmark
+
+/*
+===============
+SpawnDanger_Enabled
+===============
+*/
+inline bool SpawnDanger_Enabled() {
+	return !spawnDangerBypass && g_spawn_danger_cache && g_spawn_danger_cache->integer;
+}
+
+/*
+===============
+SpawnDanger_Find
+===============
+*/
+SpawnDangerEntry* SpawnDanger_Find(const gentity_t* s) {
+	if (!s || !SpawnDanger_Enabled())
+		return nullptr;
+
+	const size_t number = static_cast<size_t>(s->s.number);
+	if (number >= spawnDangerIndex.size() || spawnDangerIndex[number] < 0)
+		return nullptr;
+
+	return &spawnDanger[spawnDangerIndex[number]];
+}
+
+/*
+===============
+SpawnDanger_RefreshMines
+Flags every spawn with a mine or trap in range, once per frame.
+===============
+*/
+void SpawnDanger_RefreshMines() {
+	if (spawnMinesTime == level.time)
+		return;
+
+	spawnMinesTime = level.time;
+	spawnMineScratch.clear();
+
+	for (const gentity_t* e : G_RegistryMembers(EntityRegistry::Trap)) {
+		if (e->inUse && e->solid != SOLID_NOT && (IsProxMine(e) || IsTeslaMine(e) || IsTrap(e)))
+			spawnMineScratch.push_back(e->s.origin + (e->mins + e->maxs) * 0.5f);
+	}
+
+	for (auto& entry : spawnDanger) {
+		entry.mines = false;
+
+		// same test FindRadius applies
+		for (const Vector3& mine : spawnMineScratch) {
+			if ((mine - entry.spot->s.origin).lengthSquared() <= Square(SPAWN_MINE_RADIUS)) {
+				entry.mines = true;
+				break;
+			}
+		}
+	}
+}
+
+/*
+===============
+SpawnDanger_PlayerSees
+===============
+*/
+bool SpawnDanger_PlayerSees(SpawnDangerEntry& entry, const gentity_t* player, const Vector3& from) {
+	SpawnLoSSample& sample = entry.los[player->s.number - 1];
+
+	spawnDangerStats.queries++;
+
+	if (sample.valid && level.time - sample.time < SPAWN_LOS_TTL &&
+		(from - sample.from).lengthSquared() < Square(SPAWN_LOS_RESAMPLE_DIST)) {
+		spawnDangerStats.cached++;
+		return sample.visible;
+	}
+
+	sample.valid = true;
+	sample.from = from;
+	sample.time = level.time;
+
+	if (!gi.inPVS(from, entry.eye, false)) {
+		spawnDangerStats.pvsRejects++;
+		sample.visible = false;
+		return false;
+	}
+
+	spawnDangerStats.traces++;
+	sample.visible = gi.trace(from, PLAYER_MINS, PLAYER_MAXS, entry.eye, nullptr, MASK_SOLID & ~CONTENTS_PLAYER).fraction == 1.0f;
+	return sample.visible;
+}
+
+} // namespace
+
+/*
+===============
+SpawnDanger_Build
+Registers every spawn list entry at map load.
+===============
+*/
+static void SpawnDanger_Build() {
+	spawnDanger.clear();
+	spawnDangerIndex.assign(globals.maxEntities, -1);
+	spawnMinesTime = -1_ms;
+
+	for (const auto* list : { &level.spawn.ffa, &level.spawn.red, &level.spawn.blue }) {
+		for (gentity_t* s : *list) {
+			if (!s || spawnDangerIndex[s->s.number] >= 0)
+				continue;
+
+			spawnDangerIndex[s->s.number] = static_cast<int32_t>(spawnDanger.size());
+
+			SpawnDangerEntry& entry = spawnDanger.emplace_back();
+			entry.spot = s;
+			entry.eye = SpawnEye(s->s.origin);
+			entry.los.resize(game.maxClients);
+		}
+	}
+}
+
+/*
+===============
+SpawnEnemyLoS
+Cached AnyDirectEnemyLoS.
+===============
+*/
+static bool SpawnEnemyLoS(const gentity_t* requester, gentity_t* spot) {
+	SpawnDangerEntry* entry = SpawnDanger_Find(spot);
+
+	if (!entry)
+		return AnyDirectEnemyLoS(requester, spot->s.origin, SPAWN_LOS_MAX_DIST);
+
+	if (!requester || !requester->client)
+		return false;
+
+	for (auto ec : active_clients()) {
+		if (ec->health <= 0 || !IsEnemy(requester, ec))
+			continue;
+
+		const Vector3 from = SpawnEye(ec->s.origin);
+		if ((entry->eye - from).lengthSquared() > Square(SPAWN_LOS_MAX_DIST))
+			continue;
+
+		if (SpawnDanger_PlayerSees(*entry, ec, from))
+			return true;
+	}
+
+	return false;
+}
+
+/*
+===============
+SpawnHasNearbyMines
+Cached SpawnPointHasNearbyMines.
+===============
+*/
+static bool SpawnHasNearbyMines(gentity_t* spot) {
+	SpawnDangerEntry* entry = SpawnDanger_Find(spot);
+
+	if (!entry)
+		return SpawnPointHasNearbyMines(spot->s.origin, SPAWN_MINE_RADIUS);
+
+	SpawnDanger_RefreshMines();
+	return entry->mines;
+}
+
+/*
+===============
+SpawnHeat
+Cached HM_DangerAt.
+===============
+*/
+static float SpawnHeat(gentity_t* spot) {
+	SpawnDangerEntry* entry = SpawnDanger_Find(spot);
+
+	if (!entry)
+		return HM_DangerAt(spot->s.origin);
+
+	if (entry->heatTime != level.time) {
+		entry->heatTime = level.time;
+		entry->heat = HM_DangerAt(spot->s.origin);
+	}
+
+	return entry->heat;
+}
+
+/*
+===============
+G_SpawnDangerInvalidate
+Drops every cached sample, e.g. after players have been moved in bulk.
+===============
+*/
+void G_SpawnDangerInvalidate() {
+	for (auto& entry : spawnDanger) {
+		entry.heatTime = -1_ms;
+		for (auto& sample : entry.los)
+			sample.valid = false;
+	}
+
+	spawnMinesTime = -1_ms;
+}
+
 /*
 ===============
 G_UnsafeSpawnPosition
@@ -441,16 +699,13 @@ FilterInitialSpawns
 Keep only INITIAL-flagged spawns when present; otherwise fallback to all.
 ===============
 */
-static std::vector<gentity_t*> FilterInitialSpawns(const std::vector<gentity_t*>& spawns) {
-	std::vector<gentity_t*> flagged;
-	flagged.reserve(spawns.size());
-	for (auto* s : spawns) {
-		if (!s) continue;
-		if (s->spawnFlags.has(SPAWNFLAG_INITIAL)) {
-			flagged.push_back(s);
-		}
-	}
-	return flagged.empty() ? spawns : flagged;
+static void FilterInitialSpawns(std::vector<gentity_t*>& spawns) {
+	const auto flagged = [](const gentity_t* s) { return s && s->spawnFlags.has(SPAWNFLAG_INITIAL); };
+
+	if (std::none_of(spawns.begin(), spawns.end(), flagged))
+		return;
+
+	std::erase_if(spawns, [&flagged](const gentity_t* s) { return !flagged(s); });
 }
 
 /*
@@ -494,20 +749,18 @@ not too close to other players, not directly in enemy LoS.
 force_spawn bypasses the softer checks except hard solids/telefrags.
 ===============
 */
-static std::vector<gentity_t*> FilterEligibleSpawns(
-	const std::vector<gentity_t*>& spawns,
+static void FilterEligibleSpawns(
+	std::span<gentity_t* const> spawns,
 	const Vector3& avoid_point,
 	bool force_spawn,
 	gentity_t* entForTeamLogic, // may be null
-	bool respectAvoidPoint
+	bool respectAvoidPoint,
+	std::vector<gentity_t*>& out
 ) {
 	constexpr float MIN_AVOID_DIST = 192.0f;   // distance from avoid_point (e.g. last death)
 	constexpr float MIN_PLAYER_RADIUS = 160.0f;   // keep away from nearest player
-	constexpr float MINE_RADIUS = 196.0f;   // avoid mines/traps around spot
-	constexpr float MAX_LOS_DIST = 2048.0f;  // consider LoS threats up to this range
 
-	std::vector<gentity_t*> out;
-	out.reserve(spawns.size());
+	out.clear();
 
 	for (auto* s : spawns) {
 		if (!s) continue;
@@ -522,7 +775,7 @@ static std::vector<gentity_t*> FilterEligibleSpawns(
 				continue;
 
 			// No nearby mines/traps
-			if (SpawnPointHasNearbyMines(s->s.origin, MINE_RADIUS))
+			if (SpawnHasNearbyMines(s))
 				continue;
 
 			// Player proximity
@@ -530,14 +783,12 @@ static std::vector<gentity_t*> FilterEligibleSpawns(
 				continue;
 
 			// Enemy line-of-sight
-			if (AnyDirectEnemyLoS(entForTeamLogic, s->s.origin, MAX_LOS_DIST))
+			if (SpawnEnemyLoS(entForTeamLogic, s))
 				continue;
 		}
 
 		out.push_back(s);
 	}
-
-	return out;
 }
 
 /*
@@ -546,13 +797,13 @@ FilterFallbackSpawns
 Lightweight fallback filter: occupancy and minimum distance from avoid_point.
 ===============
 */
-static std::vector<gentity_t*> FilterFallbackSpawns(
-	const std::vector<gentity_t*>& spawns,
-	const Vector3& avoid_point
+static void FilterFallbackSpawns(
+	std::span<gentity_t* const> spawns,
+	const Vector3& avoid_point,
+	std::vector<gentity_t*>& out
 ) {
 	constexpr float MIN_DIST = 192.0f;
-	std::vector<gentity_t*> out;
-	out.reserve(spawns.size());
+	out.clear();
 	for (auto* s : spawns) {
 		if (!s) continue;
 		if (!SpotIsSafe(s))
@@ -561,7 +812,6 @@ static std::vector<gentity_t*> FilterFallbackSpawns(
 			continue;
 		out.push_back(s);
 	}
-	return out;
 }
 
 /*
@@ -576,33 +826,42 @@ static T* PickRandomly(const std::vector<T*>& vec) {
 	return vec[dist(game.mapRNG)];
 }
 
+// scratch lists reused across selections so respawning does not allocate
+static std::vector<gentity_t*> spawnBaseScratch;
+static std::vector<gentity_t*> spawnEligibleScratch;
+static std::vector<gentity_t*> spawnFallbackScratch;
+static std::vector<gentity_t*> spawnFinalistScratch;
+static std::vector<float> spawnScoreScratch;
+
 /*
 ===============
 SelectFromSpawnList
 Pick random among all spots within epsilon of the best score.
-"scoreFn" must return lower-is-better scores.
+"scoreFn" must return lower-is-better scores; it is evaluated once per spot.
 ===============
 */
+template <typename ScoreFn>
 static gentity_t* SelectFromSpawnList(
-	const std::vector<gentity_t*>& spawns,
-	const std::function<float(gentity_t*)>& scoreFn
+	std::span<gentity_t* const> spawns,
+	const ScoreFn& scoreFn
 ) {
 	if (spawns.empty())
 		return nullptr;
 
-	float best = scoreFn(spawns[0]);
-	for (auto* s : spawns) {
-		best = std::min(best, scoreFn(s));
-	}
+	std::vector<float>& scores = spawnScoreScratch;
+	scores.clear();
+	for (auto* s : spawns)
+		scores.push_back(scoreFn(s));
+
+	const float best = *std::min_element(scores.begin(), scores.end());
 
 	constexpr float EPS = 0.05f; // 5 percent tolerance if we use normalized scores
-	std::vector<gentity_t*> finalists;
-	finalists.reserve(spawns.size());
-	for (auto* s : spawns) {
-		const float sc = scoreFn(s);
+	std::vector<gentity_t*>& finalists = spawnFinalistScratch;
+	finalists.clear();
+	for (size_t i = 0; i < spawns.size(); i++) {
 		// treat as tie if within epsilon of best
-		if (sc <= best + std::max(EPS, 0.01f * std::abs(best)))
-			finalists.push_back(s);
+		if (scores[i] <= best + std::max(EPS, 0.01f * std::abs(best)))
+			finalists.push_back(spawns[i]);
 	}
 
 	if (finalists.empty())
@@ -622,19 +881,19 @@ Weights are intentionally conservative; tune at runtime once you graph HM_Query(
 */
 static float CompositeDangerScore(gentity_t* s, gentity_t* ent, const Vector3& avoid_point) {
 	// Heat (0..1) from your combat heat map (nearby recent combat)
-	const float heat = HM_DangerAt(s->s.origin); // 0..1 normalized by HM_DangerAt impl
+	const float heat = SpawnHeat(s); // 0..1 normalized by HM_DangerAt impl
 	// Distance to nearest player (larger is safer, so invert)
 	const float nearest = std::max(1.0f, PlayersRangeFromSpot(ent, s));
 	const float nearPenalty = 1.0f / nearest; // 0..1-ish
 	// Enemy LoS risk as binary bump; soft penalty to prefer out-of-sight
-	const bool los = AnyDirectEnemyLoS(ent, s->s.origin, 2048.0f);
+	const bool los = SpawnEnemyLoS(ent, s);
 	const float losPenalty = los ? 0.5f : 0.0f;
 	// Avoid-point proximity (e.g., last-death). Closer is worse.
 	const float ad = (s->s.origin - avoid_point).length();
 	const float avoidPenalty = 1.0f / std::max(1.0f, ad);
 
 	// Mines near spot increase danger
-	const bool mines = SpawnPointHasNearbyMines(s->s.origin, 196.0f);
+	const bool mines = SpawnHasNearbyMines(s);
 	const float minePenalty = mines ? 0.5f : 0.0f;
 
 	// Weighted sum (lower is better)
@@ -656,7 +915,7 @@ Fixed: pass scoreFn instead of an entity to SelectFromSpawnList.
 ===============
 */
 static gentity_t* SelectTeamSpawnPoint(gentity_t* ent, Team team) {
-	const std::vector<gentity_t*>* list = nullptr;
+	const LevelVector<gentity_t*, LevelMem::SpawnLists>* list = nullptr;
 	switch (team) {
 	case Team::Red:  list = &level.spawn.red;  break;
 	case Team::Blue: list = &level.spawn.blue; break;
@@ -705,9 +964,10 @@ select_spawn_result_t SelectDeathmatchSpawnPoint(
 	}
 
 	// Initial spawns: prefer INITIAL-flagged points if any exist
-	std::vector<gentity_t*> baseList = level.spawn.ffa;
+	std::vector<gentity_t*>& baseList = spawnBaseScratch;
+	baseList.assign(level.spawn.ffa.begin(), level.spawn.ffa.end());
 	if (initial) {
-		baseList = FilterInitialSpawns(baseList);
+		FilterInitialSpawns(baseList);
 	}
 
 	const bool hasAvoidPoint = static_cast<bool>(avoid_point);
@@ -717,11 +977,13 @@ select_spawn_result_t SelectDeathmatchSpawnPoint(
 	}
 
 	// Screen for eligibility
-	auto eligible = FilterEligibleSpawns(baseList, avoid_point, force_spawn, ent, hasAvoidPoint);
+	std::vector<gentity_t*>& eligible = spawnEligibleScratch;
+	FilterEligibleSpawns(baseList, avoid_point, force_spawn, ent, hasAvoidPoint, eligible);
 
 	// If none survived and fallback is allowed, try relaxed fallback set
 	if (eligible.empty() && fallback_to_ctf_or_start) {
-		auto fb = FilterFallbackSpawns(baseList, avoid_point);
+		std::vector<gentity_t*>& fb = spawnFallbackScratch;
+		FilterFallbackSpawns(baseList, avoid_point, fb);
 		if (!fb.empty()) {
 			auto scoreFn = [ent, avoid_point](gentity_t* s) {
 				return CompositeDangerScore(s, ent, avoid_point);
@@ -740,7 +1002,8 @@ select_spawn_result_t SelectDeathmatchSpawnPoint(
 
 	// Final fallback: any FFA spot that is at least not embedded
 	if (eligible.empty()) {
-		auto loose = FilterFallbackSpawns(level.spawn.ffa, avoid_point);
+		std::vector<gentity_t*>& loose = spawnFallbackScratch;
+		FilterFallbackSpawns(level.spawn.ffa, avoid_point, loose);
 		if (!loose.empty()) {
 			return { PickRandomly(loose), SelectSpawnFlags::Fallback };
 		}
@@ -758,6 +1021,61 @@ select_spawn_result_t SelectDeathmatchSpawnPoint(
 	return { nullptr, SelectSpawnFlags::None };
 }
 
+/*
+===============
+G_SpawnDangerBenchmark
+Times deathmatch spawn selection for every active client with the danger
+cache off, cold (dropped before each round, as if everyone had moved) and
+warm. Selection draws from the map RNG, so this perturbs it.
+===============
+*/
+void G_SpawnDangerBenchmark(size_t rounds) {
+	size_t players = 0;
+	for (auto ec : active_clients()) {
+		(void)ec;
+		players++;
+	}
+
+	gi.Com_PrintFmt("Spawn selection benchmark: {} spawns, {} players, {} rounds\n", spawnDanger.size(), players, rounds);
+
+	if (!players || !rounds)
+		return;
+
+	struct BenchMode {
+		const char*	name;
+		bool		bypass;
+		bool		cold;
+	};
+
+	for (const BenchMode& mode : { BenchMode{ "live", true, false }, BenchMode{ "cached, cold", false, true }, BenchMode{ "cached, warm", false, false } }) {
+		spawnDangerBypass = mode.bypass;
+		spawnDangerStats = {};
+		G_SpawnDangerInvalidate();
+
+		const auto start = std::chrono::steady_clock::now();
+		for (size_t round = 0; round < rounds; round++) {
+			if (mode.cold)
+				G_SpawnDangerInvalidate();
+
+			for (auto ec : active_clients())
+				SelectDeathmatchSpawnPoint(ec, ec->client->lastDeathLocation, false, true, false, false);
+		}
+		const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+		const double selections = static_cast<double>(rounds * players);
+
+		if (mode.bypass) {
+			gi.Com_PrintFmt("  {:<14} {:8.2f} us/selection\n", mode.name, elapsed.count() / selections);
+		}
+		else {
+			gi.Com_PrintFmt("  {:<14} {:8.2f} us/selection, {:.1f} traces, {:.1f} pvs rejects, {:.1f} cached per selection\n",
+				mode.name, elapsed.count() / selections, spawnDangerStats.traces / selections,
+				spawnDangerStats.pvsRejects / selections, spawnDangerStats.cached / selections);
+		}
+	}
+
+	spawnDangerBypass = false;
+}
+
 // ==============================================================================
 // Single-player and Coop spawn selection
 // ==============================================================================
@@ -870,7 +1188,7 @@ static gentity_t* SelectCoopSpawnPoint(gentity_t* ent) {
 
 	// If still nothing, consider FFA list to keep players flowing
 	if (coopSpots.empty() && !level.spawn.ffa.empty())
-		coopSpots = level.spawn.ffa;
+		coopSpots.assign(level.spawn.ffa.begin(), level.spawn.ffa.end());
 
 	if (coopSpots.empty())
 		return nullptr;
@@ -878,9 +1196,10 @@ static gentity_t* SelectCoopSpawnPoint(gentity_t* ent) {
 	// Safety-screen the set
 	const Vector3 avoid_point = (ent && ent->client) ? ent->client->lastDeathLocation : Vector3{ 0,0,0 };
 	const bool hasAvoidPoint = static_cast<bool>(avoid_point);
-	auto eligible = FilterEligibleSpawns(coopSpots, avoid_point, /*force_spawn=*/false, ent, hasAvoidPoint);
+	std::vector<gentity_t*>& eligible = spawnEligibleScratch;
+	FilterEligibleSpawns(coopSpots, avoid_point, /*force_spawn=*/false, ent, hasAvoidPoint, eligible);
 	if (eligible.empty())
-		eligible = FilterFallbackSpawns(coopSpots, avoid_point);
+		FilterFallbackSpawns(coopSpots, avoid_point, eligible);
 
 	if (eligible.empty()) {
 		// Deterministic last-ditch so we never hard-fail coop
@@ -1386,6 +1705,7 @@ void ClientSpawn(gentity_t* ent) {
 	ent->moveType = MoveType::Walk;
 	ent->viewHeight = DEFAULT_VIEWHEIGHT;
 	ent->inUse = true;
+	G_EntityHotSync(ent);
 	ent->className = "player";
 	ent->mass = 200;
 	ent->solid = SOLID_BBOX;
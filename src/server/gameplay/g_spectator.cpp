@@ -6,7 +6,9 @@ mode. It handles how a spectator follows other players (the "chase cam"), includ
 third-person and first-person (`eyecam`) views, and manages the logic for cycling between
 different follow targets. Key Responsibilities: - Chase Camera: `ClientUpdateFollowers` is the
 core function that updates a spectator's position and view angles to follow their target. It
-includes collision detection to prevent the camera from clipping through walls. - Eyecam Mode:
+includes collision detection to prevent the camera from clipping through walls; the traced
+camera position is computed once per target per frame and shared by everyone following that
+target (`ClientUpdateFollowersOf` fans it out). - Eyecam Mode:
 Implements the first-person spectator view by directly copying the target's player state (view
 angles, weapon model, etc.) to the spectator. - Target Cycling: `FollowNext` and `FollowPrev`
 provide the logic for a spectator to cycle through the available players to watch. - State
@@ -14,9 +16,96 @@ Management: Handles freeing and attaching followers when players connect, discon
 between playing and spectating.*/
 
 #include "../g_local.hpp"
+#include <array>
 #include <cctype>
 #include <cstddef>
 
+namespace {
+
+// the traced third-person camera for one followed client, with the inputs
+// it was computed from; reused by every follower until the target moves,
+// turns, or the frame ends
+struct chase_camera_t {
+	bool		valid = false;
+	GameTime	time = 0_ms;
+	Vector3		origin{};
+	Vector3		vAngle{};
+	int32_t		viewHeight = 0;
+	bool		onGround = false;
+
+	Vector3		position{};
+};
+
+std::array<chase_camera_t, MAX_CLIENTS + 1> chaseCameras;
+
+/*
+=============
+ChaseCameraPosition
+
+Where a chase camera behind targ sits this frame, pulled in from walls,
+ceilings and floors.
+=============
+*/
+const Vector3& ChaseCameraPosition(const gentity_t* targ) {
+	chase_camera_t& cam = chaseCameras[static_cast<size_t>(targ - g_entities)];
+	const bool onGround = targ->groundEntity != nullptr;
+
+	if (cam.valid && cam.time == level.time && cam.origin == targ->s.origin && cam.vAngle == targ->client->vAngle &&
+		cam.viewHeight == targ->viewHeight && cam.onGround == onGround)
+		return cam.position;
+
+	cam.valid = true;
+	cam.time = level.time;
+	cam.origin = targ->s.origin;
+	cam.vAngle = targ->client->vAngle;
+	cam.viewHeight = targ->viewHeight;
+	cam.onGround = onGround;
+
+	Vector3 cameraPos, forward, right, angles;
+	trace_t trace;
+
+	angles = targ->client->vAngle;
+	if (angles[PITCH] > 56)
+		angles[PITCH] = 56;
+
+	AngleVectors(angles, forward, right, nullptr);
+	forward.normalize();
+
+	Vector3 eyePos = targ->s.origin;
+	eyePos[2] += targ->viewHeight;
+
+	cameraPos = eyePos + (forward * -30.0f);
+	if (cameraPos[2] < targ->s.origin[_Z] + 20.0f)
+		cameraPos[2] = targ->s.origin[_Z] + 20.0f;
+	if (!onGround)
+		cameraPos[2] += 16.0f;
+
+	// Main line-of-sight trace
+	trace = gi.traceLine(eyePos, cameraPos, targ, MASK_SOLID);
+	cameraPos = trace.endPos + (forward * 2.0f);
+
+	// Ceiling pad
+	Vector3 ceilingCheck = cameraPos; ceilingCheck[2] += 6.0f;
+	trace = gi.traceLine(cameraPos, ceilingCheck, targ, MASK_SOLID);
+	if (trace.fraction < 1.0f) {
+		cameraPos = trace.endPos;
+		cameraPos[2] -= 6.0f;
+	}
+
+	// Floor pad
+	Vector3 floorCheck = cameraPos; floorCheck[2] -= 6.0f;
+	trace = gi.traceLine(cameraPos, floorCheck, targ, MASK_SOLID);
+	if (trace.fraction < 1.0f) {
+		cameraPos = trace.endPos;
+		cameraPos[2] += 6.0f;
+	}
+
+	cam.position = cameraPos;
+	return cam.position;
+}
+
+} // namespace
+
 /*
 =============
 FreeFollower
@@ -139,10 +228,6 @@ void ClientUpdateFollowers(gentity_t* ent) {
 		return;
 	}
 
-	Vector3 targetOrigin = targ->s.origin;
-	Vector3 cameraPos, forward, right, angles;
-	trace_t trace;
-
 	bool eyecam = g_eyecam->integer != 0;
 
 	if (eyecam) {
@@ -181,58 +266,18 @@ void ClientUpdateFollowers(gentity_t* ent) {
 
 		ent->client->vAngle = targ->client->vAngle;
 		AngleVectors(ent->client->vAngle, ent->client->vForward, nullptr, nullptr);
-
-		// Optional trace (preserve in case used later)
-		trace = gi.traceLine(targ->s.origin, targ->s.origin, targ, MASK_SOLID);
-		cameraPos = trace.endPos;
 	}
 	else {
 		// Vanilla chasecam
 		targ->svFlags &= ~SVF_INSTANCED;
 
-		angles = targ->client->vAngle;
-		if (angles[PITCH] > 56)
-			angles[PITCH] = 56;
-
-		AngleVectors(angles, forward, right, nullptr);
-		forward.normalize();
-
-		Vector3 eyePos = targetOrigin;
-		eyePos[2] += targ->viewHeight;
-
-		cameraPos = eyePos + (forward * -30.0f);
-		if (cameraPos[2] < targ->s.origin[_Z] + 20.0f)
-			cameraPos[2] = targ->s.origin[_Z] + 20.0f;
-		if (!targ->groundEntity)
-			cameraPos[2] += 16.0f;
-
-		// Main line-of-sight trace
-		trace = gi.traceLine(eyePos, cameraPos, targ, MASK_SOLID);
-		cameraPos = trace.endPos + (forward * 2.0f);
-
-		// Ceiling pad
-		Vector3 ceilingCheck = cameraPos; ceilingCheck[2] += 6.0f;
-		trace = gi.traceLine(cameraPos, ceilingCheck, targ, MASK_SOLID);
-		if (trace.fraction < 1.0f) {
-			cameraPos = trace.endPos;
-			cameraPos[2] -= 6.0f;
-		}
-
-		// Floor pad
-		Vector3 floorCheck = cameraPos; floorCheck[2] -= 6.0f;
-		trace = gi.traceLine(cameraPos, floorCheck, targ, MASK_SOLID);
-		if (trace.fraction < 1.0f) {
-			cameraPos = trace.endPos;
-			cameraPos[2] += 6.0f;
-		}
-
 		ent->client->ps.gunIndex = 0;
 		ent->client->ps.gunSkin = 0;
 		ent->s.modelIndex = 0;
 		ent->s.modelIndex2 = 0;
 		ent->s.modelIndex3 = 0;
 
-		ent->s.origin = cameraPos;
+		ent->s.origin = ChaseCameraPosition(targ);
 		ent->viewHeight = 0;
 
 		// Disable prediction to prevent view jitter
@@ -263,6 +308,23 @@ void ClientUpdateFollowers(gentity_t* ent) {
 	gi.linkEntity(ent);
 }
 
+/*
+=============
+ClientUpdateFollowersOf
+
+Updates every spectator following targ; chase cameras share one traced
+camera position.
+=============
+*/
+void ClientUpdateFollowersOf(gentity_t* targ) {
+	if (!targ)
+		return;
+
+	for (auto ec : active_clients())
+		if (ec->client->follow.target == targ)
+			ClientUpdateFollowers(ec);
+}
+
 /*
 ==================
 SanitizeString
@@ -0,0 +1,76 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+g_string_arena.cpp (Entity String Arena) Stores the level's entity strings once each. Key
+Responsibilities: - Interning: `G_InternString` returns the same pointer for the same text, so
+the thousands of repeated `target`, `team` and `model` keys on a large map share storage and can
+be compared by pointer. - Storage: strings live in the level arena and are released with it;
+`G_LevelArenaReset` drops the table. - Statistics: bytes requested versus bytes stored, printed
+on map load.*/
+
+#include "../g_local.hpp"
+
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+
+struct string_arena_t {
+	std::unordered_map<std::string_view, const char*> interned;
+
+	size_t		requests = 0;
+	size_t		requestedBytes = 0;
+	size_t		storedBytes = 0;
+};
+
+string_arena_t strings;
+
+} // namespace
+
+/*
+=============
+G_InternString
+
+Returns a level-lifetime copy of text, shared with every other caller that
+asked for the same text this level. The result must not be modified.
+=============
+*/
+const char* G_InternString(std::string_view text) {
+	strings.requests++;
+	strings.requestedBytes += text.length() + 1;
+
+	if (const auto it = strings.interned.find(text); it != strings.interned.end())
+		return it->second;
+
+	char* stored = static_cast<char*>(G_LevelAlloc(text.length() + 1, LevelMem::Strings, 1));
+	std::memcpy(stored, text.data(), text.length());
+	strings.storedBytes += text.length() + 1;
+
+	strings.interned.emplace(std::string_view(stored, text.length()), stored);
+	return stored;
+}
+
+/*
+=============
+G_StringArenaReset
+
+Forgets every interned string once the level arena has been released.
+=============
+*/
+void G_StringArenaReset() {
+	strings = {};
+}
+
+/*
+=============
+G_StringArenaPrint
+=============
+*/
+void G_StringArenaPrint() {
+	const double saved = strings.requestedBytes
+		? 100.0 * (1.0 - static_cast<double>(strings.storedBytes) / static_cast<double>(strings.requestedBytes))
+		: 0.0;
+
+	gi.Com_PrintFmt("Entity strings: {} requested ({} bytes), {} unique ({} bytes stored, {:.1f}% saved)\n",
+		strings.requests, strings.requestedBytes, strings.interned.size(), strings.storedBytes, saved);
+}
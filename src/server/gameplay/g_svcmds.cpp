@@ -2,10 +2,11 @@
 Licensed under the GNU General Public License 2.0.
 
 g_svcmds.cpp (Game Server Commands) - modernized C++ Responsibilities: - ServerCommand():
-dispatch "sv" console/RCON commands - IP filtering: addip/removeip/listip/writeip -
+dispatch "sv" console/RCON commands - tracestats: per-call-site trace counters - aibench: monster sense phase timing - spawnbench: respawn selection timing - registry: entity registry counts and cross-check - botstate: bot world-state publish counters - eventbench: frame event reset timing - monsterlod: monster think LOD counts - framebudget: frame budget watchdog counters - entbench: entity slot walk timing - memstats: level memory by owner and recent map loads - IP filtering: addip/removeip/listip/writeip -
 G_FilterPacket(): packet gate using configured filters*/
 
 #include "../g_local.hpp"
+#include "../bots/bot_utils.hpp"
 
 #include <array>
 #include <vector>
@@ -395,6 +396,200 @@ namespace
 		gi.LocBroadcast_Print(PRINT_HIGH, "$g_map_ended_by_server");
 		Match_End();
 	}
+
+	/*
+	==============
+	SVCmd_TraceStats_f
+
+	sv tracestats [reset|<count>]
+	==============
+	*/
+	static void SVCmd_TraceStats_f()
+	{
+		if (gi.argc() >= 3 && Q_strcasecmp(gi.argv(2), "reset") == 0) {
+			G_TraceStatsReset();
+			gi.LocClient_Print(nullptr, PRINT_HIGH, "Trace statistics reset.\n");
+			return;
+		}
+
+		size_t count = 20;
+		if (gi.argc() >= 3) {
+			const std::string_view arg{ gi.argv(2) };
+			size_t parsed = 0;
+			const auto [ptr, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), parsed);
+			if (ec != std::errc{} || ptr != arg.data() + arg.size() || !parsed) {
+				gi.LocClient_Print(nullptr, PRINT_HIGH, "Usage: sv {} [reset|<count>]\n", gi.argv(1));
+				return;
+			}
+			count = parsed;
+		}
+
+		G_TraceStatsPrint(count);
+	}
+
+	/*
+	==============
+	ParseCount
+	==============
+	*/
+	static bool ParseCount(const char* text, size_t& out)
+	{
+		const std::string_view arg{ text };
+		size_t parsed = 0;
+		const auto [ptr, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), parsed);
+		if (ec != std::errc{} || ptr != arg.data() + arg.size() || !parsed)
+			return false;
+		out = parsed;
+		return true;
+	}
+
+	/*
+	==============
+	SVCmd_AIBench_f
+
+	sv aibench [monsters] [frames]
+	==============
+	*/
+	static void SVCmd_AIBench_f()
+	{
+		if (Game::IsNot(GameType::Horde)) {
+			gi.LocClient_Print(nullptr, PRINT_HIGH, "AI benchmark requires Horde mode.\n");
+			return;
+		}
+
+		size_t monsters = 100;
+		size_t frames = 200;
+		if ((gi.argc() >= 3 && !ParseCount(gi.argv(2), monsters)) || (gi.argc() >= 4 && !ParseCount(gi.argv(3), frames))) {
+			gi.LocClient_Print(nullptr, PRINT_HIGH, "Usage: sv {} [monsters] [frames]\n", gi.argv(1));
+			return;
+		}
+
+		const size_t alive = Horde_PopulateMonsters(monsters);
+		if (alive < monsters)
+			gi.LocClient_Print(nullptr, PRINT_HIGH, "Only {} of {} monsters could be spawned.\n", alive, monsters);
+
+		AI_SenseBenchmark(frames);
+	}
+
+	/*
+	==============
+	SVCmd_SpawnBench_f
+
+	sv spawnbench [rounds]
+	==============
+	*/
+	static void SVCmd_SpawnBench_f()
+	{
+		size_t rounds = 100;
+		if (gi.argc() >= 3 && !ParseCount(gi.argv(2), rounds)) {
+			gi.LocClient_Print(nullptr, PRINT_HIGH, "Usage: sv {} [rounds]\n", gi.argv(1));
+			return;
+		}
+
+		G_SpawnDangerBenchmark(rounds);
+	}
+
+	/*
+	==============
+	SVCmd_Registry_f
+
+	sv registry [rebuild]
+	==============
+	*/
+	static void SVCmd_Registry_f()
+	{
+		if (gi.argc() >= 3 && Q_strcasecmp(gi.argv(2), "rebuild") == 0) {
+			G_RegistryRebuild();
+			gi.LocClient_Print(nullptr, PRINT_HIGH, "Entity registries rebuilt.\n");
+		}
+
+		G_RegistryPrint();
+	}
+
+	/*
+	==============
+	SVCmd_BotState_f
+
+	sv botstate
+	==============
+	*/
+	static void SVCmd_BotState_f()
+	{
+		Bot_PrintPublishStats();
+	}
+
+	/*
+	==============
+	SVCmd_EventBench_f
+
+	sv eventbench [frames]
+	==============
+	*/
+	static void SVCmd_EventBench_f()
+	{
+		size_t frames = 1000;
+		if (gi.argc() >= 3 && !ParseCount(gi.argv(2), frames)) {
+			gi.LocClient_Print(nullptr, PRINT_HIGH, "Usage: sv {} [frames]\n", gi.argv(1));
+			return;
+		}
+
+		G_EventBenchmark(frames);
+	}
+
+	/*
+	==============
+	SVCmd_MonsterLOD_f
+
+	sv monsterlod
+	==============
+	*/
+	static void SVCmd_MonsterLOD_f()
+	{
+		M_LODPrint();
+	}
+
+	/*
+	==============
+	SVCmd_FrameBudget_f
+
+	sv framebudget [reset]
+	==============
+	*/
+	static void SVCmd_FrameBudget_f()
+	{
+		G_FrameBudgetPrint(gi.argc() >= 3 && Q_strcasecmp(gi.argv(2), "reset") == 0);
+	}
+
+	/*
+	==============
+	SVCmd_EntityBench_f
+
+	sv entbench [frames]
+	==============
+	*/
+	static void SVCmd_EntityBench_f()
+	{
+		size_t frames = 1000;
+		if (gi.argc() >= 3 && !ParseCount(gi.argv(2), frames)) {
+			gi.LocClient_Print(nullptr, PRINT_HIGH, "Usage: sv {} [frames]\n", gi.argv(1));
+			return;
+		}
+
+		G_EntityHotBenchmark(frames);
+	}
+
+	/*
+	==============
+	SVCmd_MemStats_f
+
+	sv memstats
+	==============
+	*/
+	static void SVCmd_MemStats_f()
+	{
+		G_LevelArenaPrint();
+		G_WorldSnapshotPrint();
+	}
 } // anonymous namespace
 
 /*
@@ -515,6 +710,36 @@ void ServerCommand()
 	else if (Q_strcasecmp(cmd, "nextmap") == 0) {
 		SVCmd_NextMap_f();
 	}
+	else if (Q_strcasecmp(cmd, "tracestats") == 0) {
+		SVCmd_TraceStats_f();
+	}
+	else if (Q_strcasecmp(cmd, "aibench") == 0) {
+		SVCmd_AIBench_f();
+	}
+	else if (Q_strcasecmp(cmd, "spawnbench") == 0) {
+		SVCmd_SpawnBench_f();
+	}
+	else if (Q_strcasecmp(cmd, "registry") == 0) {
+		SVCmd_Registry_f();
+	}
+	else if (Q_strcasecmp(cmd, "botstate") == 0) {
+		SVCmd_BotState_f();
+	}
+	else if (Q_strcasecmp(cmd, "eventbench") == 0) {
+		SVCmd_EventBench_f();
+	}
+	else if (Q_strcasecmp(cmd, "monsterlod") == 0) {
+		SVCmd_MonsterLOD_f();
+	}
+	else if (Q_strcasecmp(cmd, "framebudget") == 0) {
+		SVCmd_FrameBudget_f();
+	}
+	else if (Q_strcasecmp(cmd, "entbench") == 0) {
+		SVCmd_EntityBench_f();
+	}
+	else if (Q_strcasecmp(cmd, "memstats") == 0) {
+		SVCmd_MemStats_f();
+	}
 	else {
 		gi.LocClient_Print(nullptr, PRINT_HIGH, "Unknown server command \"{}\"\n", cmd);
 	}
@@ -859,211 +859,6 @@ void SP_target_crosslevel_target(gentity_t* self) {
 
 //==========================================================
 
-/*QUAKED target_laser (0 .5 .8) (-8 -8 -8) (8 8 8) START_ON RED GREEN BLUE YELLOW ORANGE FAT WINDOWSTOP NOT_EASY NOT_MEDIUM NOT_HARD NOT_DM NOT_COOP
-When triggered, fires a laser. You can either set a target or a direction.
-
-START_ON	- if set, the laser will be on when spawned
-FAT			- if set, the laser will be wider
-WINDOWSTOP	- if set, the laser will stop at windows and not pass through them
-
-In N64, WINDOWSTOP is used to make the laser a lightning bolt.
-*/
-
-constexpr SpawnFlags SPAWNFLAG_LASER_STOPWINDOW = 0x0080_spawnflag;
-
-struct laser_pierce_t : pierce_args_t {
-	gentity_t* self;
-	int32_t count;
-	bool damaged_thing = false;
-
-	inline laser_pierce_t(gentity_t* self, int32_t count) :
-		pierce_args_t(),
-		self(self),
-		count(count) {
-	}
-
-	// we hit an entity; return false to stop the piercing.
-	// you can adjust the mask for the re-trace (for water, etc).
-	virtual bool hit(contents_t& mask, Vector3& end) override {
-		// hurt it if we can
-		if (self->dmg > 0 && (tr.ent->takeDamage) && !(tr.ent->flags & FL_IMMUNE_LASER) && self->damage_debounce_time <= level.time) {
-			damaged_thing = true;
-			Damage(tr.ent, self, self->activator, self->moveDir, tr.endPos, vec3_origin, self->dmg, 1, DamageFlags::Energy, ModID::Laser);
-		}
-
-		// if we hit something that's not a monster or player or is immune to lasers, we're done
-		if (!(tr.ent->svFlags & SVF_MONSTER) && (!tr.ent->client) && !(tr.ent->flags & FL_DAMAGEABLE)) {
-			if (self->spawnFlags.has(SPAWNFLAG_LASER_ZAP)) {
-				self->spawnFlags &= ~SPAWNFLAG_LASER_ZAP;
-				gi.WriteByte(svc_temp_entity);
-				gi.WriteByte(TE_LASER_SPARKS);
-				gi.WriteByte(count);
-				gi.WritePosition(tr.endPos);
-				gi.WriteDir(tr.plane.normal);
-				gi.WriteByte(self->s.skinNum);
-				gi.multicast(tr.endPos, MULTICAST_PVS, false);
-			}
-
-			return false;
-		}
-
-		if (!mark(tr.ent))
-			return false;
-
-		return true;
-	}
-};
-
-static THINK(target_laser_think) (gentity_t* self) -> void {
-	int32_t count;
-
-	if (self->spawnFlags.has(SPAWNFLAG_LASER_ZAP))
-		count = 8;
-	else
-		count = 4;
-
-	if (self->enemy) {
-		Vector3 last_movedir = self->moveDir;
-		Vector3 point = (self->enemy->absMin + self->enemy->absMax) * 0.5f;
-		self->moveDir = point - self->s.origin;
-		self->moveDir.normalize();
-		if (self->moveDir != last_movedir)
-			self->spawnFlags |= SPAWNFLAG_LASER_ZAP;
-	}
-
-	Vector3 start = self->s.origin;
-	Vector3 end = start + (self->moveDir * 2048);
-
-	laser_pierce_t args{
-		self,
-		count
-	};
-
-	contents_t mask = self->spawnFlags.has(SPAWNFLAG_LASER_STOPWINDOW) ? MASK_SHOT : (CONTENTS_SOLID | CONTENTS_MONSTER | CONTENTS_PLAYER | CONTENTS_DEADMONSTER);
-
-	pierce_trace(start, end, self, args, mask);
-
-	self->s.oldOrigin = args.tr.endPos;
-
-	if (args.damaged_thing)
-		self->damage_debounce_time = level.time + 10_hz;
-
-	self->nextThink = level.time + FRAME_TIME_S;
-	gi.linkEntity(self);
-}
-
-static void target_laser_on(gentity_t* self) {
-	if (!self->activator)
-		self->activator = self;
-	self->spawnFlags |= SPAWNFLAG_LASER_ZAP | SPAWNFLAG_LASER_ON;
-	self->svFlags &= ~SVF_NOCLIENT;
-	self->flags |= FL_TRAP;
-	target_laser_think(self);
-}
-
-void target_laser_off(gentity_t* self) {
-	self->spawnFlags &= ~SPAWNFLAG_LASER_ON;
-	self->svFlags |= SVF_NOCLIENT;
-	self->flags &= ~FL_TRAP;
-	self->nextThink = 0_ms;
-}
-
-static USE(target_laser_use) (gentity_t* self, gentity_t* other, gentity_t* activator) -> void {
-	self->activator = activator;
-	if (self->spawnFlags.has(SPAWNFLAG_LASER_ON))
-		target_laser_off(self);
-	else
-		target_laser_on(self);
-}
-
-static THINK(target_laser_start) (gentity_t* self) -> void {
-	self->moveType = MoveType::None;
-	self->solid = SOLID_NOT;
-	self->s.renderFX |= RF_BEAM;
-	self->s.modelIndex = MODELINDEX_WORLD; // must be non-zero
-
-	// [Sam-KEX] On Q2N64, spawnflag of 128 turns it into a lightning bolt
-	if (level.isN64) {
-		// Paril: fix for N64
-		if (self->spawnFlags.has(SPAWNFLAG_LASER_STOPWINDOW)) {
-			self->spawnFlags &= ~SPAWNFLAG_LASER_STOPWINDOW;
-			self->spawnFlags |= SPAWNFLAG_LASER_LIGHTNING;
-		}
-	}
-
-	if (self->spawnFlags.has(SPAWNFLAG_LASER_LIGHTNING)) {
-		self->s.renderFX |= RF_BEAM_LIGHTNING; // tell renderer it is lightning
-
-		if (!self->s.skinNum)
-			self->s.skinNum = 0xf3f3f1f1; // default lightning color
-	}
-
-	// set the beam diameter
-	// [Paril-KEX] lab has this set prob before lightning was implemented
-	if (!level.isN64 && self->spawnFlags.has(SPAWNFLAG_LASER_FAT))
-		self->s.frame = 16;
-	else
-		self->s.frame = 4;
-
-	// set the color
-	if (!self->s.skinNum) {
-		if (self->spawnFlags.has(SPAWNFLAG_LASER_RED))
-			self->s.skinNum = 0xf2f2f0f0;
-		else if (self->spawnFlags.has(SPAWNFLAG_LASER_GREEN))
-			self->s.skinNum = 0xd0d1d2d3;
-		else if (self->spawnFlags.has(SPAWNFLAG_LASER_BLUE))
-			self->s.skinNum = 0xf3f3f1f1;
-		else if (self->spawnFlags.has(SPAWNFLAG_LASER_YELLOW))
-			self->s.skinNum = 0xdcdddedf;
-		else if (self->spawnFlags.has(SPAWNFLAG_LASER_ORANGE))
-			self->s.skinNum = 0xe0e1e2e3;
-	}
-
-	if (!self->enemy) {
-		if (self->target) {
-			gentity_t* targetEnt = G_FindByString<&gentity_t::targetName>(nullptr, self->target);
-			if (!targetEnt)
-				gi.Com_PrintFmt("{}: {} is a bad target.\n", *self, self->target);
-			else {
-				self->enemy = targetEnt;
-
-				// N64 fix
-				// FIXME: which map was this for again? oops
-				// muff: it is down to one of these maps:
-				// cargo, complex, core, jail, lab, orbit, process, storage
-				if (level.isN64 && !strcmp(self->enemy->className, "func_train") && !(self->enemy->spawnFlags & SPAWNFLAG_TRAIN_START_ON))
-					self->enemy->use(self->enemy, self, self);
-			}
-		}
-		else {
-			SetMoveDir(self->s.angles, self->moveDir);
-		}
-	}
-	self->use = target_laser_use;
-	self->think = target_laser_think;
-
-	if (!self->dmg)
-		self->dmg = 1;
-
-	self->mins = { -8, -8, -8 };
-	self->maxs = { 8, 8, 8 };
-	gi.linkEntity(self);
-
-	if (self->spawnFlags.has(SPAWNFLAG_LASER_ON))
-		target_laser_on(self);
-	else
-		target_laser_off(self);
-}
-
-void SP_target_laser(gentity_t* self) {
-	// let everything else get spawned before we start firing
-	self->think = target_laser_start;
-	self->flags |= FL_TRAP_LASER_FIELD;
-	self->nextThink = level.time + 1_sec;
-}
-
-//==========================================================
-
 /*QUAKED target_lightramp (0 .5 .8) (-8 -8 -8) (8 8 8) TOGGLE x x x x x x x NOT_EASY NOT_MEDIUM NOT_HARD NOT_DM NOT_COOP
 speed		How many seconds the ramping will take
 message		two letters; starting lightlevel and ending lightlevel
@@ -1313,7 +1108,7 @@ static THINK(update_target_camera) (gentity_t* self) -> void {
 		if (self->moveInfo.remainingDistance <= 0) {
 			if (self->moveTarget->hackFlags & HACKFLAG_TELEPORT_OUT) {
 				if (self->enemy) {
-					self->enemy->s.event = EV_PLAYER_TELEPORT;
+					G_SetEvent(self->enemy, EV_PLAYER_TELEPORT);
 					self->enemy->hackFlags = HACKFLAG_TELEPORT_OUT;
 					self->enemy->pain_debounce_time = self->enemy->timeStamp = GameTime::from_sec(self->moveTarget->wait);
 				}
@@ -1694,232 +1489,6 @@ void SP_target_light(gentity_t* self) {
 	gi.linkEntity(self);
 }
 
-/*QUAKED target_poi (1 0 0) (-4 -4 -4) (4 4 4) NEAREST DUMMY DYNAMIC x x x x x NOT_EASY NOT_MEDIUM NOT_HARD NOT_DM NOT_COOP
-[Paril-KEX] point of interest for help in player navigation.
-Without any additional setup, targeting this entity will switch
-the current POI in the level to the one this is linked to.
-
-"count": if set, this value is the 'stage' linked to this POI. A POI
-with this set that is activated will only take effect if the current
-level's stage value is <= this value, and if it is, will also set
-the current level's stage value to this value.
-
-"style": only used for teamed POIs; the POI with the lowest style will
-be activated when checking for which POI to activate. This is mainly
-useful during development, to easily insert or change the order of teamed
-POIs without needing to manually move the entity definitions around.
-
-"team": if set, this will create a team of POIs. Teamed POIs act like
-a single unit; activating any of them will do the same thing. When activated,
-it will filter through all of the POIs on the team selecting the one that
-best fits the current situation. This includes checking "count" and "style"
-values. You can also set the NEAREST spawnflag on any of the teamed POIs,
-which will additionally cause activation to prefer the nearest one to the player.
-Killing a POI via killTarget will remove it from the chain, allowing you to
-adjust valid POIs at runtime.
-
-The DUMMY spawnflag is to allow you to use a single POI as a team member
-that can be activated, if you're using killtargets to remove POIs.
-
-The DYNAMIC spawnflag is for very specific circumstances where you want
-to direct the player to the nearest teamed POI, but want the path to pick
-the nearest at any given time rather than only when activated.
-
-The DISABLED flag is mainly intended to work with DYNAMIC & teams; the POI
-will be disabled until it is targeted, and afterwards will be enabled until
-it is killed.
-*/
-
-constexpr SpawnFlags SPAWNFLAG_POI_NEAREST = 1_spawnflag;
-constexpr SpawnFlags SPAWNFLAG_POI_DUMMY = 2_spawnflag;
-constexpr SpawnFlags SPAWNFLAG_POI_DYNAMIC = 4_spawnflag;
-constexpr SpawnFlags SPAWNFLAG_POI_DISABLED = 8_spawnflag;
-
-static float distance_to_poi(Vector3 start, Vector3 end) {
-	PathRequest request;
-	request.start = start;
-	request.goal = end;
-	request.moveDist = 64.f;
-	request.pathFlags = PathFlags::All;
-	request.nodeSearch.ignoreNodeFlags = true;
-	request.nodeSearch.minHeight = 128.0f;
-	request.nodeSearch.maxHeight = 128.0f;
-	request.nodeSearch.radius = 1024.0f;
-	request.pathPoints.count = 0;
-
-	PathInfo info;
-
-	if (gi.GetPathToGoal(request, info))
-		return info.pathDistSqr;
-
-	if (info.returnCode == PathReturnCode::NoNavAvailable)
-		return (end - start).lengthSquared();
-
-	return std::numeric_limits<float>::infinity();
-}
-
-USE(target_poi_use) (gentity_t* ent, gentity_t* other, gentity_t* activator) -> void {
-	// we were disabled, so remove the disable check
-	if (ent->spawnFlags.has(SPAWNFLAG_POI_DISABLED))
-		ent->spawnFlags &= ~SPAWNFLAG_POI_DISABLED;
-
-	// early stage check
-	if (ent->count && level.poi.currentStage > ent->count)
-		return;
-
-	// teamed POIs work a bit differently
-	if (ent->team) {
-		gentity_t* poi_master = ent->teamMaster;
-
-		// unset ent, since we need to find one that matches
-		ent = nullptr;
-
-		float best_distance = std::numeric_limits<float>::infinity();
-		int32_t best_style = std::numeric_limits<int32_t>::max();
-
-		gentity_t* dummy_fallback = nullptr;
-
-		for (gentity_t* poi = poi_master; poi; poi = poi->teamChain) {
-			// currently disabled
-			if (poi->spawnFlags.has(SPAWNFLAG_POI_DISABLED))
-				continue;
-
-			// ignore dummy POI
-			if (poi->spawnFlags.has(SPAWNFLAG_POI_DUMMY)) {
-				dummy_fallback = poi;
-				continue;
-			}
-			// POI is not part of current stage
-			else if (poi->count && level.poi.currentStage > poi->count)
-				continue;
-			// POI isn't the right style
-			else if (poi->style > best_style)
-				continue;
-
-			float dist = distance_to_poi(activator->s.origin, poi->s.origin);
-
-			// we have one already and it's farther away, don't bother
-			if (poi_master->spawnFlags.has(SPAWNFLAG_POI_NEAREST) &&
-				ent &&
-				dist > best_distance)
-				continue;
-
-			// found a better style; overwrite dist
-			if (poi->style < best_style) {
-				// unless we weren't reachable...
-				if (poi_master->spawnFlags.has(SPAWNFLAG_POI_NEAREST) && std::isinf(dist))
-					continue;
-
-				best_style = poi->style;
-				if (poi_master->spawnFlags.has(SPAWNFLAG_POI_NEAREST))
-					best_distance = dist;
-				ent = poi;
-				continue;
-			}
-
-			// if we're picking by nearest, check distance
-			if (poi_master->spawnFlags.has(SPAWNFLAG_POI_NEAREST)) {
-				if (dist < best_distance) {
-					best_distance = dist;
-					ent = poi;
-					continue;
-				}
-			}
-			else {
-				// not picking by distance, so it's order of appearance
-				ent = poi;
-			}
-		}
-
-		// no valid POI found; this isn't always an error,
-		// some valid techniques may require this to happen.
-		if (!ent) {
-			if (dummy_fallback && dummy_fallback->spawnFlags.has(SPAWNFLAG_POI_DYNAMIC))
-				ent = dummy_fallback;
-			else
-				return;
-		}
-
-		// copy over POI stage value
-		if (ent->count) {
-			if (level.poi.currentStage <= ent->count)
-				level.poi.currentStage = ent->count;
-		}
-	}
-	else {
-		if (ent->count) {
-			if (level.poi.currentStage <= ent->count)
-				level.poi.currentStage = ent->count;
-			else
-				return; // this POI is not part of our current stage
-		}
-	}
-
-	// dummy POI; not valid
-	if (!strcmp(ent->className, "target_poi") && ent->spawnFlags.has(SPAWNFLAG_POI_DUMMY) && !ent->spawnFlags.has(SPAWNFLAG_POI_DYNAMIC))
-		return;
-
-	level.poi.valid = true;
-	level.poi.current = ent->s.origin;
-	level.poi.currentImage = ent->noiseIndex;
-
-	if (!strcmp(ent->className, "target_poi") && ent->spawnFlags.has(SPAWNFLAG_POI_DYNAMIC)) {
-		level.poi.currentDynamic = nullptr;
-
-		// pick the dummy POI, since it isn't supposed to get freed
-		// FIXME maybe store the team string instead?
-
-		for (gentity_t* m = ent->teamMaster; m; m = m->teamChain)
-			if (m->spawnFlags.has(SPAWNFLAG_POI_DUMMY)) {
-				level.poi.currentDynamic = m;
-				break;
-			}
-
-		if (!level.poi.currentDynamic)
-			gi.Com_PrintFmt("can't activate poi for {}; need DUMMY in chain\n", *ent);
-	}
-	else
-		level.poi.currentDynamic = nullptr;
-}
-
-static THINK(target_poi_setup) (gentity_t* self) -> void {
-	if (self->team) {
-		// copy dynamic/nearest over to all teammates
-		if (self->spawnFlags.has((SPAWNFLAG_POI_NEAREST | SPAWNFLAG_POI_DYNAMIC)))
-			for (gentity_t* m = self->teamMaster; m; m = m->teamChain)
-				m->spawnFlags |= self->spawnFlags & (SPAWNFLAG_POI_NEAREST | SPAWNFLAG_POI_DYNAMIC);
-
-		for (gentity_t* m = self->teamMaster; m; m = m->teamChain) {
-			if (strcmp(m->className, "target_poi"))
-				gi.Com_PrintFmt("WARNING: {} is teamed with target_poi's; unintentional\n", *m);
-		}
-	}
-}
-
-void SP_target_poi(gentity_t* self) {
-	if (deathmatch->integer) { // auto-remove for deathmatch
-		FreeEntity(self);
-		return;
-	}
-
-	if (st.image)
-		self->noiseIndex = gi.imageIndex(st.image);
-	else
-		self->noiseIndex = gi.imageIndex("friend");
-
-	self->use = target_poi_use;
-	self->svFlags |= SVF_NOCLIENT;
-	self->think = target_poi_setup;
-	self->nextThink = level.time + 1_ms;
-
-	if (!self->team) {
-		if (self->spawnFlags.has(SPAWNFLAG_POI_NEAREST))
-			gi.Com_PrintFmt("{} has useless spawnflag 'NEAREST'\n", *self);
-		if (self->spawnFlags.has(SPAWNFLAG_POI_DYNAMIC))
-			gi.Com_PrintFmt("{} has useless spawnflag 'DYNAMIC'\n", *self);
-	}
-}
-
 /*QUAKED target_music (1 0 0) (-8 -8 -8) (8 8 8) x x x x x x x x NOT_EASY NOT_MEDIUM NOT_HARD NOT_DM NOT_COOP
 Change music when used
 "sounds" set music track number to change to
@@ -2197,96 +1766,6 @@ void SP_target_story(gentity_t* self) {
 	self->use = use_target_story;
 }
 
-/*QUAKED target_mal_laser (1 0 0) (-4 -4 -4) (4 4 4) START_ON RED GREEN BLUE YELLOW ORANGE FAT x NOT_EASY NOT_MEDIUM NOT_HARD NOT_DM NOT_COOP
-Mal's laser
-*/
-static void target_mal_laser_on(gentity_t* self) {
-	if (!self->activator)
-		self->activator = self;
-	self->spawnFlags |= SPAWNFLAG_LASER_ZAP | SPAWNFLAG_LASER_ON;
-	self->svFlags &= ~SVF_NOCLIENT;
-	self->flags |= FL_TRAP;
-	// target_laser_think (self);
-	self->nextThink = level.time + GameTime::from_sec(self->wait + self->delay);
-}
-
-static USE(target_mal_laser_use) (gentity_t* self, gentity_t* other, gentity_t* activator) -> void {
-	self->activator = activator;
-	if (self->spawnFlags.has(SPAWNFLAG_LASER_ON))
-		target_laser_off(self);
-	else
-		target_mal_laser_on(self);
-}
-
-void mal_laser_think(gentity_t* self);
-
-static THINK(mal_laser_think2) (gentity_t* self) -> void {
-	self->svFlags |= SVF_NOCLIENT;
-	self->think = mal_laser_think;
-	self->nextThink = level.time + GameTime::from_sec(self->wait);
-	self->spawnFlags |= SPAWNFLAG_LASER_ZAP;
-}
-
-THINK(mal_laser_think) (gentity_t* self) -> void {
-	self->svFlags &= ~SVF_NOCLIENT;
-	target_laser_think(self);
-	self->think = mal_laser_think2;
-	self->nextThink = level.time + 100_ms;
-}
-
-void SP_target_mal_laser(gentity_t* self) {
-	self->moveType = MoveType::None;
-	self->solid = SOLID_NOT;
-	self->s.renderFX |= RF_BEAM;
-	self->s.modelIndex = MODELINDEX_WORLD; // must be non-zero
-	self->flags |= FL_TRAP_LASER_FIELD;
-
-	// set the beam diameter
-	if (self->spawnFlags.has(SPAWNFLAG_LASER_FAT))
-		self->s.frame = 16;
-	else
-		self->s.frame = 4;
-
-	// set the color
-	if (self->spawnFlags.has(SPAWNFLAG_LASER_RED))
-		self->s.skinNum = 0xf2f2f0f0;
-	else if (self->spawnFlags.has(SPAWNFLAG_LASER_GREEN))
-		self->s.skinNum = 0xd0d1d2d3;
-	else if (self->spawnFlags.has(SPAWNFLAG_LASER_BLUE))
-		self->s.skinNum = 0xf3f3f1f1;
-	else if (self->spawnFlags.has(SPAWNFLAG_LASER_YELLOW))
-		self->s.skinNum = 0xdcdddedf;
-	else if (self->spawnFlags.has(SPAWNFLAG_LASER_ORANGE))
-		self->s.skinNum = 0xe0e1e2e3;
-
-	SetMoveDir(self->s.angles, self->moveDir);
-
-	if (!self->delay)
-		self->delay = 0.1f;
-
-	if (!self->wait)
-		self->wait = 0.1f;
-
-	if (!self->dmg)
-		self->dmg = 5;
-
-	self->mins = { -8, -8, -8 };
-	self->maxs = { 8, 8, 8 };
-
-	self->nextThink = level.time + GameTime::from_sec(self->delay);
-	self->think = mal_laser_think;
-
-	self->use = target_mal_laser_use;
-
-	gi.linkEntity(self);
-
-	if (self->spawnFlags.has(SPAWNFLAG_LASER_ON))
-		target_mal_laser_on(self);
-	else
-		target_laser_off(self);
-}
-
-
 //==========================================================
 
 /*QUAKED target_steam (1 0 0) (-8 -8 -8) (8 8 8) x x x x x x x x NOT_EASY NOT_MEDIUM NOT_HARD NOT_DM NOT_COOP
@@ -2748,7 +2227,7 @@ If no target set, it will find a player spawn point instead.
 */
 
 static USE(target_teleporter_use) (gentity_t* ent, gentity_t* other, gentity_t* activator) -> void {
-	if (!activator || (!activator->client && Q_strcasecmp(activator->className, "grenade")))
+	if (!activator || (!activator->client && !G_IsClass(activator, EntityClass::Grenade)))
 		return;
 
 	// no target point to teleport to, teleport to a spawn point
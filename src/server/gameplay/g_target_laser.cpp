@@ -0,0 +1,442 @@
+/*Copyright (c) 2024 ZeniMax Media Inc.
+Licensed under the GNU General Public License 2.0.
+
+g_target_laser.cpp (Laser Targets) Implements `target_laser` and `target_mal_laser`, beams that
+damage whatever crosses them. Key Responsibilities: - Beam Trace: each think pierces along the
+beam, damaging monsters and players until something solid stops it. - Persistent Beams: a beam
+that ended on static geometry keeps its result, and is only traced again once its origin or
+direction changes, its blocker moves or turns, or the broadphase finds an entity inside the beam's bounds;
+an unchanged beam is not relinked either. - Mal's Laser: a pulsing variant that reuses the beam
+think on a timer.*/
+
+#include "../g_local.hpp"
+
+/*QUAKED target_laser (0 .5 .8) (-8 -8 -8) (8 8 8) START_ON RED GREEN BLUE YELLOW ORANGE FAT WINDOWSTOP NOT_EASY NOT_MEDIUM NOT_HARD NOT_DM NOT_COOP
+When triggered, fires a laser. You can either set a target or a direction.
+
+START_ON	- if set, the laser will be on when spawned
+FAT			- if set, the laser will be wider
+WINDOWSTOP	- if set, the laser will stop at windows and not pass through them
+
+In N64, WINDOWSTOP is used to make the laser a lightning bolt.
+*/
+
+constexpr SpawnFlags SPAWNFLAG_LASER_STOPWINDOW = 0x0080_spawnflag;
+
+struct laser_pierce_t : pierce_args_t {
+	gentity_t* self;
+	int32_t count;
+	bool damaged_thing = false;
+
+	inline laser_pierce_t(gentity_t* self, int32_t count) :
+		pierce_args_t(),
+		self(self),
+		count(count) {
+	}
+
+	// we hit an entity; return false to stop the piercing.
+	// you can adjust the mask for the re-trace (for water, etc).
+	virtual bool hit(contents_t& mask, Vector3& end) override {
+		// hurt it if we can
+		if (self->dmg > 0 && (tr.ent->takeDamage) && !(tr.ent->flags & FL_IMMUNE_LASER) && self->damage_debounce_time <= level.time) {
+			damaged_thing = true;
+			Damage(tr.ent, self, self->activator, self->moveDir, tr.endPos, vec3_origin, self->dmg, 1, DamageFlags::Energy, ModID::Laser);
+		}
+
+		// if we hit something that's not a monster or player or is immune to lasers, we're done
+		if (!(tr.ent->svFlags & SVF_MONSTER) && (!tr.ent->client) && !(tr.ent->flags & FL_DAMAGEABLE)) {
+			if (self->spawnFlags.has(SPAWNFLAG_LASER_ZAP)) {
+				self->spawnFlags &= ~SPAWNFLAG_LASER_ZAP;
+				gi.WriteByte(svc_temp_entity);
+				gi.WriteByte(TE_LASER_SPARKS);
+				gi.WriteByte(count);
+				gi.WritePosition(tr.endPos);
+				gi.WriteDir(tr.plane.normal);
+				gi.WriteByte(self->s.skinNum);
+				gi.multicast(tr.endPos, MULTICAST_PVS, false);
+			}
+
+			return false;
+		}
+
+		if (!mark(tr.ent))
+			return false;
+
+		return true;
+	}
+};
+
+// what a beam last ended on, kept while nothing along it changes; not saved
+struct laser_beam_t {
+	bool		valid = false;
+	int32_t		spawnCount = 0;
+	GameTime	time = 0_ms;
+	Vector3		start = vec3_origin;
+	Vector3		dir = vec3_origin;
+	Vector3		end = vec3_origin;
+	contents_t	mask = CONTENTS_NONE;
+	bool		struck = false;			// stopped by something rather than running out
+	gentity_t*	blocker = nullptr;		// the entity that stopped it, unless the world did
+	int32_t		blockerSpawnCount = 0;
+	solid_t		blockerSolid = SOLID_NOT;
+	Vector3		blockerMins = vec3_origin;
+	Vector3		blockerMaxs = vec3_origin;
+	Vector3		blockerOrigin = vec3_origin;
+	Vector3		blockerAngles = vec3_origin;	// rotating brushes turn inside unchanged bounds
+};
+
+static std::vector<laser_beam_t> laserBeams;
+
+/*
+=============
+LaserBeamFor
+=============
+*/
+static laser_beam_t& LaserBeamFor(gentity_t* self) {
+	const size_t index = static_cast<size_t>(self - g_entities);
+
+	if (laserBeams.size() <= index)
+		laserBeams.resize(std::max<size_t>(index + 1, game.maxEntities));
+
+	return laserBeams[index];
+}
+
+/*
+=============
+LaserBeam_BoxFilter
+
+Stops at the first solid entity in the beam's bounds other than the one
+the beam already ends on.
+=============
+*/
+static BoxEntitiesResult_t LaserBeam_BoxFilter(gentity_t* ent, void* data) {
+	const laser_beam_t* beam = static_cast<const laser_beam_t*>(data);
+
+	if (ent == beam->blocker)
+		return BoxEntitiesResult_t::Skip;
+
+	return BoxEntitiesResult_t::Keep | BoxEntitiesResult_t::End;
+}
+
+/*
+=============
+LaserBeamHolds
+
+True when the last trace along the beam would come out the same: same
+start, direction and mask, a blocker that has neither moved nor turned,
+and no other solid entity inside the beam's bounds.
+=============
+*/
+static bool LaserBeamHolds(const gentity_t* self, const laser_beam_t& beam, const Vector3& start, contents_t mask) {
+	if (!beam.valid || beam.spawnCount != self->spawn_count || level.time < beam.time)
+		return false;
+
+	if (beam.start != start || beam.dir != self->moveDir || beam.mask != mask || self->s.oldOrigin != beam.end)
+		return false;
+
+	// sparks need a real hit to come from
+	if (beam.struck && self->spawnFlags.has(SPAWNFLAG_LASER_ZAP))
+		return false;
+
+	if (beam.blocker) {
+		const gentity_t* blocker = beam.blocker;
+
+		if (!blocker->inUse || blocker->spawn_count != beam.blockerSpawnCount || blocker->solid != beam.blockerSolid ||
+			blocker->absMin != beam.blockerMins || blocker->absMax != beam.blockerMaxs ||
+			blocker->s.origin != beam.blockerOrigin || blocker->s.angles != beam.blockerAngles)
+			return false;
+	}
+
+	Vector3 mins, maxs;
+	for (int i = 0; i < 3; i++) {
+		mins[i] = std::min(beam.start[i], beam.end[i]) - 1.0f;
+		maxs[i] = std::max(beam.start[i], beam.end[i]) + 1.0f;
+	}
+
+	gentity_t* inside[1];
+	return !gi.BoxEntities(mins, maxs, inside, q_countof(inside), AREA_SOLID, LaserBeam_BoxFilter, const_cast<laser_beam_t*>(&beam));
+}
+
+/*
+=============
+RememberLaserBeam
+
+Keeps a beam that ended on something that cannot be hurt, with nothing
+pierced on the way; anything else has to be traced again next think.
+=============
+*/
+static void RememberLaserBeam(gentity_t* self, laser_beam_t& beam, const Vector3& start, contents_t mask, const laser_pierce_t& args) {
+	const trace_t& tr = args.tr;
+	const bool struck = tr.ent && tr.fraction < 1.0f;
+	gentity_t* blocker = struck && tr.ent != world ? tr.ent : nullptr;
+
+	beam.valid = !args.num_pierced && !args.damaged_thing && !(blocker && blocker->takeDamage);
+	if (!beam.valid)
+		return;
+
+	beam.spawnCount = self->spawn_count;
+	beam.time = level.time;
+	beam.start = start;
+	beam.dir = self->moveDir;
+	beam.end = self->s.oldOrigin;
+	beam.mask = mask;
+	beam.struck = struck;
+	beam.blocker = blocker;
+
+	if (blocker) {
+		beam.blockerSpawnCount = blocker->spawn_count;
+		beam.blockerSolid = blocker->solid;
+		beam.blockerMins = blocker->absMin;
+		beam.blockerMaxs = blocker->absMax;
+		beam.blockerOrigin = blocker->s.origin;
+		beam.blockerAngles = blocker->s.angles;
+	}
+}
+
+THINK(target_laser_think) (gentity_t* self) -> void {
+	int32_t count;
+
+	if (self->spawnFlags.has(SPAWNFLAG_LASER_ZAP))
+		count = 8;
+	else
+		count = 4;
+
+	if (self->enemy) {
+		Vector3 last_movedir = self->moveDir;
+		Vector3 point = (self->enemy->absMin + self->enemy->absMax) * 0.5f;
+		self->moveDir = point - self->s.origin;
+		self->moveDir.normalize();
+		if (self->moveDir != last_movedir)
+			self->spawnFlags |= SPAWNFLAG_LASER_ZAP;
+	}
+
+	Vector3 start = self->s.origin;
+	Vector3 end = start + (self->moveDir * 2048);
+
+	contents_t mask = self->spawnFlags.has(SPAWNFLAG_LASER_STOPWINDOW) ? MASK_SHOT : (CONTENTS_SOLID | CONTENTS_MONSTER | CONTENTS_PLAYER | CONTENTS_DEADMONSTER);
+
+	// nothing along the beam has changed, so neither has what it hits
+	laser_beam_t& beam = LaserBeamFor(self);
+	if (LaserBeamHolds(self, beam, start, mask)) {
+		self->nextThink = level.time + FRAME_TIME_S;
+		return;
+	}
+
+	laser_pierce_t args{
+		self,
+		count
+	};
+
+	pierce_trace(start, end, self, args, mask);
+
+	self->s.oldOrigin = args.tr.endPos;
+
+	if (args.damaged_thing)
+		self->damage_debounce_time = level.time + 10_hz;
+
+	RememberLaserBeam(self, beam, start, mask, args);
+
+	self->nextThink = level.time + FRAME_TIME_S;
+	gi.linkEntity(self);
+}
+
+static void target_laser_on(gentity_t* self) {
+	if (!self->activator)
+		self->activator = self;
+	self->spawnFlags |= SPAWNFLAG_LASER_ZAP | SPAWNFLAG_LASER_ON;
+	self->svFlags &= ~SVF_NOCLIENT;
+	self->flags |= FL_TRAP;
+	target_laser_think(self);
+}
+
+void target_laser_off(gentity_t* self) {
+	self->spawnFlags &= ~SPAWNFLAG_LASER_ON;
+	self->svFlags |= SVF_NOCLIENT;
+	self->flags &= ~FL_TRAP;
+	self->nextThink = 0_ms;
+}
+
+static USE(target_laser_use) (gentity_t* self, gentity_t* other, gentity_t* activator) -> void {
+	self->activator = activator;
+	if (self->spawnFlags.has(SPAWNFLAG_LASER_ON))
+		target_laser_off(self);
+	else
+		target_laser_on(self);
+}
+
+static THINK(target_laser_start) (gentity_t* self) -> void {
+	self->moveType = MoveType::None;
+	self->solid = SOLID_NOT;
+	self->s.renderFX |= RF_BEAM;
+	self->s.modelIndex = MODELINDEX_WORLD; // must be non-zero
+
+	// [Sam-KEX] On Q2N64, spawnflag of 128 turns it into a lightning bolt
+	if (level.isN64) {
+		// Paril: fix for N64
+		if (self->spawnFlags.has(SPAWNFLAG_LASER_STOPWINDOW)) {
+			self->spawnFlags &= ~SPAWNFLAG_LASER_STOPWINDOW;
+			self->spawnFlags |= SPAWNFLAG_LASER_LIGHTNING;
+		}
+	}
+
+	if (self->spawnFlags.has(SPAWNFLAG_LASER_LIGHTNING)) {
+		self->s.renderFX |= RF_BEAM_LIGHTNING; // tell renderer it is lightning
+
+		if (!self->s.skinNum)
+			self->s.skinNum = 0xf3f3f1f1; // default lightning color
+	}
+
+	// set the beam diameter
+	// [Paril-KEX] lab has this set prob before lightning was implemented
+	if (!level.isN64 && self->spawnFlags.has(SPAWNFLAG_LASER_FAT))
+		self->s.frame = 16;
+	else
+		self->s.frame = 4;
+
+	// set the color
+	if (!self->s.skinNum) {
+		if (self->spawnFlags.has(SPAWNFLAG_LASER_RED))
+			self->s.skinNum = 0xf2f2f0f0;
+		else if (self->spawnFlags.has(SPAWNFLAG_LASER_GREEN))
+			self->s.skinNum = 0xd0d1d2d3;
+		else if (self->spawnFlags.has(SPAWNFLAG_LASER_BLUE))
+			self->s.skinNum = 0xf3f3f1f1;
+		else if (self->spawnFlags.has(SPAWNFLAG_LASER_YELLOW))
+			self->s.skinNum = 0xdcdddedf;
+		else if (self->spawnFlags.has(SPAWNFLAG_LASER_ORANGE))
+			self->s.skinNum = 0xe0e1e2e3;
+	}
+
+	if (!self->enemy) {
+		if (self->target) {
+			gentity_t* targetEnt = G_FindByString<&gentity_t::targetName>(nullptr, self->target);
+			if (!targetEnt)
+				gi.Com_PrintFmt("{}: {} is a bad target.\n", *self, self->target);
+			else {
+				self->enemy = targetEnt;
+
+				// N64 fix
+				// FIXME: which map was this for again? oops
+				// muff: it is down to one of these maps:
+				// cargo, complex, core, jail, lab, orbit, process, storage
+				if (level.isN64 && G_IsClass(self->enemy, EntityClass::FuncTrain) && !(self->enemy->spawnFlags & SPAWNFLAG_TRAIN_START_ON))
+					self->enemy->use(self->enemy, self, self);
+			}
+		}
+		else {
+			SetMoveDir(self->s.angles, self->moveDir);
+		}
+	}
+	self->use = target_laser_use;
+	self->think = target_laser_think;
+
+	if (!self->dmg)
+		self->dmg = 1;
+
+	self->mins = { -8, -8, -8 };
+	self->maxs = { 8, 8, 8 };
+	gi.linkEntity(self);
+
+	if (self->spawnFlags.has(SPAWNFLAG_LASER_ON))
+		target_laser_on(self);
+	else
+		target_laser_off(self);
+}
+
+void SP_target_laser(gentity_t* self) {
+	// let everything else get spawned before we start firing
+	self->think = target_laser_start;
+	self->flags |= FL_TRAP_LASER_FIELD;
+	self->nextThink = level.time + 1_sec;
+}
+
+//==========================================================
+
+/*QUAKED target_mal_laser (1 0 0) (-4 -4 -4) (4 4 4) START_ON RED GREEN BLUE YELLOW ORANGE FAT x NOT_EASY NOT_MEDIUM NOT_HARD NOT_DM NOT_COOP
+Mal's laser
+*/
+static void target_mal_laser_on(gentity_t* self) {
+	if (!self->activator)
+		self->activator = self;
+	self->spawnFlags |= SPAWNFLAG_LASER_ZAP | SPAWNFLAG_LASER_ON;
+	self->svFlags &= ~SVF_NOCLIENT;
+	self->flags |= FL_TRAP;
+	// target_laser_think (self);
+	self->nextThink = level.time + GameTime::from_sec(self->wait + self->delay);
+}
+
+static USE(target_mal_laser_use) (gentity_t* self, gentity_t* other, gentity_t* activator) -> void {
+	self->activator = activator;
+	if (self->spawnFlags.has(SPAWNFLAG_LASER_ON))
+		target_laser_off(self);
+	else
+		target_mal_laser_on(self);
+}
+
+void mal_laser_think(gentity_t* self);
+
+static THINK(mal_laser_think2) (gentity_t* self) -> void {
+	self->svFlags |= SVF_NOCLIENT;
+	self->think = mal_laser_think;
+	self->nextThink = level.time + GameTime::from_sec(self->wait);
+	self->spawnFlags |= SPAWNFLAG_LASER_ZAP;
+}
+
+THINK(mal_laser_think) (gentity_t* self) -> void {
+	self->svFlags &= ~SVF_NOCLIENT;
+	target_laser_think(self);
+	self->think = mal_laser_think2;
+	self->nextThink = level.time + 100_ms;
+}
+
+void SP_target_mal_laser(gentity_t* self) {
+	self->moveType = MoveType::None;
+	self->solid = SOLID_NOT;
+	self->s.renderFX |= RF_BEAM;
+	self->s.modelIndex = MODELINDEX_WORLD; // must be non-zero
+	self->flags |= FL_TRAP_LASER_FIELD;
+
+	// set the beam diameter
+	if (self->spawnFlags.has(SPAWNFLAG_LASER_FAT))
+		self->s.frame = 16;
+	else
+		self->s.frame = 4;
+
+	// set the color
+	if (self->spawnFlags.has(SPAWNFLAG_LASER_RED))
+		self->s.skinNum = 0xf2f2f0f0;
+	else if (self->spawnFlags.has(SPAWNFLAG_LASER_GREEN))
+		self->s.skinNum = 0xd0d1d2d3;
+	else if (self->spawnFlags.has(SPAWNFLAG_LASER_BLUE))
+		self->s.skinNum = 0xf3f3f1f1;
+	else if (self->spawnFlags.has(SPAWNFLAG_LASER_YELLOW))
+		self->s.skinNum = 0xdcdddedf;
+	else if (self->spawnFlags.has(SPAWNFLAG_LASER_ORANGE))
+		self->s.skinNum = 0xe0e1e2e3;
+
+	SetMoveDir(self->s.angles, self->moveDir);
+
+	if (!self->delay)
+		self->delay = 0.1f;
+
+	if (!self->wait)
+		self->wait = 0.1f;
+
+	if (!self->dmg)
+		self->dmg = 5;
+
+	self->mins = { -8, -8, -8 };
+	self->maxs = { 8, 8, 8 };
+
+	self->nextThink = level.time + GameTime::from_sec(self->delay);
+	self->think = mal_laser_think;
+
+	self->use = target_mal_laser_use;
+
+	gi.linkEntity(self);
+
+	if (self->spawnFlags.has(SPAWNFLAG_LASER_ON))
+		target_mal_laser_on(self);
+	else
+		target_laser_off(self);
+}
@@ -0,0 +1,438 @@
+/*Copyright (c) 2024 ZeniMax Media Inc.
+Licensed under the GNU General Public License 2.0.
+
+g_target_poi.cpp (Points of Interest) Implements `target_poi`, the markers that point coop players
+at their next objective. Key Responsibilities: - Activation: a used POI, or the best member of a
+POI team, becomes the level's current point of interest, honouring stages and styles. - Path
+Distances: NEAREST teams rank members by nav path length from the activator; lengths are cached
+per POI and per region of the map, dropped whenever a door opens, closes or is locked, and only a
+few new path requests are made per frame; an activation whose members cannot all be measured
+this frame is retried on the next.*/
+
+#include "../g_local.hpp"
+
+#include <unordered_map>
+
+/*QUAKED target_poi (1 0 0) (-4 -4 -4) (4 4 4) NEAREST DUMMY DYNAMIC x x x x x NOT_EASY NOT_MEDIUM NOT_HARD NOT_DM NOT_COOP
+[Paril-KEX] point of interest for help in player navigation.
+Without any additional setup, targeting this entity will switch
+the current POI in the level to the one this is linked to.
+
+"count": if set, this value is the 'stage' linked to this POI. A POI
+with this set that is activated will only take effect if the current
+level's stage value is <= this value, and if it is, will also set
+the current level's stage value to this value.
+
+"style": only used for teamed POIs; the POI with the lowest style will
+be activated when checking for which POI to activate. This is mainly
+useful during development, to easily insert or change the order of teamed
+POIs without needing to manually move the entity definitions around.
+
+"team": if set, this will create a team of POIs. Teamed POIs act like
+a single unit; activating any of them will do the same thing. When activated,
+it will filter through all of the POIs on the team selecting the one that
+best fits the current situation. This includes checking "count" and "style"
+values. You can also set the NEAREST spawnflag on any of the teamed POIs,
+which will additionally cause activation to prefer the nearest one to the player.
+Killing a POI via killTarget will remove it from the chain, allowing you to
+adjust valid POIs at runtime.
+
+The DUMMY spawnflag is to allow you to use a single POI as a team member
+that can be activated, if you're using killtargets to remove POIs.
+
+The DYNAMIC spawnflag is for very specific circumstances where you want
+to direct the player to the nearest teamed POI, but want the path to pick
+the nearest at any given time rather than only when activated.
+
+The DISABLED flag is mainly intended to work with DYNAMIC & teams; the POI
+will be disabled until it is targeted, and afterwards will be enabled until
+it is killed.
+*/
+
+constexpr SpawnFlags SPAWNFLAG_POI_NEAREST = 1_spawnflag;
+constexpr SpawnFlags SPAWNFLAG_POI_DUMMY = 2_spawnflag;
+constexpr SpawnFlags SPAWNFLAG_POI_DYNAMIC = 4_spawnflag;
+constexpr SpawnFlags SPAWNFLAG_POI_DISABLED = 8_spawnflag;
+
+namespace {
+
+// path lengths are shared by every start point inside one cell of this size
+constexpr float POI_PATH_CELL_SIZE = 128.f;
+
+// new path requests allowed per frame; beyond this, activations wait for the next frame
+constexpr int32_t POI_PATH_QUERIES_PER_FRAME = 4;
+
+struct poi_path_t {
+	int32_t	spawnCount = 0;
+	Vector3	goal = vec3_origin;
+	float	distSqr = 0.f;
+};
+
+// path lengths to POIs for this level; not saved
+struct poi_paths_t {
+	std::unordered_map<uint64_t, poi_path_t> paths;
+	bool		noNav = false;
+	bool		hasSignature = false;
+	uint64_t	navSignature = 0;
+	GameTime	signatureTime = 0_ms;
+	GameTime	budgetTime = 0_ms;
+	int32_t		queries = 0;
+};
+
+poi_paths_t poiPaths;
+
+/*
+=============
+NavLinkSignature
+
+Hashes the state of every door, which is what opens and closes the
+links between nav nodes; computed at most once a frame.
+=============
+*/
+uint64_t NavLinkSignature() {
+	uint64_t hash = 14695981039346656037ULL;
+	auto mix = [&hash](uint64_t value) {
+		hash ^= value;
+		hash *= 1099511628211ULL;
+	};
+
+	for (const gentity_t* ent : G_RegistryMembers(EntityRegistry::Mover)) {
+		if (!(ent->svFlags & SVF_DOOR))
+			continue;
+
+		mix(static_cast<uint64_t>(ent->s.number));
+		mix(static_cast<uint64_t>(ent->moveInfo.state));
+		mix((ent->flags & FL_LOCKED) ? 1 : 0);
+	}
+
+	return hash;
+}
+
+/*
+=============
+PoiPathKey
+=============
+*/
+uint64_t PoiPathKey(const gentity_t* poi, const Vector3& start) {
+	uint64_t key = static_cast<uint16_t>(poi->s.number);
+
+	for (int i = 0; i < 3; i++)
+		key = (key << 16) | static_cast<uint16_t>(static_cast<int16_t>(std::floor(start[i] / POI_PATH_CELL_SIZE)));
+
+	return key;
+}
+
+/*
+=============
+FindPoiPath
+
+The cached path length from `start`'s cell to a POI, if there is one
+for the POI as it is now and the doors have not changed since.
+=============
+*/
+const poi_path_t* FindPoiPath(const Vector3& start, const gentity_t* poi) {
+	if (!poiPaths.hasSignature || poiPaths.signatureTime != level.time) {
+		const uint64_t signature = NavLinkSignature();
+
+		if (poiPaths.hasSignature && signature != poiPaths.navSignature)
+			poiPaths.paths.clear();
+		poiPaths.hasSignature = true;
+		poiPaths.navSignature = signature;
+		poiPaths.signatureTime = level.time;
+	}
+
+	const uint64_t key = PoiPathKey(poi, start);
+
+	if (auto it = poiPaths.paths.find(key); it != poiPaths.paths.end()) {
+		if (it->second.spawnCount == poi->spawn_count && it->second.goal == poi->s.origin)
+			return &it->second;
+		poiPaths.paths.erase(it);
+	}
+
+	return nullptr;
+}
+
+/*
+=============
+MeasurePoiPath
+
+Requests the nav path length from `start` to a POI unless it is already
+cached. Returns false if it is not known and this frame's path requests
+are spent.
+=============
+*/
+bool MeasurePoiPath(const Vector3& start, const gentity_t* poi) {
+	if (poiPaths.noNav || FindPoiPath(start, poi))
+		return true;
+
+	if (poiPaths.budgetTime != level.time) {
+		poiPaths.budgetTime = level.time;
+		poiPaths.queries = 0;
+	}
+
+	if (poiPaths.queries >= POI_PATH_QUERIES_PER_FRAME)
+		return false;
+	poiPaths.queries++;
+
+	const Vector3& end = poi->s.origin;
+
+	PathRequest request;
+	request.start = start;
+	request.goal = end;
+	request.moveDist = 64.f;
+	request.pathFlags = PathFlags::All;
+	request.nodeSearch.ignoreNodeFlags = true;
+	request.nodeSearch.minHeight = 128.0f;
+	request.nodeSearch.maxHeight = 128.0f;
+	request.nodeSearch.radius = 1024.0f;
+	request.pathPoints.count = 0;
+
+	PathInfo info;
+	float distSqr;
+
+	if (gi.GetPathToGoal(request, info))
+		distSqr = info.pathDistSqr;
+	else if (info.returnCode == PathReturnCode::NoNavAvailable) {
+		poiPaths.noNav = true;
+		return true;
+	}
+	else
+		distSqr = std::numeric_limits<float>::infinity();
+
+	poiPaths.paths[PoiPathKey(poi, start)] = { poi->spawn_count, end, distSqr };
+	return true;
+}
+
+/*
+=============
+distance_to_poi
+
+Squared nav path length from `start` to a POI, infinite if it cannot
+be reached; MeasurePoiPath must have succeeded for it this frame.
+Straight-line distance without a nav file.
+=============
+*/
+float distance_to_poi(const Vector3& start, const gentity_t* poi) {
+	if (!poiPaths.noNav)
+		if (const poi_path_t* path = FindPoiPath(start, poi))
+			return path->distSqr;
+
+	return (poi->s.origin - start).lengthSquared();
+}
+
+} // namespace
+
+/*
+=============
+G_PoiPathsClear
+
+Forgets every path length; used when a level is loaded and by both world
+resets, re-parse and snapshot restore.
+=============
+*/
+void G_PoiPathsClear() {
+	poiPaths = {};
+}
+
+static void target_poi_use_deferred(gentity_t* self);
+
+USE(target_poi_use) (gentity_t* ent, gentity_t* other, gentity_t* activator) -> void {
+	// we were disabled, so remove the disable check
+	if (ent->spawnFlags.has(SPAWNFLAG_POI_DISABLED))
+		ent->spawnFlags &= ~SPAWNFLAG_POI_DISABLED;
+
+	// early stage check
+	if (ent->count && level.poi.currentStage > ent->count)
+		return;
+
+	// teamed POIs work a bit differently
+	if (ent->team) {
+		gentity_t* poi_master = ent->teamMaster;
+
+		// every member is ranked by path length, so all of them have to be
+		// measured first; if that takes more than this frame's path
+		// requests, try again next frame rather than rank by a mix
+		if (poi_master->spawnFlags.has(SPAWNFLAG_POI_NEAREST)) {
+			bool measured = true;
+
+			for (gentity_t* poi = poi_master; poi; poi = poi->teamChain) {
+				if (poi->spawnFlags.has(SPAWNFLAG_POI_DISABLED | SPAWNFLAG_POI_DUMMY))
+					continue;
+				if (poi->count && level.poi.currentStage > poi->count)
+					continue;
+				if (!MeasurePoiPath(activator->s.origin, poi))
+					measured = false;
+			}
+
+			if (!measured) {
+				ent->activator = activator;
+				ent->think = target_poi_use_deferred;
+				ent->nextThink = level.time + FRAME_TIME_MS;
+				return;
+			}
+		}
+
+		// unset ent, since we need to find one that matches
+		ent = nullptr;
+
+		float best_distance = std::numeric_limits<float>::infinity();
+		int32_t best_style = std::numeric_limits<int32_t>::max();
+
+		gentity_t* dummy_fallback = nullptr;
+
+		for (gentity_t* poi = poi_master; poi; poi = poi->teamChain) {
+			// currently disabled
+			if (poi->spawnFlags.has(SPAWNFLAG_POI_DISABLED))
+				continue;
+
+			// ignore dummy POI
+			if (poi->spawnFlags.has(SPAWNFLAG_POI_DUMMY)) {
+				dummy_fallback = poi;
+				continue;
+			}
+			// POI is not part of current stage
+			else if (poi->count && level.poi.currentStage > poi->count)
+				continue;
+			// POI isn't the right style
+			else if (poi->style > best_style)
+				continue;
+
+			float dist = distance_to_poi(activator->s.origin, poi);
+
+			// we have one already and it's farther away, don't bother
+			if (poi_master->spawnFlags.has(SPAWNFLAG_POI_NEAREST) &&
+				ent &&
+				dist > best_distance)
+				continue;
+
+			// found a better style; overwrite dist
+			if (poi->style < best_style) {
+				// unless we weren't reachable...
+				if (poi_master->spawnFlags.has(SPAWNFLAG_POI_NEAREST) && std::isinf(dist))
+					continue;
+
+				best_style = poi->style;
+				if (poi_master->spawnFlags.has(SPAWNFLAG_POI_NEAREST))
+					best_distance = dist;
+				ent = poi;
+				continue;
+			}
+
+			// if we're picking by nearest, check distance
+			if (poi_master->spawnFlags.has(SPAWNFLAG_POI_NEAREST)) {
+				if (dist < best_distance) {
+					best_distance = dist;
+					ent = poi;
+					continue;
+				}
+			}
+			else {
+				// not picking by distance, so it's order of appearance
+				ent = poi;
+			}
+		}
+
+		// no valid POI found; this isn't always an error,
+		// some valid techniques may require this to happen.
+		if (!ent) {
+			if (dummy_fallback && dummy_fallback->spawnFlags.has(SPAWNFLAG_POI_DYNAMIC))
+				ent = dummy_fallback;
+			else
+				return;
+		}
+
+		// copy over POI stage value
+		if (ent->count) {
+			if (level.poi.currentStage <= ent->count)
+				level.poi.currentStage = ent->count;
+		}
+	}
+	else {
+		if (ent->count) {
+			if (level.poi.currentStage <= ent->count)
+				level.poi.currentStage = ent->count;
+			else
+				return; // this POI is not part of our current stage
+		}
+	}
+
+	// dummy POI; not valid
+	if (G_IsClass(ent, EntityClass::TargetPoi) && ent->spawnFlags.has(SPAWNFLAG_POI_DUMMY) && !ent->spawnFlags.has(SPAWNFLAG_POI_DYNAMIC))
+		return;
+
+	level.poi.valid = true;
+	level.poi.current = ent->s.origin;
+	level.poi.currentImage = ent->noiseIndex;
+
+	if (G_IsClass(ent, EntityClass::TargetPoi) && ent->spawnFlags.has(SPAWNFLAG_POI_DYNAMIC)) {
+		level.poi.currentDynamic = nullptr;
+
+		// pick the dummy POI, since it isn't supposed to get freed
+		// FIXME maybe store the team string instead?
+
+		for (gentity_t* m = ent->teamMaster; m; m = m->teamChain)
+			if (m->spawnFlags.has(SPAWNFLAG_POI_DUMMY)) {
+				level.poi.currentDynamic = m;
+				break;
+			}
+
+		if (!level.poi.currentDynamic)
+			gi.Com_PrintFmt("can't activate poi for {}; need DUMMY in chain\n", *ent);
+	}
+	else
+		level.poi.currentDynamic = nullptr;
+}
+
+/*
+=============
+target_poi_use_deferred
+
+An activation of a NEAREST team that could not be measured in its
+frame; dropped if the activator has gone.
+=============
+*/
+static THINK(target_poi_use_deferred) (gentity_t* self) -> void {
+	gentity_t* activator = self->activator;
+
+	self->activator = nullptr;
+	if (activator && activator->inUse)
+		target_poi_use(self, self, activator);
+}
+
+static THINK(target_poi_setup) (gentity_t* self) -> void {
+	if (self->team) {
+		// copy dynamic/nearest over to all teammates
+		if (self->spawnFlags.has((SPAWNFLAG_POI_NEAREST | SPAWNFLAG_POI_DYNAMIC)))
+			for (gentity_t* m = self->teamMaster; m; m = m->teamChain)
+				m->spawnFlags |= self->spawnFlags & (SPAWNFLAG_POI_NEAREST | SPAWNFLAG_POI_DYNAMIC);
+
+		for (gentity_t* m = self->teamMaster; m; m = m->teamChain) {
+			if (strcmp(m->className, "target_poi"))
+				gi.Com_PrintFmt("WARNING: {} is teamed with target_poi's; unintentional\n", *m);
+		}
+	}
+}
+
+void SP_target_poi(gentity_t* self) {
+	if (deathmatch->integer) { // auto-remove for deathmatch
+		FreeEntity(self);
+		return;
+	}
+
+	if (st.image)
+		self->noiseIndex = gi.imageIndex(st.image);
+	else
+		self->noiseIndex = gi.imageIndex("friend");
+
+	self->use = target_poi_use;
+	self->svFlags |= SVF_NOCLIENT;
+	self->think = target_poi_setup;
+	self->nextThink = level.time + 1_ms;
+
+	if (!self->team) {
+		if (self->spawnFlags.has(SPAWNFLAG_POI_NEAREST))
+			gi.Com_PrintFmt("{} has useless spawnflag 'NEAREST'\n", *self);
+		if (self->spawnFlags.has(SPAWNFLAG_POI_DYNAMIC))
+			gi.Com_PrintFmt("{} has useless spawnflag 'DYNAMIC'\n", *self);
+	}
+}
@@ -0,0 +1,288 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+g_trace.cpp (Game Trace Facade) Every `gi.trace`/`gi.traceLine` call made by the game module is
+routed through `G_Trace`, which attributes it to the calling source location and keeps per-site
+counters for the current frame, the previous frame, the peak frame and the whole session. Key
+Responsibilities: - Accounting: per-site counts exposed through `sv tracestats` so the heaviest
+trace users can be targeted. - Memoization: when `g_trace_memo` is enabled, identical queries
+(start, end, mins, maxs, mask, passent) issued within one frame are answered from a small cache,
+as long as no entity has been linked or unlinked since the cached result was produced. -
+Invalidation: `local_game_import_t::linkEntity`/`unlinkEntity` bump a world link generation
+that every cached result is stamped with. - Threading: traces issued from job workers
+(e.g. the monster sense phase) bypass the per-site table and memo and are only counted in
+aggregate, since both are owned by the main thread.*/
+
+#include "../g_local.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t TRACE_MAX_SITES = 1024;	// must be a power of two
+constexpr size_t TRACE_MEMO_SLOTS = 512;	// must be a power of two
+
+struct TraceSite {
+	const char* file = nullptr;
+	const char* function = nullptr;
+	uint32_t	line = 0;
+	uint32_t	frameCount = 0;		// traces issued during the current frame
+	uint32_t	lastFrameCount = 0;	// traces issued during the previous frame
+	uint32_t	peakFrameCount = 0;
+	uint64_t	totalCount = 0;
+	uint64_t	memoHits = 0;
+};
+
+// laid out without padding so keys can be hashed and compared bytewise
+struct TraceKey {
+	Vector3				start;
+	Vector3				end;
+	Vector3				mins;
+	Vector3				maxs;
+	const gentity_t*	passent;
+	contents_t			mask;
+	uint32_t			box;
+};
+
+struct TraceMemoEntry {
+	TraceKey	key{};
+	trace_t		result{};
+	uint64_t	frame = 0;
+	uint64_t	linkGeneration = 0;
+};
+
+std::array<TraceSite, TRACE_MAX_SITES> traceSites{};
+size_t traceSiteCount = 0;
+TraceSite traceOverflowSite{ "<overflow>", "<overflow>", 0 };
+
+std::array<TraceMemoEntry, TRACE_MEMO_SLOTS> traceMemo{};
+
+uint64_t traceFrame = 1;
+uint64_t traceLinkGeneration = 1;
+uint64_t traceFramesCounted = 0;
+uint32_t traceFrameTotal = 0;
+uint32_t traceLastFrameTotal = 0;
+uint32_t tracePeakFrameTotal = 0;
+uint64_t traceTotal = 0;
+uint64_t traceMemoHits = 0;
+std::atomic<uint64_t> traceWorkerTotal{ 0 };
+std::thread::id traceMainThread = std::this_thread::get_id();
+
+/*
+===============
+FindSite
+
+Returns the counter slot for a source location. Lines are hashed rather
+than file pointers because inline functions in headers produce one file
+string per translation unit.
+===============
+*/
+TraceSite& FindSite(const std::source_location& where) {
+	const uint32_t line = where.line();
+	size_t slot = (line * 2654435761u) & (TRACE_MAX_SITES - 1);
+
+	for (size_t probe = 0; probe < TRACE_MAX_SITES; probe++, slot = (slot + 1) & (TRACE_MAX_SITES - 1)) {
+		TraceSite& site = traceSites[slot];
+
+		if (!site.file) {
+			// keep a little headroom so probes stay short
+			if (traceSiteCount >= TRACE_MAX_SITES - (TRACE_MAX_SITES / 8))
+				return traceOverflowSite;
+
+			site.file = where.file_name();
+			site.function = where.function_name();
+			site.line = line;
+			traceSiteCount++;
+			return site;
+		}
+
+		if (site.line == line && (site.file == where.file_name() || !strcmp(site.file, where.file_name())))
+			return site;
+	}
+
+	return traceOverflowSite;
+}
+
+/*
+===============
+HashKey
+===============
+*/
+size_t HashKey(const TraceKey& key) {
+	const auto* bytes = reinterpret_cast<const uint8_t*>(&key);
+	uint32_t hash = 2166136261u;
+
+	for (size_t i = 0; i < sizeof(key); i++) {
+		hash ^= bytes[i];
+		hash *= 16777619u;
+	}
+
+	return hash & (TRACE_MEMO_SLOTS - 1);
+}
+
+/*
+===============
+ShortFileName
+===============
+*/
+const char* ShortFileName(const char* path) {
+	const char* name = path;
+
+	for (const char* p = path; *p; p++)
+		if (*p == '/' || *p == '\\')
+			name = p + 1;
+
+	return name;
+}
+
+} // namespace
+
+static_assert(sizeof(TraceKey) == sizeof(Vector3) * 4 + sizeof(const gentity_t*) + sizeof(contents_t) + sizeof(uint32_t),
+	"TraceKey must not contain padding");
+
+/*
+===============
+G_Trace
+
+Single entry point for game-side traces. Counts the call against its
+source location and, with g_trace_memo enabled, reuses an identical
+query's result from earlier in the same frame.
+===============
+*/
+trace_t G_Trace(const Vector3& start, const Vector3* mins, const Vector3* maxs, const Vector3& end, const gentity_t* passent, contents_t contentmask, const std::source_location& where) {
+	if (std::this_thread::get_id() != traceMainThread) {
+		traceWorkerTotal.fetch_add(1, std::memory_order_relaxed);
+		return static_cast<const game_import_t&>(gi).trace(start, mins, maxs, end, passent, contentmask);
+	}
+
+	TraceSite& site = FindSite(where);
+
+	site.frameCount++;
+	site.totalCount++;
+	traceFrameTotal++;
+	traceTotal++;
+
+	if (!g_trace_memo || !g_trace_memo->integer)
+		return static_cast<const game_import_t&>(gi).trace(start, mins, maxs, end, passent, contentmask);
+
+	TraceKey key{};
+	key.start = start;
+	key.end = end;
+	key.mins = mins ? *mins : vec3_origin;
+	key.maxs = maxs ? *maxs : vec3_origin;
+	key.passent = passent;
+	key.mask = contentmask;
+	key.box = (mins || maxs) ? 1 : 0;
+
+	TraceMemoEntry& entry = traceMemo[HashKey(key)];
+
+	if (entry.frame == traceFrame && entry.linkGeneration == traceLinkGeneration && !memcmp(&entry.key, &key, sizeof(key))) {
+		site.memoHits++;
+		traceMemoHits++;
+		return entry.result;
+	}
+
+	entry.key = key;
+	entry.result = static_cast<const game_import_t&>(gi).trace(start, mins, maxs, end, passent, contentmask);
+	entry.frame = traceFrame;
+	entry.linkGeneration = traceLinkGeneration;
+
+	return entry.result;
+}
+
+/*
+===============
+G_TraceWorldChanged
+
+Called whenever an entity is linked or unlinked; any memoized trace
+may now be stale.
+===============
+*/
+void G_TraceWorldChanged() {
+	traceLinkGeneration++;
+}
+
+/*
+===============
+G_TraceBeginFrame
+
+Rolls the per-frame counters over and drops the memo cache.
+===============
+*/
+void G_TraceBeginFrame() {
+	traceMainThread = std::this_thread::get_id();
+
+	for (auto& site : traceSites) {
+		if (!site.file)
+			continue;
+
+		site.lastFrameCount = site.frameCount;
+		site.peakFrameCount = std::max(site.peakFrameCount, site.frameCount);
+		site.frameCount = 0;
+	}
+
+	traceLastFrameTotal = traceFrameTotal;
+	tracePeakFrameTotal = std::max(tracePeakFrameTotal, traceFrameTotal);
+	traceFrameTotal = 0;
+	traceFramesCounted++;
+	traceFrame++;
+}
+
+/*
+===============
+G_TraceStatsReset
+===============
+*/
+void G_TraceStatsReset() {
+	traceSites = {};
+	traceSiteCount = 0;
+	traceOverflowSite = { "<overflow>", "<overflow>", 0 };
+	traceFramesCounted = 0;
+	traceFrameTotal = traceLastFrameTotal = tracePeakFrameTotal = 0;
+	traceTotal = traceMemoHits = 0;
+	traceWorkerTotal = 0;
+}
+
+/*
+===============
+G_TraceStatsPrint
+
+Prints the busiest trace call sites, heaviest first.
+===============
+*/
+void G_TraceStatsPrint(size_t maxSites) {
+	std::vector<const TraceSite*> sorted;
+	sorted.reserve(traceSiteCount + 1);
+
+	for (const auto& site : traceSites)
+		if (site.file)
+			sorted.push_back(&site);
+	if (traceOverflowSite.totalCount)
+		sorted.push_back(&traceOverflowSite);
+
+	std::sort(sorted.begin(), sorted.end(), [](const TraceSite* a, const TraceSite* b) {
+		return a->totalCount > b->totalCount;
+	});
+
+	const uint64_t frames = std::max<uint64_t>(traceFramesCounted, 1);
+
+	gi.Com_PrintFmt("Traces: {} total over {} frames, {:.1f}/frame avg, {} last frame, {} peak, {} memo hits ({})\n",
+		traceTotal, traceFramesCounted, static_cast<double>(traceTotal) / frames, traceLastFrameTotal, tracePeakFrameTotal,
+		traceMemoHits, (g_trace_memo && g_trace_memo->integer) ? "memo on" : "memo off");
+	if (const uint64_t workerTraces = traceWorkerTotal.load(std::memory_order_relaxed))
+		gi.Com_PrintFmt("{} traces issued from job workers (not attributed to sites)\n", workerTraces);
+	gi.Com_PrintFmt("{:>10} {:>8} {:>6} {:>6} {:>8}  site\n", "total", "avg", "last", "peak", "memo");
+
+	for (size_t i = 0; i < sorted.size() && i < maxSites; i++) {
+		const TraceSite& site = *sorted[i];
+
+		gi.Com_PrintFmt("{:>10} {:>8.2f} {:>6} {:>6} {:>8}  {}:{} {}\n",
+			site.totalCount, static_cast<double>(site.totalCount) / frames, site.lastFrameCount, site.peakFrameCount,
+			site.memoHits, ShortFileName(site.file), site.line, site.function);
+	}
+}
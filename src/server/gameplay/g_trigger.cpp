@@ -615,7 +615,7 @@ static TOUCH(trigger_push_touch) (gentity_t* self, gentity_t* other, const trace
 	if (self->target)
 		velocity = self->origin2 ? self->origin2 : self->moveDir * (self->speed * 10);
 
-	if (strcmp(other->className, "grenade") == 0) {
+	if (G_IsClass(other, EntityClass::Grenade)) {
 		other->velocity = velocity ? velocity : self->moveDir * (self->speed * 10);
 	}
 	else if (other->health > 0 || (other->client && other->client->eliminated)) {
@@ -828,7 +828,7 @@ static TOUCH(hurt_touch) (gentity_t* self, gentity_t* other, const trace_t& tr,
 
 	if (!other->takeDamage)
 		return;
-	else if (!(other->svFlags & SVF_MONSTER) && !(other->flags & FL_DAMAGEABLE) && (!other->client) && (strcmp(other->className, "misc_explobox") != 0))
+	else if (!(other->svFlags & SVF_MONSTER) && !(other->flags & FL_DAMAGEABLE) && (!other->client) && !G_IsClass(other, EntityClass::MiscExplobox))
 		return;
 	else if (self->spawnFlags.has(SPAWNFLAG_HURT_NO_MONSTERS) && (other->svFlags & SVF_MONSTER))
 		return;
@@ -1468,8 +1468,8 @@ static TOUCH(trigger_teleport_touch) (gentity_t* self, gentity_t* other, const t
 
 		// draw the teleport splash at source and on the player
 		if (ClientIsPlaying(other->client) && !self->spawnFlags.has(SPAWNFLAG_TELEPORT_NO_FX)) {
-			other->s.event = EV_PLAYER_TELEPORT;
-			self->s.event = EV_PLAYER_TELEPORT;
+			G_SetEvent(other, EV_PLAYER_TELEPORT);
+			G_SetEvent(self, EV_PLAYER_TELEPORT);
 		}
 
 		// set angles
@@ -1557,8 +1557,8 @@ static TOUCH(old_teleporter_touch) (gentity_t* self, gentity_t* other, const tra
 
 	// draw the teleport splash at source and on the player
 	if (ClientIsPlaying(other->client)) {
-		self->enemy->s.event = EV_PLAYER_TELEPORT;
-		other->s.event = EV_PLAYER_TELEPORT;
+		G_SetEvent(self->enemy, EV_PLAYER_TELEPORT);
+		G_SetEvent(other, EV_PLAYER_TELEPORT);
 	}
 
 	// set angles
@@ -1718,7 +1718,7 @@ static void camera_trigger_fire(gentity_t* self) {
 		return;
 
 	gentity_t* cam = PickTarget(self->target);
-	if (!cam || Q_strcasecmp(cam->className, "misc_camera")) {
+	if (!G_IsClass(cam, EntityClass::MiscCamera)) {
 		gi.Com_PrintFmt("{}: target {} is not a misc_camera.\n", *self, self->target);
 		return;
 	}
@@ -323,9 +323,9 @@ void UseTargets(gentity_t* ent, gentity_t* activator) {
 		t = nullptr;
 		while ((t = G_FindByString<&gentity_t::targetName>(t, ent->target))) {
 			// doors fire area portals in a specific way
-			if (!Q_strcasecmp(t->className, "func_areaportal") &&
-				(!Q_strcasecmp(ent->className, "func_door") || !Q_strcasecmp(ent->className, "func_door_rotating")
-					|| !Q_strcasecmp(ent->className, "func_door_secret") || !Q_strcasecmp(ent->className, "func_water")))
+			if (G_IsClass(t, EntityClass::FuncAreaportal) &&
+				(G_IsClass(ent, EntityClass::FuncDoor) || G_IsClass(ent, EntityClass::FuncDoorRotating)
+					|| G_IsClass(ent, EntityClass::FuncDoorSecret) || G_IsClass(ent, EntityClass::FuncWater)))
 				continue;
 
 			if (t == ent) {
@@ -415,6 +415,8 @@ void InitGEntity(gentity_t* e) {
 
 	// do this before calling the spawn function so it can be overridden.
 	e->gravityVector = { 0.0, 0.0, -1.0 };
+
+	G_EntityHotSync(e);
 }
 
 /*
@@ -429,16 +431,14 @@ angles and bad trails.
 =================
 */
 gentity_t* Spawn() {
-	gentity_t* e = &g_entities[static_cast<size_t>(game.maxClients) + 1];
-	size_t i;
-
-	for (i = static_cast<size_t>(game.maxClients + 1); i < globals.numEntities; i++, e++) {
-		// the first couple seconds of server time can involve a lot of
-		// freeing and allocating, so relax the replacement policy
-		if (!e->inUse && (e->freeTime < 2_sec || level.time - e->freeTime > 500_ms)) {
-			InitGEntity(e);
-			return e;
-		}
+	// the first couple seconds of server time can involve a lot of
+	// freeing and allocating, so the replacement policy is relaxed there
+	const size_t i = G_EntityHotFindFree(static_cast<size_t>(game.maxClients) + 1);
+	gentity_t* e = &g_entities[i];
+
+	if (i < globals.numEntities) {
+		InitGEntity(e);
+		return e;
 	}
 
 	if (i == game.maxEntities)
@@ -477,6 +477,7 @@ THINK(FreeEntity) (gentity_t* ed) -> void {
 	//gi.Com_PrintFmt("{}: removing {}\n", __FUNCTION__, *ed);
 
 	gi.Bot_UnRegisterEntity(ed);
+	G_RegistryRemove(ed);
 
 	int32_t id = ed->spawn_count + 1;
 	memset(ed, 0, sizeof(*ed));
@@ -486,6 +487,8 @@ THINK(FreeEntity) (gentity_t* ed) -> void {
 	ed->inUse = false;
 	ed->spawn_count = id;
 	ed->sv.init = false;
+
+	G_EntityHotSync(ed);
 }
 
 /*
@@ -1300,7 +1303,7 @@ void TeleportPlayerToRandomSpawnPoint(gentity_t* ent, bool fx) {
 
 	TeleportPlayer(ent, spawn_origin, spawn_angles);
 
-	ent->s.event = fx ? EV_PLAYER_TELEPORT : EV_OTHER_TELEPORT;
+	G_SetEvent(ent, fx ? EV_PLAYER_TELEPORT : EV_OTHER_TELEPORT);
 }
 
 /*
@@ -1710,19 +1713,20 @@ void CalculateRanks() {
 		if (cl->sess.consolePlayer)
 			level.pop.num_console_clients++;
 
-		if (!ClientIsPlaying(cl)) {
-			if (g_allowSpecVote->integer)
-				level.pop.num_voting_clients++;
+		// a client who can no longer vote takes their vote with them
+		if (G_ClientCanVote(cl))
+			level.pop.num_voting_clients++;
+		else if (cl->pers.voted)
+			G_WithdrawVote(cl);
+
+		if (!ClientIsPlaying(cl))
 			continue;
-		}
 
 		level.pop.num_nonspectator_clients++;
 		level.pop.num_playing_clients++;
 
-		if (!cl->sess.is_a_bot) {
+		if (!cl->sess.is_a_bot)
 			level.pop.num_playing_human_clients++;
-			level.pop.num_voting_clients++;
-		}
 
 		if (level.follow1 == -1)
 			level.follow1 = clientNum;
@@ -1941,11 +1945,7 @@ Returns Weapon::None if not found.
 =============
 */
 Weapon GetWeaponIndexByAbbrev(const std::string& abbr) {
-	const std::string query = NormalizeWeaponAbbreviation(abbr);
-	if (auto weapon = ParseNormalizedWeaponAbbreviation(query)) {
-		return *weapon;
-	}
-	return Weapon::None;
+	return ParseWeaponAbbreviation(abbr).value_or(Weapon::None);
 }
 
 /*
@@ -1989,7 +1989,7 @@ bool Vote_Menu_Active(gentity_t* ent) {
 	if (ent->client->pers.voted)
 		return false;
 
-	if (!g_allowSpecVote->integer && !ClientIsPlaying(ent->client))
+	if (!G_ClientCanVote(ent->client))
 		return false;
 
 	return true;
@@ -5,11 +5,12 @@ g_weapon.cpp (Game Weapon Logic) This file contains the server-side implementati
 player-usable weapons. It is responsible for the mechanics of firing each weapon, spawning the
 appropriate projectiles or performing hitscan traces, and applying damage. Key Responsibilities:
 - Firing Functions: Implements the `fire_*` functions (e.g., `fire_rocket`, `fire_rail`,
-`fire_shotgun`) that are called when a player attacks. - Projectile Spawning: Handles the
+`fire_blaster`) that are called when a player attacks. - Projectile Spawning: Handles the
 creation and initialization of projectile entities, setting their velocity, damage, owner, and
 other properties. - Hitscan Logic: Performs the trace line calculations for instant-hit weapons
-like the shotgun and machinegun. - Damage and Effects: Calls the core `Damage` function to apply
-damage to targets and triggers visual and audio effects for weapon fire. - Weapon State Machine:
+like the railgun; bullets and pellets are in g_weapon_lead.cpp. - Damage and Effects: Calls the
+core `Damage` function to apply damage to targets and triggers visual and audio effects for
+weapon fire. - Weapon State Machine:
 The `Weapon_Generic` function provides a state machine to handle the animation sequence of
 firing a weapon (ready, fire, idle, etc.).*/
 
@@ -114,255 +115,6 @@ bool fire_hit(gentity_t* self, Vector3 aim, int damage, int kick) {
 	return true;
 }
 
-// helper routine for piercing traces;
-// mask = the input mask for finding what to hit
-// you can adjust the mask for the re-trace (for water, etc).
-// note that you must take care in your pierce callback to mark
-// the entities that are being pierced.
-/*
-=============
-pierce_trace
-
-Performs a pierce-aware trace between two points, delegating hit handling to a callback.
-=============
-*/
-void pierce_trace(const Vector3& start, const Vector3& end, gentity_t* ignore, pierce_args_t& pierce, contents_t mask) {
-	Vector3 own_start = start;
-	Vector3 own_end = end;
-
-	for (int loop_count = MAX_ENTITIES; loop_count > 0; --loop_count) {
-		pierce.tr = gi.traceLine(start, own_end, ignore, mask);
-
-		// didn't hit anything, so we're done
-		if (!pierce.tr.ent || pierce.tr.fraction == 1.0f)
-			return;
-
-		// hit callback said we're done
-		if (!pierce.hit(mask, own_end))
-			return;
-
-		own_start = pierce.tr.endPos;
-	}
-
-	gi.Com_Print("runaway pierce_trace\n");
-}
-
-struct fire_lead_pierce_t : pierce_args_t {
-	gentity_t* self;
-	Vector3		 start;
-	Vector3		 aimDir;
-	int			 damage;
-	int			 kick;
-	int			 hSpread;
-	int			 vSpread;
-	MeansOfDeath		 mod;
-	int			 te_impact;
-	contents_t   mask;
-	bool	     water = false;
-	Vector3	     water_start = {};
-	gentity_t* chain = nullptr;
-
-	inline fire_lead_pierce_t(gentity_t* self, Vector3 start, Vector3 aimDir, int damage, int kick, int hSpread, int vSpread, MeansOfDeath mod, int te_impact, contents_t mask) :
-		pierce_args_t(),
-		self(self),
-		start(start),
-		aimDir(aimDir),
-		damage(damage),
-		kick(kick),
-		hSpread(hSpread),
-		vSpread(vSpread),
-		mod(mod),
-		te_impact(te_impact),
-		mask(mask) {
-	}
-
-	// we hit an entity; return false to stop the piercing.
-	// you can adjust the mask for the re-trace (for water, etc).
-	bool hit(contents_t& mask, Vector3& end) override {
-		// see if we hit water
-		if (tr.contents & MASK_WATER) {
-			int color;
-
-			water = true;
-			water_start = tr.endPos;
-
-			// CHECK: is this compare ever true?
-			if (te_impact != -1 && start != tr.endPos) {
-				if (tr.contents & CONTENTS_WATER) {
-					// FIXME: this effectively does nothing..
-					if (strcmp(tr.surface->name, "brwater") == 0)
-						color = SPLASH_BROWN_WATER;
-					else
-						color = SPLASH_BLUE_WATER;
-				}
-				else if (tr.contents & CONTENTS_SLIME)
-					color = SPLASH_SLIME;
-				else if (tr.contents & CONTENTS_LAVA)
-					color = SPLASH_LAVA;
-				else
-					color = SPLASH_UNKNOWN;
-
-				if (color != SPLASH_UNKNOWN) {
-					gi.WriteByte(svc_temp_entity);
-					gi.WriteByte(TE_SPLASH);
-					gi.WriteByte(8);
-					gi.WritePosition(tr.endPos);
-					gi.WriteDir(tr.plane.normal);
-					gi.WriteByte(color);
-					gi.multicast(tr.endPos, MULTICAST_PVS, false);
-				}
-
-				// change bullet's course when it enters water
-				Vector3 dir, forward, right, up;
-				dir = end - start;
-				dir = VectorToAngles(dir);
-				AngleVectors(dir, forward, right, up);
-				float r = crandom() * hSpread * 2;
-				float u = crandom() * vSpread * 2;
-				end = water_start + (forward * 8192);
-				end += (right * r);
-				end += (up * u);
-			}
-
-			// re-trace ignoring water this time
-			mask &= ~MASK_WATER;
-			return true;
-		}
-
-		// did we hit an hurtable entity?
-		if (tr.ent->takeDamage) {
-			Damage(tr.ent, self, self, aimDir, tr.endPos, tr.plane.normal, damage, kick, mod.id == ModID::TeslaMine ? DamageFlags::Energy : DamageFlags::Bullet, mod);
-
-			// only deadmonster is pierceable, or actual dead monsters
-			// that haven't been made non-solid yet
-			if ((tr.ent->svFlags & SVF_DEADMONSTER) ||
-				(tr.ent->health <= 0 && (tr.ent->svFlags & SVF_MONSTER))) {
-				if (!mark(tr.ent))
-					return false;
-
-				return true;
-			}
-		}
-		else {
-			// send gun puff / flash
-			// don't mark the sky
-			if (te_impact != -1 && !(tr.surface && ((tr.surface->flags & SURF_SKY) || strncmp(tr.surface->name, "sky", 3) == 0))) {
-				gi.WriteByte(svc_temp_entity);
-				gi.WriteByte(te_impact);
-				gi.WritePosition(tr.endPos);
-				gi.WriteDir(tr.plane.normal);
-				gi.multicast(tr.endPos, MULTICAST_PVS, false);
-
-				if (self->client)
-					G_PlayerNoise(self, tr.endPos, PlayerNoise::Impact);
-			}
-		}
-
-		// hit a solid, so we're stopping here
-
-		return false;
-	}
-};
-
-/*
-=================
-fire_lead
-
-This is an internal support routine used for bullet/pellet based weapons.
-=================
-*/
-static void fire_lead(gentity_t* self, const Vector3& start, const Vector3& aimDir, int damage, int kick, int te_impact, int hSpread, int vSpread, MeansOfDeath mod) {
-	fire_lead_pierce_t args = {
-		self,
-		start,
-		aimDir,
-		damage,
-		kick,
-		hSpread,
-		vSpread,
-		mod,
-		te_impact,
-		MASK_PROJECTILE | MASK_WATER
-	};
-
-	// [Paril-KEX]
-	if (self->client && !G_ShouldPlayersCollide(true))
-		args.mask &= ~CONTENTS_PLAYER;
-
-	// special case: we started in water.
-	if (gi.pointContents(start) & MASK_WATER) {
-		args.water = true;
-		args.water_start = start;
-		args.mask &= ~MASK_WATER;
-	}
-
-	// check initial firing position
-	pierce_trace(self->s.origin, start, self, args, args.mask);
-
-	// we're clear, so do the second pierce
-	if (args.tr.fraction == 1.f) {
-		args.restore();
-
-		Vector3 end, dir, forward, right, up;
-		dir = VectorToAngles(aimDir);
-		AngleVectors(dir, forward, right, up);
-
-		float r = crandom() * hSpread;
-		float u = crandom() * vSpread;
-		end = start + (forward * 8192);
-		end += (right * r);
-		end += (up * u);
-
-		pierce_trace(args.tr.endPos, end, self, args, args.mask);
-	}
-
-	// if went through water, determine where the end is and make a bubble trail
-	if (args.water && te_impact != -1) {
-		Vector3 pos, dir;
-
-		dir = args.tr.endPos - args.water_start;
-		dir.normalize();
-		pos = args.tr.endPos + (dir * -2);
-		if (gi.pointContents(pos) & MASK_WATER)
-			args.tr.endPos = pos;
-		else
-			args.tr = gi.traceLine(pos, args.water_start, args.tr.ent != world ? args.tr.ent : nullptr, MASK_WATER);
-
-		pos = args.water_start + args.tr.endPos;
-		pos *= 0.5f;
-
-		gi.WriteByte(svc_temp_entity);
-		gi.WriteByte(TE_BUBBLETRAIL);
-		gi.WritePosition(args.water_start);
-		gi.WritePosition(args.tr.endPos);
-		gi.multicast(pos, MULTICAST_PVS, false);
-	}
-}
-
-/*
-=================
-fire_bullet
-
-Fires a single round.  Used for machinegun and chaingun.  Would be fine for
-pistols, rifles, etc....
-=================
-*/
-void fire_bullet(gentity_t* self, const Vector3& start, const Vector3& aimDir, int damage, int kick, int hSpread, int vSpread, MeansOfDeath mod) {
-	fire_lead(self, start, aimDir, damage, kick, mod.id == ModID::TeslaMine ? -1 : TE_GUNSHOT, hSpread, vSpread, mod);
-}
-
-/*
-=================
-fire_shotgun
-
-Shoots shotgun pellets.  Used by shotgun and super shotgun.
-=================
-*/
-void fire_shotgun(gentity_t* self, const Vector3& start, const Vector3& aimDir, int damage, int kick, int hSpread, int vSpread, int count, MeansOfDeath mod) {
-	for (int i = 0; i < count; i++)
-		fire_lead(self, start, aimDir, damage, kick, TE_SHOTGUN, hSpread, vSpread, mod);
-}
-
 /*
 =================
 fire_blaster
@@ -1141,7 +893,7 @@ static THINK(bfg_explode) (gentity_t* self) -> void {
 			if (!CanDamage(ent, self->owner))
 				continue;
 			// make tesla hurt by bfg
-			if (!(ent->svFlags & SVF_MONSTER) && !(ent->flags & FL_DAMAGEABLE) && (!ent->client) && (strcmp(ent->className, "misc_explobox") != 0))
+			if (!(ent->svFlags & SVF_MONSTER) && !(ent->flags & FL_DAMAGEABLE) && (!ent->client) && !G_IsClass(ent, EntityClass::MiscExplobox))
 				continue;
 			// don't target team mates during teamplay if we can't damage them
 			if (CheckTeamDamage(ent, self->owner))
@@ -1271,7 +1023,7 @@ static THINK(bfg_think) (gentity_t* self) -> void {
 			continue;
 
 		// make tesla hurt by bfg
-		if (!(ent->svFlags & SVF_MONSTER) && !(ent->flags & FL_DAMAGEABLE) && (!ent->client) && (strcmp(ent->className, "misc_explobox") != 0))
+		if (!(ent->svFlags & SVF_MONSTER) && !(ent->flags & FL_DAMAGEABLE) && (!ent->client) && !G_IsClass(ent, EntityClass::MiscExplobox))
 			continue;
 		// don't target team mates during teamplay if we can't damage them
 		if (CheckTeamDamage(ent, self->owner))
@@ -1969,7 +1721,7 @@ prox_die
 */
 static DIE(prox_die) (gentity_t* self, gentity_t* inflictor, gentity_t* attacker, int damage, const Vector3& point, const MeansOfDeath& mod) -> void {
 	// if set off by another prox, delay a little (chained explosions)
-	if (strcmp(inflictor->className, "prox_mine")) {
+	if (!G_IsClass(inflictor, EntityClass::ProxMine)) {
 		self->takeDamage = false;
 		Prox_Explode(self);
 	}
@@ -2029,11 +1781,10 @@ static THINK(Prox_TriggerThink) (gentity_t* trigger) -> void {
 		const bool candidate =
 			((search->svFlags & SVF_MONSTER) ||
 				(deathmatch->integer && (search->client ||
-					(search->className && !strcmp(search->className, "prox_mine"))))) ? (search->health > 0) :
+					G_IsClass(search, EntityClass::ProxMine)))) ? (search->health > 0) :
 			(deathmatch->integer &&
-				((strncmp(search->className, "info_player_", 12) == 0) ||
-					(strcmp(search->className, "misc_teleporter_dest") == 0) ||
-					(strncmp(search->className, "item_flag_", 10) == 0)));
+				(G_InClassGroup(search, EntityClassGroup::PlayerSpawn | EntityClassGroup::TeamFlag) ||
+					G_IsClass(search, EntityClass::MiscTeleporterDest)));
 
 		if (!candidate)
 			continue;
@@ -2103,11 +1854,10 @@ static THINK(prox_open) (gentity_t* ent) -> void {
 				const bool candidate =
 					((search->svFlags & SVF_MONSTER) ||
 						(deathmatch->integer && (search->client ||
-							(search->className && !strcmp(search->className, "prox_mine"))))) ? (search->health > 0) :
+							G_IsClass(search, EntityClass::ProxMine)))) ? (search->health > 0) :
 					(deathmatch->integer &&
-						((strncmp(search->className, "info_player_", 12) == 0) ||
-							(strcmp(search->className, "misc_teleporter_dest") == 0) ||
-							(strncmp(search->className, "item_flag_", 10) == 0)));
+						(G_InClassGroup(search, EntityClassGroup::PlayerSpawn | EntityClassGroup::TeamFlag) ||
+							G_IsClass(search, EntityClass::MiscTeleporterDest)));
 
 				if (!candidate)
 					continue;
@@ -2513,7 +2263,7 @@ void Nuke_Explode(gentity_t* ent) {
 
 static DIE(nuke_die) (gentity_t* self, gentity_t* inflictor, gentity_t* attacker, int damage, const Vector3& point, const MeansOfDeath& mod) -> void {
 	self->takeDamage = false;
-	if ((attacker) && !(strcmp(attacker->className, "nuke"))) {
+	if (G_IsClass(attacker, EntityClass::Nuke)) {
 		FreeEntity(self);
 		return;
 	}
@@ -2815,10 +2565,9 @@ static THINK(tesla_activate) (gentity_t* self) -> void {
 			// or it's a player start point
 			// and we can see it
 			// blow up
-			if (search->className && ((deathmatch->integer &&
-				((!strncmp(search->className, "info_player_", 12)) ||
-					(!strcmp(search->className, "misc_teleporter_dest")) ||
-					(!strncmp(search->className, "item_flag_", 10))))) &&
+			if (deathmatch->integer &&
+				(G_InClassGroup(search, EntityClassGroup::PlayerSpawn | EntityClassGroup::TeamFlag) ||
+					G_IsClass(search, EntityClass::MiscTeleporterDest)) &&
 				(visible(search, self))) {
 				BecomeExplosion1(self);
 				return;
@@ -3367,10 +3116,9 @@ static THINK(Trap_Think) (gentity_t* ent) -> void {
 		// or it's a player start point
 		// and we can see it
 		// blow up
-		if (target->className && ((deathmatch->integer &&
-			((!strncmp(target->className, "info_player_", 12)) ||
-				(!strcmp(target->className, "misc_teleporter_dest")) ||
-				(!strncmp(target->className, "item_flag_", 10))))) &&
+		if (deathmatch->integer &&
+			(G_InClassGroup(target, EntityClassGroup::PlayerSpawn | EntityClassGroup::TeamFlag) ||
+				G_IsClass(target, EntityClass::MiscTeleporterDest)) &&
 			(visible(target, ent))) {
 			BecomeExplosion1(ent);
 			return;
@@ -3450,7 +3198,7 @@ static THINK(Trap_Think) (gentity_t* ent) -> void {
 
 					if (!e->inUse)
 						continue;
-					else if (strcmp(e->className, "gib"))
+					else if (!G_IsClass(e, EntityClass::Gib))
 						continue;
 					else if ((e->s.origin - ent->s.origin).length() > 128.f)
 						continue;
@@ -3724,14 +3472,14 @@ Returns the number of mines detonated.
 int G_ExplodeNearbyMinesSafe(const Vector3& origin, float radius, gentity_t* safe) {
 	// Helper classifiers
 	auto IsProxMine = [](const gentity_t* e) -> bool {
-		return e && e->className && strcmp(e->className, "prox_mine") == 0;
+		return G_IsClass(e, EntityClass::ProxMine);
 		};
 	auto IsTeslaMine = [](const gentity_t* e) -> bool {
 		// Allow "tesla", "tesla_mine", "tesla_trap", etc.
-		return e && e->className && strncmp(e->className, "tesla", 5) == 0;
+		return G_InClassGroup(e, EntityClassGroup::Tesla);
 		};
 	auto IsTrap = [](const gentity_t* e) -> bool {
-		return e && e->className && strncmp(e->className, "food_cube_trap", 14) == 0;
+		return G_InClassGroup(e, EntityClassGroup::FoodCubeTrap);
 		};
 
 	// Temporarily suppress damage on the spawning/teleporting player for this clear operation.
@@ -0,0 +1,556 @@
+/*Copyright (c) 2024 ZeniMax Media Inc.
+Licensed under the GNU General Public License 2.0.
+
+g_weapon_lead.cpp (Bullets and Pellets) Hitscan lead for the machinegun, chaingun, shotguns and
+the monsters that use them. Key Responsibilities: - Piercing: `pierce_trace` walks a line
+through water and pierceable bodies, handing each hit to a callback. - Bullets: `fire_lead`
+traces and resolves one round at a time. - Pellets: `fire_shotgun` shares the muzzle checks
+across a shot, traces every pellet without applying anything, then hands each target all the
+pellets that hit it in one `DamageHits` call and sends one impact effect per cluster of pellet
+marks. Pellets that kill a pierceable target carry on past it, as they would one at a time.*/
+
+#include "../g_local.hpp"
+
+#include <vector>
+
+// helper routine for piercing traces;
+// mask = the input mask for finding what to hit
+// you can adjust the mask for the re-trace (for water, etc).
+// note that you must take care in your pierce callback to mark
+// the entities that are being pierced.
+/*
+=============
+pierce_trace
+
+Performs a pierce-aware trace between two points, delegating hit handling to a callback.
+=============
+*/
+void pierce_trace(const Vector3& start, const Vector3& end, gentity_t* ignore, pierce_args_t& pierce, contents_t mask) {
+	Vector3 own_start = start;
+	Vector3 own_end = end;
+
+	for (int loop_count = MAX_ENTITIES; loop_count > 0; --loop_count) {
+		pierce.tr = gi.traceLine(start, own_end, ignore, mask);
+
+		// didn't hit anything, so we're done
+		if (!pierce.tr.ent || pierce.tr.fraction == 1.0f)
+			return;
+
+		// hit callback said we're done
+		if (!pierce.hit(mask, own_end))
+			return;
+
+		own_start = pierce.tr.endPos;
+	}
+
+	gi.Com_Print("runaway pierce_trace\n");
+}
+
+/*
+=============
+LeadPierces
+
+Lead passes through dead monsters, including ones that have not been made
+non-solid yet.
+=============
+*/
+static inline bool LeadPierces(const gentity_t* ent) {
+	return (ent->svFlags & SVF_DEADMONSTER) || (ent->health <= 0 && (ent->svFlags & SVF_MONSTER));
+}
+
+/*
+=============
+LeadDamageFlags
+=============
+*/
+static inline DamageFlags LeadDamageFlags(const MeansOfDeath& mod) {
+	return mod.id == ModID::TeslaMine ? DamageFlags::Energy : DamageFlags::Bullet;
+}
+
+/*
+=============
+LeadBubbleTrail
+
+Bubble trail from where the lead entered water to where it stopped.
+=============
+*/
+static void LeadBubbleTrail(trace_t tr, const Vector3& water_start) {
+	Vector3 pos, dir;
+
+	dir = tr.endPos - water_start;
+	dir.normalize();
+	pos = tr.endPos + (dir * -2);
+	if (gi.pointContents(pos) & MASK_WATER)
+		tr.endPos = pos;
+	else
+		tr = gi.traceLine(pos, water_start, tr.ent != world ? tr.ent : nullptr, MASK_WATER);
+
+	pos = water_start + tr.endPos;
+	pos *= 0.5f;
+
+	gi.WriteByte(svc_temp_entity);
+	gi.WriteByte(TE_BUBBLETRAIL);
+	gi.WritePosition(water_start);
+	gi.WritePosition(tr.endPos);
+	gi.multicast(pos, MULTICAST_PVS, false);
+}
+
+struct fire_lead_pierce_t : pierce_args_t {
+	gentity_t* self;
+	Vector3		 start;
+	Vector3		 aimDir;
+	int			 damage;
+	int			 kick;
+	int			 hSpread;
+	int			 vSpread;
+	MeansOfDeath		 mod;
+	int			 te_impact;
+	contents_t   mask;
+	bool	     water = false;
+	Vector3	     water_start = {};
+	gentity_t* chain = nullptr;
+
+	inline fire_lead_pierce_t(gentity_t* self, Vector3 start, Vector3 aimDir, int damage, int kick, int hSpread, int vSpread, MeansOfDeath mod, int te_impact, contents_t mask) :
+		pierce_args_t(),
+		self(self),
+		start(start),
+		aimDir(aimDir),
+		damage(damage),
+		kick(kick),
+		hSpread(hSpread),
+		vSpread(vSpread),
+		mod(mod),
+		te_impact(te_impact),
+		mask(mask) {
+	}
+
+	// the trace hit water: splash, bend the lead, and re-trace without water
+	bool enter_water(contents_t& mask, Vector3& end) {
+		int color;
+
+		water = true;
+		water_start = tr.endPos;
+
+		// CHECK: is this compare ever true?
+		if (te_impact != -1 && start != tr.endPos) {
+			if (tr.contents & CONTENTS_WATER) {
+				// FIXME: this effectively does nothing..
+				if (strcmp(tr.surface->name, "brwater") == 0)
+					color = SPLASH_BROWN_WATER;
+				else
+					color = SPLASH_BLUE_WATER;
+			}
+			else if (tr.contents & CONTENTS_SLIME)
+				color = SPLASH_SLIME;
+			else if (tr.contents & CONTENTS_LAVA)
+				color = SPLASH_LAVA;
+			else
+				color = SPLASH_UNKNOWN;
+
+			if (color != SPLASH_UNKNOWN) {
+				gi.WriteByte(svc_temp_entity);
+				gi.WriteByte(TE_SPLASH);
+				gi.WriteByte(8);
+				gi.WritePosition(tr.endPos);
+				gi.WriteDir(tr.plane.normal);
+				gi.WriteByte(color);
+				gi.multicast(tr.endPos, MULTICAST_PVS, false);
+			}
+
+			// change bullet's course when it enters water
+			Vector3 dir, forward, right, up;
+			dir = end - start;
+			dir = VectorToAngles(dir);
+			AngleVectors(dir, forward, right, up);
+			float r = crandom() * hSpread * 2;
+			float u = crandom() * vSpread * 2;
+			end = water_start + (forward * 8192);
+			end += (right * r);
+			end += (up * u);
+		}
+
+		// re-trace ignoring water this time
+		mask &= ~MASK_WATER;
+		return true;
+	}
+
+	// the lead leaves a mark here; the sky takes none
+	bool marks_surface() const {
+		return te_impact != -1 && !(tr.surface && ((tr.surface->flags & SURF_SKY) || strncmp(tr.surface->name, "sky", 3) == 0));
+	}
+
+	// we hit an entity; return false to stop the piercing.
+	// you can adjust the mask for the re-trace (for water, etc).
+	bool hit(contents_t& mask, Vector3& end) override {
+		// see if we hit water
+		if (tr.contents & MASK_WATER)
+			return enter_water(mask, end);
+
+		// did we hit an hurtable entity?
+		if (tr.ent->takeDamage) {
+			Damage(tr.ent, self, self, aimDir, tr.endPos, tr.plane.normal, damage, kick, LeadDamageFlags(mod), mod);
+
+			// only deadmonster is pierceable, or actual dead monsters
+			// that haven't been made non-solid yet
+			if (LeadPierces(tr.ent)) {
+				if (!mark(tr.ent))
+					return false;
+
+				return true;
+			}
+		}
+		else {
+			// send gun puff / flash
+			// don't mark the sky
+			if (marks_surface()) {
+				gi.WriteByte(svc_temp_entity);
+				gi.WriteByte(te_impact);
+				gi.WritePosition(tr.endPos);
+				gi.WriteDir(tr.plane.normal);
+				gi.multicast(tr.endPos, MULTICAST_PVS, false);
+
+				if (self->client)
+					G_PlayerNoise(self, tr.endPos, PlayerNoise::Impact);
+			}
+		}
+
+		// hit a solid, so we're stopping here
+
+		return false;
+	}
+};
+
+/*
+=================
+fire_lead
+
+This is an internal support routine used for bullet/pellet based weapons.
+=================
+*/
+static void fire_lead(gentity_t* self, const Vector3& start, const Vector3& aimDir, int damage, int kick, int te_impact, int hSpread, int vSpread, MeansOfDeath mod) {
+	fire_lead_pierce_t args = {
+		self,
+		start,
+		aimDir,
+		damage,
+		kick,
+		hSpread,
+		vSpread,
+		mod,
+		te_impact,
+		MASK_PROJECTILE | MASK_WATER
+	};
+
+	// [Paril-KEX]
+	if (self->client && !G_ShouldPlayersCollide(true))
+		args.mask &= ~CONTENTS_PLAYER;
+
+	// special case: we started in water.
+	if (gi.pointContents(start) & MASK_WATER) {
+		args.water = true;
+		args.water_start = start;
+		args.mask &= ~MASK_WATER;
+	}
+
+	// check initial firing position
+	pierce_trace(self->s.origin, start, self, args, args.mask);
+
+	// we're clear, so do the second pierce
+	if (args.tr.fraction == 1.f) {
+		args.restore();
+
+		Vector3 end, dir, forward, right, up;
+		dir = VectorToAngles(aimDir);
+		AngleVectors(dir, forward, right, up);
+
+		float r = crandom() * hSpread;
+		float u = crandom() * vSpread;
+		end = start + (forward * 8192);
+		end += (right * r);
+		end += (up * u);
+
+		pierce_trace(args.tr.endPos, end, self, args, args.mask);
+	}
+
+	// if went through water, determine where the end is and make a bubble trail
+	if (args.water && te_impact != -1)
+		LeadBubbleTrail(args.tr, args.water_start);
+}
+
+/*
+=================
+fire_bullet
+
+Fires a single round.  Used for machinegun and chaingun.  Would be fine for
+pistols, rifles, etc....
+=================
+*/
+void fire_bullet(gentity_t* self, const Vector3& start, const Vector3& aimDir, int damage, int kick, int hSpread, int vSpread, MeansOfDeath mod) {
+	fire_lead(self, start, aimDir, damage, kick, mod.id == ModID::TeslaMine ? -1 : TE_GUNSHOT, hSpread, vSpread, mod);
+}
+
+namespace {
+
+// pellet marks closer than this on the same surface share one impact effect
+constexpr float PELLET_IMPACT_CLUSTER = 24.f;
+
+struct pellet_t {
+	Vector3		start;			// where the pellet's trace begins
+	Vector3		end;			// where it is headed, after any bend in water
+	contents_t	mask;
+	bool		water = false;
+	Vector3		water_start = {};
+	trace_t		tr;				// where it stopped
+	bool		resume = false;	// killed a pierceable target; carry on past it
+};
+
+struct pellet_hit_t {
+	gentity_t*	ent;
+	Vector3		point;
+	Vector3		normal;
+	uint32_t	pellet;
+	bool		pierced;		// already pierceable, so the pellet went on
+};
+
+struct pellet_impact_t {
+	gentity_t*	ent;
+	Vector3		point;
+	Vector3		normal;
+};
+
+struct pellet_shot_t {
+	std::vector<pellet_t>			pellets;
+	std::vector<pellet_hit_t>		hits;
+	std::vector<pellet_impact_t>	impacts;
+};
+
+/*
+=================
+pellet_pierce_t
+
+Traces one pellet of a shot, recording what it hits instead of applying it.
+=================
+*/
+struct pellet_pierce_t : fire_lead_pierce_t {
+	pellet_shot_t&	shot;
+	uint32_t		index;
+
+	inline pellet_pierce_t(gentity_t* self, const Vector3& start, const Vector3& aimDir, int damage, int kick, int hSpread, int vSpread, MeansOfDeath mod, pellet_shot_t& shot, uint32_t index) :
+		fire_lead_pierce_t(self, start, aimDir, damage, kick, hSpread, vSpread, mod, TE_SHOTGUN, shot.pellets[index].mask),
+		shot(shot),
+		index(index) {
+		water = shot.pellets[index].water;
+		water_start = shot.pellets[index].water_start;
+	}
+
+	// this pellet was already charged to ent on an earlier pass
+	bool charged(const gentity_t* ent) const {
+		for (const pellet_hit_t& hit : shot.hits) {
+			if (hit.pellet == index && hit.ent == ent)
+				return true;
+		}
+		return false;
+	}
+
+	bool hit(contents_t& mask, Vector3& end) override {
+		if (tr.contents & MASK_WATER) {
+			const bool result = enter_water(mask, end);
+			pellet_t& pellet = shot.pellets[index];
+
+			pellet.mask = mask;
+			pellet.end = end;
+			pellet.water = water;
+			pellet.water_start = water_start;
+			return result;
+		}
+
+		if (tr.ent->takeDamage) {
+			if (charged(tr.ent))
+				return mark(tr.ent);
+
+			const bool pierced = LeadPierces(tr.ent);
+			shot.hits.push_back({ tr.ent, tr.endPos, tr.plane.normal, index, pierced });
+			return pierced && mark(tr.ent);
+		}
+
+		if (marks_surface())
+			shot.impacts.push_back({ tr.ent, tr.endPos, tr.plane.normal });
+
+		return false;
+	}
+};
+
+/*
+=================
+TracePellet
+=================
+*/
+void TracePellet(gentity_t* self, const Vector3& start, const Vector3& aimDir, int damage, int kick, int hSpread, int vSpread, MeansOfDeath mod, pellet_shot_t& shot, uint32_t index) {
+	pellet_pierce_t args(self, start, aimDir, damage, kick, hSpread, vSpread, mod, shot, index);
+	pellet_t& pellet = shot.pellets[index];
+
+	pierce_trace(pellet.start, pellet.end, self, args, args.mask);
+	pellet.tr = args.tr;
+}
+
+/*
+=================
+ApplyPelletHits
+
+Charges every target hit since first with all of its pellets at once, in
+the order the targets were first hit. Returns true if any pellet killed a
+pierceable target and should carry on past it.
+=================
+*/
+bool ApplyPelletHits(gentity_t* self, const Vector3& aimDir, int damage, int kick, MeansOfDeath mod, pellet_shot_t& shot, size_t first) {
+	const size_t last = shot.hits.size();
+	bool resume = false;
+
+	for (size_t i = first; i < last; i++) {
+		const pellet_hit_t& hit = shot.hits[i];
+		bool applied = false;
+
+		for (size_t j = first; j < i && !applied; j++)
+			applied = shot.hits[j].ent == hit.ent;
+		if (applied)
+			continue;
+
+		int count = 0;
+		for (size_t j = i; j < last; j++)
+			count += shot.hits[j].ent == hit.ent ? 1 : 0;
+
+		const int beforeDeath = DamageHits(hit.ent, self, self, aimDir, hit.point, hit.normal, damage, kick, count, LeadDamageFlags(mod), mod);
+
+		// one at a time, the pellets after the one that killed it would have
+		// gone through, or past where it was if it was gibbed
+		if (hit.pierced || beforeDeath >= count || (hit.ent->inUse && !LeadPierces(hit.ent)))
+			continue;
+
+		int order = 0;
+		for (size_t j = i; j < last; j++) {
+			if (shot.hits[j].ent != hit.ent)
+				continue;
+			if (order++ >= beforeDeath) {
+				shot.pellets[shot.hits[j].pellet].resume = true;
+				resume = true;
+			}
+		}
+	}
+
+	return resume;
+}
+
+/*
+=================
+SendPelletImpacts
+
+One impact effect per cluster of pellet marks on the same surface.
+=================
+*/
+void SendPelletImpacts(gentity_t* self, std::vector<pellet_impact_t>& impacts) {
+	for (size_t i = 0; i < impacts.size(); i++) {
+		const pellet_impact_t& impact = impacts[i];
+
+		if (!impact.ent)
+			continue;
+
+		gi.WriteByte(svc_temp_entity);
+		gi.WriteByte(TE_SHOTGUN);
+		gi.WritePosition(impact.point);
+		gi.WriteDir(impact.normal);
+		gi.multicast(impact.point, MULTICAST_PVS, false);
+
+		for (size_t j = i + 1; j < impacts.size(); j++) {
+			pellet_impact_t& other = impacts[j];
+
+			if (other.ent == impact.ent && other.normal.dot(impact.normal) > 0.99f &&
+				(other.point - impact.point).lengthSquared() < PELLET_IMPACT_CLUSTER * PELLET_IMPACT_CLUSTER)
+				other.ent = nullptr;
+		}
+	}
+
+	if (self->client && !impacts.empty())
+		G_PlayerNoise(self, impacts.back().point, PlayerNoise::Impact);
+}
+
+} // namespace
+
+/*
+=================
+fire_shotgun
+
+Shoots shotgun pellets.  Used by shotgun and super shotgun.
+=================
+*/
+void fire_shotgun(gentity_t* self, const Vector3& start, const Vector3& aimDir, int damage, int kick, int hSpread, int vSpread, int count, MeansOfDeath mod) {
+	if (count <= 0)
+		return;
+
+	contents_t mask = MASK_PROJECTILE | MASK_WATER;
+
+	// [Paril-KEX]
+	if (self->client && !G_ShouldPlayersCollide(true))
+		mask &= ~CONTENTS_PLAYER;
+
+	// special case: we started in water.
+	const bool startInWater = gi.pointContents(start) & MASK_WATER;
+	if (startInWater)
+		mask &= ~MASK_WATER;
+
+	// the firing position check is the same for every pellet; if anything is
+	// in the way, let each pellet deal with it on its own
+	const trace_t muzzle = gi.traceLine(self->s.origin, start, self, mask);
+	if (muzzle.fraction < 1.f) {
+		for (int i = 0; i < count; i++)
+			fire_lead(self, start, aimDir, damage, kick, TE_SHOTGUN, hSpread, vSpread, mod);
+		return;
+	}
+
+	Vector3 dir, forward, right, up;
+	dir = VectorToAngles(aimDir);
+	AngleVectors(dir, forward, right, up);
+
+	pellet_shot_t shot;
+	shot.pellets.resize(count);
+	shot.hits.reserve(count);
+	shot.impacts.reserve(count);
+
+	for (int i = 0; i < count; i++) {
+		pellet_t& pellet = shot.pellets[i];
+
+		float r = crandom() * hSpread;
+		float u = crandom() * vSpread;
+		pellet.start = muzzle.endPos;
+		pellet.end = start + (forward * 8192);
+		pellet.end += (right * r);
+		pellet.end += (up * u);
+		pellet.mask = mask;
+		pellet.water = startInWater;
+		pellet.water_start = start;
+
+		TracePellet(self, start, aimDir, damage, kick, hSpread, vSpread, mod, shot, static_cast<uint32_t>(i));
+	}
+
+	for (size_t first = 0; first < shot.hits.size();) {
+		const size_t last = shot.hits.size();
+
+		if (ApplyPelletHits(self, aimDir, damage, kick, mod, shot, first)) {
+			for (uint32_t i = 0; i < shot.pellets.size(); i++) {
+				if (!shot.pellets[i].resume)
+					continue;
+
+				shot.pellets[i].resume = false;
+				TracePellet(self, start, aimDir, damage, kick, hSpread, vSpread, mod, shot, i);
+			}
+		}
+
+		first = last;
+	}
+
+	SendPelletImpacts(self, shot.impacts);
+
+	for (const pellet_t& pellet : shot.pellets) {
+		if (pellet.water)
+			LeadBubbleTrail(pellet.tr, pellet.water_start);
+	}
+}
@@ -0,0 +1,306 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+g_world_snapshot.cpp (World Snapshot) Keeps a binary copy of the map-authored world as it stood
+right after SpawnEntities, so warmup-to-match and round resets can put it back without
+re-parsing the entity string and re-running every spawn function. Key Responsibilities: -
+Capture: the worldspawn and every in-use slot above the clients, the free slots' free times, and
+a copy of the level locals. - Restore: releases the gametype state that points into the world,
+puts the level locals back, frees whatever is in the world now, copies the slots back, moves
+their timestamps forward to the present, and relinks what was linked. - Spawn Inputs: the
+ruleset, gametype and spawn-time cvars are recorded with the capture; a snapshot taken under
+others is not restored, so the reset parses the map again and captures anew. - Lifetime: the
+snapshot points into TAG_LEVEL memory (interned strings, spawn state), so it is dropped with
+every `gi.FreeTags(TAG_LEVEL)` and resets that restore from it must not free the tag.*/
+
+#include "../g_local.hpp"
+#include "g_headhunters.hpp"
+#include "g_proball.hpp"
+
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+struct snapshot_free_slot_t {
+	uint32_t	slot;
+	GameTime	freeTime;
+};
+
+// cvars the spawn functions read: G_InhibitEntity, worldspawn's map
+// settings, CheckItemEnabled and SpawnItem
+cvar_t** const SPAWN_CVARS[] = {
+	&deathmatch, &coop, &skill,
+	&g_instaGib, &g_nadeFest, &g_quadhog, &g_vampiric_damage,
+	&g_no_items, &g_no_mines, &g_no_nukes, &g_no_spheres,
+	&g_no_armor, &g_no_powerups, &g_no_health,
+	&g_mapspawn_no_bfg, &g_mapspawn_no_plasmabeam,
+	&g_fallingDamage, &g_selfDamage, &match_weaponsStay,
+	&g_itemBobbing, &match_powerupMinPlayerLock, &g_dm_random_items,
+};
+
+struct snapshot_inputs_t {
+	Ruleset		ruleset = Ruleset::None;
+	GameType	gametype = GameType::None;
+	std::array<int32_t, std::size(SPAWN_CVARS)> modifiedCounts{};
+
+	bool operator==(const snapshot_inputs_t&) const = default;
+};
+
+struct world_snapshot_t {
+	bool		valid = false;
+	GameTime	captureTime = 0_ms;
+	uint32_t	numEntities = 0;
+	snapshot_inputs_t	inputs;
+
+	LevelVector<uint32_t, LevelMem::WorldSnapshot>				slots;		// in-use slots, worldspawn first
+	LevelVector<uint8_t, LevelMem::WorldSnapshot>				entities;	// one gentity_t per slot
+	LevelVector<snapshot_free_slot_t, LevelMem::WorldSnapshot>	freeSlots;
+	std::unique_ptr<LevelLocals>								level;
+
+	size_t		restores = 0;
+	double		captureMs = 0.0;
+	double		lastRestoreMs = 0.0;
+};
+
+world_snapshot_t snapshot;
+
+/*
+=============
+SpawnInputs
+
+What the spawn functions would see if the map were parsed now.
+=============
+*/
+snapshot_inputs_t SpawnInputs() {
+	snapshot_inputs_t inputs;
+
+	inputs.ruleset = game.ruleset;
+	inputs.gametype = Game::GetCurrentType();
+	for (size_t i = 0; i < std::size(SPAWN_CVARS); i++)
+		inputs.modifiedCounts[i] = (*SPAWN_CVARS[i])->modifiedCount;
+
+	return inputs;
+}
+
+/*
+=============
+StoredEntity
+=============
+*/
+inline const gentity_t* StoredEntity(size_t index) {
+	return reinterpret_cast<const gentity_t*>(snapshot.entities.data() + index * sizeof(gentity_t));
+}
+
+/*
+=============
+StoreEntity
+=============
+*/
+void StoreEntity(const gentity_t* ent) {
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(ent);
+
+	snapshot.slots.push_back(static_cast<uint32_t>(ent - g_entities));
+	snapshot.entities.insert(snapshot.entities.end(), bytes, bytes + sizeof(gentity_t));
+}
+
+} // namespace
+
+/*
+=============
+G_WorldSnapshotClear
+
+Drops the snapshot; call whenever the TAG_LEVEL memory it points into is
+released.
+=============
+*/
+void G_WorldSnapshotClear() {
+	if (snapshot.level)
+		G_LevelMemTrack(LevelMem::WorldSnapshot, -static_cast<ptrdiff_t>(sizeof(LevelLocals)));
+
+	const size_t restores = snapshot.restores;
+	snapshot = {};
+	snapshot.restores = restores;
+}
+
+/*
+=============
+G_WorldSnapshotCapture
+
+Records the world as it stands now; called once the map's entities have
+been spawned and set up, before any frame has run.
+=============
+*/
+void G_WorldSnapshotCapture() {
+	const auto start = std::chrono::steady_clock::now();
+	const size_t first = static_cast<size_t>(game.maxClients) + 1;
+
+	G_WorldSnapshotClear();
+
+	size_t inUse = 1;
+	for (size_t i = first; i < globals.numEntities; i++)
+		inUse += g_entities[i].inUse ? 1 : 0;
+
+	snapshot.slots.reserve(inUse);
+	snapshot.entities.reserve(inUse * sizeof(gentity_t));
+	snapshot.freeSlots.reserve(globals.numEntities - first - (inUse - 1));
+
+	StoreEntity(world);
+	for (size_t i = first; i < globals.numEntities; i++) {
+		const gentity_t* ent = &g_entities[i];
+
+		if (ent->inUse)
+			StoreEntity(ent);
+		else
+			snapshot.freeSlots.push_back({ static_cast<uint32_t>(i), ent->freeTime });
+	}
+
+	snapshot.level = std::make_unique<LevelLocals>(level);
+	G_LevelMemTrack(LevelMem::WorldSnapshot, sizeof(LevelLocals));
+
+	// the persistent half of the level is carried over by the reset, not restored
+	snapshot.level->savedEntityString.clear();
+	snapshot.level->savedEntityString.shrink_to_fit();
+
+	snapshot.captureTime = level.time;
+	snapshot.numEntities = globals.numEntities;
+	snapshot.inputs = SpawnInputs();
+	snapshot.valid = true;
+	snapshot.captureMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*
+=============
+G_WorldSnapshotValid
+
+Whether there is a snapshot, taken under the ruleset, gametype and
+spawn cvars in effect now; otherwise the map has to be parsed again.
+=============
+*/
+bool G_WorldSnapshotValid() {
+	return snapshot.valid && snapshot.inputs == SpawnInputs();
+}
+
+/*
+=============
+G_WorldSnapshotLevel
+
+The level locals as captured, with their timestamps still at capture time.
+=============
+*/
+const LevelLocals* G_WorldSnapshotLevel() {
+	return snapshot.valid ? snapshot.level.get() : nullptr;
+}
+
+/*
+=============
+G_WorldReleaseEntityState
+
+Drops the gametype state that points into the world. Both world resets
+run it; a snapshot restore must do so before the level locals are
+replaced and before the slots are refilled, or heads still attached to
+clients would later free whatever map entity took their slot.
+=============
+*/
+void G_WorldReleaseEntityState() {
+	Domination_ClearState();
+	HeadHunters::ClearState();
+	ProBall::ClearState();
+}
+
+/*
+=============
+G_WorldSnapshotRestore
+
+Puts the captured world back as if it had been spawned at the current
+level time: the level locals as captured, moved forward to now, and the
+entities. Clients keep their slots; everything else above them, including
+the body queue, is freed and replaced. The caller puts back whatever
+level state the reset carries over afterwards.
+=============
+*/
+void G_WorldSnapshotRestore() {
+	if (!snapshot.valid)
+		return;
+
+	const auto start = std::chrono::steady_clock::now();
+	const GameTime delta = level.time - snapshot.captureTime;
+	const size_t first = static_cast<size_t>(game.maxClients) + 1;
+
+	G_WorldReleaseEntityState();
+
+	level = *snapshot.level;
+	G_LevelShiftTimes(&level, delta);
+
+	for (size_t i = first; i < globals.numEntities; i++) {
+		gentity_t* ent = &g_entities[i];
+
+		if (!ent->inUse)
+			continue;
+
+		// the body queue is never freed, only unlinked
+		if (i <= static_cast<size_t>(game.maxClients) + BODY_QUEUE_SIZE) {
+			gi.unlinkEntity(ent);
+			continue;
+		}
+
+		FreeEntity(ent);
+	}
+
+	gi.unlinkEntity(world);
+	globals.numEntities = snapshot.numEntities;
+
+	for (size_t i = 0; i < snapshot.slots.size(); i++) {
+		gentity_t* ent = &g_entities[snapshot.slots[i]];
+		const int32_t spawnCount = ent->spawn_count + 1;
+
+		std::memcpy(static_cast<void*>(ent), StoredEntity(i), sizeof(gentity_t));
+		G_EntityShiftTimes(ent, delta);
+
+		// handles held across the reset must not resolve to the restored copy
+		ent->spawn_count = spawnCount;
+		ent->sv.init = false;
+	}
+
+	for (const snapshot_free_slot_t& free : snapshot.freeSlots) {
+		gentity_t* ent = &g_entities[free.slot];
+
+		ent->freeTime = free.freeTime ? free.freeTime + delta : free.freeTime;
+	}
+
+	// link in capture order so area lists come out as they did after the spawn
+	for (size_t i = 0; i < snapshot.slots.size(); i++) {
+		gentity_t* ent = &g_entities[snapshot.slots[i]];
+		const gentity_t* stored = StoredEntity(i);
+
+		if (!stored->linked)
+			continue;
+
+		ent->linked = false;
+		gi.linkEntity(ent);
+		ent->linkCount = stored->linkCount;
+	}
+
+	G_RegistryRebuild();
+	G_EventListRebuild();
+	G_EntityHotRebuild();
+
+	snapshot.restores++;
+	snapshot.lastRestoreMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*
+=============
+G_WorldSnapshotPrint
+=============
+*/
+void G_WorldSnapshotPrint() {
+	if (!snapshot.valid) {
+		gi.Com_Print("World snapshot: none\n");
+		return;
+	}
+
+	gi.Com_PrintFmt("World snapshot: {} entities, {} free slots, {} bytes, captured in {:.2f} ms; {} restores, last {:.2f} ms\n",
+		snapshot.slots.size(), snapshot.freeSlots.size(), snapshot.entities.size() + sizeof(LevelLocals),
+		snapshot.captureMs, snapshot.restores, snapshot.lastRestoreMs);
+}
@@ -407,8 +407,8 @@ struct MatchStats {
 	json gametypeStats;
 	int timeLimitSeconds = 0;
 	int scoreLimit = 0;
-	std::vector<MatchEvent> eventLog;
-	std::vector<MatchDeathEvent> deathLog;
+	LevelVector<MatchEvent, LevelMem::MatchLog> eventLog;
+	LevelVector<MatchDeathEvent, LevelMem::MatchLog> deathLog;
 #if 0
 	// Convert time_t to ISO 8601 string
 	std::string formatTime(std::time_t time) const {
@@ -2287,33 +2287,34 @@ void MatchStats_End() {
 
 		auto process_player = [&](gentity_t* ec) {
 			auto* cl = ec->client;
+			const ClientMatchStats stats = cl->MatchStats();
 			PlayerStats p;
 
 			p.socialID = cl->sess.socialID;
 			p.playerName = cl->sess.netName;
 			p.skillRating = cl->sess.skillRating;
 			p.skillRatingChange = cl->sess.skillRatingChange;
-			p.totalKills = cl->pers.match.totalKills;
-			p.totalSpawnKills = cl->pers.match.totalSpawnKills;
-			p.totalTeamKills = cl->pers.match.totalTeamKills;
-			p.totalDeaths = cl->pers.match.totalDeaths;
-			p.totalSuicides = cl->pers.match.totalSuicides;
+			p.totalKills = stats.totalKills();
+			p.totalSpawnKills = stats.totalSpawnKills();
+			p.totalTeamKills = stats.totalTeamKills();
+			p.totalDeaths = stats.totalDeaths();
+			p.totalSuicides = stats.totalSuicides();
 			p.calculateKDR();
 			p.totalScore = cl->resp.score;
-			p.proBallGoals = cl->pers.match.proBallGoals;
-			p.proBallAssists = cl->pers.match.proBallAssists;
-			p.totalShots = cl->pers.match.totalShots;
-			p.totalHits = cl->pers.match.totalHits;
-			p.totalDmgDealt = cl->pers.match.totalDmgDealt;
-			p.totalDmgReceived = cl->pers.match.totalDmgReceived;
-			p.ctfFlagPickups = cl->pers.match.ctfFlagPickups;
-			p.ctfFlagDrops = cl->pers.match.ctfFlagDrops;
-			p.ctfFlagReturns = cl->pers.match.ctfFlagReturns;
-			p.ctfFlagAssists = cl->pers.match.ctfFlagAssists;
-			p.ctfFlagCaptures = cl->pers.match.ctfFlagCaptures;
-			p.ctfFlagCarrierTimeTotalMsec = static_cast<int64_t>(cl->pers.match.ctfFlagCarrierTimeTotalMsec);
-			p.ctfFlagCarrierTimeShortestMsec = static_cast<int>(cl->pers.match.ctfFlagCarrierTimeShortestMsec);
-			p.ctfFlagCarrierTimeLongestMsec = static_cast<int>(cl->pers.match.ctfFlagCarrierTimeLongestMsec);
+			p.proBallGoals = stats.proBallGoals();
+			p.proBallAssists = stats.proBallAssists();
+			p.totalShots = stats.totalShots();
+			p.totalHits = stats.totalHits();
+			p.totalDmgDealt = stats.totalDmgDealt();
+			p.totalDmgReceived = stats.totalDmgReceived();
+			p.ctfFlagPickups = stats.ctfFlagPickups();
+			p.ctfFlagDrops = stats.ctfFlagDrops();
+			p.ctfFlagReturns = stats.ctfFlagReturns();
+			p.ctfFlagAssists = stats.ctfFlagAssists();
+			p.ctfFlagCaptures = stats.ctfFlagCaptures();
+			p.ctfFlagCarrierTimeTotalMsec = static_cast<int64_t>(stats.ctfFlagCarrierTimeTotalMsec());
+			p.ctfFlagCarrierTimeShortestMsec = static_cast<int>(stats.ctfFlagCarrierTimeShortestMsec());
+			p.ctfFlagCarrierTimeLongestMsec = static_cast<int>(stats.ctfFlagCarrierTimeLongestMsec());
 
 		if (HasFlag(matchStats.recordedFlags, GameFlags::CTF)) {
 				json& playerCtfJson = p.gametypeStats["ctf"];
@@ -2341,8 +2342,8 @@ void MatchStats_End() {
 
 			// Weapon stats
 			for (size_t i = 0; i < weaponAbbreviations.size(); ++i) {
-				int shots = cl->pers.match.totalShotsPerWeapon[i];
-				int hits = cl->pers.match.totalHitsPerWeapon[i];
+				int shots = stats.totalShotsPerWeapon()[i];
+				int hits = stats.totalHitsPerWeapon()[i];
 				if (shots > 0) {
 					p.totalShotsPerWeapon[i] = shots;
 					p.totalHitsPerWeapon[i] = hits;
@@ -2357,17 +2358,17 @@ void MatchStats_End() {
 
 			// Pickup stats
 			for (int i = static_cast<int>(HighValueItems::None) + 1; i < static_cast<int>(HighValueItems::Total); ++i) {
-				p.pickupCounts[i] = cl->pers.match.pickupCounts[i];
-				p.pickupDelays[i] = cl->pers.match.pickupDelay[i].seconds<double>();
+				p.pickupCounts[i] = stats.pickupCounts()[i];
+				p.pickupDelays[i] = stats.pickupDelay()[i].seconds<double>();
 			}
 
 			// MOD stats
 			for (const auto& mod : modr) {
 				const size_t idx = static_cast<size_t>(mod.mod);
-				int kills = cl->pers.match.modTotalKills[idx];
-				int deaths = cl->pers.match.modTotalDeaths[idx];
-				int dmgDealt = cl->pers.match.modTotalDmgD[idx];
-				int dmgReceived = cl->pers.match.modTotalDmgR[idx];
+				int kills = stats.modTotalKills()[idx];
+				int deaths = stats.modTotalDeaths()[idx];
+				int dmgDealt = stats.modTotalDmgD()[idx];
+				int dmgReceived = stats.modTotalDmgR()[idx];
 
 				p.modTotalKills[idx] = kills;
 				p.modTotalDeaths[idx] = deaths;
@@ -2386,7 +2387,7 @@ void MatchStats_End() {
 			}
 
 			// Medals
-			p.awards = cl->pers.match.medalCount;
+			std::ranges::copy(stats.medalCount(), p.awards.begin());
 
 			// Bot sanitization
 			if (cl->sess.is_a_bot) {
@@ -84,16 +84,17 @@ static void CalmTriggerableMovers() {
 		return (ent.moveType == MoveType::Push || ent.moveType == MoveType::Stop) && ent.className;
 	};
 	const auto isDoor = [](const gentity_t& ent) {
-		return Q_strcasecmp(ent.className, "func_door") == 0 ||
-			Q_strcasecmp(ent.className, "func_door_rotating") == 0 ||
-			Q_strcasecmp(ent.className, "func_door_secret") == 0 ||
-			Q_strcasecmp(ent.className, "func_water") == 0;
+		const EntityClass cls = G_EntityClassOf(&ent);
+		return cls == EntityClass::FuncDoor ||
+			cls == EntityClass::FuncDoorRotating ||
+			cls == EntityClass::FuncDoorSecret ||
+			cls == EntityClass::FuncWater;
 	};
 	const auto isPlat = [](const gentity_t& ent) {
-		return Q_strcasecmp(ent.className, "func_plat") == 0;
+		return G_IsClass(&ent, EntityClass::FuncPlat);
 	};
 	const auto isPlat2 = [](const gentity_t& ent) {
-		return Q_strcasecmp(ent.className, "func_plat2") == 0;
+		return G_IsClass(&ent, EntityClass::FuncPlat2);
 	};
 
 	for (gentity_t& ent : entities) {
@@ -154,16 +155,16 @@ countdown phase.
 =============
 */
 static void CalmMonsters() {
-	const size_t startIndex = static_cast<size_t>(game.maxClients) + 1;
-	if (startIndex >= globals.numEntities)
-		return;
-
-	const auto entities = std::span{g_entities + startIndex, globals.numEntities - startIndex};
 	const auto isMonster = [](const gentity_t& ent) {
 		return ent.inUse && (ent.svFlags & SVF_MONSTER);
 	};
 
-	for (gentity_t& ent : entities) {
+	// stand/idle handlers may relink, so walk a copy of the registry
+	std::vector<gentity_t*> monsters;
+	G_RegistrySnapshot(EntityRegistry::Monster, monsters);
+
+	for (gentity_t* member : monsters) {
+		gentity_t& ent = *member;
 		if (!isMonster(ent))
 			continue;
 
@@ -396,12 +397,15 @@ constexpr struct GameTypeRules {
 };
 
 static void Monsters_KillAll() {
-	for (size_t i = 0; i < globals.maxEntities; i++) {
-		if (!g_entities[i].inUse)
+	std::vector<gentity_t*> monsters;
+	G_RegistrySnapshot(EntityRegistry::Monster, monsters);
+
+	for (gentity_t* ent : monsters) {
+		if (!ent->inUse)
 			continue;
-		if (!(g_entities[i].svFlags & SVF_MONSTER))
+		if (!(ent->svFlags & SVF_MONSTER))
 			continue;
-		FreeEntity(&g_entities[i]);
+		FreeEntity(ent);
 	}
 	level.campaign.totalMonsters = 0;
 	level.campaign.killedMonsters = 0;
@@ -450,21 +454,18 @@ static void ResetMatchWorldState(bool reloadWorldEntities) {
 		Monsters_KillAll();
 	}
 
-	gentity_t* ent;
-	size_t i;
-
-	for (ent = g_entities + 1, i = 1; i < globals.numEntities; i++, ent++) {
-		if (!ent->inUse)
-			continue;
+	for (size_t i = G_EntityHotNextInUse(1); i < globals.numEntities; i = G_EntityHotNextInUse(i + 1)) {
+		gentity_t* ent = &g_entities[i];
 
-		if (Q_strcasecmp(ent->className, "gib") == 0) {
+		// a reload leaves only map-authored entities, so there is nothing to clear
+		if (!reloadedEntities && G_IsClass(ent, EntityClass::Gib)) {
 			ent->svFlags = SVF_NOCLIENT;
 			ent->takeDamage = false;
 			ent->solid = SOLID_NOT;
 			gi.unlinkEntity(ent);
 			FreeEntity(ent);
 		}
-		else if ((ent->svFlags & SVF_PROJECTILE) || (ent->clipMask & CONTENTS_PROJECTILECLIP)) {
+		else if (!reloadedEntities && ((ent->svFlags & SVF_PROJECTILE) || (ent->clipMask & CONTENTS_PROJECTILECLIP))) {
 			FreeEntity(ent);
 		}
 		else if (ent->item) {
@@ -537,7 +538,7 @@ static void ResetMatchPlayers(bool resetGhost, bool resetScore, LimitedLivesRese
 			ec->svFlags &= ~SVF_NOCLIENT;
 			ClientSpawn(ec);
 			G_PostRespawn(ec);
-			memset(&ec->client->pers.match, 0, sizeof(ec->client->pers.match));
+			ec->client->MatchStats().Reset();
 
 			gi.linkEntity(ec);
 		}
@@ -0,0 +1,103 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+match_stats.cpp (Match Statistics Store) Owns the per-match player statistics, kept in a
+column per stat rather than inside gclient_t. Key Responsibilities: - Storage: one row per
+client slot and per ghost slot; `gclient_t::MatchStats()` and `Ghosts::MatchStats()` hand out
+row handles. - Row Operations: resetting a row when a player's persistent data is wiped and
+copying rows between a client and its ghost when they leave and rejoin.*/
+
+#include "../g_local.hpp"
+
+MatchStatsColumns matchStatsColumns;
+
+namespace {
+
+/*
+=============
+ForEachColumn
+
+Visits every column of the store; keep in sync with MatchStatsColumns.
+=============
+*/
+template<typename Fn>
+void ForEachColumn(Fn&& fn) {
+	MatchStatsColumns& c = matchStatsColumns;
+
+	fn(c.lifeAverage);
+	fn(c.lifeLongest);
+	fn(c.totalDmgDealt);
+	fn(c.totalDmgReceived);
+	fn(c.totalShots);
+	fn(c.totalHits);
+	fn(c.proBallGoals);
+	fn(c.proBallAssists);
+	fn(c.totalKills);
+	fn(c.totalTeamKills);
+	fn(c.totalSpawnKills);
+	fn(c.totalDeaths);
+	fn(c.totalSpawnDeaths);
+	fn(c.totalSuicides);
+	fn(c.modTotalKills);
+	fn(c.modTotalDeaths);
+	fn(c.modTotalDmgD);
+	fn(c.modTotalDmgR);
+	fn(c.totalShotsPerWeapon);
+	fn(c.totalHitsPerWeapon);
+	fn(c.medalCount);
+	fn(c.pickupCounts);
+	fn(c.pickupDelay);
+	fn(c.ctfFlagPickups);
+	fn(c.ctfFlagDrops);
+	fn(c.ctfFlagReturns);
+	fn(c.ctfFlagAssists);
+	fn(c.ctfFlagCaptures);
+	fn(c.ctfFlagCarrierTimeTotalMsec);
+	fn(c.ctfFlagCarrierTimeShortestMsec);
+	fn(c.ctfFlagCarrierTimeLongestMsec);
+}
+
+} // namespace
+
+/*
+=============
+ClientMatchStats::Reset
+=============
+*/
+void ClientMatchStats::Reset() const {
+	const size_t target = row;
+
+	ForEachColumn([target](auto& column) {
+		column[target] = {};
+	});
+}
+
+/*
+=============
+ClientMatchStats::CopyFrom
+=============
+*/
+void ClientMatchStats::CopyFrom(ClientMatchStats other) const {
+	const size_t target = row;
+	const size_t source = other.row;
+
+	if (target == source)
+		return;
+
+	ForEachColumn([target, source](auto& column) {
+		column[target] = column[source];
+	});
+}
+
+/*
+=============
+G_MatchStatsClear
+
+Wipes every row; used when the client array is (re)allocated.
+=============
+*/
+void G_MatchStatsClear() {
+	ForEachColumn([](auto& column) {
+		column.fill({});
+	});
+}
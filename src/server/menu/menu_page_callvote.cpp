@@ -5,7 +5,8 @@ menu_page_callvote.cpp (Menu Page - Call Vote) This file contains the UI logic f
 Vote" menu. It provides a structured way for players to initiate votes for various game actions,
 such as changing the map or shuffling teams. Key Responsibilities: - Vote Menu Construction:
 Builds the main vote menu, dynamically showing only the vote options that are currently enabled
-by the server's `g_vote_flags` cvar. - Sub-Menus for Options: Implements sub-menus for votes
+by the server's `g_vote_flags` cvar; the enabled votes and the map list are cached until the
+vote definitions, the voting cvars or the map pool change. - Sub-Menus for Options: Implements sub-menus for votes
 that require additional parameters, such as the map selection list (`OpenCallvoteMapMenu`) or
 the timelimit chooser. - Parameter Handling: Manages the state for complex votes, like storing
 the selected map and custom map flags before initiating the vote. - Integration with Vote
@@ -27,19 +28,79 @@ Helpers
 ===============
 */
 
-static inline bool VoteEnabled(std::string_view name) {
-	if (!g_allowVoting || !g_allowVoting->integer) {
-		return false;
+/*
+===============
+Menu cache
+
+What the pages list only changes with the vote definitions, the voting
+cvars or the map pool, so it is worked out once and reused by every
+open until one of those changes.
+===============
+*/
+struct CallvoteMapItem {
+	std::string label;
+	std::string filename;
+};
+
+struct CallvoteMenuCache {
+	bool		votesBuilt = false;
+	uint32_t	definitionsRevision = 0;
+	int32_t		allowVoting = 0;
+	int32_t		voteFlags = 0;
+	int32_t		menuVotes = 0;	// kVoteFlag_* bits of the votes shown in the menu
+
+	bool		mapsBuilt = false;
+	uint32_t	poolRevision = 0;
+	std::vector<CallvoteMapItem> maps;
+};
+static CallvoteMenuCache g_callvoteCache;
+
+static int32_t MenuVotes() {
+	const int32_t allowVoting = g_allowVoting ? g_allowVoting->integer : 0;
+	const int32_t voteFlags = g_vote_flags->integer;
+	const uint32_t revision = Commands::GetVoteDefinitionsRevision();
+	auto& cache = g_callvoteCache;
+
+	if (cache.votesBuilt && cache.definitionsRevision == revision && cache.allowVoting == allowVoting && cache.voteFlags == voteFlags) {
+		return cache.menuVotes;
 	}
-	for (const auto& def : Commands::GetRegisteredVoteDefinitions()) {
-		if (def.name == name) {
-			if (!def.visibleInMenu) {
-				return false;
+
+	cache.votesBuilt = true;
+	cache.definitionsRevision = revision;
+	cache.allowVoting = allowVoting;
+	cache.voteFlags = voteFlags;
+	cache.menuVotes = 0;
+
+	if (allowVoting) {
+		for (const auto& def : Commands::GetRegisteredVoteDefinitions()) {
+			if (def.visibleInMenu) {
+				cache.menuVotes |= def.flag & voteFlags;
 			}
-			return (g_vote_flags->integer & def.flag) != 0;
 		}
 	}
-	return false;
+
+	return cache.menuVotes;
+}
+
+static inline bool VoteEnabled(int32_t flag) {
+	return (MenuVotes() & flag) != 0;
+}
+
+static const std::vector<CallvoteMapItem>& CallvoteMaps() {
+	auto& cache = g_callvoteCache;
+
+	if (!cache.mapsBuilt || cache.poolRevision != game.mapSystem.poolRevision) {
+		cache.mapsBuilt = true;
+		cache.poolRevision = game.mapSystem.poolRevision;
+		cache.maps.clear();
+		cache.maps.reserve(game.mapSystem.mapPool.size());
+
+		for (const auto& entry : game.mapSystem.mapPool) {
+			cache.maps.push_back({ entry.longName.empty() ? entry.filename : entry.longName, entry.filename });
+		}
+	}
+
+	return cache.maps;
 }
 
 static void NotifyVoteLaunch(gentity_t* ent, const Commands::VoteLaunchResult& result) {
@@ -94,6 +155,20 @@ static constexpr std::array<MapFlagEntry, 10> kMapFlags = { {
 	{ MAPFLAG_WS, "ws", "Weapons Stay" },
 } };
 
+// each flag's label in its default, enabled and disabled states
+static const std::array<std::array<std::string, 3>, kMapFlags.size()>& MapFlagLabels() {
+	static const auto labels = [] {
+		std::array<std::array<std::string, 3>, kMapFlags.size()> out;
+		for (size_t i = 0; i < kMapFlags.size(); ++i) {
+			out[i][0] = std::string(kMapFlags[i].label) + " [Default]";
+			out[i][1] = std::string(kMapFlags[i].label) + " [Enabled]";
+			out[i][2] = std::string(kMapFlags[i].label) + " [Disabled]";
+		}
+		return out;
+	}();
+	return labels;
+}
+
 static inline void MapFlags_Clear() {
 	g_mapVote.enableFlags = 0;
 	g_mapVote.disableFlags = 0;
@@ -179,10 +254,8 @@ static void OpenCallvoteMap(gentity_t* ent) {
 
 	builder.addFixed("");
 
-	for (const auto& entry : game.mapSystem.mapPool) {
-		const std::string& displayName = entry.longName.empty() ? entry.filename : entry.longName;
-
-		builder.add(displayName, MenuAlign::Left, [mapname = entry.filename](gentity_t* e, Menu&) {
+	for (const auto& item : CallvoteMaps()) {
+		builder.add(item.label, MenuAlign::Left, [mapname = item.filename](gentity_t* e, Menu&) {
 			const std::string fullArg = BuildMapVoteArg(mapname);
 			TryLaunchMenuVote(e, "map", fullArg);
 		});
@@ -200,11 +273,12 @@ static void OpenCallvoteMapFlags(gentity_t* ent) {
 	MenuBuilder builder;
 	builder.add("Map Flags", MenuAlign::Center).spacer();
 
-	for (const auto& f : kMapFlags) {
+	for (size_t i = 0; i < kMapFlags.size(); ++i) {
+		const auto& f = kMapFlags[i];
 		const bool en = (g_mapVote.enableFlags & f.bit) != 0;
 		const bool dis = (g_mapVote.disableFlags & f.bit) != 0;
-		const char* state = (!en && !dis) ? "Default" : (en ? "Enabled" : "Disabled");
-		builder.add(std::string(f.label) + " [" + state + "]", MenuAlign::Left, [mask = f.bit](gentity_t* e, Menu&) {
+		const size_t state = (!en && !dis) ? 0 : (en ? 1 : 2);
+		builder.add(MapFlagLabels()[i][state], MenuAlign::Left, [mask = f.bit](gentity_t* e, Menu&) {
 			MapFlags_ToggleTri(mask);
 			OpenCallvoteMapFlags(e);
 			});
@@ -429,49 +503,49 @@ void OpenCallvoteMenu(gentity_t* ent) {
 	MapFlags_Clear();
 
 	// Map (with flags)
-	if (VoteEnabled("map")) {
+	if (VoteEnabled(Commands::kVoteFlag_Map)) {
 		builder.add("Map", MenuAlign::Left, [](gentity_t* e, Menu&) {
 			OpenCallvoteMap(e);
 			});
 	}
 
 	// Next Map
-	if (VoteEnabled("nextmap")) {
+	if (VoteEnabled(Commands::kVoteFlag_NextMap)) {
 		builder.add("Next Map", MenuAlign::Left, [](gentity_t* e, Menu&) {
 			OpenSimpleCallvote("nextmap", e);
 			});
 	}
 
 	// Restart
-	if (VoteEnabled("restart")) {
+	if (VoteEnabled(Commands::kVoteFlag_Restart)) {
 		builder.add("Restart Match", MenuAlign::Left, [](gentity_t* e, Menu&) {
 			OpenSimpleCallvote("restart", e);
 			});
 	}
 
 	// Gametype
-	if (VoteEnabled("gametype")) {
+	if (VoteEnabled(Commands::kVoteFlag_Gametype)) {
 		builder.add("Gametype", MenuAlign::Left, [](gentity_t* e, Menu&) {
 			OpenCallvoteGametype(e);
 			});
 	}
 
 	// Ruleset
-	if (VoteEnabled("ruleset")) {
+	if (VoteEnabled(Commands::kVoteFlag_Ruleset)) {
 		builder.add("Ruleset", MenuAlign::Left, [](gentity_t* e, Menu&) {
 			OpenCallvoteRuleset(e);
 			});
 	}
 
 	// Timelimit
-	if (VoteEnabled("timelimit")) {
+	if (VoteEnabled(Commands::kVoteFlag_Timelimit)) {
 		builder.add("Timelimit", MenuAlign::Left, [](gentity_t* e, Menu&) {
 			OpenCallvoteTimelimit(e);
 			});
 	}
 
 	// Scorelimit
-	if (VoteEnabled("scorelimit")) {
+	if (VoteEnabled(Commands::kVoteFlag_Scorelimit)) {
 		builder.add("Scorelimit", MenuAlign::Left, [](gentity_t* e, Menu&) {
 			OpenCallvoteScorelimit(e);
 			});
@@ -479,12 +553,12 @@ void OpenCallvoteMenu(gentity_t* ent) {
 
 	// Team things only if teams exist
 	if (Teams()) {
-		if (VoteEnabled("shuffle")) {
+		if (VoteEnabled(Commands::kVoteFlag_Shuffle)) {
 			builder.add("Shuffle Teams", MenuAlign::Left, [](gentity_t* e, Menu&) {
 				OpenSimpleCallvote("shuffle", e);
 				});
 		}
-		if (VoteEnabled("balance")) {
+		if (VoteEnabled(Commands::kVoteFlag_Balance)) {
 			builder.add("Balance Teams", MenuAlign::Left, [](gentity_t* e, Menu&) {
 				OpenSimpleCallvote("balance", e);
 				});
@@ -492,28 +566,28 @@ void OpenCallvoteMenu(gentity_t* ent) {
 	}
 
 	// Unlagged
-	if (VoteEnabled("unlagged")) {
+	if (VoteEnabled(Commands::kVoteFlag_Unlagged)) {
 		builder.add("Unlagged", MenuAlign::Left, [](gentity_t* e, Menu&) {
 			OpenCallvoteUnlagged(e);
 			});
 	}
 
 	// Cointoss
-	if (VoteEnabled("cointoss")) {
+	if (VoteEnabled(Commands::kVoteFlag_Cointoss)) {
 		builder.add("Cointoss", MenuAlign::Left, [](gentity_t* e, Menu&) {
 			OpenSimpleCallvote("cointoss", e);
 			});
 	}
 
 	// Random
-	if (VoteEnabled("random")) {
+	if (VoteEnabled(Commands::kVoteFlag_Random)) {
 		builder.add("Random Number", MenuAlign::Left, [](gentity_t* e, Menu&) {
 			OpenCallvoteRandom(e);
 			});
 	}
 
 	// Arena page (only if RA2 and vote enabled)
-	if (level.arenaTotal && VoteEnabled("arena")) {
+	if (level.arenaTotal && VoteEnabled(Commands::kVoteFlag_Arena)) {
 		builder.add("Arena", MenuAlign::Left, [](gentity_t* e, Menu&) {
 			OpenCallvoteArena(e);
 			});
@@ -21,7 +21,7 @@ void OpenPlayerMatchStatsMenu(gentity_t* ent) {
 		if (!ent || !ent->client || !g_matchstats->integer) return;
 
 		auto& menu = const_cast<Menu&>(m);
-		auto& st = ent->client->pers.match;
+		const ClientMatchStats st = ent->client->MatchStats();
 		int i = 0;
 
 		menu.entries[i++].text = "Player Stats for Match";
@@ -31,20 +31,20 @@ void OpenPlayerMatchStatsMenu(gentity_t* ent) {
 		if (value[0]) menu.entries[i++].text = value;
 
 		menu.entries[i++].text = "--------------------------";
-		menu.entries[i++].text = fmt::format("kills: {}", st.totalKills);
-		menu.entries[i++].text = fmt::format("deaths: {}", st.totalDeaths);
-		if (st.totalDeaths > 0)
-			menu.entries[i++].text = fmt::format("k/d ratio: {:.2f}", (float)st.totalKills / st.totalDeaths);
+		menu.entries[i++].text = fmt::format("kills: {}", st.totalKills());
+		menu.entries[i++].text = fmt::format("deaths: {}", st.totalDeaths());
+		if (st.totalDeaths() > 0)
+			menu.entries[i++].text = fmt::format("k/d ratio: {:.2f}", (float)st.totalKills() / st.totalDeaths());
 		else i++;
-		menu.entries[i++].text = fmt::format("dmg dealt: {}", st.totalDmgDealt);
-		menu.entries[i++].text = fmt::format("dmg received: {}", st.totalDmgReceived);
-		if (st.totalDmgReceived > 0)
-			menu.entries[i++].text = fmt::format("dmg ratio: {:.2f}", (float)st.totalDmgDealt / st.totalDmgReceived);
+		menu.entries[i++].text = fmt::format("dmg dealt: {}", st.totalDmgDealt());
+		menu.entries[i++].text = fmt::format("dmg received: {}", st.totalDmgReceived());
+		if (st.totalDmgReceived() > 0)
+			menu.entries[i++].text = fmt::format("dmg ratio: {:.2f}", (float)st.totalDmgDealt() / st.totalDmgReceived());
 		else i++;
-		menu.entries[i++].text = fmt::format("shots fired: {}", st.totalShots);
-		menu.entries[i++].text = fmt::format("shots on target: {}", st.totalHits);
-		if (st.totalShots > 0)
-			menu.entries[i++].text = fmt::format("total accuracy: {}%", (int)((float)st.totalHits / st.totalShots * 100));
+		menu.entries[i++].text = fmt::format("shots fired: {}", st.totalShots());
+		menu.entries[i++].text = fmt::format("shots on target: {}", st.totalHits());
+		if (st.totalShots() > 0)
+			menu.entries[i++].text = fmt::format("total accuracy: {}%", (int)((float)st.totalHits() / st.totalShots() * 100));
 		};
 
 	MenuSystem::Open(ent, std::move(menu));
@@ -49,9 +49,8 @@ void OpenVoteMenu(gentity_t* ent) {
 			menu.entries[i++].text = "[ YES ]";
 			if (i > 0 && i <= menu.entries.size())
 				menu.entries[static_cast<int>(i) - 1].onSelect = [](gentity_t* e, Menu&) {
-				level.vote.countYes++;
-				e->client->pers.voted = 1;
-				gi.Client_Print(e, PRINT_HIGH, "Vote cast.\n");
+				if (G_CastVote(e->client, true))
+					gi.Client_Print(e, PRINT_HIGH, "Vote cast.\n");
 				MenuSystem::Close(e);
 				};
 
@@ -59,9 +58,8 @@ void OpenVoteMenu(gentity_t* ent) {
 			menu.entries[i++].text = "[ NO ]";
 			if (i > 0 && i <= menu.entries.size())
 				menu.entries[static_cast<int>(i) - 1].onSelect = [](gentity_t* e, Menu&) {
-				level.vote.countNo++;
-				e->client->pers.voted = -1;
-				gi.Client_Print(e, PRINT_HIGH, "Vote cast.\n");
+				if (G_CastVote(e->client, false))
+					gi.Client_Print(e, PRINT_HIGH, "Vote cast.\n");
 				MenuSystem::Close(e);
 				};
 		}
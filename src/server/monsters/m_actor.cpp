@@ -402,7 +402,7 @@ void actor_use(gentity_t* self, gentity_t* other, gentity_t* activator)
 	}
 	
 	self->moveTarget = self->goalEntity = PickTarget(self->target);
-	if (!self->moveTarget || strcmp(self->moveTarget->className, "target_actor") != 0) {
+	if (!G_IsClass(self->moveTarget, EntityClass::TargetActor)) {
 		gi.Com_PrintFmt("{}: has bad target {}\n", *self, self->target);
 		self->target = nullptr;
 		self->monsterInfo.stand(self);
@@ -325,13 +325,13 @@ static void CarrierSpawn(gentity_t *self) {
 			ent->enemy = self->enemy;
 			FoundTarget(ent);
 
-			if (!strcmp(ent->className, "monster_kamikaze")) {
+			if (G_IsClass(ent, EntityClass::MonsterKamikaze)) {
 				ent->monsterInfo.lefty = false;
 				ent->monsterInfo.attackState = MonsterAttackState::Straight;
 				M_SetAnimation(ent, &flyer_move_kamikaze);
 				ent->monsterInfo.aiFlags |= AI_CHARGING;
 				ent->owner = self;
-			} else if (!strcmp(ent->className, "monster_flyer")) {
+			} else if (G_IsClass(ent, EntityClass::MonsterFlyer)) {
 				if (brandom()) {
 					ent->monsterInfo.lefty = false;
 					ent->monsterInfo.attackState = MonsterAttackState::Sliding;
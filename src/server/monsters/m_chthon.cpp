@@ -88,7 +88,7 @@ static bool chthon_is_energy_mod(const MeansOfDeath& mod) {
 }
 
 static bool chthon_is_lavaman(const gentity_t* self) {
-        return (self->className && !Q_strcasecmp(self->className, "monster_lavaman"));
+        return G_IsClass(self, EntityClass::MonsterLavaman);
 }
 
 static int chthon_base_skin(const gentity_t* self) {
@@ -730,7 +730,7 @@ static USE(Use_target_chthon_lightning) (gentity_t* self, gentity_t* other, gent
         for (gentity_t* e = g_entities; e < g_entities + globals.numEntities; ++e) {
                 if (!e->inUse || !e->className)
                         continue;
-                if (strcmp(e->className, "monster_chthon") != 0 && strcmp(e->className, "monster_lavaman") != 0)
+                if (!G_IsClass(e, EntityClass::MonsterChthon) && !G_IsClass(e, EntityClass::MonsterLavaman))
                         continue;
                 if (self->target && e->targetName && strcmp(self->target, e->targetName) != 0)
                         continue;
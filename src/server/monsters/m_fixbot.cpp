@@ -277,10 +277,10 @@ void use_scanner(gentity_t *self) {
 
 	while ((ent = FindRadius(ent, self->s.origin, radius)) != nullptr) {
 		if (ent->health >= 100) {
-			if (strcmp(ent->className, "object_repair") == 0) {
+			if (G_IsClass(ent, EntityClass::ObjectRepair)) {
 				if (visible(self, ent)) {
 					// remove the old one
-					if (strcmp(self->goalEntity->className, "bot_goal") == 0) {
+					if (G_IsClass(self->goalEntity, EntityClass::BotGoal)) {
 						self->goalEntity->nextThink = level.time + 100_ms;
 						self->goalEntity->think = FreeEntity;
 					}
@@ -311,7 +311,7 @@ void use_scanner(gentity_t *self) {
 	len = vec.length();
 
 	if (len < 32) {
-		if (strcmp(self->goalEntity->className, "object_repair") == 0) {
+		if (G_IsClass(self->goalEntity, EntityClass::ObjectRepair)) {
 			M_SetAnimation(self, &fixbot_move_weld_start);
 		} else {
 			self->goalEntity->nextThink = level.time + 100_ms;
@@ -329,7 +329,7 @@ void use_scanner(gentity_t *self) {
 	  bot is stuck get new goalEntity
 	*/
 	if (len == 0) {
-		if (strcmp(self->goalEntity->className, "object_repair") == 0) {
+		if (G_IsClass(self->goalEntity, EntityClass::ObjectRepair)) {
 			M_SetAnimation(self, &fixbot_move_stand);
 		} else {
 			self->goalEntity->nextThink = level.time + 100_ms;
@@ -1092,7 +1092,7 @@ MONSTERINFO_WALK(fixbot_walk) (gentity_t *self) -> void {
 	Vector3 vec;
 	float  len;
 
-	if (self->goalEntity && strcmp(self->goalEntity->className, "object_repair") == 0) {
+	if (G_IsClass(self->goalEntity, EntityClass::ObjectRepair)) {
 		vec = self->s.origin - self->goalEntity->s.origin;
 		len = vec.length();
 		if (len < 32) {
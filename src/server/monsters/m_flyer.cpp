@@ -219,7 +219,7 @@ static void flyer_kamikaze_explode(gentity_t *self) {
 	Vector3 dir;
 
 	if (self->monsterInfo.commander && self->monsterInfo.commander->inUse &&
-		!strcmp(self->monsterInfo.commander->className, "monster_carrier"))
+		G_IsClass(self->monsterInfo.commander, EntityClass::MonsterCarrier))
 		self->monsterInfo.commander->monsterInfo.monster_slots++;
 
 	if (self->enemy) {
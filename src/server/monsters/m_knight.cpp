@@ -299,7 +299,7 @@ MMOVE_T(knight_move_death2) = { FRAME_deathb1, FRAME_deathb11, knight_frames_dea
 static DIE(knight_die) (gentity_t* self, gentity_t* inflictor, gentity_t* attacker,
         int damage, const Vector3& point, const MeansOfDeath& mod) -> void {
         const bool isStatue = self->spawnFlags.has(SPAWNFLAG_STATUE_STATIONARY) ||
-                (self->className && strcmp(self->className, "monster_statue") == 0);
+                G_IsClass(self, EntityClass::MonsterStatue);
 
         if (M_CheckGib(self, mod)) {
                 gi.sound(self, CHAN_VOICE, gi.soundIndex("misc/udeath.wav"), 1, ATTN_NORM, 0);
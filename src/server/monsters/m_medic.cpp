@@ -150,8 +150,8 @@ void M_SetupReinforcements(const char *reinforcements, reinforcement_list_t &lis
 			list.num_reinforcements++;
 
 	// allocate
-	list.reinforcements = (reinforcement_t *)gi.TagMalloc(sizeof(reinforcement_t) * list.num_reinforcements, TAG_LEVEL);
-	list.spawn_counts = (uint32_t *)gi.TagMalloc(sizeof(uint32_t) * list.num_reinforcements, TAG_LEVEL);
+	list.reinforcements = (reinforcement_t *)G_LevelAlloc(sizeof(reinforcement_t) * list.num_reinforcements, LevelMem::Reinforcements);
+	list.spawn_counts = (uint32_t *)G_LevelAlloc(sizeof(uint32_t) * list.num_reinforcements, LevelMem::Reinforcements);
 	memset(list.spawn_counts, 0, sizeof(uint32_t) * list.num_reinforcements);
 
 	// parse
@@ -166,7 +166,7 @@ void M_SetupReinforcements(const char *reinforcements, reinforcement_list_t &lis
 		if (!*token || r == list.reinforcements + list.num_reinforcements)
 			break;
 
-		r->className = CopyString(token, TAG_LEVEL);
+		r->className = G_InternString(token);
 
 		token = COM_ParseEx(&p, "; ");
 
@@ -221,7 +221,7 @@ void abortHeal(gentity_t *self, bool change_frame, bool gib, bool mark) {
 		// gib em!
 		if (mark) {
 			// if the first badMedic slot is filled by a medic, skip it and use the second one
-			if ((self->enemy->monsterInfo.badMedic1) && (self->enemy->monsterInfo.badMedic1->inUse) && (!strncmp(self->enemy->monsterInfo.badMedic1->className, "monster_medic", 13))) {
+			if ((self->enemy->monsterInfo.badMedic1) && (self->enemy->monsterInfo.badMedic1->inUse) && G_InClassGroup(self->enemy->monsterInfo.badMedic1, EntityClassGroup::Medic)) {
 				self->enemy->monsterInfo.badMedic2 = self;
 			} else {
 				self->enemy->monsterInfo.badMedic1 = self;
@@ -296,7 +296,7 @@ static gentity_t *medic_FindDeadMonster(gentity_t *self) {
 			continue;
 		if (!visible(self, ent))
 			continue;
-		if (!strncmp(ent->className, "player", 6)) // stop it from trying to heal player_noise entities
+		if (G_InClassGroup(ent, EntityClassGroup::Player)) // stop it from trying to heal player_noise entities
 			continue;
 		// FIXME - there's got to be a better way ..
 		// make sure we don't spawn people right on top of us
@@ -632,7 +632,7 @@ static void medic_fire_blaster(gentity_t *self) {
 	dir = end - start;
 	dir.normalize();
 
-	if (!strcmp(self->enemy->className, "tesla_mine"))
+	if (G_IsClass(self->enemy, EntityClass::TeslaMine))
 		damage = 3;
 
 	// medic commander shoots blaster2
@@ -401,7 +401,7 @@ static bool G_alternate_flystep(gentity_t *ent, Vector3 move, bool relink, genti
 	if (ent->enemy && (ent->monsterInfo.fly_buzzard || (ent->monsterInfo.aiFlags & AI_MEDIC))) {
 		Vector3 d = (ent->s.origin - towards_origin).normalized();
 		d = VectorToAngles(d);
-		ent->s.angles[PITCH] = LerpAngle(ent->s.angles[PITCH], -d[PITCH], gi.frameTimeSec * 4.0f);
+		ent->s.angles[PITCH] = LerpAngle(ent->s.angles[PITCH], -d[PITCH], gi.frameTimeSec * 4.0f * M_ThinkSteps(ent));
 	} else
 		ent->s.angles[PITCH] = 0;
 
@@ -424,7 +424,7 @@ static bool G_flystep(gentity_t *ent, Vector3 move, bool relink, gentity_t *curr
 	// from shooting his fliers, who spawn in below him
 	float minheight;
 
-	if (!strcmp(ent->className, "monster_carrier"))
+	if (G_IsClass(ent, EntityClass::MonsterCarrier))
 		minheight = 104;
 	else
 		minheight = 40;
@@ -454,7 +454,7 @@ static bool G_flystep(gentity_t *ent, Vector3 move, bool relink, gentity_t *curr
 						new_move[2] += dist;
 					}
 			} else {
-				if (strcmp(ent->className, "monster_fixbot") == 0) {
+				if (G_IsClass(ent, EntityClass::MonsterFixbot)) {
 					if (ent->s.frame >= 105 && ent->s.frame <= 120) {
 						if (dz > 12)
 							new_move[2]--;
@@ -551,7 +551,7 @@ static bool G_movestep(gentity_t *ent, Vector3 move, bool relink) {
 		if (current_bad) {
 			ent->bad_area = current_bad;
 
-			if (ent->enemy && !strcmp(ent->enemy->className, "tesla_mine")) {
+			if (G_IsClass(ent->enemy, EntityClass::TeslaMine)) {
 				// if the tesla is in front of us, back up...
 				if (IsBadAhead(ent, current_bad, move))
 					move *= -1;
@@ -690,11 +690,11 @@ static bool G_movestep(gentity_t *ent, Vector3 move, bool relink) {
 		new_bad = CheckForBadArea(ent);
 		if (!current_bad && new_bad) {
 			if (new_bad->owner) {
-				if (!strcmp(new_bad->owner->className, "tesla_mine")) {
+				if (G_IsClass(new_bad->owner, EntityClass::TeslaMine)) {
 					if ((!(ent->enemy)) || (!(ent->enemy->inUse))) {
 						TargetTesla(ent, new_bad->owner);
 						ent->monsterInfo.aiFlags |= AI_BLOCKED;
-					} else if (!strcmp(ent->enemy->className, "tesla_mine")) {
+					} else if (G_IsClass(ent->enemy, EntityClass::TeslaMine)) {
 					} else if ((ent->enemy) && (ent->enemy->client)) {
 						if (!visible(ent, ent->enemy)) {
 							TargetTesla(ent, new_bad->owner);
@@ -817,8 +817,9 @@ void M_ChangeYaw(gentity_t *ent) {
 		return;
 
 	move = ideal - current;
-	// [Paril-KEX] high tick rate
+	// [Paril-KEX] high tick rate; a reduced-rate think turns for every frame it covers
 	speed = ent->yawSpeed / (static_cast<float>(gi.tickRate) / 10.0f);
+	speed *= static_cast<float>(M_ThinkSteps(ent));
 
 	if (ideal > current) {
 		if (move >= 180)
@@ -870,7 +871,7 @@ static bool G_StepDirection(gentity_t *ent, float yaw, float dist, bool allow_no
 		if (!ent->inUse)
 			return true; // PGM g_touchtrigger free problem
 
-		if (strncmp(ent->className, "monster_widow", 13)) {
+		if (!G_InClassGroup(ent, EntityClassGroup::Widow)) {
 			if (!FacingIdeal(ent)) {
 				// not turned far enough, so don't take the step
 				// but still turn
@@ -1117,7 +1118,7 @@ static bool M_NavPathToGoal(gentity_t *self, float dist, const Vector3 &goal) {
 					return true;
 			}
 
-			self->monsterInfo.path_blocked_counter += FRAME_TIME_S * 3;
+			self->monsterInfo.path_blocked_counter += FRAME_TIME_S * 3 * M_ThinkSteps(self);
 		}
 
 		if (self->monsterInfo.path_blocked_counter > 1.5_sec)
@@ -1196,7 +1197,7 @@ static bool M_MoveToPath(gentity_t *self, float dist) {
 		return false;
 	}
 
-	self->monsterInfo.path_blocked_counter += FRAME_TIME_S * 3;
+	self->monsterInfo.path_blocked_counter += FRAME_TIME_S * 3 * M_ThinkSteps(self);
 
 	if (self->monsterInfo.path_blocked_counter > 5_sec) {
 		self->monsterInfo.path_blocked_counter = 0_ms;
@@ -1234,7 +1235,7 @@ void M_MoveToGoal(gentity_t *ent, float dist) {
 	// [Paril-KEX] try paths if we can't see the enemy
 	if (!(ent->monsterInfo.aiFlags & AI_COMBAT_POINT) && ent->monsterInfo.attackState < MonsterAttackState::Missile) {
 		if (M_MoveToPath(ent, dist)) {
-			ent->monsterInfo.path_blocked_counter = max(0_ms, ent->monsterInfo.path_blocked_counter - FRAME_TIME_S);
+			ent->monsterInfo.path_blocked_counter = max(0_ms, ent->monsterInfo.path_blocked_counter - FRAME_TIME_S * M_ThinkSteps(ent));
 			return;
 		}
 	}
@@ -1247,7 +1248,7 @@ void M_MoveToGoal(gentity_t *ent, float dist) {
 	// [Paril-KEX] dumb hack; in some n64 maps, the corners are way too high and
 	// I'm too lazy to fix them individually in maps, so here's a game fix..
 	if (!(goal->flags & FL_PARTIALGROUND) && !(ent->flags & (FL_FLY | FL_SWIM)) &&
-		goal->className && (!strcmp(goal->className, "path_corner") || !strcmp(goal->className, "point_combat"))) {
+		(G_IsClass(goal, EntityClass::PathCorner) || G_IsClass(goal, EntityClass::PointCombat))) {
 		Vector3 p = goal->s.origin;
 		p.z = ent->s.origin.z;
 
@@ -1280,7 +1281,7 @@ void M_MoveToGoal(gentity_t *ent, float dist) {
 
 		// we didn't make a step, so don't try this for a while
 		// *unless* we're going to a path corner
-		if (goal->className && strcmp(goal->className, "path_corner") && strcmp(goal->className, "point_combat")) {
+		if (goal->className && !G_IsClass(goal, EntityClass::PathCorner) && !G_IsClass(goal, EntityClass::PointCombat)) {
 			ent->monsterInfo.bad_move_time = level.time + 5_sec;
 			ent->monsterInfo.aiFlags &= ~AI_CHARGING;
 		}
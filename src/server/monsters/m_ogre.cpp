@@ -342,8 +342,8 @@ static void ogre_flak_fire(gentity_t* self) {
 }
 
 static void ogre_fire(gentity_t* self) {
-        const bool isMarksman = self->className && strcmp(self->className, "monster_ogre_marksman") == 0;
-        const bool isMultiGrenade = self->className && strcmp(self->className, "monster_ogre_multigrenade") == 0;
+        const bool isMarksman = G_IsClass(self, EntityClass::MonsterOgreMarksman);
+        const bool isMultiGrenade = G_IsClass(self, EntityClass::MonsterOgreMultiGrenade);
 
         if (isMarksman)
                 ogre_flak_fire(self);
@@ -488,9 +488,9 @@ MONSTERINFO_SETSKIN(ogre_setskin) (gentity_t* self) -> void {
         int baseSkin = 0;
 
         if (self->className) {
-                if (strcmp(self->className, "monster_ogre_marksman") == 0)
+                if (G_IsClass(self, EntityClass::MonsterOgreMarksman))
                         baseSkin = 2;
-                else if (strcmp(self->className, "monster_ogre_multigrenade") == 0)
+                else if (G_IsClass(self, EntityClass::MonsterOgreMultiGrenade))
                         baseSkin = 4;
         }
 
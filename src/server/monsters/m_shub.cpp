@@ -556,7 +556,7 @@ static USE(Use_target_oldone_vulnerable)
         for (gentity_t* ent = g_entities; ent < g_entities + globals.numEntities; ++ent) {
                 if (!ent->inUse || !ent->className)
                         continue;
-                if (strcmp(ent->className, "monster_oldone") != 0)
+                if (!G_IsClass(ent, EntityClass::MonsterOldOne))
                         continue;
                 if (self->target && (!ent->targetName || strcmp(self->target, ent->targetName) != 0))
                         continue;
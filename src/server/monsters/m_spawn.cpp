@@ -290,7 +290,7 @@ PAIN(tarbaby_pain) (gentity_t* self, gentity_t* other, float kick, int damage, c
         if (level.time < self->pain_debounce_time)
                 return;
 
-        if (!self->className || strcmp(self->className, "monster_tarbaby_hell") != 0)
+        if (!G_IsClass(self, EntityClass::MonsterTarbabyHell))
                 return;
 
         if (self->spawnFlags.has(SPAWNFLAG_HELLSPAWN_BABY))
@@ -760,14 +760,14 @@ MONSTERINFO_ATTACK(tank_attack) (gentity_t *self) -> void {
 	r = frandom();
 
 	if (range <= 125) {
-		bool can_machinegun = (!self->enemy->className || strcmp(self->enemy->className, "tesla_mine")) && M_CheckClearShot(self, monster_flash_offset[MZ2_TANK_MACHINEGUN_5]);
+		bool can_machinegun = !G_IsClass(self->enemy, EntityClass::TeslaMine) && M_CheckClearShot(self, monster_flash_offset[MZ2_TANK_MACHINEGUN_5]);
 
 		if (can_machinegun && r < 0.5f)
 			M_SetAnimation(self, &tank_move_attack_chain);
 		else if (M_CheckClearShot(self, monster_flash_offset[MZ2_TANK_BLASTER_1]))
 			M_SetAnimation(self, &tank_move_attack_blast);
 	} else if (range <= 250) {
-		bool can_machinegun = (!self->enemy->className || strcmp(self->enemy->className, "tesla_mine")) && M_CheckClearShot(self, monster_flash_offset[MZ2_TANK_MACHINEGUN_5]);
+		bool can_machinegun = !G_IsClass(self->enemy, EntityClass::TeslaMine) && M_CheckClearShot(self, monster_flash_offset[MZ2_TANK_MACHINEGUN_5]);
 
 		if (can_machinegun && r < 0.25f)
 			M_SetAnimation(self, &tank_move_attack_chain);
@@ -218,7 +218,7 @@ namespace {
 
 		Vector3 aim = (target - start).normalized();
 
-		int damage = (strcmp(self->className, "monster_mummy") == 0) ? 40 : 10;
+		int damage = G_IsClass(self, EntityClass::MonsterMummy) ? 40 : 10;
 
 		gi.sound(self, CHAN_WEAPON | CHAN_RELIABLE, sound_shot, 1.0f, ATTN_NORM, 0);
 
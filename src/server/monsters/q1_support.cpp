@@ -212,7 +212,7 @@ TOUCH(ZombieGibTouch) (gentity_t* ent, gentity_t* other, const trace_t& tr, bool
 				if (self->owner && !CanDamage(ent, self->owner))
 					continue;
 				if (!(ent->svFlags & SVF_MONSTER) && !(ent->flags & FL_DAMAGEABLE) && !ent->client &&
-					(!ent->className || std::strcmp(ent->className, "misc_explobox") != 0))
+					!G_IsClass(ent, EntityClass::MiscExplobox))
 					continue;
 				if (self->owner && CheckTeamDamage(ent, self->owner))
 					continue;
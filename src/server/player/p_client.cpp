@@ -316,7 +316,7 @@ void PushAward(gentity_t* ent, PlayerMedal medal) {
 	cl.pers.medalTime = level.time;
 	cl.pers.medalType = medal;
 
-	auto& count = cl.pers.match.medalCount[idx];
+	auto& count = cl.MatchStats().medalCount()[idx];
 	++count;
 
 	std::string_view key = (count == 1 && !info.soundKeyFirst.empty())
@@ -417,7 +417,7 @@ void P_SaveGhostSlot(gentity_t* ent) {
 	// Store inventory and stats
 	slot->inventory = cl->pers.inventory;
 	slot->ammoMax = cl->pers.ammoMax;
-	slot->match = cl->pers.match;
+	slot->MatchStats().CopyFrom(cl->MatchStats());
 	slot->weapon = cl->pers.weapon;
 	slot->lastWeapon = cl->pers.lastWeapon;
 	slot->team = cl->sess.team;
@@ -452,7 +452,7 @@ void P_RestoreFromGhostSlot(gentity_t* ent) {
 		// Restore inventory and stats
 		cl->pers.inventory = g.inventory;
 		cl->pers.ammoMax = g.ammoMax;
-		cl->pers.match = g.match;
+		cl->MatchStats().CopyFrom(g.MatchStats());
 		cl->pers.weapon = g.weapon;
 		cl->pers.lastWeapon = g.lastWeapon;
 		cl->sess.team = g.team;
@@ -469,6 +469,7 @@ void P_RestoreFromGhostSlot(gentity_t* ent) {
 		gi.Client_Print(ent, PRINT_HIGH, "Your game state has been restored.\n");
 
 		// Clear the ghost slot
+		g.MatchStats().Reset();
 		g = Ghosts{};
 		return;
 	}
@@ -1563,14 +1564,14 @@ static void PushDeathStats(gentity_t* victim, gentity_t* attacker, const MeansOf
 	auto  now = level.time;
 	auto& glob = level.match;
 	auto* vcl = victim->client;
-	auto& vSess = vcl->pers.match;
+	const ClientMatchStats vSess = vcl->MatchStats();
 	bool  isSuicide = (attacker == victim);
 	bool  validKill = (attacker && attacker->client && !isSuicide && !mod.friendly_fire);
 
 	// -- handle a valid non-suicide kill --
 	if (validKill) {
 		auto* acl = attacker->client;
-		auto& aSess = acl->pers.match;
+		const ClientMatchStats aSess = acl->MatchStats();
 
 		if (glob.totalKills == 0) {
 			PushAward(attacker, PlayerMedal::First_Frag);
@@ -1584,19 +1585,19 @@ static void PushDeathStats(gentity_t* victim, gentity_t* attacker, const MeansOf
 			G_AdjustPlayerScore(acl, 1, Game::Is(GameType::TeamDeathmatch) || Game::Is(GameType::Domination), 1);
 		}
 
-		++aSess.totalKills;
-		++aSess.modTotalKills[static_cast<int>(mod.id)];
+		++aSess.totalKills();
+		++aSess.modTotalKills()[static_cast<int>(mod.id)];
 		++glob.totalKills;
 		++glob.modKills[static_cast<int>(mod.id)];
 		if (now - victim->client->respawnMaxTime < 1_sec) {
 			++glob.totalSpawnKills;
-			++acl->pers.match.totalSpawnKills;
+			++aSess.totalSpawnKills();
 		}
 
 
 		if (OnSameTeam(attacker, victim)) {
 			++glob.totalTeamKills;
-			++acl->pers.match.totalTeamKills;
+			++aSess.totalTeamKills();
 		}
 
 		if (acl->pers.lastFragTime && acl->pers.lastFragTime + 2_sec > now) {
@@ -1610,16 +1611,16 @@ static void PushDeathStats(gentity_t* victim, gentity_t* attacker, const MeansOf
 	}
 
 	// -- always record the victim's death --
-	++vSess.totalDeaths;
+	++vSess.totalDeaths();
 	++glob.totalDeaths;
 	++glob.modDeaths[static_cast<int>(mod.id)];
-	++vSess.modTotalDeaths[static_cast<int>(mod.id)];
+	++vSess.modTotalDeaths()[static_cast<int>(mod.id)];
 
 	if (isSuicide) {
-		++vSess.totalSuicides;
+		++vSess.totalSuicides();
 	}
 	else if (now - victim->client->respawnMaxTime < 1_sec) {
-		++vSess.totalSpawnDeaths;
+		++vSess.totalSpawnDeaths();
 	}
 
 	// -- penalty / follow-killer logic -- 
@@ -1754,7 +1755,7 @@ static void GibPlayer(gentity_t* self, int damage) {
 	}
 }
 
-inline bool FreezeTag_IsActive() {
+bool FreezeTag_IsActive() {
 	return Game::Is(GameType::FreezeTag) && !level.intermission.time;
 }
 
@@ -1805,133 +1806,7 @@ static void FreezeTag_StartFrozenState(gentity_t* ent) {
 	}
 }
 
-static bool FreezeTag_CanThawTarget(gentity_t* thawer, gentity_t* frozen) {
-	if (!FreezeTag_IsActive())
-		return false;
-
-	if (!thawer || !thawer->client || !frozen || !frozen->client)
-		return false;
-
-	if (!ClientIsPlaying(thawer->client) || thawer->client->eliminated)
-		return false;
-
-	if (!ClientIsPlaying(frozen->client) || !frozen->client->eliminated)
-		return false;
-
-	if (!Teams() || thawer->client->sess.team != frozen->client->sess.team)
-		return false;
-
-	if (frozen->client->resp.thawer && frozen->client->resp.thawer != thawer)
-		return false;
-
-	return true;
-}
-
-/*
-=============
-FreezeTag_FindFrozenTarget
-
-Locates the best frozen teammate within range of the thawer, prioritizing
-line-of-sight and directional alignment.
-=============
-*/
-gentity_t* worr::server::client::FreezeTag_FindFrozenTarget(gentity_t* thawer) {
-	if (!FreezeTag_IsActive() || !thawer || !thawer->client)
-		return nullptr;
-
-	constexpr float THAW_RANGE = 96.0f;
-
-	Vector3 forward;
-	AngleVectors(thawer->client->vAngle, forward, nullptr, nullptr);
-
-	Vector3 eyeOrigin = thawer->s.origin + thawer->client->ps.viewOffset +
-		Vector3{ 0, 0, static_cast<float>(thawer->client->ps.pmove.viewHeight) };
-
-	trace_t tr = gi.traceLine(eyeOrigin, eyeOrigin + forward * THAW_RANGE, thawer, MASK_SHOT);
-	if (tr.ent && FreezeTag_CanThawTarget(thawer, tr.ent))
-		return tr.ent;
-
-	gentity_t* best = nullptr;
-	float       bestDot = 0.0f;
-
-	for (gentity_t* candidate : active_clients()) {
-		if (!FreezeTag_CanThawTarget(thawer, candidate))
-			continue;
-
-		Vector3 toTarget = candidate->s.origin - thawer->s.origin;
-		const float distance = toTarget.length();
-		if (distance > THAW_RANGE)
-			continue;
-
-		Vector3 dir = toTarget.normalized();
-		const float dot = dir.dot(forward);
-		if (dot < 0.35f)
-			continue;
-
-		if (gi.traceLine(eyeOrigin, candidate->s.origin, thawer, MASK_SHOT).fraction != 1.0f)
-			continue;
-
-		if (!best || dot > bestDot) {
-			best = candidate;
-			bestDot = dot;
-		}
-	}
-
-	return best;
-}
-
 static constexpr GameTime FREEZETAG_THAW_HOLD_DURATION = 3_sec;
-static constexpr float FREEZETAG_THAW_RANGE = MELEE_DISTANCE;
-
-/*
-=============
-FreezeTag_IsValidThawHelper
-
-Checks if a thawer is eligible to thaw the frozen teammate based on distance,
-team alignment, and active state.
-=============
-*/
-bool worr::server::client::FreezeTag_IsValidThawHelper(gentity_t* thawer, gentity_t* frozen) {
-	if (!FreezeTag_IsActive())
-		return false;
-
-	if (!thawer || !thawer->client || !frozen || !frozen->client)
-		return false;
-
-	if (thawer == frozen)
-		return false;
-
-	if (!ClientIsPlaying(thawer->client) || thawer->client->eliminated)
-		return false;
-
-	if (!ClientIsPlaying(frozen->client) || !frozen->client->eliminated)
-		return false;
-
-	if (!Teams() || thawer->client->sess.team != frozen->client->sess.team)
-		return false;
-
-	const Vector3 delta = frozen->s.origin - thawer->s.origin;
-	return delta.length() <= FREEZETAG_THAW_RANGE;
-}
-
-static gentity_t* FreezeTag_FindNearbyThawer(gentity_t* frozen) {
-	gentity_t* best = nullptr;
-	float       bestDistance = 0.0f;
-
-	for (gentity_t* candidate : active_clients()) {
-if (!worr::server::client::FreezeTag_IsValidThawHelper(candidate, frozen))
-			continue;
-
-		const float distance = (frozen->s.origin - candidate->s.origin).length();
-
-		if (!best || distance < bestDistance) {
-			best = candidate;
-			bestDistance = distance;
-		}
-	}
-
-	return best;
-}
 
 static void FreezeTag_StopThawHold(gentity_t* frozen, bool notify) {
 	if (!frozen || !frozen->client)
@@ -2391,6 +2266,7 @@ void InitClientPersistant(gentity_t* ent, gclient_t* client) {
 	Q_strlcpy(userInfo, client->pers.userInfo, sizeof(userInfo));
 
 	client->pers = client_persistant_t{};
+	client->MatchStats().Reset();
 
 	ClientUserinfoChanged(ent, userInfo);
 
@@ -2768,7 +2644,7 @@ void CopyToBodyQue(gentity_t* ent) {
 	body->moveType = ent->moveType;
 	body->health = ent->health;
 	body->gibHealth = ent->gibHealth;
-	body->s.event = EV_OTHER_TELEPORT;
+	G_SetEvent(body, EV_OTHER_TELEPORT);
 	body->velocity = ent->velocity;
 	body->aVelocity = ent->aVelocity;
 	body->groundEntity = ent->groundEntity;
@@ -2798,7 +2674,7 @@ void G_PostRespawn(gentity_t* self) {
 		return;
 
 	// add a teleportation effect
-	self->s.event = EV_PLAYER_TELEPORT;
+	G_SetEvent(self, EV_PLAYER_TELEPORT);
 
 	// hold in place briefly
 	self->client->ps.pmove.pmFlags |= PMF_TIME_KNOCKBACK;
@@ -3861,7 +3737,7 @@ static void P_FallingDamage(gentity_t* ent, const PMove& pm) {
 
 	if (delta < 15) {
 		if (!(pm.s.pmFlags & PMF_ON_LADDER))
-			ent->s.event = EV_FOOTSTEP;
+			G_SetEvent(ent, EV_FOOTSTEP);
 		return;
 	}
 
@@ -3875,9 +3751,9 @@ static void P_FallingDamage(gentity_t* ent, const PMove& pm) {
 
 	if (delta > med_min) {
 		if (delta >= far_min)
-			ent->s.event = EV_FALL_FAR;
+			G_SetEvent(ent, EV_FALL_FAR);
 		else
-			ent->s.event = EV_FALL_MEDIUM;
+			G_SetEvent(ent, EV_FALL_MEDIUM);
 		if (g_fallingDamage->integer && !Game::Has(GameFlags::Arena)) {
 			ent->pain_debounce_time = level.time + FRAME_TIME_S; // no normal pain sound
 			if (RS(Quake3Arena))
@@ -3893,7 +3769,7 @@ static void P_FallingDamage(gentity_t* ent, const PMove& pm) {
 		}
 	}
 	else
-		ent->s.event = EV_FALL_SHORT;
+		G_SetEvent(ent, EV_FALL_SHORT);
 
 	// Paril: falling damage noises alert monsters
 	if (ent->health)
@@ -3954,161 +3830,6 @@ void ClientThink(gentity_t* ent, usercmd_t* ucmd) {
 
 void OpenJoinMenu(gentity_t* ent);
 
-// active monsters
-struct active_monsters_filter_t {
-	inline bool operator()(gentity_t* ent) const {
-		return (ent->inUse && (ent->svFlags & SVF_MONSTER) && ent->health > 0);
-	}
-};
-
-static inline entity_iterable_t<active_monsters_filter_t> active_monsters() {
-	return entity_iterable_t<active_monsters_filter_t> { game.maxClients + (uint32_t)BODY_QUEUE_SIZE + 1U };
-}
-
-static inline bool G_MonstersSearchingFor(gentity_t* player) {
-	for (auto ent : active_monsters()) {
-		// check for *any* player target
-		if (player == nullptr && ent->enemy && !ent->enemy->client)
-			continue;
-		// they're not targeting us, so who cares
-		else if (player != nullptr && ent->enemy != player)
-			continue;
-
-		// they lost sight of us
-		if ((ent->monsterInfo.aiFlags & AI_LOST_SIGHT) && level.time > ent->monsterInfo.trailTime + 5_sec)
-			continue;
-
-		// no sir
-		return true;
-	}
-
-	// yes sir
-	return false;
-}
-
-/*
-===============
-G_FindRespawnSpot
-
-Attempts to find a valid respawn spot near the given player.
-Returns true and fills `spot` if successful.
-===============
-*/
-static inline bool G_FindRespawnSpot(gentity_t* player, Vector3& spot) {
-	constexpr std::array<float, 5> yawOffsets{ { 0, 90, 45, -45, -90 } };
-	constexpr float backDistance = 128.0f;
-	constexpr float upDistance = 128.0f;
-	constexpr float viewHeight = static_cast<float>(DEFAULT_VIEWHEIGHT);
-	constexpr contents_t solidMask = MASK_PLAYERSOLID | CONTENTS_LAVA | CONTENTS_SLIME;
-
-	// Sanity check: make sure player isn't already stuck
-	if (gi.trace(player->s.origin, PLAYER_MINS, PLAYER_MAXS, player->s.origin, player, MASK_PLAYERSOLID).startSolid)
-		return false;
-
-	for (float yawOffset : yawOffsets) {
-		Vector3 yawAngles = { 0, player->s.angles[YAW] + 180.0f + yawOffset, 0 };
-
-		// Step 1: Try moving up first
-		Vector3 start = player->s.origin;
-		Vector3 end = start + Vector3{ 0, 0, upDistance };
-		trace_t tr = gi.trace(start, PLAYER_MINS, PLAYER_MAXS, end, player, solidMask);
-		if (tr.startSolid || tr.allSolid || (tr.contents & (CONTENTS_LAVA | CONTENTS_SLIME)))
-			continue;
-
-		// Step 2: Then move backwards from that elevated point
-		Vector3 forward;
-		AngleVectors(yawAngles, forward, nullptr, nullptr);
-		start = tr.endPos;
-		end = start + forward * backDistance;
-		tr = gi.trace(start, PLAYER_MINS, PLAYER_MAXS, end, player, solidMask);
-		if (tr.startSolid || tr.allSolid || (tr.contents & (CONTENTS_LAVA | CONTENTS_SLIME)))
-			continue;
-
-		// Step 3: Now cast downward to find solid ground
-		start = tr.endPos;
-		end = start - Vector3{ 0, 0, upDistance * 4 };
-		tr = gi.trace(start, PLAYER_MINS, PLAYER_MAXS, end, player, solidMask);
-		if (tr.startSolid || tr.allSolid || tr.fraction == 1.0f || tr.ent != world || tr.plane.normal.z < 0.7f)
-			continue;
-
-		// Avoid liquids
-		if (gi.pointContents(tr.endPos + Vector3{ 0, 0, viewHeight }) & MASK_WATER)
-			continue;
-
-		// Height delta check
-		float zDelta = std::fabs(player->s.origin[_Z] - tr.endPos[2]);
-		float stepLimit = (player->s.origin[_Z] < 0 ? STEPSIZE_BELOW : STEPSIZE);
-		if (zDelta > stepLimit * 4.0f)
-			continue;
-
-		// If stepped up/down, ensure visibility
-		if (zDelta > stepLimit) {
-			if (gi.traceLine(player->s.origin, tr.endPos, player, solidMask).fraction != 1.0f)
-				continue;
-			if (gi.traceLine(player->s.origin + Vector3{ 0, 0, viewHeight }, tr.endPos + Vector3{ 0, 0, viewHeight }, player, solidMask).fraction != 1.0f)
-				continue;
-		}
-
-		spot = tr.endPos;
-		return true;
-	}
-
-	return false;
-}
-
-/*
-==============================
-G_FindSquadRespawnTarget
-
-Scans for a valid living player who is not in combat or danger
-and has a suitable spawn spot nearby. Returns the player and spot.
-==============================
-*/
-static inline std::tuple<gentity_t*, Vector3> G_FindSquadRespawnTarget() {
-	const bool anyMonstersSearching = G_MonstersSearchingFor(nullptr);
-
-	for (gentity_t* player : active_clients()) {
-		auto* cl = player->client;
-
-		// Skip invalid candidates
-		if (player->deadFlag)
-			continue;
-
-		using enum CoopRespawn;
-
-		if (cl->last_damage_time >= level.time) {
-			cl->coopRespawnState = InCombat;
-			continue;
-		}
-		if (G_MonstersSearchingFor(player)) {
-			cl->coopRespawnState = InCombat;
-			continue;
-		}
-		if (anyMonstersSearching && cl->lastFiringTime >= level.time) {
-			cl->coopRespawnState = InCombat;
-			continue;
-		}
-		if (player->groundEntity != world) {
-			cl->coopRespawnState = BadArea;
-			continue;
-		}
-		if (player->waterLevel >= WATER_UNDER) {
-			cl->coopRespawnState = BadArea;
-			continue;
-		}
-
-		Vector3 spot;
-		if (!G_FindRespawnSpot(player, spot)) {
-			cl->coopRespawnState = Blocked;
-			continue;
-		}
-
-		return { player, spot };
-	}
-
-	return { nullptr, vec3_origin };
-}
-
 enum respawn_state_t {
 	RESPAWN_NONE,     // invalid state
 	RESPAWN_SPECTATE, // move to spectator
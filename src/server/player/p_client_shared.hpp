@@ -12,6 +12,7 @@ namespace worr::server::client {
 	void PrintModifierIntro(gentity_t* ent);
 	gentity_t* FreezeTag_FindFrozenTarget(gentity_t* thawer);
 	bool FreezeTag_IsValidThawHelper(gentity_t* thawer, gentity_t* frozen);
+	gentity_t* FreezeTag_FindNearbyThawer(gentity_t* frozen);
 	void FreezeTag_StartThawHold(gentity_t* thawer, gentity_t* frozen);
 	void FreezeTag_ThawPlayer(gentity_t* thawer, gentity_t* frozen, bool awardScore, bool autoThaw);
 	bool FreezeTag_UpdateThawHold(gentity_t* frozen);
@@ -0,0 +1,328 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+p_coop_respawn.cpp (Coop Squad Respawn) Picks the living squad member a dead coop player
+respawns beside. Key Responsibilities: - Hunting Index: one pass over the active monsters each
+frame records which clients are being hunted, shared by every candidate and every waiting
+player. - Probe Cache: the traces that find a spot beside a squad member are kept per client and
+reused until that player moves, one of the entities their probes ran into moves, or the result
+grows stale; a cached spot is re-checked with a box trace at each end. - Target Selection:
+`G_FindSquadRespawnTarget` returns the first candidate out of combat with a usable spot.*/
+
+#include "../g_local.hpp"
+
+namespace {
+
+// a cached probe is redone at least this often, to catch entities that
+// moved into its path without having blocked it before
+constexpr GameTime RESPAWN_PROBE_LIFETIME = 1_sec;
+
+// one entity per yaw offset, plus the stuck check
+constexpr size_t RESPAWN_PROBE_BLOCKERS = 6;
+
+// active monsters
+struct active_monsters_filter_t {
+	inline bool operator()(gentity_t* ent) const {
+		return (ent->inUse && (ent->svFlags & SVF_MONSTER) && ent->health > 0);
+	}
+};
+
+inline entity_iterable_t<active_monsters_filter_t> active_monsters() {
+	return entity_iterable_t<active_monsters_filter_t> { game.maxClients + (uint32_t)BODY_QUEUE_SIZE + 1U };
+}
+
+struct hunting_index_t {
+	bool		built = false;
+	GameTime	time = 0_ms;
+	bool		anySearching = false;
+	std::array<uint16_t, MAX_CLIENTS> hunters{};	// per client slot
+};
+
+struct respawn_blocker_t {
+	gentity_t*	ent = nullptr;
+	int32_t		spawnCount = 0;
+	solid_t		solid = SOLID_NOT;
+	Vector3		origin = vec3_origin;
+};
+
+struct respawn_probe_t {
+	bool		valid = false;
+	bool		found = false;
+	GameTime	time = 0_ms;
+	int32_t		spawnCount = 0;
+	Vector3		origin = vec3_origin;
+	float		yaw = 0;
+	Vector3		spot = vec3_origin;
+	std::array<respawn_blocker_t, RESPAWN_PROBE_BLOCKERS> blockers{};
+	size_t		numBlockers = 0;
+};
+
+hunting_index_t huntingIndex;
+std::array<respawn_probe_t, MAX_CLIENTS> respawnProbes;
+
+/*
+=============
+MonsterLostSight
+=============
+*/
+inline bool MonsterLostSight(const gentity_t* ent) {
+	return (ent->monsterInfo.aiFlags & AI_LOST_SIGHT) && level.time > ent->monsterInfo.trailTime + 5_sec;
+}
+
+/*
+=============
+HuntingIndex
+
+Counts the monsters after each client in one pass, once per frame.
+`anySearching` keeps the old meaning of searching for nobody in
+particular: a monster with no enemy, or a player for one.
+=============
+*/
+const hunting_index_t& HuntingIndex() {
+	if (huntingIndex.built && huntingIndex.time == level.time)
+		return huntingIndex;
+
+	huntingIndex.built = true;
+	huntingIndex.time = level.time;
+	huntingIndex.anySearching = false;
+	huntingIndex.hunters.fill(0);
+
+	for (auto ent : active_monsters()) {
+		if (MonsterLostSight(ent))
+			continue;
+
+		if (!ent->enemy || ent->enemy->client)
+			huntingIndex.anySearching = true;
+
+		if (ent->enemy && ent->enemy->client) {
+			const ptrdiff_t slot = ent->enemy->client - game.clients;
+
+			if (slot >= 0 && slot < static_cast<ptrdiff_t>(huntingIndex.hunters.size()) && ent->enemy == &g_entities[slot + 1])
+				huntingIndex.hunters[slot]++;
+		}
+	}
+
+	return huntingIndex;
+}
+
+/*
+=============
+NoteBlocker
+
+Remembers an entity a probe ran into, so the result can be dropped
+once it moves.
+=============
+*/
+void NoteBlocker(respawn_probe_t& probe, const trace_t& tr) {
+	if (!tr.ent || tr.ent == world)
+		return;
+
+	for (size_t i = 0; i < probe.numBlockers; i++) {
+		if (probe.blockers[i].ent == tr.ent)
+			return;
+	}
+
+	// out of room; let the probe expire instead
+	if (probe.numBlockers == probe.blockers.size()) {
+		probe.time = level.time - RESPAWN_PROBE_LIFETIME;
+		return;
+	}
+
+	probe.blockers[probe.numBlockers++] = { tr.ent, tr.ent->spawn_count, tr.ent->solid, tr.ent->s.origin };
+}
+
+/*
+=============
+ProbeStillValid
+=============
+*/
+bool ProbeStillValid(const respawn_probe_t& probe, const gentity_t* player) {
+	if (!probe.valid || probe.spawnCount != player->spawn_count)
+		return false;
+	if (level.time < probe.time || level.time >= probe.time + RESPAWN_PROBE_LIFETIME)
+		return false;
+	if (probe.origin != player->s.origin || probe.yaw != player->s.angles[YAW])
+		return false;
+
+	for (size_t i = 0; i < probe.numBlockers; i++) {
+		const respawn_blocker_t& blocker = probe.blockers[i];
+
+		if (!blocker.ent->inUse || blocker.ent->spawn_count != blocker.spawnCount ||
+			blocker.ent->solid != blocker.solid || blocker.ent->s.origin != blocker.origin)
+			return false;
+	}
+
+	return true;
+}
+
+/*
+===============
+ProbeRespawnSpot
+
+Attempts to find a valid respawn spot near the given player, noting
+every entity the traces run into.
+===============
+*/
+bool ProbeRespawnSpot(gentity_t* player, respawn_probe_t& probe) {
+	constexpr std::array<float, 5> yawOffsets{ { 0, 90, 45, -45, -90 } };
+	constexpr float backDistance = 128.0f;
+	constexpr float upDistance = 128.0f;
+	constexpr float viewHeight = static_cast<float>(DEFAULT_VIEWHEIGHT);
+	constexpr contents_t solidMask = MASK_PLAYERSOLID | CONTENTS_LAVA | CONTENTS_SLIME;
+
+	// Sanity check: make sure player isn't already stuck
+	trace_t tr = gi.trace(player->s.origin, PLAYER_MINS, PLAYER_MAXS, player->s.origin, player, MASK_PLAYERSOLID);
+	NoteBlocker(probe, tr);
+	if (tr.startSolid)
+		return false;
+
+	for (float yawOffset : yawOffsets) {
+		Vector3 yawAngles = { 0, player->s.angles[YAW] + 180.0f + yawOffset, 0 };
+
+		// Step 1: Try moving up first
+		Vector3 start = player->s.origin;
+		Vector3 end = start + Vector3{ 0, 0, upDistance };
+		tr = gi.trace(start, PLAYER_MINS, PLAYER_MAXS, end, player, solidMask);
+		NoteBlocker(probe, tr);
+		if (tr.startSolid || tr.allSolid || (tr.contents & (CONTENTS_LAVA | CONTENTS_SLIME)))
+			continue;
+
+		// Step 2: Then move backwards from that elevated point
+		Vector3 forward;
+		AngleVectors(yawAngles, forward, nullptr, nullptr);
+		start = tr.endPos;
+		end = start + forward * backDistance;
+		tr = gi.trace(start, PLAYER_MINS, PLAYER_MAXS, end, player, solidMask);
+		NoteBlocker(probe, tr);
+		if (tr.startSolid || tr.allSolid || (tr.contents & (CONTENTS_LAVA | CONTENTS_SLIME)))
+			continue;
+
+		// Step 3: Now cast downward to find solid ground
+		start = tr.endPos;
+		end = start - Vector3{ 0, 0, upDistance * 4 };
+		tr = gi.trace(start, PLAYER_MINS, PLAYER_MAXS, end, player, solidMask);
+		NoteBlocker(probe, tr);
+		if (tr.startSolid || tr.allSolid || tr.fraction == 1.0f || tr.ent != world || tr.plane.normal.z < 0.7f)
+			continue;
+
+		// Avoid liquids
+		if (gi.pointContents(tr.endPos + Vector3{ 0, 0, viewHeight }) & MASK_WATER)
+			continue;
+
+		// Height delta check
+		float zDelta = std::fabs(player->s.origin[_Z] - tr.endPos[2]);
+		float stepLimit = (player->s.origin[_Z] < 0 ? STEPSIZE_BELOW : STEPSIZE);
+		if (zDelta > stepLimit * 4.0f)
+			continue;
+
+		// If stepped up/down, ensure visibility
+		if (zDelta > stepLimit) {
+			trace_t sight = gi.traceLine(player->s.origin, tr.endPos, player, solidMask);
+			NoteBlocker(probe, sight);
+			if (sight.fraction != 1.0f)
+				continue;
+			sight = gi.traceLine(player->s.origin + Vector3{ 0, 0, viewHeight }, tr.endPos + Vector3{ 0, 0, viewHeight }, player, solidMask);
+			NoteBlocker(probe, sight);
+			if (sight.fraction != 1.0f)
+				continue;
+		}
+
+		probe.spot = tr.endPos;
+		return true;
+	}
+
+	return false;
+}
+
+/*
+===============
+G_FindRespawnSpot
+
+Finds a spot beside the given player, reusing the last probe while
+nothing it depends on has changed.
+===============
+*/
+bool G_FindRespawnSpot(gentity_t* player, Vector3& spot) {
+	respawn_probe_t& probe = respawnProbes[player->client - game.clients];
+
+	if (ProbeStillValid(probe, player)) {
+		if (!probe.found)
+			return false;
+
+		// something may have moved onto either end since
+		if (!gi.trace(player->s.origin, PLAYER_MINS, PLAYER_MAXS, player->s.origin, player, MASK_PLAYERSOLID).startSolid) {
+			const trace_t tr = gi.trace(probe.spot, PLAYER_MINS, PLAYER_MAXS, probe.spot, player, MASK_PLAYERSOLID | CONTENTS_LAVA | CONTENTS_SLIME);
+			if (!tr.startSolid && !tr.allSolid) {
+				spot = probe.spot;
+				return true;
+			}
+		}
+	}
+
+	probe = {};
+	probe.valid = true;
+	probe.time = level.time;
+	probe.spawnCount = player->spawn_count;
+	probe.origin = player->s.origin;
+	probe.yaw = player->s.angles[YAW];
+	probe.found = ProbeRespawnSpot(player, probe);
+
+	if (probe.found)
+		spot = probe.spot;
+	return probe.found;
+}
+
+} // namespace
+
+/*
+==============================
+G_FindSquadRespawnTarget
+
+Scans for a valid living player who is not in combat or danger
+and has a suitable spawn spot nearby. Returns the player and spot.
+==============================
+*/
+std::tuple<gentity_t*, Vector3> G_FindSquadRespawnTarget() {
+	const hunting_index_t& hunting = HuntingIndex();
+
+	for (gentity_t* player : active_clients()) {
+		auto* cl = player->client;
+
+		// Skip invalid candidates
+		if (player->deadFlag)
+			continue;
+
+		using enum CoopRespawn;
+
+		if (cl->last_damage_time >= level.time) {
+			cl->coopRespawnState = InCombat;
+			continue;
+		}
+		if (hunting.hunters[cl - game.clients]) {
+			cl->coopRespawnState = InCombat;
+			continue;
+		}
+		if (hunting.anySearching && cl->lastFiringTime >= level.time) {
+			cl->coopRespawnState = InCombat;
+			continue;
+		}
+		if (player->groundEntity != world) {
+			cl->coopRespawnState = BadArea;
+			continue;
+		}
+		if (player->waterLevel >= WATER_UNDER) {
+			cl->coopRespawnState = BadArea;
+			continue;
+		}
+
+		Vector3 spot;
+		if (!G_FindRespawnSpot(player, spot)) {
+			cl->coopRespawnState = Blocked;
+			continue;
+		}
+
+		return { player, spot };
+	}
+
+	return { nullptr, vec3_origin };
+}
@@ -0,0 +1,251 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+p_freeze_thaw.cpp (Freeze Tag Thaw Search) Finds who can thaw whom in freeze tag. Key
+Responsibilities: - Roster: the playing clients of each team are gathered once per frame, so a
+search only visits teammates instead of every client. - Helper Search: `FreezeTag_FindNearbyThawer`
+picks the closest teammate within `FREEZETAG_THAW_RANGE` of a frozen player. - Target Search:
+`FreezeTag_FindFrozenTarget` picks the frozen teammate a thawer is looking at; line-of-sight
+traces are only made for teammates in range and are reused for a few frames while neither end
+moves.*/
+
+#include "../g_local.hpp"
+#include "p_client_shared.hpp"
+
+namespace {
+
+constexpr float FREEZETAG_TARGET_RANGE = 96.0f;
+constexpr float FREEZETAG_THAW_RANGE = MELEE_DISTANCE;
+
+// a sight check is reused while both ends stay put, for at most this long
+constexpr GameTime FREEZETAG_SIGHT_CACHE_TIME = 100_ms;
+constexpr size_t FREEZETAG_SIGHT_CACHE_SLOTS = 4;
+
+struct thaw_roster_t {
+	bool		built = false;
+	GameTime	time = 0_ms;
+	std::array<std::vector<gentity_t*>, static_cast<size_t>(Team::Total)> teams{};
+};
+
+struct thaw_sight_t {
+	const gentity_t*	target = nullptr;
+	Vector3				eye = vec3_origin;
+	Vector3				targetOrigin = vec3_origin;
+	GameTime			time = 0_ms;
+	bool				clear = false;
+};
+
+thaw_roster_t thawRoster;
+std::array<std::array<thaw_sight_t, FREEZETAG_SIGHT_CACHE_SLOTS>, MAX_CLIENTS> thawSights;
+
+/*
+=============
+ThawTeammates
+
+The playing clients on a team this frame, in client order. Entries
+are only candidates; callers still check each one.
+=============
+*/
+const std::vector<gentity_t*>& ThawTeammates(Team team) {
+	if (!thawRoster.built || thawRoster.time != level.time) {
+		thawRoster.built = true;
+		thawRoster.time = level.time;
+		for (auto& members : thawRoster.teams)
+			members.clear();
+
+		for (gentity_t* ent : active_clients()) {
+			if (ClientIsPlaying(ent->client))
+				thawRoster.teams[static_cast<size_t>(ent->client->sess.team)].push_back(ent);
+		}
+	}
+
+	return thawRoster.teams[static_cast<size_t>(team)];
+}
+
+/*
+=============
+InThawReach
+
+A cheap first cut before the exact checks; the unit of slack keeps
+rounding from dropping anyone those would accept.
+=============
+*/
+inline bool InThawReach(const gentity_t* from, const gentity_t* to, float range) {
+	return active_clients_filter_t{}(const_cast<gentity_t*>(to)) &&
+		(to->s.origin - from->s.origin).lengthSquared() <= (range + 1.0f) * (range + 1.0f);
+}
+
+/*
+=============
+ThawSightClear
+
+Line of sight from a thawer's eye to a teammate, reusing a recent
+check made between the same two points.
+=============
+*/
+bool ThawSightClear(gentity_t* thawer, const Vector3& eye, gentity_t* target) {
+	auto& sights = thawSights[thawer->client - game.clients];
+	thaw_sight_t* oldest = &sights[0];
+
+	for (thaw_sight_t& sight : sights) {
+		if (sight.target == target && sight.eye == eye && sight.targetOrigin == target->s.origin &&
+			level.time >= sight.time && level.time < sight.time + FREEZETAG_SIGHT_CACHE_TIME)
+			return sight.clear;
+
+		if (sight.time < oldest->time)
+			oldest = &sight;
+	}
+
+	const bool clear = gi.traceLine(eye, target->s.origin, thawer, MASK_SHOT).fraction == 1.0f;
+	*oldest = { target, eye, target->s.origin, level.time, clear };
+	return clear;
+}
+
+/*
+=============
+FreezeTag_CanThawTarget
+=============
+*/
+bool FreezeTag_CanThawTarget(gentity_t* thawer, gentity_t* frozen) {
+	if (!FreezeTag_IsActive())
+		return false;
+
+	if (!thawer || !thawer->client || !frozen || !frozen->client)
+		return false;
+
+	if (!ClientIsPlaying(thawer->client) || thawer->client->eliminated)
+		return false;
+
+	if (!ClientIsPlaying(frozen->client) || !frozen->client->eliminated)
+		return false;
+
+	if (!Teams() || thawer->client->sess.team != frozen->client->sess.team)
+		return false;
+
+	if (frozen->client->resp.thawer && frozen->client->resp.thawer != thawer)
+		return false;
+
+	return true;
+}
+
+} // namespace
+
+/*
+=============
+FreezeTag_FindFrozenTarget
+
+Locates the best frozen teammate within range of the thawer, prioritizing
+line-of-sight and directional alignment.
+=============
+*/
+gentity_t* worr::server::client::FreezeTag_FindFrozenTarget(gentity_t* thawer) {
+	if (!FreezeTag_IsActive() || !thawer || !thawer->client)
+		return nullptr;
+
+	Vector3 forward;
+	AngleVectors(thawer->client->vAngle, forward, nullptr, nullptr);
+
+	Vector3 eyeOrigin = thawer->s.origin + thawer->client->ps.viewOffset +
+		Vector3{ 0, 0, static_cast<float>(thawer->client->ps.pmove.viewHeight) };
+
+	trace_t tr = gi.traceLine(eyeOrigin, eyeOrigin + forward * FREEZETAG_TARGET_RANGE, thawer, MASK_SHOT);
+	if (tr.ent && FreezeTag_CanThawTarget(thawer, tr.ent))
+		return tr.ent;
+
+	if (!Teams())
+		return nullptr;
+
+	gentity_t* best = nullptr;
+	float       bestDot = 0.0f;
+
+	for (gentity_t* candidate : ThawTeammates(thawer->client->sess.team)) {
+		if (!InThawReach(thawer, candidate, FREEZETAG_TARGET_RANGE))
+			continue;
+
+		if (!FreezeTag_CanThawTarget(thawer, candidate))
+			continue;
+
+		Vector3 toTarget = candidate->s.origin - thawer->s.origin;
+		const float distance = toTarget.length();
+		if (distance > FREEZETAG_TARGET_RANGE)
+			continue;
+
+		Vector3 dir = toTarget.normalized();
+		const float dot = dir.dot(forward);
+		if (dot < 0.35f)
+			continue;
+
+		if (!ThawSightClear(thawer, eyeOrigin, candidate))
+			continue;
+
+		if (!best || dot > bestDot) {
+			best = candidate;
+			bestDot = dot;
+		}
+	}
+
+	return best;
+}
+
+/*
+=============
+FreezeTag_IsValidThawHelper
+
+Checks if a thawer is eligible to thaw the frozen teammate based on distance,
+team alignment, and active state.
+=============
+*/
+bool worr::server::client::FreezeTag_IsValidThawHelper(gentity_t* thawer, gentity_t* frozen) {
+	if (!FreezeTag_IsActive())
+		return false;
+
+	if (!thawer || !thawer->client || !frozen || !frozen->client)
+		return false;
+
+	if (thawer == frozen)
+		return false;
+
+	if (!ClientIsPlaying(thawer->client) || thawer->client->eliminated)
+		return false;
+
+	if (!ClientIsPlaying(frozen->client) || !frozen->client->eliminated)
+		return false;
+
+	if (!Teams() || thawer->client->sess.team != frozen->client->sess.team)
+		return false;
+
+	const Vector3 delta = frozen->s.origin - thawer->s.origin;
+	return delta.length() <= FREEZETAG_THAW_RANGE;
+}
+
+/*
+=============
+FreezeTag_FindNearbyThawer
+
+The closest teammate able to thaw a frozen player.
+=============
+*/
+gentity_t* worr::server::client::FreezeTag_FindNearbyThawer(gentity_t* frozen) {
+	if (!frozen || !frozen->client || !Teams())
+		return nullptr;
+
+	gentity_t* best = nullptr;
+	float       bestDistance = 0.0f;
+
+	for (gentity_t* candidate : ThawTeammates(frozen->client->sess.team)) {
+		if (!InThawReach(frozen, candidate, FREEZETAG_THAW_RANGE))
+			continue;
+
+		if (!FreezeTag_IsValidThawHelper(candidate, frozen))
+			continue;
+
+		const float distance = (frozen->s.origin - candidate->s.origin).length();
+
+		if (!best || distance < bestDistance) {
+			best = candidate;
+			bestDistance = distance;
+		}
+	}
+
+	return best;
+}
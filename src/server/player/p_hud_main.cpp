@@ -32,7 +32,7 @@ MoveClientToIntermission
 */
 void MoveClientToIntermission(gentity_t* ent) {
 	if (ent->svFlags & SVF_NOCLIENT) {
-		ent->s.event = EV_OTHER_TELEPORT;
+		G_SetEvent(ent, EV_OTHER_TELEPORT);
 	}
 
 	// Set client view and movement
@@ -476,6 +476,9 @@ static void SetCrosshairIDView(gentity_t* ent) {
 	if (level.time - ent->client->resp.lastIDTime < 250_ms)
 		return;
 
+	if (!G_FrameBudgetAllow(FrameWork::CrosshairID, level.time - ent->client->resp.lastIDTime - 250_ms))
+		return;
+
 	ent->client->resp.lastIDTime = level.time;
 
 	ent->client->ps.stats[STAT_CROSSHAIR_ID_VIEW] = 0;
@@ -681,7 +684,7 @@ static void SetMiniScoreStats(gentity_t* ent) {
 
 	// Medal HUD display
 	if (medalType != PlayerMedal::None) {
-		const auto count = ent->client->pers.match.medalCount[static_cast<size_t>(medalType)];
+		const auto count = ent->client->MatchStats().medalCount()[static_cast<size_t>(medalType)];
 		if (count >= 2 && static_cast<size_t>(medalType) < awardNames.size()) {
 			const std::string& medalName = awardNames[static_cast<size_t>(medalType)];
 			const std::string medalText = fmt::format("{} (x{})", medalName, count);
@@ -2,14 +2,14 @@
 Licensed under the GNU General Public License 2.0.
 
 p_trail.cpp (Player Trail) This file implements a system for tracking the recent path of a
-player. It creates a trail of "breadcrumb" entities that monsters can use for pursuit even after
-they have lost direct line of sight to the player. Key Responsibilities: - Trail Creation: The
-`PlayerTrail_Add` function periodically drops a new trail entity at the player's location. -
-Trail Management: Manages a two-way linked list of trail entities, ensuring the trail does not
-exceed a maximum length by reusing the oldest node. - AI Pathfinding: The `PlayerTrail_Pick`
-function is used by the monster AI to find the most relevant point on a player's trail to move
-towards. - Cleanup: `PlayerTrail_Destroy` cleans up all trail entities associated with a player,
-for example, when they disconnect.*/
+player. It keeps a short trail of "breadcrumb" positions that monsters can use for pursuit even
+after they have lost direct line of sight to the player. Key Responsibilities: - Trail Creation:
+The `PlayerTrail_Add` function periodically drops a new breadcrumb at the player's location. -
+Trail Management: Breadcrumbs live in a fixed ring in the client data, so the oldest one is
+overwritten once the trail is full and no entities are allocated. - AI Pathfinding: The
+`PlayerTrail_Pick` function is used by the monster AI to find the most relevant point on a
+player's trail to move towards. - Cleanup: `PlayerTrail_Destroy` clears a player's trail, for
+example, when they disconnect.*/
 
 #include "../g_local.hpp"
 
@@ -20,103 +20,97 @@ PLAYER TRAIL
 
 ==============================================================================
 
-This is a two-way list containing the a list of points of where
-the player has been recently. It is used by monsters for pursuit.
+This is a list of points of where the player has been recently. It is
+used by monsters for pursuit.
 
 This is improved from vanilla; now, the list itself is stored in
-client data so it can be stored for multiple clients.
-
-chain = next
-enemy = prev
-
-The head node will always have a null "chain", the tail node
-will always have a null "enemy".
+client data so it can be stored for multiple clients. Points are held
+in a fixed ring rather than as entities; index 0 below always means the
+newest point and `count - 1` the oldest.
 */
 
-constexpr size_t TRAIL_LENGTH = 8;
-
-// places a new entity at the head of the player trail.
-// the tail entity may be moved to the front if the length
-// is at the end.
-static gentity_t* PlayerTrail_Spawn(gentity_t* owner) {
-	size_t len = 0;
-
-	for (gentity_t* tail = owner->client->trail_tail; tail; tail = tail->chain)
-		len++;
-
-	gentity_t* trail;
-
-	// move the tail to the head
-	if (len == TRAIL_LENGTH) {
-		// unlink the old tail
-		trail = owner->client->trail_tail;
-		owner->client->trail_tail = trail->chain;
-		owner->client->trail_tail->enemy = nullptr;
-		trail->chain = trail->enemy = nullptr;
-	}
-	else {
-		// spawn a new head
-		trail = Spawn();
-		trail->className = "player_trail";
-	}
+// the head is only re-checked for visibility once the player has moved
+// this far from where it was last checked, and no more often than this
+constexpr float TRAIL_CHECK_DISTANCE = 32.f;
+constexpr GameTime TRAIL_CHECK_INTERVAL = 100_ms;
 
-	// link as new head
-	if (owner->client->trail_head)
-		owner->client->trail_head->chain = trail;
-	trail->enemy = owner->client->trail_head;
-	owner->client->trail_head = trail;
+// ring slot of the n'th newest point
+static inline size_t PlayerTrail_Slot(const gclient_t* client, size_t n) {
+	return (client->trail.head + PLAYER_TRAIL_LENGTH - 1 - n) % PLAYER_TRAIL_LENGTH;
+}
 
-	// if there's no tail, we become the tail too
-	if (!owner->client->trail_tail)
-		owner->client->trail_tail = trail;
+// the same test visible() does against a trail point, which has
+// no view height and can never be hit by the trace
+static bool PlayerTrail_Visible(gentity_t* self, const Vector3& point) {
+	Vector3 eye = self->s.origin;
+	eye[2] += self->viewHeight;
 
-	return trail;
+	return gi.traceLine(eye, point, self, MASK_OPAQUE).fraction == 1.0f;
 }
 
-// destroys all player trail entities in the map.
+// clears the player trail, or every player's trail.
 // we don't want these to stay around across level loads.
 void PlayerTrail_Destroy(gentity_t* player) {
-	for (size_t i = 0; i < globals.numEntities; i++)
-		if (g_entities[i].className && strcmp(g_entities[i].className, "player_trail") == 0)
-			if (!player || g_entities[i].owner == player)
-				FreeEntity(&g_entities[i]);
-
-	if (player)
-		player->client->trail_head = player->client->trail_tail = nullptr;
-	else for (auto ec : active_clients())
-		ec->client->trail_head = ec->client->trail_tail = nullptr;
+	if (player) {
+		player->client->trail = {};
+		return;
+	}
+
+	for (size_t i = 0; i < game.maxClients; i++)
+		game.clients[i].trail = {};
 }
 
 // check to see if we can add a new player trail spot
 // for this player.
 void PlayerTrail_Add(gentity_t* player) {
-	// if we can still see the head, we don't want a new one.
-	if (player->client->trail_head && visible(player, player->client->trail_head))
-		return;
+	gclient_t* cl = player->client;
+
 	// don't spawn trails in intermission, if we're dead, if we're noclipping or not on ground yet
-	else if (level.intermission.time || player->health <= 0 || player->moveType == MoveType::NoClip || player->moveType == MoveType::FreeCam ||
+	if (level.intermission.time || player->health <= 0 || player->moveType == MoveType::NoClip || player->moveType == MoveType::FreeCam ||
 		!player->groundEntity)
 		return;
 
-	gentity_t* trail = PlayerTrail_Spawn(player);
-	trail->s.origin = player->s.oldOrigin;
-	trail->timeStamp = level.time;
-	trail->owner = player;
+	if (cl->trail.count) {
+		// until we've moved a bit, assume we can still see the head
+		if (level.time < cl->trail.nextCheckTime ||
+			(player->s.origin - cl->trail.checkOrigin).lengthSquared() < TRAIL_CHECK_DISTANCE * TRAIL_CHECK_DISTANCE)
+			return;
+
+		cl->trail.checkOrigin = player->s.origin;
+		cl->trail.nextCheckTime = level.time + TRAIL_CHECK_INTERVAL;
+
+		// if we can still see the head, we don't want a new one.
+		if (PlayerTrail_Visible(player, cl->trail.origins[PlayerTrail_Slot(cl, 0)]))
+			return;
+	}
+
+	// place a new head, overwriting the tail if the trail is full
+	cl->trail.origins[cl->trail.head] = player->s.oldOrigin;
+	cl->trail.times[cl->trail.head] = level.time;
+	cl->trail.head = static_cast<uint8_t>((cl->trail.head + 1) % PLAYER_TRAIL_LENGTH);
+	if (cl->trail.count < PLAYER_TRAIL_LENGTH)
+		cl->trail.count++;
+
+	cl->trail.checkOrigin = player->s.origin;
+	cl->trail.nextCheckTime = level.time + TRAIL_CHECK_INTERVAL;
 }
 
-// pick a trail node that matches the player
+// pick a trail point that matches the player
 // we're hunting that is visible to us.
-gentity_t* PlayerTrail_Pick(gentity_t* self, bool next) {
+bool PlayerTrail_Pick(gentity_t* self, bool next, Vector3& origin, GameTime& timeStamp) {
 	// not player or doesn't have a trail yet
-	if (!self->enemy->client || !self->enemy->client->trail_head)
-		return nullptr;
+	if (!self->enemy->client || !self->enemy->client->trail.count)
+		return false;
+
+	const gclient_t* cl = self->enemy->client;
+	const size_t count = cl->trail.count;
 
 	// find which marker head that was dropped while we
 	// were searching for this enemy
-	gentity_t* marker;
+	size_t marker;
 
-	for (marker = self->enemy->client->trail_head; marker; marker = marker->enemy) {
-		if (marker->timeStamp <= self->monsterInfo.trailTime)
+	for (marker = 0; marker < count; marker++) {
+		if (cl->trail.times[PlayerTrail_Slot(cl, marker)] <= self->monsterInfo.trailTime)
 			continue;
 
 		break;
@@ -125,10 +119,10 @@ gentity_t* PlayerTrail_Pick(gentity_t* self, bool next) {
 	if (next) {
 		// find the marker we're closest to
 		float closest_dist = std::numeric_limits<float>::infinity();
-		gentity_t* closest = nullptr;
+		size_t closest = count;
 
-		for (gentity_t* m2 = marker; m2; m2 = m2->enemy) {
-			float len = (m2->s.origin - self->s.origin).lengthSquared();
+		for (size_t m2 = marker; m2 < count; m2++) {
+			float len = (cl->trail.origins[PlayerTrail_Slot(cl, m2)] - self->s.origin).lengthSquared();
 
 			if (len < closest_dist) {
 				closest_dist = len;
@@ -137,17 +131,25 @@ gentity_t* PlayerTrail_Pick(gentity_t* self, bool next) {
 		}
 
 		// should never happen
+		if (closest == count)
+			return false;
+
+		// use the next (newer) one from the closest one
 		if (!closest)
-			return nullptr;
+			return false;
 
-		// use the next one from the closest one
-		marker = closest->chain;
+		marker = closest - 1;
 	}
 	else {
 		// from that marker, find the first one we can see
-		for (; marker && !visible(self, marker); marker = marker->enemy)
+		for (; marker < count && !PlayerTrail_Visible(self, cl->trail.origins[PlayerTrail_Slot(cl, marker)]); marker++)
 			continue;
+
+		if (marker == count)
+			return false;
 	}
 
-	return marker;
+	origin = cl->trail.origins[PlayerTrail_Slot(cl, marker)];
+	timeStamp = cl->trail.times[PlayerTrail_Slot(cl, marker)];
+	return true;
 }
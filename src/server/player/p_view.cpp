@@ -16,8 +16,10 @@ attacker, ensuring accurate hit detection in a networked environment.*/
 #include "../g_local.hpp"
 #include "../monsters/m_player.hpp"
 #include "../bots/bot_includes.hpp"
+#include "../gameplay/g_jobs.hpp"
 
 #include <array>
+#include <vector>
 
 static gentity_t* currentPlayer{};
 static gclient_t* currentClient{};
@@ -29,23 +31,45 @@ float bobMove = 0.0f;
 int	  bobCycle = 0, bobCycleRun = 0;	  // odd cycles are right foot going forward
 float bobFracSin = 0.0f; // std::sinf(bobfrac*M_PI)
 
+/*
+===============
+player_view_t
+
+Per-player copy of the frame globals above, captured once the serial
+part of ClientEndServerFrame has run. The view calculations read only
+this and their own client, so they can run on job workers.
+===============
+*/
+struct player_view_t {
+	Vector3	forward{}, right{}, up{};
+	float	xySpeed = 0.0f;
+	float	bobMove = 0.0f;
+	float	bobFracSin = 0.0f;
+	int		bobCycle = 0, bobCycleRun = 0;
+	bool	deathView = false;		// third-person death camera traces; main thread only
+	bool	quake = false;
+	Vector3	quakeJitter{};			// earthquake offsets, drawn up front to keep mt_rand off workers
+};
+
+static std::array<player_view_t, MAX_CLIENTS> playerViews{};
+
 /*
 ===============
 SkipViewModifiers
 ===============
 */
-static inline bool SkipViewModifiers() {
+static inline bool SkipViewModifiers(gclient_t* cl) {
 	if (g_skip_view_modifiers->integer && g_cheats->integer)
 		return true;
 
 	// don't do bobbing, etc on grapple
-	if (currentClient->grapple.entity &&
-		currentClient->grapple.state > GrappleState::Fly) {
+	if (cl->grapple.entity &&
+		cl->grapple.state > GrappleState::Fly) {
 		return true;
 	}
 
 	// spectator mode
-	if (!ClientIsPlaying(currentClient))
+	if (!ClientIsPlaying(cl))
 		return true;
 
 	return false;
@@ -57,7 +81,7 @@ P_CalcRoll
 ===============
 */
 static float P_CalcRoll(const Vector3& angles, const Vector3& velocity) {
-	if (SkipViewModifiers())
+	if (SkipViewModifiers(currentClient))
 		return 0.0f;
 
 	// Project velocity onto the right vector
@@ -368,7 +392,7 @@ Auto pitching on slopes?
 
 ===============
 */
-static void G_CalcViewOffset(gentity_t* ent) {
+static void G_CalcViewOffset(gentity_t* ent, const player_view_t& view) {
 	float  bob;
 	float  ratio;
 	float  delta;
@@ -398,7 +422,7 @@ static void G_CalcViewOffset(gentity_t* ent) {
 
 	ent->client->deathView = {};
 
-	if (!ent->client->pers.bob_skip && !SkipViewModifiers()) {
+	if (!ent->client->pers.bob_skip && !SkipViewModifiers(ent->client)) {
 		// add angles based on weapon kick
 		angles = P_CurrentKickAngles(ent);
 
@@ -441,35 +465,33 @@ static void G_CalcViewOffset(gentity_t* ent) {
 		}
 
 		// add angles based on velocity
-		if (!ent->client->pers.bob_skip && !SkipViewModifiers()) {
-			delta = ent->velocity.dot(forward);
+		if (!ent->client->pers.bob_skip && !SkipViewModifiers(ent->client)) {
+			delta = ent->velocity.dot(view.forward);
 			angles[PITCH] += delta * run_pitch->value;
 
-			delta = ent->velocity.dot(right);
+			delta = ent->velocity.dot(view.right);
 			angles[ROLL] += delta * run_roll->value;
 
 			// add angles based on bob
-			delta = bobFracSin * bob_pitch->value * xySpeed;
+			delta = view.bobFracSin * bob_pitch->value * view.xySpeed;
 			if ((ent->client->ps.pmove.pmFlags & PMF_DUCKED) && ent->groundEntity)
 				delta *= 6; // crouching
 			delta = min(delta, 1.2f);
 			angles[PITCH] += delta;
-			delta = bobFracSin * bob_roll->value * xySpeed;
+			delta = view.bobFracSin * bob_roll->value * view.xySpeed;
 			if ((ent->client->ps.pmove.pmFlags & PMF_DUCKED) && ent->groundEntity)
 				delta *= 6; // crouching
 			delta = min(delta, 1.2f);
-			if (bobCycle & 1)
+			if (view.bobCycle & 1)
 				delta = -delta;
 			angles[ROLL] += delta;
 		}
 
 		// add earthquake angles
-		if (ent->client->feedback.quakeTime > level.time) {
+		if (view.quake) {
 			float factor = min(1.0f, (ent->client->feedback.quakeTime.seconds() / level.time.seconds()) * 0.25f);
 
-			angles.x += crandom_open() * factor;
-			angles.z += crandom_open() * factor;
-			angles.y += crandom_open() * factor;
+			angles += view.quakeJitter * factor;
 		}
 	}
 
@@ -485,7 +507,7 @@ static void G_CalcViewOffset(gentity_t* ent) {
 
 	// add fall height
 
-	if (!ent->client->pers.bob_skip && !SkipViewModifiers()) {
+	if (!ent->client->pers.bob_skip && !SkipViewModifiers(ent->client)) {
 		if (ent->client->feedback.fallTime > level.time) {
 			// [Paril-KEX] 100ms of slack is added to account for
 			// visual difference in higher tickrates
@@ -504,7 +526,7 @@ static void G_CalcViewOffset(gentity_t* ent) {
 		}
 
 		// add bob height
-		bob = bobFracSin * xySpeed * bob_up->value;
+		bob = view.bobFracSin * view.xySpeed * bob_up->value;
 		if (bob > 6)
 			bob = 6;
 		// gi.DebugGraph (bob *2, 255);
@@ -513,7 +535,7 @@ static void G_CalcViewOffset(gentity_t* ent) {
 
 	// add kick offset
 
-	if (!ent->client->pers.bob_skip && !SkipViewModifiers())
+	if (!ent->client->pers.bob_skip && !SkipViewModifiers(ent->client))
 		v += P_CurrentKickOrigin(ent);
 
 	// absolutely bound offsets
@@ -540,21 +562,21 @@ static void G_CalcViewOffset(gentity_t* ent) {
 G_CalcGunOffset
 ==============
 */
-static void G_CalcGunOffset(gentity_t* ent) {
+static void G_CalcGunOffset(gentity_t* ent, const player_view_t& view) {
 	int	  i;
 
 	if (ent->client->pers.weapon &&
 		!((ent->client->pers.weapon->id == IT_WEAPON_PLASMABEAM || ent->client->pers.weapon->id == IT_WEAPON_GRAPPLE) && ent->client->weaponState == WeaponState::Firing)
-		&& !SkipViewModifiers()) {
+		&& !SkipViewModifiers(ent->client)) {
 		// gun angles from bobbing
-		ent->client->ps.gunAngles[ROLL] = xySpeed * bobFracSin * 0.005f;
-		ent->client->ps.gunAngles[YAW] = xySpeed * bobFracSin * 0.01f;
-		if (bobCycle & 1) {
+		ent->client->ps.gunAngles[ROLL] = view.xySpeed * view.bobFracSin * 0.005f;
+		ent->client->ps.gunAngles[YAW] = view.xySpeed * view.bobFracSin * 0.01f;
+		if (view.bobCycle & 1) {
 			ent->client->ps.gunAngles[ROLL] = -ent->client->ps.gunAngles[ROLL];
 			ent->client->ps.gunAngles[YAW] = -ent->client->ps.gunAngles[YAW];
 		}
 
-		ent->client->ps.gunAngles[PITCH] = xySpeed * bobFracSin * 0.005f;
+		ent->client->ps.gunAngles[PITCH] = view.xySpeed * view.bobFracSin * 0.005f;
 
 		Vector3 viewangles_delta = ent->client->oldViewAngles - ent->client->ps.viewAngles;
 
@@ -604,9 +626,9 @@ static void G_CalcGunOffset(gentity_t* ent) {
 
 	// gun_x / gun_y / gun_z are development tools
 	for (i = 0; i < 3; i++) {
-		ent->client->ps.gunOffset[i] += forward[i] * (gun_y->value);
-		ent->client->ps.gunOffset[i] += right[i] * gun_x->value;
-		ent->client->ps.gunOffset[i] += up[i] * (-gun_z->value);
+		ent->client->ps.gunOffset[i] += view.forward[i] * (gun_y->value);
+		ent->client->ps.gunOffset[i] += view.right[i] * gun_x->value;
+		ent->client->ps.gunOffset[i] += view.up[i] * (-gun_z->value);
 	}
 }
 
@@ -624,7 +646,7 @@ G_CalcBlend
 	return (std::sin(phase) * 0.5f + 0.5f) * max_alpha;
 }
 
-static void G_CalcBlend(gentity_t* ent) {
+static void G_CalcBlend(gentity_t* ent, JobCommandBuffer& commands) {
 	GameTime remaining;
 	ent->client->ps.damageBlend = ent->client->ps.screenBlend = {};
 
@@ -632,7 +654,7 @@ static void G_CalcBlend(gentity_t* ent) {
 		if (end_time > level.time) {
 			remaining = end_time - level.time;
 			if (remaining.milliseconds() == 3000 && sound)
-				gi.sound(ent, CHAN_ITEM, gi.soundIndex(sound), 1, ATTN_NORM, 0);
+				commands.Defer([ent, sound]() { gi.sound(ent, CHAN_ITEM, gi.soundIndex(sound), 1, ATTN_NORM, 0); });
 			if (G_PowerUpExpiringRelative(remaining))
 				G_AddBlend(r, g, b, G_PowerUpFadeAlpha(remaining, max_alpha), ent->client->ps.screenBlend);
 		}
@@ -949,7 +971,7 @@ static void ClientSetEvent(gentity_t* ent) {
 		if (g_ladderSteps->integer > 1 || (g_ladderSteps->integer == 1 && !deathmatch->integer)) {
 			if (currentClient->last_ladder_sound < level.time &&
 				(currentClient->last_ladder_pos - ent->s.origin).length() > 48.f) {
-				ent->s.event = EV_LADDER_STEP;
+				G_SetEvent(ent, EV_LADDER_STEP);
 				currentClient->last_ladder_pos = ent->s.origin;
 				currentClient->last_ladder_sound = level.time + LADDER_SOUND_TIME;
 			}
@@ -957,7 +979,7 @@ static void ClientSetEvent(gentity_t* ent) {
 	}
 	else if (ent->groundEntity && xySpeed > 225) {
 		if ((int)(currentClient->feedback.bobTime + bobMove) != bobCycleRun)
-			ent->s.event = EV_FOOTSTEP;
+			G_SetEvent(ent, EV_FOOTSTEP);
 	}
 }
 
@@ -1357,17 +1379,18 @@ static void PlayQueuedAwardSound(gentity_t* ent) {
 
 /*
 =================
-ClientEndServerFrame
+ClientEndServerFrame_Begin
 
-Called for each player at the end of the server frame
-and right after spawning
+Serial first half of ClientEndServerFrame, up to and including damage
+feedback. Captures the per-player view inputs into 'view'. Returns false
+when the frame has been fully handled here.
 =================
 */
 static int scorelimit = -1;
-void ClientEndServerFrame(gentity_t* ent) {
+static bool ClientEndServerFrame_Begin(gentity_t* ent, player_view_t& view) {
 	// no player exists yet (load game)
 	if (!ent->client->pers.spawned && !level.mapSelector.voteStartTime)
-		return;
+		return false;
 
 	float bobTime = 0, bobTimeRun = 0;
 	gentity_t* e = ent; // eyecam or follow targeting can redirect here if needed
@@ -1393,7 +1416,7 @@ void ClientEndServerFrame(gentity_t* ent) {
 
 				player_die(ent, ent, ent, 1, vec3_origin, { ModID::Expiration, true });
 				if (!ent->client->eliminated)
-					return;
+					return false;
 			}
 		}
 	}
@@ -1470,7 +1493,7 @@ void ClientEndServerFrame(gentity_t* ent) {
 		}
 		/*freeze*/
 
-		return;
+		return false;
 	}
 
 	if (deathmatch->integer) {
@@ -1541,16 +1564,70 @@ void ClientEndServerFrame(gentity_t* ent) {
 	// apply all the damage taken this frame
 	P_DamageFeedback(e);
 
+	view.forward = forward;
+	view.right = right;
+	view.up = up;
+	view.xySpeed = xySpeed;
+	view.bobMove = bobMove;
+	view.bobFracSin = bobFracSin;
+	view.bobCycle = bobCycle;
+	view.bobCycleRun = bobCycleRun;
+	view.deathView = ent->deadFlag && ClientIsPlaying(ent->client);
+	view.quake = !view.deathView && !ent->client->pers.bob_skip && !SkipViewModifiers(ent->client) &&
+		ent->client->feedback.quakeTime > level.time;
+
+	if (view.quake) {
+		view.quakeJitter.x = crandom_open();
+		view.quakeJitter.z = crandom_open();
+		view.quakeJitter.y = crandom_open();
+	}
+
+	return true;
+}
+
+/*
+=================
+ClientEndServerFrame_CalcView
+
+View offset, gun offset and screen blend. Touches nothing but the
+player's own client; engine calls go through 'commands'.
+=================
+*/
+static void ClientEndServerFrame_CalcView(gentity_t* ent, const player_view_t& view, JobCommandBuffer& commands) {
 	// determine the view offsets
-	G_CalcViewOffset(e);
+	G_CalcViewOffset(ent, view);
 
 	// determine the gun offsets
-	G_CalcGunOffset(e);
+	G_CalcGunOffset(ent, view);
 
 	// determine the full screen color blend
 	// must be after viewOffset, so eye contents can be
 	// accurately determined
-	G_CalcBlend(e);
+	G_CalcBlend(ent, commands);
+}
+
+/*
+=================
+ClientEndServerFrame_Finish
+
+Serial second half of ClientEndServerFrame: stats, events, effects,
+animation and UI updates.
+=================
+*/
+static void ClientEndServerFrame_Finish(gentity_t* ent, const player_view_t& view) {
+	currentPlayer = ent;
+	currentClient = ent->client;
+
+	forward = view.forward;
+	right = view.right;
+	up = view.up;
+	xySpeed = view.xySpeed;
+	bobMove = view.bobMove;
+	bobFracSin = view.bobFracSin;
+	bobCycle = view.bobCycle;
+	bobCycleRun = view.bobCycleRun;
+
+	gentity_t* e = ent;
 
 	// chase cam stuff
 	if (!ClientIsPlaying(ent->client) || ent->client->eliminated) {
@@ -1598,7 +1675,8 @@ void ClientEndServerFrame(gentity_t* ent) {
 		ent->client->showScores = true;
 
 		// Update at frame cadence
-		if (ent->client->menu.updateTime <= level.time) {
+		if (ent->client->menu.updateTime <= level.time &&
+			G_FrameBudgetAllow(FrameWork::MenuRefresh, level.time - ent->client->menu.updateTime)) {
 			MenuSystem::Update(ent);
 			gi.unicast(ent, true);
 			ent->client->menu.updateTime = level.time + FRAME_TIME_MS;
@@ -1607,7 +1685,8 @@ void ClientEndServerFrame(gentity_t* ent) {
 	}
 	// SCOREBOARD (only if no active menu)
 	else if (ent->client->showScores) {
-		if (ent->client->menu.updateTime <= level.time) {
+		if (ent->client->menu.updateTime <= level.time &&
+			G_FrameBudgetAllow(FrameWork::ScoreboardRefresh, level.time - ent->client->menu.updateTime)) {
 			DeathmatchScoreboardMessage(ent, ent->enemy);
 			gi.unicast(ent, false);
 			ent->client->menu.updateTime = level.time + 3_sec;
@@ -1648,3 +1727,66 @@ void ClientEndServerFrame(gentity_t* ent) {
 			ent->clipMask |= CONTENTS_PLAYER;
 	}
 }
+
+/*
+=================
+ClientEndServerFrame
+
+Called for each player at the end of the server frame
+and right after spawning
+=================
+*/
+void ClientEndServerFrame(gentity_t* ent) {
+	player_view_t& view = playerViews[ent->s.number - 1];
+
+	if (!ClientEndServerFrame_Begin(ent, view))
+		return;
+
+	JobCommandBuffer commands;
+	ClientEndServerFrame_CalcView(ent, view, commands);
+	commands.Flush();
+
+	ClientEndServerFrame_Finish(ent, view);
+}
+
+/*
+=================
+P_EndServerFrames
+
+ClientEndServerFrame for every active client, with the view calculations
+of all players run as one parallel pass between the serial halves.
+=================
+*/
+void P_EndServerFrames(JobSystem& jobs) {
+	static std::vector<gentity_t*> players;
+	static std::vector<gentity_t*> parallel;
+
+	players.clear();
+	parallel.clear();
+
+	for (auto ec : active_clients()) {
+		if (ClientEndServerFrame_Begin(ec, playerViews[ec->s.number - 1]))
+			players.push_back(ec);
+	}
+
+	for (gentity_t* ec : players) {
+		const player_view_t& view = playerViews[ec->s.number - 1];
+
+		if (!view.deathView) {
+			parallel.push_back(ec);
+			continue;
+		}
+
+		JobCommandBuffer commands;
+		ClientEndServerFrame_CalcView(ec, view, commands);
+		commands.Flush();
+	}
+
+	jobs.ParallelForDeferred(parallel.size(), 4, [](size_t begin, size_t end, JobCommandBuffer& commands) {
+		for (size_t i = begin; i < end; i++)
+			ClientEndServerFrame_CalcView(parallel[i], playerViews[parallel[i]->s.number - 1], commands);
+	});
+
+	for (gentity_t* ec : players)
+		ClientEndServerFrame_Finish(ec, playerViews[ec->s.number - 1]);
+}
@@ -231,6 +231,9 @@ void G_PlayerNoise(gentity_t* who, const Vector3& where, PlayerNoise type) {
 	noise->teleportTime = level.time;
 
 	gi.linkEntity(noise);
+
+	// monsters that can hear this stop thinking at the reduced rate
+	M_PromoteLODNear(where);
 }
 
 /*
@@ -438,35 +441,6 @@ constexpr std::array<item_id_t, 21> weaponPriorityList{ {
 		IT_WEAPON_CHAINFIST
 } };
 
-static item_id_t weaponIndexToItemID(Weapon weaponIndex) {
-	switch (weaponIndex) {
-		using enum Weapon;
-	case Blaster:			return IT_WEAPON_BLASTER;
-	case Chainfist:			return IT_WEAPON_CHAINFIST;
-	case Shotgun:			return IT_WEAPON_SHOTGUN;
-	case SuperShotgun:		return IT_WEAPON_SSHOTGUN;
-	case Machinegun:		return IT_WEAPON_MACHINEGUN;
-	case ETFRifle:			return IT_WEAPON_ETF_RIFLE;
-	case Chaingun:			return IT_WEAPON_CHAINGUN;
-	case HandGrenades:		return IT_AMMO_GRENADES;
-	case Trap:				return IT_AMMO_TRAP;
-	case TeslaMine:			return IT_AMMO_TESLA;
-	case GrenadeLauncher:	return IT_WEAPON_GLAUNCHER;
-	case ProxLauncher:		return IT_WEAPON_PROXLAUNCHER;
-	case RocketLauncher:	return IT_WEAPON_RLAUNCHER;
-	case HyperBlaster:		return IT_WEAPON_HYPERBLASTER;
-	case IonRipper:			return IT_WEAPON_IONRIPPER;
-	case PlasmaBeam:		return IT_WEAPON_PLASMABEAM;
-	case Thunderbolt:		return IT_WEAPON_THUNDERBOLT;
-	case Railgun:			return IT_WEAPON_RAILGUN;
-	case Phalanx:			return IT_WEAPON_PHALANX;
-	case BFG10K:			return IT_WEAPON_BFG;
-	case Disruptor:			return IT_WEAPON_DISRUPTOR;
-	default:				return IT_NULL;
-	}
-
-}
-
 void Client_RebuildWeaponPreferenceOrder(gclient_t& cl) {
 	auto& cache = cl.sess.weaponPrefOrder;
 	cache.clear();
@@ -486,7 +460,7 @@ void Client_RebuildWeaponPreferenceOrder(gclient_t& cl) {
 		if (weaponIndex == Weapon::None || weaponEnumIndex >= static_cast<size_t>(Weapon::Total))
 			continue;
 
-		add_item(weaponIndexToItemID(weaponIndex));
+		add_item(WeaponItemID(weaponIndex));
 	}
 
 	for (item_id_t def : weaponPriorityList)
@@ -528,17 +502,15 @@ Returns effective priority index for a weapon based on client preference.
 Lower index = higher priority.
 =============
 */
-static int GetWeaponPriorityIndex(gclient_t& cl, const std::string& abbr) {
-	const auto weapon = ParseWeaponAbbreviation(abbr);
-	if (!weapon)
+static int GetWeaponPriorityIndex(gclient_t& cl, std::string_view abbr) {
+	const Item* weaponItem = FindItemByAbbreviation(abbr);
+	if (!weaponItem)
 		return 9999; // unknown weapon = lowest priority
 
 	Client_RebuildWeaponPreferenceOrder(cl);
 	const auto& order = cl.sess.weaponPrefOrder;
 
-	const item_id_t item = weaponIndexToItemID(*weapon);
-	if (!item)
-		return 9999;
+	const item_id_t item = weaponItem->id;
 
 	for (size_t i = 0; i < order.size(); ++i) {
 		if (order[i] == item)
@@ -1355,8 +1327,8 @@ static void Weapon_HandGrenade_Fire(gentity_t* ent, bool held) {
 
 	fire_handgrenade(ent, start, dir, damage, speed, timer, radius, held);
 
-	ent->client->pers.match.totalShots++;
-	ent->client->pers.match.totalShotsPerWeapon[static_cast<uint8_t>(Weapon::HandGrenades)]++;
+	ent->client->MatchStats().totalShots()++;
+	ent->client->MatchStats().totalShotsPerWeapon()[static_cast<uint8_t>(Weapon::HandGrenades)]++;
 	RemoveAmmo(ent, 1);
 }
 
@@ -1631,8 +1603,8 @@ static void Weapon_GrenadeLauncher_Fire(gentity_t* ent) {
 
 	G_PlayerNoise(ent, start, PlayerNoise::Weapon);
 
-	ent->client->pers.match.totalShots++;
-	ent->client->pers.match.totalShotsPerWeapon[static_cast<uint8_t>(Weapon::GrenadeLauncher)]++;
+	ent->client->MatchStats().totalShots()++;
+	ent->client->MatchStats().totalShotsPerWeapon()[static_cast<uint8_t>(Weapon::GrenadeLauncher)]++;
 	RemoveAmmo(ent, 1);
 }
 
@@ -1702,8 +1674,8 @@ static void Weapon_RocketLauncher_Fire(gentity_t* ent) {
 
 	G_PlayerNoise(ent, start, PlayerNoise::Weapon);
 
-	ent->client->pers.match.totalShots++;
-	ent->client->pers.match.totalShotsPerWeapon[static_cast<uint8_t>(Weapon::RocketLauncher)]++;
+	ent->client->MatchStats().totalShots()++;
+	ent->client->MatchStats().totalShotsPerWeapon()[static_cast<uint8_t>(Weapon::RocketLauncher)]++;
 	RemoveAmmo(ent, 1);
 }
 
@@ -2076,8 +2048,8 @@ static void Weapon_Blaster_Fire(gentity_t* ent, const Vector3& g_offset, int dam
 
 	G_PlayerNoise(ent, start, PlayerNoise::Weapon);
 
-	ent->client->pers.match.totalShots++;
-	ent->client->pers.match.totalShotsPerWeapon[static_cast<uint8_t>(Weapon::Blaster)]++;
+	ent->client->MatchStats().totalShots()++;
+	ent->client->MatchStats().totalShotsPerWeapon()[static_cast<uint8_t>(Weapon::Blaster)]++;
 }
 
 static void Weapon_Blaster_DoFire(gentity_t* ent) {
@@ -2166,8 +2138,8 @@ offset[2] = 0.0f;
 		Weapon_Blaster_Fire(ent, offset, damage, true, effect);
 		Weapon_PowerupSound(ent);
 
-		client->pers.match.totalShots++;
-		client->pers.match.totalShotsPerWeapon[static_cast<uint8_t>(Weapon::HyperBlaster)]++;
+		client->MatchStats().totalShots()++;
+		client->MatchStats().totalShotsPerWeapon()[static_cast<uint8_t>(Weapon::HyperBlaster)]++;
 		RemoveAmmo(ent, 1);
 
 		// Play attack animation
@@ -2266,8 +2238,8 @@ static void Weapon_Machinegun_Fire(gentity_t* ent) {
 
 	G_PlayerNoise(ent, start, PlayerNoise::Weapon);
 
-	client.pers.match.totalShots++;
-	client.pers.match.totalShotsPerWeapon[static_cast<uint8_t>(Weapon::Machinegun)]++;
+	client.MatchStats().totalShots()++;
+	client.MatchStats().totalShotsPerWeapon()[static_cast<uint8_t>(Weapon::Machinegun)]++;
 	RemoveAmmo(ent, 1);
 
 	// Attack animation
@@ -2404,8 +2376,8 @@ static void Weapon_Chaingun_Fire(gentity_t* ent) {
 
 	G_PlayerNoise(ent, start, PlayerNoise::Weapon);
 
-	client.pers.match.totalShots += shots;
-	client.pers.match.totalShotsPerWeapon[static_cast<uint8_t>(Weapon::Chaingun)] += shots;
+	client.MatchStats().totalShots() += shots;
+	client.MatchStats().totalShotsPerWeapon()[static_cast<uint8_t>(Weapon::Chaingun)] += shots;
 
 	RemoveAmmo(ent, shots);
 }
@@ -2465,8 +2437,8 @@ static void Weapon_Shotgun_Fire(gentity_t* ent) {
 	// Weapon noise and stats
 	G_PlayerNoise(ent, start, PlayerNoise::Weapon);
 
-	ent->client->pers.match.totalShots += pelletCount;
-	ent->client->pers.match.totalShotsPerWeapon[static_cast<uint8_t>(Weapon::Shotgun)] += pelletCount;
+	ent->client->MatchStats().totalShots() += pelletCount;
+	ent->client->MatchStats().totalShotsPerWeapon()[static_cast<uint8_t>(Weapon::Shotgun)] += pelletCount;
 	RemoveAmmo(ent, 1);
 }
 
@@ -2535,8 +2507,8 @@ static void Weapon_SuperShotgun_Fire(gentity_t* ent) {
 	G_PlayerNoise(ent, start, PlayerNoise::Weapon);
 
 	// Stats and ammo
-	ent->client->pers.match.totalShots += DEFAULT_SSHOTGUN_COUNT;
-	ent->client->pers.match.totalShotsPerWeapon[static_cast<uint8_t>(Weapon::SuperShotgun)] += DEFAULT_SSHOTGUN_COUNT;
+	ent->client->MatchStats().totalShots() += DEFAULT_SSHOTGUN_COUNT;
+	ent->client->MatchStats().totalShotsPerWeapon()[static_cast<uint8_t>(Weapon::SuperShotgun)] += DEFAULT_SSHOTGUN_COUNT;
 	RemoveAmmo(ent, 2);
 }
 
@@ -2582,8 +2554,8 @@ static void Weapon_Railgun_Fire(gentity_t* ent) {
 	G_PlayerNoise(ent, start, PlayerNoise::Weapon);
 
 	// Stats and ammo tracking
-	ent->client->pers.match.totalShots++;
-	ent->client->pers.match.totalShotsPerWeapon[static_cast<uint8_t>(Weapon::Railgun)]++;
+	ent->client->MatchStats().totalShots()++;
+	ent->client->MatchStats().totalShotsPerWeapon()[static_cast<uint8_t>(Weapon::Railgun)]++;
 	RemoveAmmo(ent, 1);
 }
 
@@ -2649,8 +2621,8 @@ static void Weapon_BFG_Fire(gentity_t* ent) {
 	G_PlayerNoise(ent, start, PlayerNoise::Weapon);
 
 	// Stats and ammo
-	ent->client->pers.match.totalShots++;
-	ent->client->pers.match.totalShotsPerWeapon[static_cast<uint8_t>(Weapon::BFG10K)]++;
+	ent->client->MatchStats().totalShots()++;
+	ent->client->MatchStats().totalShotsPerWeapon()[static_cast<uint8_t>(Weapon::BFG10K)]++;
 	RemoveAmmo(ent, ammoNeeded);
 }
 
@@ -2696,8 +2668,8 @@ static void Weapon_ProxLauncher_Fire(gentity_t* ent) {
 	G_PlayerNoise(ent, start, PlayerNoise::Weapon);
 
 	// Stats and ammo
-	ent->client->pers.match.totalShots++;
-	ent->client->pers.match.totalShotsPerWeapon[static_cast<uint8_t>(Weapon::ProxLauncher)]++;
+	ent->client->MatchStats().totalShots()++;
+	ent->client->MatchStats().totalShotsPerWeapon()[static_cast<uint8_t>(Weapon::ProxLauncher)]++;
 	RemoveAmmo(ent, 1);
 }
 
@@ -2740,8 +2712,8 @@ static void Weapon_Tesla_Fire(gentity_t* ent, bool held) {
 	fire_tesla(ent, start, dir, damageMultiplier, static_cast<int>(speed));
 
 	// Stats and ammo
-	ent->client->pers.match.totalShots++;
-	ent->client->pers.match.totalShotsPerWeapon[static_cast<uint8_t>(Weapon::TeslaMine)]++;
+	ent->client->MatchStats().totalShots()++;
+	ent->client->MatchStats().totalShotsPerWeapon()[static_cast<uint8_t>(Weapon::TeslaMine)]++;
 	RemoveAmmo(ent, 1);
 }
 
@@ -2978,8 +2950,8 @@ static void Weapon_Disruptor_Fire(gentity_t* ent) {
 	G_PlayerNoise(ent, start, PlayerNoise::Weapon);
 
 	// Stats
-	ent->client->pers.match.totalShots++;
-	ent->client->pers.match.totalShotsPerWeapon[static_cast<uint8_t>(Weapon::Disruptor)]++;
+	ent->client->MatchStats().totalShots()++;
+	ent->client->MatchStats().totalShotsPerWeapon()[static_cast<uint8_t>(Weapon::Disruptor)]++;
 	RemoveAmmo(ent, 1);
 }
 
@@ -3053,8 +3025,8 @@ static void Weapon_ETF_Rifle_Fire(gentity_t* ent) {
 	G_PlayerNoise(ent, start, PlayerNoise::Weapon);
 
 	// Stats tracking
-	ent->client->pers.match.totalShots++;
-	ent->client->pers.match.totalShotsPerWeapon[static_cast<uint8_t>(Weapon::ETFRifle)]++;
+	ent->client->MatchStats().totalShots()++;
+	ent->client->MatchStats().totalShotsPerWeapon()[static_cast<uint8_t>(Weapon::ETFRifle)]++;
 	RemoveAmmo(ent, 1);
 
 	// Animation
@@ -3157,8 +3129,8 @@ static void Weapon_PlasmaBeam_Fire(gentity_t* ent) {
 	G_PlayerNoise(ent, start, PlayerNoise::Weapon);
 
 	// Stats tracking
-	ent->client->pers.match.totalShots++;
-	ent->client->pers.match.totalShotsPerWeapon[static_cast<uint8_t>(Weapon::PlasmaBeam)]++;
+	ent->client->MatchStats().totalShots()++;
+	ent->client->MatchStats().totalShotsPerWeapon()[static_cast<uint8_t>(Weapon::PlasmaBeam)]++;
 	RemoveAmmo(ent, RS(Quake1) ? 2 : 1);
 
 	// Animation
@@ -3255,8 +3227,8 @@ static void Weapon_Thunderbolt_Fire(gentity_t* ent) {
 #endif
 	G_PlayerNoise(ent, start, PlayerNoise::Weapon);
 
-	ent->client->pers.match.totalShots++;
-	ent->client->pers.match.totalShotsPerWeapon[static_cast<uint8_t>(Weapon::Thunderbolt)]++;
+	ent->client->MatchStats().totalShots()++;
+	ent->client->MatchStats().totalShotsPerWeapon()[static_cast<uint8_t>(Weapon::Thunderbolt)]++;
 	RemoveAmmo(ent, RS(Quake1) ? 2 : 1);
 
 	ent->client->anim.priority = ANIM_ATTACK;
@@ -3346,8 +3318,8 @@ static void Weapon_IonRipper_Fire(gentity_t* ent) {
 
 	G_PlayerNoise(ent, start, PlayerNoise::Weapon);
 
-	ent->client->pers.match.totalShots += kProjectileCount;
-	ent->client->pers.match.totalShotsPerWeapon[static_cast<uint8_t>(Weapon::IonRipper)] += kProjectileCount;
+	ent->client->MatchStats().totalShots() += kProjectileCount;
+	ent->client->MatchStats().totalShotsPerWeapon()[static_cast<uint8_t>(Weapon::IonRipper)] += kProjectileCount;
 
 	RemoveAmmo(ent, ammoNeeded);
 }
@@ -3422,8 +3394,8 @@ static void Weapon_Phalanx_Fire(gentity_t* ent) {
 	gi.multicast(ent->s.origin, MULTICAST_PVS, false);
 
 	if (isRightBarrel) {
-		ent->client->pers.match.totalShots += 2;
-		ent->client->pers.match.totalShotsPerWeapon[static_cast<uint8_t>(Weapon::Phalanx)] += 2;
+		ent->client->MatchStats().totalShots() += 2;
+		ent->client->MatchStats().totalShotsPerWeapon()[static_cast<uint8_t>(Weapon::Phalanx)] += 2;
 		RemoveAmmo(ent, 1);
 	}
 	else {
@@ -3482,8 +3454,8 @@ static void Weapon_Trap_Fire(gentity_t* ent, bool held) {
 	fire_trap(ent, start, dir, static_cast<int>(speed));
 
 	// Track usage stats
-	ent->client->pers.match.totalShots++;
-	ent->client->pers.match.totalShotsPerWeapon[static_cast<uint8_t>(Weapon::Trap)]++;
+	ent->client->MatchStats().totalShots()++;
+	ent->client->MatchStats().totalShotsPerWeapon()[static_cast<uint8_t>(Weapon::Trap)]++;
 	RemoveAmmo(ent, 1);
 }
 
@@ -42,13 +42,26 @@ inline std::optional<Weapon> ParseNormalizedWeaponAbbreviation(std::string_view
         return std::nullopt;
 }
 
+inline bool WeaponAbbreviationEquals(std::string_view abbr, std::string_view normalized) {
+        if (abbr.size() != normalized.size()) {
+                return false;
+        }
+        for (std::size_t i = 0; i < abbr.size(); ++i) {
+                if (ToUpperASCII(abbr[i]) != normalized[i]) {
+                        return false;
+                }
+        }
+        return true;
+}
+
+// compares in place, so parsing a preference does not allocate
 inline std::optional<Weapon> ParseWeaponAbbreviation(std::string_view abbr) {
-        const std::string normalized = NormalizeWeaponAbbreviation(abbr);
-        auto weapon = ParseNormalizedWeaponAbbreviation(normalized);
-        if (!weapon || *weapon == Weapon::None) {
-                return std::nullopt;
+        for (std::size_t i = static_cast<std::size_t>(Weapon::None) + 1; i < weaponAbbreviations.size(); ++i) {
+                if (WeaponAbbreviationEquals(abbr, weaponAbbreviations[i])) {
+                        return static_cast<Weapon>(i);
+                }
         }
-        return weapon;
+        return std::nullopt;
 }
 
 enum class WeaponPrefAppendResult {
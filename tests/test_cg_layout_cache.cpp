@@ -0,0 +1,174 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+test_cg_layout_cache.cpp implementation.*/
+
+#include "client/cg_layout.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace {
+
+// representative deathmatch scoreboard as sent by the server
+constexpr const char* kScoreboardLayout =
+	"xv 0 yv 0 loc_string2 1 $g_score_frags \"12\" "
+	"if 31 xv 100 yv 16 pic 31 endif "
+	"xv -120 yv 40 client -120 40 0 25 48 3 "
+	"xv -120 yv 72 client -120 72 1 19 33 3 "
+	"xv -120 yv 104 client -120 104 2 7 110 2 "
+	"xv -120 yv 136 client -120 136 3 -1 999 1 "
+	"xv 40 yv 40 ctf 40 40 4 15 1200 \"/players/male/w_railgun\" "
+	"xv 0 yb -48 loc_rstring 2 $g_score_limit \"30\" \"frags\" "
+	"xv 0 yv 180 time_limit 18000 "
+	"start_table 3 $name $score $ping "
+	"table_row 3 \"player one\" 25 48 "
+	"table_row 3 \"player two\" 19 33 "
+	"draw_table "
+	"ifgef 500 xv 0 yv 200 cstring2 \"match ends soon\" endif "
+	"unknown_token hnum anum rnum story";
+
+/*
+=============
+CountOps
+
+Counts how many instructions in the program carry the requested opcode.
+=============
+*/
+size_t CountOps(const layout_program_t& program, layout_op_t op) {
+	size_t count = 0;
+	for (const auto& instr : program.code)
+		if (instr.op == op)
+			count++;
+	return count;
+}
+
+/*
+=============
+TokenizeLayout
+
+Mirrors the per-frame cost the interpreter paid before layouts were
+compiled: every token parsed and tested against the keyword list.
+=============
+*/
+size_t TokenizeLayout(const char* s) {
+	size_t matched = 0;
+
+	while (s) {
+		const char* token = COM_Parse(&s);
+		for (const auto& kw : layout_detail::layout_keywords) {
+			if (!strcmp(token, kw.name)) {
+				matched++;
+				break;
+			}
+		}
+	}
+
+	return matched;
+}
+
+} // namespace
+
+/*
+=============
+main
+
+Verifies layout compilation, cache reuse and in-place edits, then times
+100k scoreboard executions against re-tokenizing the text every frame.
+=============
+*/
+int main() {
+	layout_program_t program;
+	CG_CompileLayout(kScoreboardLayout, program);
+
+	assert(CountOps(program, layout_op_t::Client) == 4);
+	assert(CountOps(program, layout_op_t::CTF) == 1);
+	assert(CountOps(program, layout_op_t::If) == 1);
+	assert(CountOps(program, layout_op_t::IfGEF) == 1);
+	assert(CountOps(program, layout_op_t::EndIf) == 2);
+	assert(CountOps(program, layout_op_t::HNum) == 1);
+	assert(CountOps(program, layout_op_t::Story) == 1);
+	assert(CountOps(program, layout_op_t::Error) == 0);
+
+	// client operands are pre-parsed, including negative values
+	for (const auto& instr : program.code) {
+		if (instr.op != layout_op_t::Client || instr.args[2] != 3)
+			continue;
+		assert(instr.args[0] == -120);
+		assert(instr.args[1] == 136);
+		assert(instr.args[3] == -1);
+		assert(instr.args[4] == 999);
+		assert(instr.args[5] == 1);
+	}
+
+	// string operands survive quoting, and keyword flags are carried over
+	for (const auto& instr : program.code) {
+		if (instr.op == layout_op_t::CTF) {
+			assert(instr.args[4] == 1200);
+			assert(!strcmp(program.string(instr, 0), "/players/male/w_railgun"));
+		}
+		else if (instr.op == layout_op_t::LocStringAligned && (instr.flags & LAYOUT_FLAG_RIGHT_ALIGN)) {
+			assert(!(instr.flags & LAYOUT_FLAG_GREEN));
+			assert(instr.args[0] == 2);
+			assert(instr.num_strings == 3);
+			assert(!strcmp(program.string(instr, 0), "$g_score_limit"));
+			assert(!strcmp(program.string(instr, 2), "frags"));
+		}
+		else if (instr.op == layout_op_t::TableRow && instr.num_strings == 3) {
+			assert(!strcmp(program.string(instr, 0), "player one") || !strcmp(program.string(instr, 0), "player two"));
+		}
+	}
+
+	// malformed localization counts fail at the same point the parser did
+	CG_CompileLayout("xv 0 loc_string 99 $bad", program);
+	assert(program.code.size() == 2);
+	assert(program.code.back().op == layout_op_t::Error);
+	assert(!strcmp(program.string(program.code.back(), 0), "Bad loc string"));
+
+	// the cache compiles each distinct layout once and notices in-place edits
+	layout_cache_t<4> cache;
+	char buffer[1024];
+	Q_strlcpy(buffer, kScoreboardLayout, sizeof(buffer));
+
+	const layout_program_t* first = &cache.get(buffer);
+	assert(&cache.get(buffer) == first);
+	assert(cache.compiles == 1 && cache.hits == 1);
+
+	buffer[strlen("xv 0 yv 0 loc_string2 1 $g_score_frags \"1")] = '3';
+	const layout_program_t& edited = cache.get(buffer);
+	assert(cache.compiles == 2);
+	assert(!strcmp(edited.string(edited.code[2], 1), "13"));
+
+	// least recently used entry is the one evicted
+	cache.get("xv 1");
+	cache.get("xv 2");
+	cache.get(buffer);
+	cache.get("xv 3");
+	assert(cache.compiles == 5);
+	cache.get(buffer);
+	assert(cache.compiles == 5);
+
+	constexpr int kIterations = 100000;
+	size_t sink = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < kIterations; i++)
+		sink += TokenizeLayout(kScoreboardLayout);
+	auto tokenized = std::chrono::steady_clock::now() - start;
+
+	start = std::chrono::steady_clock::now();
+	for (int i = 0; i < kIterations; i++) {
+		for (const auto& instr : cache.get(buffer).code)
+			sink += static_cast<size_t>(instr.op) + instr.args[0];
+	}
+	auto compiled = std::chrono::steady_clock::now() - start;
+
+	using ms = std::chrono::duration<double, std::milli>;
+	std::printf("scoreboard x%d: tokenized %.2f ms, compiled %.2f ms (sink %zu)\n",
+		kIterations, ms(tokenized).count(), ms(compiled).count(), sink);
+
+	return 0;
+}
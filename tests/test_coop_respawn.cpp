@@ -0,0 +1,330 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+test_coop_respawn.cpp implementation.*/
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "server/player/p_coop_respawn.cpp"
+
+constexpr size_t CLIENT_COUNT = 8;
+constexpr size_t CANDIDATE_COUNT = 4;	// clients 1-4 are alive, 5-8 wait to respawn
+constexpr size_t MONSTER_COUNT = 300;
+constexpr size_t FIRST_MONSTER = CLIENT_COUNT + BODY_QUEUE_SIZE + 1;
+constexpr size_t DECOY = FIRST_MONSTER + MONSTER_COUNT;
+constexpr size_t CRATE = DECOY + 1;
+constexpr size_t ENTITY_COUNT = CRATE + 1;
+constexpr size_t FRAMES = 400;
+
+// a pit with no floor, where no spot can be found
+constexpr float PIT_X = 1000.f;
+constexpr float PIT_HALF_SIZE = 400.f;
+
+static std::unique_ptr<gentity_t[]> entities;
+static std::unique_ptr<gclient_t[]> clients;
+static size_t traces;
+static size_t monsterVisits;
+
+/*
+=============
+InPit
+=============
+*/
+static bool InPit(const Vector3& point) {
+	return std::fabs(point[0] - PIT_X) < PIT_HALF_SIZE && std::fabs(point[1]) < PIT_HALF_SIZE;
+}
+
+/*
+=============
+TraceLevel
+
+A floor at zero everywhere but the pit, and a crate that anything
+starting inside it is stuck in.
+=============
+*/
+static trace_t TraceLevel(gvec3_cref_t start, gvec3_cptr_t mins, gvec3_cptr_t, gvec3_cref_t end, const gentity_t*, contents_t) {
+	trace_t tr{};
+	tr.fraction = 1.f;
+	tr.endPos = end;
+	traces++;
+
+	const gentity_t* crate = &entities[CRATE];
+	if (crate->solid == SOLID_BBOX && start == end && (start - crate->s.origin).length() < 16.f) {
+		tr.startSolid = tr.allSolid = true;
+		tr.fraction = 0.f;
+		tr.endPos = start;
+		tr.ent = const_cast<gentity_t*>(crate);
+		return tr;
+	}
+
+	const float floorZ = mins ? -(*mins)[2] : 0.f;
+	if (end[2] < floorZ && start[2] >= floorZ && !InPit(end)) {
+		tr.fraction = (start[2] - floorZ) / (start[2] - end[2]);
+		tr.ent = world;
+		tr.plane.normal = { 0.f, 0.f, 1.f };
+		for (int a = 0; a < 3; a++)
+			tr.endPos[a] = start[a] + (end[a] - start[a]) * tr.fraction;
+	}
+
+	return tr;
+}
+
+/*
+=============
+EmptyContents
+=============
+*/
+static contents_t EmptyContents(gvec3_cref_t) {
+	return CONTENTS_NONE;
+}
+
+/*
+=============
+LegacyMonstersSearchingFor
+=============
+*/
+static bool LegacyMonstersSearchingFor(gentity_t* player) {
+	for (auto ent : active_monsters()) {
+		monsterVisits++;
+
+		if (player == nullptr && ent->enemy && !ent->enemy->client)
+			continue;
+		else if (player != nullptr && ent->enemy != player)
+			continue;
+
+		if ((ent->monsterInfo.aiFlags & AI_LOST_SIGHT) && level.time > ent->monsterInfo.trailTime + 5_sec)
+			continue;
+
+		return true;
+	}
+
+	return false;
+}
+
+/*
+=============
+LegacyFindSquadRespawnTarget
+
+The squad search as it ran before, with every probe redone each call.
+=============
+*/
+static std::tuple<gentity_t*, Vector3> LegacyFindSquadRespawnTarget() {
+	const bool anyMonstersSearching = LegacyMonstersSearchingFor(nullptr);
+
+	for (gentity_t* player : active_clients()) {
+		auto* cl = player->client;
+
+		if (player->deadFlag)
+			continue;
+
+		using enum CoopRespawn;
+
+		if (cl->last_damage_time >= level.time) {
+			cl->coopRespawnState = InCombat;
+			continue;
+		}
+		if (LegacyMonstersSearchingFor(player)) {
+			cl->coopRespawnState = InCombat;
+			continue;
+		}
+		if (anyMonstersSearching && cl->lastFiringTime >= level.time) {
+			cl->coopRespawnState = InCombat;
+			continue;
+		}
+		if (player->groundEntity != world) {
+			cl->coopRespawnState = BadArea;
+			continue;
+		}
+		if (player->waterLevel >= WATER_UNDER) {
+			cl->coopRespawnState = BadArea;
+			continue;
+		}
+
+		respawn_probe_t probe{};
+		if (!ProbeRespawnSpot(player, probe)) {
+			cl->coopRespawnState = Blocked;
+			continue;
+		}
+
+		return { player, probe.spot };
+	}
+
+	return { nullptr, vec3_origin };
+}
+
+/*
+=============
+ResetLevel
+
+Client 1 is hunted, 2 and 4 stand at the edge of the pit, and 3 is
+stuck in the crate; most monsters are busy with a decoy.
+=============
+*/
+static void ResetLevel() {
+	entities = std::make_unique<gentity_t[]>(ENTITY_COUNT);
+	clients = std::make_unique<gclient_t[]>(CLIENT_COUNT);
+
+	g_entities = entities.get();
+	game.clients = clients.get();
+	game.maxClients = CLIENT_COUNT;
+	game.maxEntities = ENTITY_COUNT;
+	globals.numEntities = ENTITY_COUNT;
+	level.time = 10_sec;
+
+	huntingIndex = {};
+	respawnProbes = {};
+
+	for (size_t i = 1; i <= CLIENT_COUNT; i++) {
+		gentity_t* ent = &entities[i];
+
+		ent->inUse = true;
+		ent->client = &clients[i - 1];
+		ent->client->pers.connected = true;
+		ent->groundEntity = world;
+		ent->deadFlag = i > CANDIDATE_COUNT;
+		ent->s.origin = { -2000.f + static_cast<float>(i) * 100.f, 0.f, 24.f };
+	}
+
+	entities[2].s.origin = { PIT_X, 0.f, 24.f };
+	entities[2].s.angles[YAW] = 30.f;
+	entities[3].s.origin = { -500.f, 300.f, 24.f };
+	entities[4].s.origin = { PIT_X + 40.f, 20.f, 24.f };
+	entities[4].s.angles[YAW] = 200.f;
+
+	gentity_t* decoy = &entities[DECOY];
+	decoy->inUse = true;
+
+	gentity_t* crate = &entities[CRATE];
+	crate->inUse = true;
+	crate->solid = SOLID_BBOX;
+	crate->s.origin = entities[3].s.origin;
+
+	for (size_t i = 0; i < MONSTER_COUNT; i++) {
+		gentity_t* monster = &entities[FIRST_MONSTER + i];
+
+		monster->inUse = true;
+		monster->svFlags = SVF_MONSTER;
+		monster->health = 100;
+		monster->enemy = decoy;
+	}
+
+	// a few after client 1, some of which have lost it
+	for (size_t i = 0; i < 6; i++) {
+		gentity_t* monster = &entities[FIRST_MONSTER + MONSTER_COUNT - 1 - i];
+
+		monster->enemy = &entities[1];
+		if (i % 2) {
+			monster->monsterInfo.aiFlags |= AI_LOST_SIGHT;
+			monster->monsterInfo.trailTime = 0_sec;
+		}
+	}
+}
+
+/*
+=============
+AdvanceFrame
+
+Scripted changes the caches have to notice.
+=============
+*/
+static void AdvanceFrame(size_t frame) {
+	level.time += 25_ms;
+
+	// client 4 paces along the pit edge, then walks out of it
+	if (frame % 40 == 10)
+		entities[4].s.angles[YAW] += 15.f;
+	if (frame == 250)
+		entities[4].s.origin = { -300.f, -300.f, 24.f };
+
+	// the crate is pushed off client 3, then back
+	if (frame == 150)
+		entities[CRATE].s.origin = { -600.f, 300.f, 24.f };
+	if (frame == 200)
+		entities[CRATE].s.origin = entities[3].s.origin;
+
+	// the hunters give up on client 1
+	if (frame == 300) {
+		for (size_t i = 0; i < 6; i++)
+			entities[FIRST_MONSTER + MONSTER_COUNT - 1 - i].enemy = &entities[DECOY];
+	}
+}
+
+/*
+=============
+RunSearch
+
+Every waiting client searches for a squad member each frame, as
+G_LimitedLivesRespawn does while they wait.
+=============
+*/
+template <typename Search>
+static void RunSearch(Search search, std::vector<std::pair<size_t, Vector3>>& results, std::vector<CoopRespawn>& states) {
+	ResetLevel();
+
+	for (size_t frame = 0; frame < FRAMES; frame++) {
+		AdvanceFrame(frame);
+
+		for (size_t waiting = CANDIDATE_COUNT; waiting < CLIENT_COUNT; waiting++) {
+			auto [player, spot] = search();
+			results.emplace_back(player ? player - entities.get() : 0, spot);
+			for (size_t i = 0; i < CANDIDATE_COUNT; i++)
+				states.push_back(clients[i].coopRespawnState);
+		}
+	}
+}
+
+/*
+=============
+main
+=============
+*/
+int main() {
+	using clock = std::chrono::steady_clock;
+
+	game_import_t& base = gi;
+	base.trace = &TraceLevel;
+	base.pointContents = &EmptyContents;
+
+	std::vector<std::pair<size_t, Vector3>> legacyResults, cachedResults;
+	std::vector<CoopRespawn> legacyStates, cachedStates;
+
+	traces = monsterVisits = 0;
+	auto start = clock::now();
+	RunSearch(&LegacyFindSquadRespawnTarget, legacyResults, legacyStates);
+	const double legacyMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+	const size_t legacyTraces = traces;
+	const size_t legacyVisits = monsterVisits;
+
+	traces = 0;
+	start = clock::now();
+	RunSearch(&G_FindSquadRespawnTarget, cachedResults, cachedStates);
+	const double cachedMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+	// the same squad member and spot, with the same reasons given for the rest
+	assert(legacyResults.size() == cachedResults.size());
+	for (size_t i = 0; i < legacyResults.size(); i++) {
+		assert(legacyResults[i].first == cachedResults[i].first);
+		assert(legacyResults[i].second == cachedResults[i].second);
+	}
+	assert(legacyStates == cachedStates);
+
+	// each phase of the script was reached
+	size_t found[CANDIDATE_COUNT + 1]{};
+	for (const auto& [player, spot] : cachedResults)
+		found[player]++;
+	assert(found[0] && found[1] && found[3] && found[4]);
+	assert(!found[2]);
+
+	assert(traces * 10 < legacyTraces);
+
+	std::printf("Coop squad search, %zu waiting x %zu frames, %zu monsters:\n", CLIENT_COUNT - CANDIDATE_COUNT, FRAMES, MONSTER_COUNT);
+	std::printf("  legacy  %zu traces (%.1f/frame)  %zu monster checks  %.3f ms\n",
+		legacyTraces, static_cast<double>(legacyTraces) / FRAMES, legacyVisits, legacyMs);
+	std::printf("  cached  %zu traces (%.1f/frame)  %zu monster passes  %.3f ms\n",
+		traces, static_cast<double>(traces) / FRAMES, FRAMES, cachedMs);
+	return 0;
+}
@@ -0,0 +1,267 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+test_entity_class.cpp implementation.*/
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "server/gameplay/g_entity_class.cpp"
+#include "server/gameplay/g_entity_hot.cpp"
+
+constexpr size_t CLIENT_COUNT = 8;
+constexpr size_t WORLD_SIZE = 4096;
+constexpr size_t FRAMES = 400;
+
+static std::unique_ptr<gentity_t[]> entities;
+
+/*
+=============
+PrintToStdout
+=============
+*/
+static void PrintToStdout(const char* message) {
+	std::fputs(message, stdout);
+}
+
+/*
+=============
+ResetEntities
+=============
+*/
+static void ResetEntities(size_t count) {
+	entities = std::make_unique<gentity_t[]>(count);
+	std::memset(static_cast<void*>(entities.get()), 0, sizeof(gentity_t) * count);
+
+	g_entities = entities.get();
+	game.maxEntities = static_cast<uint32_t>(count);
+	game.maxClients = CLIENT_COUNT;
+	globals.numEntities = static_cast<uint32_t>(count);
+	level.time = 10_sec;
+
+	G_EntityHotClear();
+}
+
+/*
+=============
+SpawnAs
+
+Puts an entity in use under a class name, as ED_CallSpawn leaves it.
+=============
+*/
+static gentity_t* SpawnAs(size_t slot, const char* className) {
+	gentity_t* ent = &entities[slot];
+
+	ent->inUse = true;
+	ent->className = className;
+	G_EntityHotSync(ent);
+	G_EntityClassResolve(ent);
+	return ent;
+}
+
+/*
+=============
+CheckNames
+
+Every tagged name maps back to its tag, in any case; anything else is
+Other.
+=============
+*/
+static void CheckNames() {
+	for (size_t i = 1; i < static_cast<size_t>(EntityClass::Total); i++) {
+		const EntityClass cls = static_cast<EntityClass>(i);
+		std::string upper = G_EntityClassName(cls);
+
+		assert(!upper.empty());
+		assert(G_EntityClassFromName(upper.c_str()) == cls);
+
+		for (char& c : upper)
+			c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+		assert(G_EntityClassFromName(upper.c_str()) == cls);
+	}
+
+	assert(G_EntityClassFromName(nullptr) == EntityClass::Other);
+	assert(G_EntityClassFromName("") == EntityClass::Other);
+	assert(G_EntityClassFromName("grenade2") == EntityClass::Other);
+	assert(G_EntityClassFromName("monster_soldier") == EntityClass::Other);
+	assert(G_EntityClassFromName(std::string(MAX_CLASS_NAME + 8, 'a').c_str()) == EntityClass::Other);
+	assert(!std::strcmp(G_EntityClassName(EntityClass::Total), ""));
+}
+
+/*
+=============
+CheckGroups
+
+Prefix families match the strncmp checks they replace.
+=============
+*/
+static void CheckGroups() {
+	EntityClassGroup groups;
+
+	assert(G_EntityClassFromName("player_noise", &groups) == EntityClass::PlayerNoise);
+	assert(groups == EntityClassGroup::Player);
+
+	assert(G_EntityClassFromName("info_player_deathmatch", &groups) == EntityClass::Other);
+	assert(groups == EntityClassGroup::PlayerSpawn);
+
+	assert(G_EntityClassFromName("item_flag_team1", &groups) == EntityClass::Other);
+	assert(groups == EntityClassGroup::TeamFlag);
+
+	assert(G_EntityClassFromName("tesla_mine", &groups) == EntityClass::TeslaMine);
+	assert(groups == EntityClassGroup::Tesla);
+
+	assert(G_EntityClassFromName("food_cube_trap", &groups) == EntityClass::Other);
+	assert(groups == EntityClassGroup::FoodCubeTrap);
+
+	assert(G_EntityClassFromName("func_plat2", &groups) == EntityClass::FuncPlat2);
+	assert(groups == EntityClassGroup::FuncPlat);
+
+	assert(G_EntityClassFromName("monster_medic_commander", &groups) == EntityClass::MonsterMedicCommander);
+	assert(groups == EntityClassGroup::Medic);
+
+	assert(G_EntityClassFromName("monster_widow2", &groups) == EntityClass::Other);
+	assert(groups == EntityClassGroup::Widow);
+
+	assert(G_EntityClassFromName("worldspawn", &groups) == EntityClass::Other);
+	assert(groups == EntityClassGroup::None);
+}
+
+/*
+=============
+CheckRename
+
+Entities that change className after spawning are re-tagged on the next
+query, without anyone calling G_EntityClassResolve.
+=============
+*/
+static void CheckRename() {
+	ResetEntities(64);
+
+	gentity_t* ent = SpawnAs(20, "grenade");
+	assert(G_IsClass(ent, EntityClass::Grenade));
+	assert(!G_IsClass(ent, EntityClass::Gib));
+
+	ent->className = "gib";
+	assert(G_IsClass(ent, EntityClass::Gib));
+	assert(!G_IsClass(ent, EntityClass::Grenade));
+
+	ent->className = "tesla";
+	assert(G_EntityClassOf(ent) == EntityClass::Other);
+	assert(G_InClassGroup(ent, EntityClassGroup::Tesla));
+	assert(!G_InClassGroup(ent, EntityClassGroup::FoodCubeTrap));
+
+	ent->className = nullptr;
+	assert(G_EntityClassOf(ent) == EntityClass::Other);
+	assert(!G_InClassGroup(ent, EntityClassGroup::Tesla));
+
+	assert(!G_IsClass(nullptr, EntityClass::Other));
+	assert(!G_InClassGroup(nullptr, EntityClassGroup::Player));
+
+	// a copied entity carries its cache with it and stays correct
+	gentity_t* copy = &entities[21];
+	ent->className = "prox_mine";
+	G_EntityClassResolve(ent);
+	std::memcpy(static_cast<void*>(copy), ent, sizeof(gentity_t));
+	assert(G_IsClass(copy, EntityClass::ProxMine));
+}
+
+/*
+=============
+CheckVerify
+
+A cached tag that disagrees with its className is reported and re-tagged.
+=============
+*/
+static void CheckVerify() {
+	ResetEntities(64);
+
+	SpawnAs(30, "misc_explobox");
+	gentity_t* door = SpawnAs(31, "func_door");
+	assert(G_EntityClassVerify(false));
+
+	door->classTag = EntityClass::FuncWater;
+	assert(!G_EntityClassVerify(true));
+	assert(G_EntityClassVerify(false));
+	assert(G_IsClass(door, EntityClass::FuncDoor));
+}
+
+/*
+=============
+RunBenchmark
+
+The checks a busy frame makes per damaged or touched entity, against a
+world of mixed classes: string compares as before, and tag compares.
+=============
+*/
+static void RunBenchmark() {
+	static const char* const names[] = {
+		"monster_soldier", "monster_gunner", "gib", "grenade", "prox_mine", "tesla_mine",
+		"misc_explobox", "func_door", "path_corner", "player_noise", "info_player_deathmatch",
+		"item_health", "weapon_shotgun", "light", "func_plat", "monster_medic_commander",
+	};
+
+	using clock = std::chrono::steady_clock;
+
+	ResetEntities(WORLD_SIZE);
+	for (size_t i = CLIENT_COUNT + 1; i < WORLD_SIZE; i++)
+		SpawnAs(i, names[i % std::size(names)]);
+
+	size_t stringHits = 0;
+	auto start = clock::now();
+	for (size_t frame = 0; frame < FRAMES; frame++) {
+		for (size_t i = CLIENT_COUNT + 1; i < WORLD_SIZE; i++) {
+			const gentity_t* ent = &entities[i];
+
+			stringHits += !strcmp(ent->className, "tesla_mine");
+			stringHits += !strcmp(ent->className, "prox_mine");
+			stringHits += !strcmp(ent->className, "misc_explobox");
+			stringHits += !strcmp(ent->className, "gib");
+			stringHits += !strncmp(ent->className, "info_player_", 12);
+			stringHits += !strcmp(ent->className, "player_noise");
+		}
+	}
+	const double stringMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+	size_t tagHits = 0;
+	start = clock::now();
+	for (size_t frame = 0; frame < FRAMES; frame++) {
+		for (size_t i = CLIENT_COUNT + 1; i < WORLD_SIZE; i++) {
+			const gentity_t* ent = &entities[i];
+
+			tagHits += G_IsClass(ent, EntityClass::TeslaMine);
+			tagHits += G_IsClass(ent, EntityClass::ProxMine);
+			tagHits += G_IsClass(ent, EntityClass::MiscExplobox);
+			tagHits += G_IsClass(ent, EntityClass::Gib);
+			tagHits += G_InClassGroup(ent, EntityClassGroup::PlayerSpawn);
+			tagHits += G_IsClass(ent, EntityClass::PlayerNoise);
+		}
+	}
+	const double tagMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+	assert(stringHits == tagHits);
+
+	const double checks = static_cast<double>(FRAMES * (WORLD_SIZE - CLIENT_COUNT - 1) * 6);
+	std::printf("Class checks over %zu frames, %zu entities:\n", FRAMES, WORLD_SIZE);
+	std::printf("  className strings  %.3f ms  %.2f ns/check\n", stringMs, stringMs * 1e6 / checks);
+	std::printf("  class tags         %.3f ms  %.2f ns/check\n", tagMs, tagMs * 1e6 / checks);
+}
+
+/*
+=============
+main
+=============
+*/
+int main() {
+	gi.Com_Print = &PrintToStdout;
+
+	CheckNames();
+	CheckGroups();
+	CheckRename();
+	CheckVerify();
+	RunBenchmark();
+	return 0;
+}
@@ -0,0 +1,156 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+test_entity_hot.cpp implementation.*/
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "server/gameplay/g_entity_hot.cpp"
+
+constexpr size_t CLIENT_COUNT = 4;
+constexpr size_t WORLD_SIZES[] = { 1024, 4096, 8192 };
+
+static std::unique_ptr<gentity_t[]> entities;
+
+/*
+=============
+PrintToStdout
+=============
+*/
+static void PrintToStdout(const char* message) {
+	std::fputs(message, stdout);
+}
+
+/*
+=============
+ResetEntities
+
+A wiped entity array of the given size, as InitGame leaves it.
+=============
+*/
+static void ResetEntities(size_t count) {
+	entities = std::make_unique<gentity_t[]>(count);
+	std::memset(static_cast<void*>(entities.get()), 0, sizeof(gentity_t) * count);
+
+	g_entities = entities.get();
+	game.maxEntities = static_cast<uint32_t>(count);
+	game.maxClients = CLIENT_COUNT;
+	globals.numEntities = static_cast<uint32_t>(count);
+	level.time = 10_sec;
+
+	G_EntityHotClear();
+}
+
+/*
+=============
+SetInUse
+
+What InitGEntity and FreeEntity do to the mirrored fields.
+=============
+*/
+static void SetInUse(size_t slot, bool inUse) {
+	gentity_t* ent = &entities[slot];
+
+	ent->inUse = inUse;
+	if (!inUse)
+		ent->freeTime = level.time;
+	G_EntityHotSync(ent);
+}
+
+/*
+=============
+CheckWalk
+
+The column walk visits exactly the in-use slots, and the free-slot search
+applies Spawn's reuse policy, across random churn.
+=============
+*/
+static void CheckWalk(size_t count) {
+	ResetEntities(count);
+	std::mt19937 rng(static_cast<uint32_t>(count));
+
+	for (size_t frame = 0; frame < 50; frame++) {
+		for (size_t op = 0; op < count / 8; op++)
+			SetInUse(CLIENT_COUNT + 1 + rng() % (count - CLIENT_COUNT - 1), (rng() % 4) == 0);
+
+		std::vector<size_t> expected;
+		for (size_t i = CLIENT_COUNT + 1; i < count; i++) {
+			if (entities[i].inUse)
+				expected.push_back(i);
+		}
+
+		std::vector<size_t> walked;
+		for (size_t i = G_EntityHotNextInUse(CLIENT_COUNT + 1); i < globals.numEntities; i = G_EntityHotNextInUse(i + 1))
+			walked.push_back(i);
+
+		assert(walked == expected);
+		assert(G_EntityHotVerify(false));
+
+		size_t reusable = CLIENT_COUNT + 1;
+		while (reusable < count && (entities[reusable].inUse || level.time - entities[reusable].freeTime <= 500_ms))
+			reusable++;
+		assert(G_EntityHotFindFree(CLIENT_COUNT + 1) == reusable);
+
+		level.time += 100_ms;
+	}
+}
+
+/*
+=============
+CheckVerifyAndRebuild
+
+A change made without a sync is caught, and a rebuild repairs it.
+=============
+*/
+static void CheckVerifyAndRebuild() {
+	ResetEntities(256);
+
+	SetInUse(100, true);
+	assert(G_EntityHotNextInUse(CLIENT_COUNT + 1) == 100);
+
+	entities[200].inUse = true;
+	assert(!G_EntityHotVerify(false));
+
+	G_EntityHotRebuild();
+	assert(G_EntityHotVerify(false));
+	assert(G_EntityHotNextInUse(101) == 200);
+	assert(G_EntityHotNextInUse(201) == globals.numEntities);
+}
+
+/*
+=============
+RunBenchmarks
+
+One in four slots in use, the rest free, at each world size.
+=============
+*/
+static void RunBenchmarks() {
+	for (size_t count : WORLD_SIZES) {
+		ResetEntities(count);
+
+		for (size_t i = CLIENT_COUNT + 1; i < count; i += 4)
+			SetInUse(i, true);
+
+		G_EntityHotBenchmark(200);
+	}
+}
+
+/*
+=============
+main
+=============
+*/
+int main() {
+	gi.Com_Print = &PrintToStdout;
+
+	for (size_t count : WORLD_SIZES)
+		CheckWalk(count);
+	CheckVerifyAndRebuild();
+	RunBenchmarks();
+	return 0;
+}
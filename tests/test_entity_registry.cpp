@@ -0,0 +1,192 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+test_entity_registry.cpp implementation.*/
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+#include "server/gameplay/g_entity_class.cpp"
+#include "server/gameplay/g_entity_hot.cpp"
+#include "server/gameplay/g_registry.cpp"
+
+constexpr size_t ENTITY_COUNT = 32;
+static std::unique_ptr<gentity_t[]> entities;
+
+/*
+=============
+ResetEntities
+
+Gives the tests a fresh entity array with four client slots.
+=============
+*/
+static void ResetEntities() {
+	entities = std::make_unique<gentity_t[]>(ENTITY_COUNT);
+	g_entities = entities.get();
+	game.maxClients = 4;
+	globals.numEntities = ENTITY_COUNT;
+
+	for (size_t i = 0; i < ENTITY_COUNT; i++)
+		entities[i].s.number = static_cast<int32_t>(i);
+
+	G_RegistryClear();
+}
+
+/*
+=============
+MakeMonster
+=============
+*/
+static gentity_t* MakeMonster(size_t number) {
+	gentity_t* ent = &entities[number];
+	ent->inUse = true;
+	ent->svFlags = SVF_MONSTER;
+	ent->health = 100;
+	G_RegistrySync(ent);
+	return ent;
+}
+
+/*
+=============
+CheckClassification
+
+Each category lands in its own registry and clients are never tracked.
+=============
+*/
+static void CheckClassification() {
+	ResetEntities();
+
+	MakeMonster(10);
+
+	gentity_t* rocket = &entities[11];
+	rocket->inUse = true;
+	rocket->owner = &entities[1];
+	rocket->moveType = MoveType::FlyMissile;
+	G_RegistrySync(rocket);
+
+	gentity_t* mine = &entities[12];
+	mine->inUse = true;
+	mine->owner = &entities[1];
+	mine->moveType = MoveType::Bounce;
+	mine->className = "prox_mine";
+	G_RegistrySync(mine);
+
+	gentity_t* door = &entities[13];
+	door->inUse = true;
+	door->solid = SOLID_BSP;
+	door->moveType = MoveType::Push;
+	G_RegistrySync(door);
+
+	gentity_t* player = &entities[1];
+	player->inUse = true;
+	player->svFlags = SVF_MONSTER;
+	G_RegistrySync(player);
+
+	assert(G_RegistryCount(EntityRegistry::Monster) == 1);
+	assert(G_RegistryCount(EntityRegistry::Projectile) == 1);
+	assert(G_RegistryCount(EntityRegistry::Trap) == 1);
+	assert(G_RegistryCount(EntityRegistry::Mover) == 1);
+	assert(player->registry == EntityRegistry::None);
+	assert(G_RegistryVerify(false));
+}
+
+/*
+=============
+CheckAliveCounts
+
+Deaths and revivals move the living count without changing membership.
+=============
+*/
+static void CheckAliveCounts() {
+	ResetEntities();
+
+	gentity_t* a = MakeMonster(10);
+	gentity_t* b = MakeMonster(11);
+	assert(G_RegistryAliveCount(EntityRegistry::Monster) == 2);
+
+	a->health = 0;
+	G_RegistrySync(a);
+	b->deadFlag = true;
+	G_RegistrySync(b);
+	assert(G_RegistryCount(EntityRegistry::Monster) == 2);
+	assert(G_RegistryAliveCount(EntityRegistry::Monster) == 0);
+
+	a->health = 50;
+	G_RegistrySync(a);
+	assert(G_RegistryAliveCount(EntityRegistry::Monster) == 1);
+	assert(G_RegistryVerify(false));
+}
+
+/*
+=============
+CheckRemoval
+
+Swap-removal keeps the remaining members' slots valid.
+=============
+*/
+static void CheckRemoval() {
+	ResetEntities();
+
+	gentity_t* a = MakeMonster(10);
+	gentity_t* b = MakeMonster(11);
+	gentity_t* c = MakeMonster(12);
+
+	G_RegistryRemove(a);
+	a->inUse = false;
+
+	const auto members = G_RegistryMembers(EntityRegistry::Monster);
+	assert(members.size() == 2);
+	assert(members[b->registrySlot] == b);
+	assert(members[c->registrySlot] == c);
+	assert(G_RegistryAliveCount(EntityRegistry::Monster) == 2);
+	assert(G_RegistryVerify(false));
+
+	// losing the monster flag moves it out on the next sync
+	c->svFlags = SVF_NONE;
+	G_RegistrySync(c);
+	assert(G_RegistryCount(EntityRegistry::Monster) == 1);
+	assert(G_RegistryVerify(false));
+}
+
+/*
+=============
+CheckVerifyAndRebuild
+
+Changes made behind the registry's back are caught by the cross-check
+and repaired by a rebuild.
+=============
+*/
+static void CheckVerifyAndRebuild() {
+	ResetEntities();
+
+	MakeMonster(10);
+
+	gentity_t* stray = &entities[20];
+	stray->inUse = true;
+	stray->svFlags = SVF_MONSTER;
+	stray->health = 10;
+	assert(!G_RegistryVerify(false));
+
+	G_RegistryRebuild();
+	assert(G_RegistryVerify(false));
+	assert(G_RegistryCount(EntityRegistry::Monster) == 2);
+	assert(G_RegistryAliveCount(EntityRegistry::Monster) == 2);
+
+	std::vector<gentity_t*> snapshot;
+	G_RegistrySnapshot(EntityRegistry::Monster, snapshot);
+	assert(snapshot.size() == 2);
+}
+
+/*
+=============
+main
+=============
+*/
+int main() {
+	CheckClassification();
+	CheckAliveCounts();
+	CheckRemoval();
+	CheckVerifyAndRebuild();
+	return 0;
+}
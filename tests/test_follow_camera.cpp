@@ -0,0 +1,299 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+test_follow_camera.cpp implementation.*/
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+
+#include "server/gameplay/g_spectator.cpp"
+
+constexpr size_t TARGET_COUNT = 2;
+constexpr size_t SPECTATOR_COUNT = 64;
+constexpr size_t CLIENT_COUNT = TARGET_COUNT + SPECTATOR_COUNT;
+constexpr size_t FRAMES = 2000;
+constexpr float CEILING_Z = 80.f;
+
+static std::unique_ptr<gentity_t[]> entities;
+static std::unique_ptr<gclient_t[]> clients;
+static size_t traces;
+
+static cvar_t g_eyecam_storage{};
+cvar_t* g_eyecam = &g_eyecam_storage;
+
+/*
+=============
+ClientIsPlaying
+=============
+*/
+bool ClientIsPlaying(gclient_t* cl) {
+	return cl && cl->sess.team != Team::Spectator;
+}
+
+/*
+=============
+TraceRoom
+
+A room with a floor at zero and a low ceiling, so the camera pads trigger.
+=============
+*/
+static trace_t TraceRoom(gvec3_cref_t start, gvec3_cptr_t, gvec3_cptr_t, gvec3_cref_t end, const gentity_t*, contents_t) {
+	trace_t tr{};
+	tr.fraction = 1.f;
+	tr.endPos = end;
+	traces++;
+
+	const float dz = end[2] - start[2];
+	float fraction = 1.f;
+
+	if (end[2] > CEILING_Z && dz > 0.f)
+		fraction = (CEILING_Z - start[2]) / dz;
+	else if (end[2] < 0.f && dz < 0.f)
+		fraction = -start[2] / dz;
+
+	if (fraction < 1.f) {
+		tr.fraction = fraction;
+		tr.ent = world;
+		for (int a = 0; a < 3; a++)
+			tr.endPos[a] = start[a] + (end[a] - start[a]) * fraction;
+	}
+
+	return tr;
+}
+
+/*
+=============
+IgnoreLink
+=============
+*/
+static void IgnoreLink(gentity_t*) {}
+
+/*
+=============
+LegacyCameraPosition
+
+The chase camera as every spectator used to trace it for itself.
+=============
+*/
+static Vector3 LegacyCameraPosition(const gentity_t* targ) {
+	Vector3 forward, right, angles = targ->client->vAngle;
+	if (angles[PITCH] > 56)
+		angles[PITCH] = 56;
+
+	AngleVectors(angles, forward, right, nullptr);
+	forward.normalize();
+
+	Vector3 eyePos = targ->s.origin;
+	eyePos[2] += targ->viewHeight;
+
+	Vector3 cameraPos = eyePos + (forward * -30.0f);
+	if (cameraPos[2] < targ->s.origin[_Z] + 20.0f)
+		cameraPos[2] = targ->s.origin[_Z] + 20.0f;
+	if (!targ->groundEntity)
+		cameraPos[2] += 16.0f;
+
+	trace_t trace = gi.traceLine(eyePos, cameraPos, targ, MASK_SOLID);
+	cameraPos = trace.endPos + (forward * 2.0f);
+
+	Vector3 ceilingCheck = cameraPos; ceilingCheck[2] += 6.0f;
+	trace = gi.traceLine(cameraPos, ceilingCheck, targ, MASK_SOLID);
+	if (trace.fraction < 1.0f) {
+		cameraPos = trace.endPos;
+		cameraPos[2] -= 6.0f;
+	}
+
+	Vector3 floorCheck = cameraPos; floorCheck[2] -= 6.0f;
+	trace = gi.traceLine(cameraPos, floorCheck, targ, MASK_SOLID);
+	if (trace.fraction < 1.0f) {
+		cameraPos = trace.endPos;
+		cameraPos[2] += 6.0f;
+	}
+
+	return cameraPos;
+}
+
+/*
+=============
+ResetClients
+
+Two duelists, with the spectators split between them.
+=============
+*/
+static void ResetClients() {
+	entities = std::make_unique<gentity_t[]>(CLIENT_COUNT + 1);
+	clients = std::make_unique<gclient_t[]>(CLIENT_COUNT);
+
+	g_entities = entities.get();
+	game.clients = clients.get();
+	game.maxClients = CLIENT_COUNT;
+	game.maxEntities = CLIENT_COUNT + 1;
+	globals.numEntities = CLIENT_COUNT + 1;
+	level.time = 10_sec;
+
+	for (size_t i = 1; i <= CLIENT_COUNT; i++) {
+		gentity_t* ent = &entities[i];
+
+		ent->inUse = true;
+		ent->client = &clients[i - 1];
+		ent->client->pers.connected = true;
+		ent->client->sess.team = i <= TARGET_COUNT ? Team::Free : Team::Spectator;
+	}
+
+	for (size_t i = 1; i <= TARGET_COUNT; i++) {
+		gentity_t* targ = &entities[i];
+
+		targ->s.origin = { static_cast<float>(i) * 512.f, 0.f, 24.f };
+		targ->viewHeight = 22;
+		targ->groundEntity = world;
+	}
+
+	for (size_t i = TARGET_COUNT + 1; i <= CLIENT_COUNT; i++)
+		entities[i].client->follow.target = &entities[1 + i % TARGET_COUNT];
+}
+
+/*
+=============
+MoveTargets
+
+The duelists run, turn, look up and jump from frame to frame.
+=============
+*/
+static void MoveTargets(size_t frame) {
+	level.time += 25_ms;
+
+	for (size_t i = 1; i <= TARGET_COUNT; i++) {
+		gentity_t* targ = &entities[i];
+
+		targ->s.origin[0] += 8.f;
+		targ->client->vAngle = { static_cast<float>((frame * 7 + i * 40) % 120) - 60.f, static_cast<float>((frame * 3) % 360), 0.f };
+		targ->groundEntity = (frame + i) % 5 ? world : nullptr;
+	}
+}
+
+/*
+=============
+CheckChaseCamera
+
+Followers of the same target share one set of camera traces, and land
+where they would have when each traced its own.
+=============
+*/
+static void CheckChaseCamera() {
+	ResetClients();
+	g_eyecam_storage.integer = 0;
+
+	for (size_t frame = 0; frame < 50; frame++) {
+		MoveTargets(frame);
+
+		traces = 0;
+		for (size_t i = 1; i <= TARGET_COUNT; i++)
+			ClientUpdateFollowersOf(&entities[i]);
+		assert(traces == TARGET_COUNT * 3);
+
+		for (size_t i = TARGET_COUNT + 1; i <= CLIENT_COUNT; i++) {
+			const gentity_t* ent = &entities[i];
+			const gentity_t* targ = ent->client->follow.target;
+
+			assert(ent->s.origin == LegacyCameraPosition(targ));
+			assert(ent->client->ps.pmove.pmFlags & PMF_NO_POSITIONAL_PREDICTION);
+			assert(!(targ->svFlags & SVF_INSTANCED));
+		}
+
+		// a target that moves again within the frame gets a fresh camera
+		entities[1].s.origin[1] += 4.f;
+		traces = 0;
+		ClientUpdateFollowersOf(&entities[1]);
+		assert(traces == 3);
+		assert(entities[TARGET_COUNT + 2].s.origin == LegacyCameraPosition(&entities[1]));
+	}
+}
+
+/*
+=============
+CheckEyecam
+
+Eyecam copies the view and traces nothing.
+=============
+*/
+static void CheckEyecam() {
+	ResetClients();
+	g_eyecam_storage.integer = 1;
+
+	MoveTargets(3);
+	entities[1].client->ps.gunIndex = 7;
+
+	traces = 0;
+	ClientUpdateFollowersOf(&entities[1]);
+	assert(traces == 0);
+	assert(entities[1].svFlags & SVF_INSTANCED);
+
+	for (size_t i = TARGET_COUNT + 1; i <= CLIENT_COUNT; i++) {
+		const gentity_t* ent = &entities[i];
+
+		if (ent->client->follow.target != &entities[1])
+			continue;
+		assert(ent->s.origin == entities[1].s.origin);
+		assert(ent->client->ps.gunIndex == 7);
+	}
+}
+
+/*
+=============
+RunBenchmark
+
+64 spectators on 2 duelists: the per-spectator camera traces as before,
+against the frame's updates with shared cameras.
+=============
+*/
+static void RunBenchmark() {
+	using clock = std::chrono::steady_clock;
+
+	ResetClients();
+	g_eyecam_storage.integer = 0;
+
+	traces = 0;
+	auto start = clock::now();
+	for (size_t frame = 0; frame < FRAMES; frame++) {
+		MoveTargets(frame);
+		for (size_t i = TARGET_COUNT + 1; i <= CLIENT_COUNT; i++)
+			entities[i].s.origin = LegacyCameraPosition(entities[i].client->follow.target);
+	}
+	const double legacyMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+	const size_t legacyTraces = traces;
+
+	ResetClients();
+
+	traces = 0;
+	start = clock::now();
+	for (size_t frame = 0; frame < FRAMES; frame++) {
+		MoveTargets(frame);
+		for (size_t i = 1; i <= TARGET_COUNT; i++)
+			ClientUpdateFollowersOf(&entities[i]);
+	}
+	const double sharedMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+	assert(traces * SPECTATOR_COUNT == legacyTraces * TARGET_COUNT);
+
+	std::printf("Chase cameras for %zu spectators on %zu targets over %zu frames:\n", SPECTATOR_COUNT, TARGET_COUNT, FRAMES);
+	std::printf("  camera per spectator  %zu traces  %.3f ms (camera only)\n", legacyTraces, legacyMs);
+	std::printf("  camera per target     %zu traces  %.3f ms (full follower update)\n", traces, sharedMs);
+}
+
+/*
+=============
+main
+=============
+*/
+int main() {
+	game_import_t& base = gi;
+	base.trace = &TraceRoom;
+	base.linkEntity = &IgnoreLink;
+	base.unlinkEntity = &IgnoreLink;
+
+	CheckChaseCamera();
+	CheckEyecam();
+	RunBenchmark();
+	return 0;
+}
@@ -0,0 +1,146 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+test_frame_budget.cpp implementation.*/
+
+#include <cassert>
+
+#include "server/gameplay/g_frame_budget.cpp"
+
+static cvar_t budgetEnabled{};
+static cvar_t budgetMs{};
+
+cvar_t* g_frame_budget = &budgetEnabled;
+cvar_t* g_frame_budget_ms = &budgetMs;
+
+constexpr float OVER_BUDGET = 1e-6f;	// every frame overruns
+constexpr float UNDER_BUDGET = 1e6f;	// no frame comes close
+
+/*
+=============
+StubComPrint
+=============
+*/
+static void StubComPrint(const char* message) {
+	(void)message;
+}
+
+/*
+=============
+RunFrames
+=============
+*/
+static void RunFrames(int32_t count) {
+	for (int32_t i = 0; i < count; i++) {
+		G_FrameBudgetBeginFrame();
+		G_FrameBudgetEndFrame();
+	}
+}
+
+/*
+=============
+CheckHysteresis
+
+A single long frame does not degrade, a run of them does, and recovery
+needs a longer run of quiet frames.
+=============
+*/
+static void CheckHysteresis() {
+	budgetEnabled.integer = 1;
+	budgetMs.value = OVER_BUDGET;
+
+	RunFrames(ENTER_OVERRUNS - 1);
+	assert(!G_FrameBudgetDegraded());
+
+	RunFrames(1);
+	assert(G_FrameBudgetDegraded());
+
+	budgetMs.value = UNDER_BUDGET;
+	RunFrames(LEAVE_UNDERRUNS - 1);
+	assert(G_FrameBudgetDegraded());
+
+	// one overrun restarts the recovery count
+	budgetMs.value = OVER_BUDGET;
+	RunFrames(1);
+	budgetMs.value = UNDER_BUDGET;
+	RunFrames(LEAVE_UNDERRUNS - 1);
+	assert(G_FrameBudgetDegraded());
+
+	RunFrames(1);
+	assert(!G_FrameBudgetDegraded());
+}
+
+/*
+=============
+CheckShedding
+
+Optional work is skipped while degraded; deferrable work runs a few per
+frame, and overdue work always runs.
+=============
+*/
+static void CheckShedding() {
+	budgetEnabled.integer = 1;
+	budgetMs.value = UNDER_BUDGET;
+	G_FrameBudgetBeginFrame();
+	assert(G_FrameBudgetAllow(FrameWork::Heatmap));
+	assert(G_FrameBudgetAllow(FrameWork::MenuRefresh));
+	G_FrameBudgetEndFrame();
+
+	budgetMs.value = OVER_BUDGET;
+	RunFrames(ENTER_OVERRUNS);
+	assert(G_FrameBudgetDegraded());
+
+	budgetMs.value = UNDER_BUDGET;
+	G_FrameBudgetBeginFrame();
+	assert(!G_FrameBudgetAllow(FrameWork::Heatmap));
+	assert(!G_FrameBudgetAllow(FrameWork::BotDebug));
+
+	int32_t allowed = 0;
+	for (int32_t i = 0; i < 8; i++)
+		allowed += G_FrameBudgetAllow(FrameWork::MenuRefresh) ? 1 : 0;
+	assert(allowed == DEFERRED_PER_FRAME);
+
+	assert(G_FrameBudgetAllow(FrameWork::ScoreboardRefresh, MAX_OVERDUE));
+	G_FrameBudgetEndFrame();
+
+	// the next frame has a fresh allowance
+	G_FrameBudgetBeginFrame();
+	assert(G_FrameBudgetAllow(FrameWork::MenuRefresh));
+	G_FrameBudgetEndFrame();
+
+	const frame_work_stats_t& menus = budget.work[static_cast<size_t>(FrameWork::MenuRefresh)];
+	assert(menus.deferred == 6);
+	assert(budget.work[static_cast<size_t>(FrameWork::ScoreboardRefresh)].forced == 1);
+}
+
+/*
+=============
+CheckDisabled
+=============
+*/
+static void CheckDisabled() {
+	budgetEnabled.integer = 0;
+	budgetMs.value = OVER_BUDGET;
+
+	RunFrames(ENTER_OVERRUNS * 2);
+	assert(!G_FrameBudgetDegraded());
+
+	G_FrameBudgetBeginFrame();
+	assert(G_FrameBudgetAllow(FrameWork::Heatmap));
+	G_FrameBudgetEndFrame();
+}
+
+/*
+=============
+main
+=============
+*/
+int main() {
+	gi.Com_Print = &StubComPrint;
+
+	CheckHysteresis();
+	G_FrameBudgetPrint(true);
+	CheckShedding();
+	CheckDisabled();
+	return 0;
+}
@@ -0,0 +1,178 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+test_frame_events.cpp implementation.*/
+
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <random>
+
+#include "server/gameplay/g_events.cpp"
+
+constexpr size_t ENTITY_COUNT = 256;
+constexpr size_t CLIENT_COUNT = 4;
+constexpr size_t FRAME_COUNT = 500;
+
+/*
+=============
+EventWorld
+
+One copy of the entity and client arrays.
+=============
+*/
+struct EventWorld {
+	std::unique_ptr<gentity_t[]> entities = std::make_unique<gentity_t[]>(ENTITY_COUNT);
+	std::unique_ptr<gclient_t[]> clients = std::make_unique<gclient_t[]>(CLIENT_COUNT);
+
+	EventWorld() {
+		// the game allocates and wipes entities with memset, padding included
+		std::memset(static_cast<void*>(entities.get()), 0, sizeof(gentity_t) * ENTITY_COUNT);
+
+		for (size_t i = 0; i < ENTITY_COUNT; i++) {
+			entities[i].s.number = static_cast<int32_t>(i);
+			entities[i].inUse = (i % 3) != 0;
+		}
+
+		for (size_t i = 0; i < CLIENT_COUNT; i++) {
+			gentity_t* ent = &entities[i + 1];
+
+			ent->inUse = true;
+			ent->client = &clients[i];
+			clients[i].pers.connected = true;
+		}
+	}
+};
+
+/*
+=============
+SweepReset
+
+The reset G_PrepFrame used to do: every slot, then every active client.
+=============
+*/
+static void SweepReset(EventWorld& state) {
+	for (size_t i = 0; i < ENTITY_COUNT; i++)
+		state.entities[i].s.event = EV_NONE;
+
+	for (size_t i = 1; i <= CLIENT_COUNT; i++) {
+		gentity_t* ent = &state.entities[i];
+
+		if (ent->inUse && ent->client && ent->client->pers.connected)
+			ent->client->ps.stats[STAT_HIT_MARKER] = 0;
+	}
+}
+
+/*
+=============
+FreeSlot
+
+Mirrors FreeEntity wiping the slot.
+=============
+*/
+static void FreeSlot(gentity_t* ent, size_t slot) {
+	std::memset(static_cast<void*>(ent), 0, sizeof(*ent));
+	ent->s.number = static_cast<int32_t>(slot);
+}
+
+/*
+=============
+CheckIdenticalStreams
+
+Drives both worlds through the same seeded frames and compares the
+network-visible state after each one.
+=============
+*/
+static void CheckIdenticalStreams() {
+	EventWorld reference;
+	EventWorld listed;
+	std::mt19937 rng(1234);
+
+	g_entities = listed.entities.get();
+	globals.numEntities = ENTITY_COUNT;
+	game.maxClients = CLIENT_COUNT;
+	G_EventListClear();
+
+	constexpr entity_event_t events[] = { EV_FOOTSTEP, EV_FALL_SHORT, EV_PLAYER_TELEPORT, EV_OTHER_TELEPORT };
+
+	for (size_t frame = 0; frame < FRAME_COUNT; frame++) {
+		SweepReset(reference);
+		assert(G_EventListVerify());
+		G_ClearEvents();
+
+		const size_t ops = rng() % 24;
+
+		for (size_t op = 0; op < ops; op++) {
+			const size_t slot = rng() % ENTITY_COUNT;
+			const uint32_t kind = rng() % 8;
+			gentity_t* a = &reference.entities[slot];
+			gentity_t* b = &listed.entities[slot];
+
+			if (kind < 4) {
+				const entity_event_t event = events[rng() % 4];
+
+				a->s.event = event;
+				G_SetEvent(b, event);
+			} else if (kind == 4 && slot >= 1 && slot <= CLIENT_COUNT) {
+				const int32_t amount = static_cast<int32_t>(rng() % 50);
+
+				a->client->ps.stats[STAT_HIT_MARKER] += amount;
+				G_AddHitMarker(b, amount);
+			} else if (kind == 5 && slot > CLIENT_COUNT) {
+				FreeSlot(a, slot);
+				FreeSlot(b, slot);
+			} else if (kind == 6) {
+				a->inUse = b->inUse = true;
+			} else {
+				a->s.origin[0] = b->s.origin[0] = static_cast<float>(frame);
+			}
+		}
+
+		for (size_t i = 0; i < ENTITY_COUNT; i++)
+			assert(!memcmp(&reference.entities[i].s, &listed.entities[i].s, sizeof(entity_state_t)));
+
+		for (size_t i = 0; i < CLIENT_COUNT; i++)
+			assert(reference.clients[i].ps.stats[STAT_HIT_MARKER] == listed.clients[i].ps.stats[STAT_HIT_MARKER]);
+	}
+}
+
+/*
+=============
+CheckVerifyAndRebuild
+
+A direct write to s.event is caught, and a rebuild queues it.
+=============
+*/
+static void CheckVerifyAndRebuild() {
+	EventWorld scratch;
+
+	g_entities = scratch.entities.get();
+	globals.numEntities = ENTITY_COUNT;
+	G_EventListClear();
+
+	G_SetEvent(&scratch.entities[10], EV_FOOTSTEP);
+	assert(G_EventListCount() == 1);
+
+	scratch.entities[20].s.event = EV_FOOTSTEP;
+	assert(!G_EventListVerify());
+
+	G_EventListRebuild();
+	assert(G_EventListVerify());
+	assert(G_EventListCount() == 2);
+
+	G_ClearEvents();
+	assert(scratch.entities[10].s.event == EV_NONE);
+	assert(scratch.entities[20].s.event == EV_NONE);
+	assert(G_EventListCount() == 0);
+}
+
+/*
+=============
+main
+=============
+*/
+int main() {
+	CheckIdenticalStreams();
+	CheckVerifyAndRebuild();
+	return 0;
+}
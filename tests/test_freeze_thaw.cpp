@@ -0,0 +1,297 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+test_freeze_thaw.cpp implementation.*/
+
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "server/player/p_freeze_thaw.cpp"
+
+constexpr size_t TEAM_SIZE = 24;
+constexpr size_t CLIENT_COUNT = TEAM_SIZE * 2;
+constexpr size_t FRAMES = 400;
+
+static std::unique_ptr<gentity_t[]> entities;
+static std::unique_ptr<gclient_t[]> clients;
+static std::vector<Vector3> homes;
+static size_t traces;
+
+static cvar_t g_gametype_storage{};
+cvar_t* g_gametype = &g_gametype_storage;
+
+/*
+=============
+FreezeTag_IsActive
+=============
+*/
+bool FreezeTag_IsActive() {
+	return Game::Is(GameType::FreezeTag) && !level.intermission.time;
+}
+
+/*
+=============
+ClientIsPlaying
+=============
+*/
+bool ClientIsPlaying(gclient_t* cl) {
+	return cl && cl->sess.team != Team::Spectator && cl->sess.team != Team::None;
+}
+
+/*
+=============
+Teams
+=============
+*/
+bool Teams() {
+	return true;
+}
+
+/*
+=============
+TraceArena
+
+Open floor split by a wall along x = 0.
+=============
+*/
+static trace_t TraceArena(gvec3_cref_t start, gvec3_cptr_t, gvec3_cptr_t, gvec3_cref_t end, const gentity_t*, contents_t) {
+	trace_t tr{};
+	tr.fraction = 1.f;
+	tr.endPos = end;
+	traces++;
+
+	if ((start[0] < 0.f) != (end[0] < 0.f)) {
+		tr.fraction = start[0] / (start[0] - end[0]);
+		tr.ent = world;
+		for (int a = 0; a < 3; a++)
+			tr.endPos[a] = start[a] + (end[a] - start[a]) * tr.fraction;
+	}
+
+	return tr;
+}
+
+/*
+=============
+LegacyFindFrozenTarget
+
+The target search as it was, visiting every client.
+=============
+*/
+static gentity_t* LegacyFindFrozenTarget(gentity_t* thawer) {
+	constexpr float THAW_RANGE = 96.0f;
+
+	Vector3 forward;
+	AngleVectors(thawer->client->vAngle, forward, nullptr, nullptr);
+
+	Vector3 eyeOrigin = thawer->s.origin + thawer->client->ps.viewOffset +
+		Vector3{ 0, 0, static_cast<float>(thawer->client->ps.pmove.viewHeight) };
+
+	trace_t tr = gi.traceLine(eyeOrigin, eyeOrigin + forward * THAW_RANGE, thawer, MASK_SHOT);
+	if (tr.ent && FreezeTag_CanThawTarget(thawer, tr.ent))
+		return tr.ent;
+
+	gentity_t* best = nullptr;
+	float       bestDot = 0.0f;
+
+	for (gentity_t* candidate : active_clients()) {
+		if (!FreezeTag_CanThawTarget(thawer, candidate))
+			continue;
+
+		Vector3 toTarget = candidate->s.origin - thawer->s.origin;
+		const float distance = toTarget.length();
+		if (distance > THAW_RANGE)
+			continue;
+
+		Vector3 dir = toTarget.normalized();
+		const float dot = dir.dot(forward);
+		if (dot < 0.35f)
+			continue;
+
+		if (gi.traceLine(eyeOrigin, candidate->s.origin, thawer, MASK_SHOT).fraction != 1.0f)
+			continue;
+
+		if (!best || dot > bestDot) {
+			best = candidate;
+			bestDot = dot;
+		}
+	}
+
+	return best;
+}
+
+/*
+=============
+LegacyFindNearbyThawer
+=============
+*/
+static gentity_t* LegacyFindNearbyThawer(gentity_t* frozen) {
+	gentity_t* best = nullptr;
+	float       bestDistance = 0.0f;
+
+	for (gentity_t* candidate : active_clients()) {
+		if (!worr::server::client::FreezeTag_IsValidThawHelper(candidate, frozen))
+			continue;
+
+		const float distance = (frozen->s.origin - candidate->s.origin).length();
+
+		if (!best || distance < bestDistance) {
+			best = candidate;
+			bestDistance = distance;
+		}
+	}
+
+	return best;
+}
+
+/*
+=============
+ResetMatch
+
+Half of each team is frozen in a loose huddle around the wall, with a
+teammate close to most of them.
+=============
+*/
+static void ResetMatch() {
+	entities = std::make_unique<gentity_t[]>(CLIENT_COUNT + 1);
+	clients = std::make_unique<gclient_t[]>(CLIENT_COUNT);
+	homes.assign(CLIENT_COUNT + 1, vec3_origin);
+
+	g_entities = entities.get();
+	game.clients = clients.get();
+	game.maxClients = CLIENT_COUNT;
+	game.maxEntities = CLIENT_COUNT + 1;
+	globals.numEntities = CLIENT_COUNT + 1;
+	level.time = 10_sec;
+	level.intermission.time = 0_ms;
+	g_gametype_storage.integer = static_cast<int>(GameType::FreezeTag);
+
+	thawRoster = {};
+	thawSights = {};
+
+	std::mt19937 rng(47);
+	std::uniform_real_distribution<float> spread(-300.f, 300.f);
+
+	for (size_t i = 1; i <= CLIENT_COUNT; i++) {
+		gentity_t* ent = &entities[i];
+		gclient_t* cl = &clients[i - 1];
+
+		ent->inUse = true;
+		ent->client = cl;
+		cl->pers.connected = true;
+		cl->sess.team = i <= TEAM_SIZE ? Team::Red : Team::Blue;
+		cl->ps.pmove.viewHeight = 22;
+
+		// odd slots are frozen; even ones stand beside the slot before them
+		const size_t teamIndex = (i - 1) % TEAM_SIZE;
+		cl->eliminated = teamIndex % 2 == 0;
+
+		if (cl->eliminated)
+			ent->s.origin = { spread(rng), spread(rng), 24.f };
+		else
+			ent->s.origin = entities[i - 1].s.origin + Vector3{ 30.f, static_cast<float>(teamIndex % 3) * 10.f, 0.f };
+
+		homes[i] = ent->s.origin;
+	}
+
+	for (size_t i = 1; i <= CLIENT_COUNT; i++) {
+		gentity_t* ent = &entities[i];
+		if (ent->client->eliminated)
+			continue;
+
+		const Vector3 delta = entities[i - 1].s.origin - ent->s.origin;
+		ent->client->vAngle = { 0.f, std::atan2(delta[1], delta[0]) * 180.f / PIf, 0.f };
+	}
+}
+
+/*
+=============
+AdvanceFrame
+
+A third of the thawers wander and turn; the rest hold still on
+their frozen teammate.
+=============
+*/
+static void AdvanceFrame(size_t frame) {
+	level.time += 25_ms;
+
+	for (size_t i = 1; i <= CLIENT_COUNT; i++) {
+		gentity_t* ent = &entities[i];
+		if (ent->client->eliminated || i % 3)
+			continue;
+
+		const float phase = static_cast<float>(frame + i) * 0.1f;
+		ent->s.origin = homes[i] + Vector3{ std::cos(phase) * 40.f, std::sin(phase) * 40.f, 0.f };
+		ent->client->vAngle[YAW] += 5.f;
+	}
+}
+
+/*
+=============
+RunMatch
+
+Every frozen player looks for a helper and every thawer holds use,
+each frame.
+=============
+*/
+template <typename Target, typename Helper>
+static std::vector<size_t> RunMatch(Target findTarget, Helper findHelper) {
+	std::vector<size_t> picks;
+	picks.reserve(FRAMES * CLIENT_COUNT);
+
+	ResetMatch();
+
+	for (size_t frame = 0; frame < FRAMES; frame++) {
+		AdvanceFrame(frame);
+
+		for (size_t i = 1; i <= CLIENT_COUNT; i++) {
+			gentity_t* ent = &entities[i];
+			gentity_t* pick = ent->client->eliminated ? findHelper(ent) : findTarget(ent);
+			picks.push_back(pick ? static_cast<size_t>(pick - entities.get()) : 0);
+		}
+	}
+
+	return picks;
+}
+
+/*
+=============
+main
+=============
+*/
+int main() {
+	using clock = std::chrono::steady_clock;
+
+	game_import_t& base = gi;
+	base.trace = &TraceArena;
+
+	traces = 0;
+	auto start = clock::now();
+	const std::vector<size_t> legacy = RunMatch(&LegacyFindFrozenTarget, &LegacyFindNearbyThawer);
+	const double legacyMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+	const size_t legacyTraces = traces;
+
+	traces = 0;
+	start = clock::now();
+	const std::vector<size_t> rostered = RunMatch(&worr::server::client::FreezeTag_FindFrozenTarget, &worr::server::client::FreezeTag_FindNearbyThawer);
+	const double rosterMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+	// the same pick for everyone, every frame
+	assert(legacy == rostered);
+
+	size_t paired = 0;
+	for (size_t pick : rostered)
+		paired += pick != 0;
+	assert(paired > FRAMES * TEAM_SIZE / 2);
+
+	assert(traces < legacyTraces);
+
+	std::printf("Freeze tag %zuv%zu, %zu frames, every thawer holding use:\n", TEAM_SIZE, TEAM_SIZE, FRAMES);
+	std::printf("  every client   %zu traces (%.1f/frame)  %.3f ms\n", legacyTraces, static_cast<double>(legacyTraces) / FRAMES, legacyMs);
+	std::printf("  team roster    %zu traces (%.1f/frame)  %.3f ms\n", traces, static_cast<double>(traces) / FRAMES, rosterMs);
+	return 0;
+}
@@ -0,0 +1,169 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+test_item_index.cpp implementation.*/
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "server/gameplay/g_item_index.cpp"
+
+std::array<Item, IT_TOTAL> itemList{};
+
+static std::vector<std::string> classNames;
+static std::vector<std::string> useNames;
+
+/*
+=============
+FoldedEquals
+
+A stand-in for Q_strcasecmp, which the legacy scans used.
+=============
+*/
+static bool FoldedEquals(const char* a, const char* b) {
+	for (; *a && *b; a++, b++) {
+		if (FoldASCII(*a) != FoldASCII(*b))
+			return false;
+	}
+	return *a == *b;
+}
+
+/*
+=============
+LegacyFindItemByClassname
+=============
+*/
+static Item* LegacyFindItemByClassname(const char* className) {
+	for (auto& item : itemList) {
+		if (item.className && FoldedEquals(item.className, className))
+			return &item;
+	}
+	return nullptr;
+}
+
+/*
+=============
+BuildItemList
+
+Synthetic names for every item, a few real ones, and one duplicate so the
+first-match rule is exercised.
+=============
+*/
+static void BuildItemList() {
+	classNames.resize(IT_TOTAL);
+	useNames.resize(IT_TOTAL);
+
+	for (size_t i = 0; i < itemList.size(); i++) {
+		itemList[i].id = static_cast<item_id_t>(i);
+		if (i == IT_NULL)
+			continue;
+
+		classNames[i] = "item_synthetic_" + std::to_string(i);
+		useNames[i] = "Synthetic " + std::to_string(i);
+		itemList[i].className = classNames[i].c_str();
+		itemList[i].useName = useNames[i].c_str();
+	}
+
+	itemList[IT_WEAPON_RLAUNCHER].className = "weapon_rocketlauncher";
+	itemList[IT_WEAPON_RLAUNCHER].useName = "Rocket Launcher";
+	itemList[IT_WEAPON_RAILGUN].className = "weapon_railgun";
+	itemList[IT_WEAPON_RAILGUN].useName = "Railgun";
+	itemList[IT_AMMO_GRENADES].className = "ammo_grenades";
+	itemList[IT_AMMO_GRENADES].useName = "Grenades";
+
+	// a later item sharing an earlier one's use name loses to it
+	itemList[IT_WEAPON_BFG].useName = "Railgun";
+	itemList[IT_WEAPON_BFG].className = nullptr;
+}
+
+/*
+=============
+CheckLookups
+=============
+*/
+static void CheckLookups() {
+	assert(FindItemByClassname("weapon_rocketlauncher") == &itemList[IT_WEAPON_RLAUNCHER]);
+	assert(FindItemByClassname("WEAPON_RocketLauncher") == &itemList[IT_WEAPON_RLAUNCHER]);
+	assert(FindItemByClassname("weapon_rocketlauncher2") == nullptr);
+	assert(FindItemByClassname("") == nullptr);
+	assert(FindItemByClassname(nullptr) == nullptr);
+
+	assert(FindItem("rocket launcher") == &itemList[IT_WEAPON_RLAUNCHER]);
+	assert(FindItem("Railgun") == &itemList[IT_WEAPON_RAILGUN]);
+	assert(FindItem("Nothing") == nullptr);
+	assert(FindItem(nullptr) == nullptr);
+
+	assert(FindItemByAbbreviation("RL") == &itemList[IT_WEAPON_RLAUNCHER]);
+	assert(FindItemByAbbreviation("rl") == &itemList[IT_WEAPON_RLAUNCHER]);
+	assert(FindItemByAbbreviation("Rg") == &itemList[IT_WEAPON_RAILGUN]);
+	assert(FindItemByAbbreviation("hg") == &itemList[IT_AMMO_GRENADES]);
+	assert(FindItemByAbbreviation("NONE") == nullptr);
+	assert(FindItemByAbbreviation("") == nullptr);
+	assert(FindItemByAbbreviation("RLX") == nullptr);
+
+	for (size_t i = IT_NULL + 1; i < itemList.size(); i++) {
+		const char* className = itemList[i].className;
+		if (!className)
+			continue;
+		assert(FindItemByClassname(className) == LegacyFindItemByClassname(className));
+	}
+}
+
+/*
+=============
+RunBenchmark
+
+Looks up every class name a map might spawn, as the linear scan did and
+through the index.
+=============
+*/
+static void RunBenchmark() {
+	using clock = std::chrono::steady_clock;
+	constexpr size_t ROUNDS = 200;
+
+	std::vector<const char*> queries;
+	for (size_t i = IT_NULL + 1; i < itemList.size(); i++) {
+		if (itemList[i].className)
+			queries.push_back(itemList[i].className);
+	}
+	queries.push_back("info_player_start");
+	queries.push_back("func_door");
+
+	size_t found = 0;
+	auto start = clock::now();
+	for (size_t round = 0; round < ROUNDS; round++) {
+		for (const char* query : queries)
+			found += LegacyFindItemByClassname(query) != nullptr;
+	}
+	const double legacyMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+	size_t indexed = 0;
+	start = clock::now();
+	for (size_t round = 0; round < ROUNDS; round++) {
+		for (const char* query : queries)
+			indexed += FindItemByClassname(query) != nullptr;
+	}
+	const double indexMs = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+	assert(found == indexed);
+
+	std::printf("Class name lookups: %zu queries x %zu rounds over %zu items\n", queries.size(), ROUNDS, itemList.size());
+	std::printf("  linear scan  %.3f ms\n", legacyMs);
+	std::printf("  index        %.3f ms\n", indexMs);
+}
+
+/*
+=============
+main
+=============
+*/
+int main() {
+	BuildItemList();
+	CheckLookups();
+	RunBenchmark();
+	return 0;
+}
@@ -0,0 +1,181 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+test_job_system.cpp implementation.*/
+
+#include "server/gameplay/g_jobs.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <numeric>
+#include <vector>
+
+/*
+=============
+RecordCommands
+
+Runs a deferred parallel pass that records each index through the
+command buffers and returns the replay order.
+=============
+*/
+static std::vector<size_t> RecordCommands(JobSystem& jobs, size_t count, size_t grain) {
+	std::vector<size_t> replay;
+
+	jobs.ParallelForDeferred(count, grain, [&replay](size_t begin, size_t end, JobCommandBuffer& commands) {
+		for (size_t i = begin; i < end; i++)
+			commands.Defer([&replay, i]() { replay.push_back(i); });
+	});
+
+	return replay;
+}
+
+/*
+=============
+CheckParallelFor
+
+Every index is visited exactly once and ranges are reported with the
+expected bounds.
+=============
+*/
+static void CheckParallelFor(JobSystem& jobs) {
+	constexpr size_t count = 10007;
+	std::vector<std::atomic<int>> visits(count);
+
+	jobs.ParallelFor(count, 64, [&visits](size_t begin, size_t end, size_t index) {
+		assert(begin == index * 64);
+		assert(end == (begin + 64 < count ? begin + 64 : count));
+		for (size_t i = begin; i < end; i++)
+			visits[i].fetch_add(1, std::memory_order_relaxed);
+	});
+
+	for (auto& visit : visits)
+		assert(visit.load() == 1);
+
+	// nested passes from inside a task must not deadlock
+	std::atomic<size_t> nested{ 0 };
+	jobs.ParallelFor(8, 1, [&jobs, &nested](size_t, size_t, size_t) {
+		jobs.ParallelFor(100, 10, [&nested](size_t begin, size_t end, size_t) {
+			nested.fetch_add(end - begin, std::memory_order_relaxed);
+		});
+	});
+	assert(nested.load() == 800);
+
+	// command buffers replay in index order regardless of scheduling
+	std::vector<size_t> expected(1000);
+	std::iota(expected.begin(), expected.end(), size_t{ 0 });
+	assert(RecordCommands(jobs, 1000, 7) == expected);
+}
+
+/*
+=============
+CheckGraph
+
+Dependencies are honoured, command buffers flush in task id order and
+cycles are rejected.
+=============
+*/
+static void CheckGraph(JobSystem& jobs) {
+	JobGraph graph;
+	std::atomic<int> stage{ 0 };
+	std::vector<int> flushed;
+
+	const auto a = graph.Add([&](JobCommandBuffer& commands) {
+		assert(stage.load() == 0);
+		stage.store(1);
+		commands.Defer([&flushed]() { flushed.push_back(0); });
+	});
+	const auto b = graph.Add([&](JobCommandBuffer& commands) {
+		assert(stage.load() >= 1);
+		commands.Defer([&flushed]() { flushed.push_back(1); });
+	});
+	const auto c = graph.Add([&](JobCommandBuffer& commands) {
+		assert(stage.load() >= 1);
+		commands.Defer([&flushed]() { flushed.push_back(2); });
+	});
+	const auto d = graph.Add([&](JobCommandBuffer& commands) {
+		stage.store(2);
+		commands.Defer([&flushed]() { flushed.push_back(3); });
+	});
+
+	graph.Precede(a, b);
+	graph.Precede(a, c);
+	graph.Precede(b, d);
+	graph.Precede(c, d);
+
+	assert(jobs.Run(graph));
+	assert(stage.load() == 2);
+	assert((flushed == std::vector<int>{ 0, 1, 2, 3 }));
+
+	JobGraph cyclic;
+	bool ran = false;
+	const auto x = cyclic.Add([&ran](JobCommandBuffer&) { ran = true; });
+	const auto y = cyclic.Add([&ran](JobCommandBuffer&) { ran = true; });
+	cyclic.Precede(x, y);
+	cyclic.Precede(y, x);
+	assert(!jobs.Run(cyclic));
+	assert(!ran);
+}
+
+/*
+=============
+CheckDeterministicOrder
+
+Deterministic mode runs ranges and graph tasks inline in index order
+even when workers are available.
+=============
+*/
+static void CheckDeterministicOrder(JobSystem& jobs) {
+	jobs.SetDeterministic(true);
+	assert(jobs.RunsInline());
+
+	std::vector<size_t> order;
+	jobs.ParallelFor(50, 5, [&order](size_t begin, size_t, size_t index) {
+		assert(begin == index * 5);
+		order.push_back(index);
+	});
+
+	std::vector<size_t> expected(10);
+	std::iota(expected.begin(), expected.end(), size_t{ 0 });
+	assert(order == expected);
+
+	JobGraph graph;
+	std::vector<int> ran;
+	const auto late = graph.Add([&ran](JobCommandBuffer&) { ran.push_back(0); });
+	const auto first = graph.Add([&ran](JobCommandBuffer&) { ran.push_back(1); });
+	graph.Add([&ran](JobCommandBuffer&) { ran.push_back(2); });
+	graph.Precede(first, late);
+	assert(jobs.Run(graph));
+	assert((ran == std::vector<int>{ 1, 0, 2 }));
+
+	jobs.SetDeterministic(false);
+}
+
+/*
+=============
+main
+=============
+*/
+int main() {
+	for (size_t workers : { 0u, 1u, 3u }) {
+		JobSystem jobs;
+		jobs.Start(workers);
+		assert(jobs.WorkerCount() == workers);
+		assert(jobs.RunsInline() == (workers == 0));
+
+		CheckParallelFor(jobs);
+		CheckGraph(jobs);
+		CheckDeterministicOrder(jobs);
+
+		jobs.Stop();
+		assert(jobs.WorkerCount() == 0);
+	}
+
+	// restarting an existing pool with a different size
+	JobSystem jobs;
+	jobs.Start(2);
+	jobs.Start(4);
+	assert(jobs.WorkerCount() == 4);
+	CheckParallelFor(jobs);
+
+	return 0;
+}
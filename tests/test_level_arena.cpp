@@ -0,0 +1,229 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+test_level_arena.cpp implementation.*/
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "server/gameplay/g_level_arena.cpp"
+#include "server/gameplay/g_string_arena.cpp"
+
+constexpr size_t MAP_ENTITIES = 8192;
+constexpr size_t MAP_ROTATION = 6;
+
+static std::vector<void*> levelBlocks;
+static size_t levelBlockBytes;
+
+/*
+=============
+PrintToStdout
+=============
+*/
+static void PrintToStdout(const char* message) {
+	std::fputs(message, stdout);
+}
+
+/*
+=============
+TestTagMalloc
+
+Tracks TAG_LEVEL blocks so the test can stand in for FreeTags.
+=============
+*/
+static void* TestTagMalloc(size_t size, int tag) {
+	void* block = std::malloc(size);
+	if (tag == TAG_LEVEL) {
+		levelBlocks.push_back(block);
+		levelBlockBytes += size;
+	}
+	return block;
+}
+
+/*
+=============
+FreeLevel
+
+What SpawnEntities does between maps.
+=============
+*/
+static void FreeLevel() {
+	for (void* block : levelBlocks)
+		std::free(block);
+	levelBlocks.clear();
+	levelBlockBytes = 0;
+	G_LevelArenaReset();
+}
+
+/*
+=============
+LiveBytes
+=============
+*/
+static size_t LiveBytes(LevelMem owner) {
+	return arena.owners[static_cast<size_t>(owner)].liveBytes;
+}
+
+/*
+=============
+CheckAllocation
+
+Blocks are aligned, zeroed, packed into shared chunks, and charged to
+their owner; large blocks stand alone.
+=============
+*/
+static void CheckAllocation() {
+	auto* spawn = static_cast<saved_spawn_t*>(G_LevelAlloc(sizeof(saved_spawn_t), LevelMem::SpawnState, alignof(saved_spawn_t)));
+	assert(reinterpret_cast<uintptr_t>(spawn) % alignof(saved_spawn_t) == 0);
+	assert(!spawn->target && !spawn->spawnFunc);
+
+	auto* counts = static_cast<uint32_t*>(G_LevelAlloc(sizeof(uint32_t) * 3, LevelMem::Reinforcements));
+	assert(reinterpret_cast<uintptr_t>(counts) % alignof(std::max_align_t) == 0);
+	assert(!counts[0] && !counts[1] && !counts[2]);
+
+	char* odd = static_cast<char*>(G_LevelAlloc(3, LevelMem::Strings, 1));
+	auto* paths = static_cast<Vector3*>(G_LevelAlloc(sizeof(Vector3) * 4, LevelMem::PoiPaths, alignof(Vector3)));
+	assert(reinterpret_cast<uintptr_t>(paths) % alignof(Vector3) == 0);
+	assert(reinterpret_cast<char*>(paths) > odd);
+	assert(levelBlocks.size() == 1);
+
+	G_LevelAlloc(LEVEL_CHUNK_SIZE, LevelMem::PoiPaths);
+	assert(levelBlocks.size() == 2);
+
+	// the open chunk is still used after a large block
+	char* next = static_cast<char*>(G_LevelAlloc(8, LevelMem::Strings, 1));
+	assert(next >= arena.chunk && next < arena.chunk + arena.chunkSize);
+
+	assert(LiveBytes(LevelMem::SpawnState) == sizeof(saved_spawn_t));
+	assert(LiveBytes(LevelMem::Reinforcements) == sizeof(uint32_t) * 3);
+	assert(LiveBytes(LevelMem::PoiPaths) == sizeof(Vector3) * 4 + LEVEL_CHUNK_SIZE);
+	assert(arena.reservedBytes == levelBlockBytes);
+
+	FreeLevel();
+	assert(!arena.chunk && !arena.reservedBytes && !arena.usedBytes);
+	assert(!LiveBytes(LevelMem::PoiPaths));
+	assert(arena.owners[static_cast<size_t>(LevelMem::PoiPaths)].peakBytes == sizeof(Vector3) * 4 + LEVEL_CHUNK_SIZE);
+}
+
+/*
+=============
+CheckContainers
+
+Container storage is charged and credited as it comes and goes, and is not
+forgotten by a level reset since it lives on the heap.
+=============
+*/
+static void CheckContainers() {
+	const size_t before = LiveBytes(LevelMem::SpawnLists);
+
+	{
+		LevelVector<gentity_t*, LevelMem::SpawnLists> spots;
+		spots.reserve(64);
+		assert(LiveBytes(LevelMem::SpawnLists) == before + 64 * sizeof(gentity_t*));
+
+		FreeLevel();
+		assert(LiveBytes(LevelMem::SpawnLists) == before + 64 * sizeof(gentity_t*));
+
+		spots.push_back(nullptr);
+		spots.shrink_to_fit();
+		assert(LiveBytes(LevelMem::SpawnLists) == before + sizeof(gentity_t*));
+	}
+
+	assert(LiveBytes(LevelMem::SpawnLists) == before);
+}
+
+/*
+=============
+EntityKey
+
+The kind of key a large map repeats: a few hundred distinct values.
+=============
+*/
+static std::string EntityKey(const char* prefix, size_t i) {
+	return std::string(prefix) + std::to_string(i % 384);
+}
+
+/*
+=============
+RunBenchmark
+
+Loads a rotation of large maps both ways: a TagMalloc block per entity
+string and spawn record, and the level arena with interning.
+=============
+*/
+static void RunBenchmark() {
+	using clock = std::chrono::steady_clock;
+	static const char* const keys[] = { "target_", "targetname_", "team_", "*model_", "message_", "killtarget_" };
+
+	std::vector<std::string> text;
+	for (size_t i = 0; i < MAP_ENTITIES; i++) {
+		for (const char* key : keys)
+			text.push_back(EntityKey(key, i));
+	}
+
+	size_t mallocBytes = 0;
+	size_t mallocBlocks = 0;
+	double mallocMs = 0.0;
+	for (size_t map = 0; map < MAP_ROTATION; map++) {
+		const auto start = clock::now();
+		for (size_t i = 0; i < MAP_ENTITIES; i++) {
+			TestTagMalloc(sizeof(saved_spawn_t), TAG_LEVEL);
+			for (size_t k = 0; k < std::size(keys); k++) {
+				const std::string& s = text[i * std::size(keys) + k];
+				std::memcpy(TestTagMalloc(s.length() + 1, TAG_LEVEL), s.c_str(), s.length() + 1);
+			}
+		}
+		mallocBytes = levelBlockBytes;
+		mallocBlocks = levelBlocks.size();
+		FreeLevel();
+		mallocMs += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+	}
+
+	size_t arenaBytes = 0;
+	size_t arenaBlocks = 0;
+	double arenaMs = 0.0;
+	for (size_t map = 0; map < MAP_ROTATION; map++) {
+		const auto start = clock::now();
+		for (size_t i = 0; i < MAP_ENTITIES; i++) {
+			G_LevelAlloc(sizeof(saved_spawn_t), LevelMem::SpawnState, alignof(saved_spawn_t));
+			for (size_t k = 0; k < std::size(keys); k++)
+				G_InternString(text[i * std::size(keys) + k]);
+		}
+		arenaBytes = levelBlockBytes;
+		arenaBlocks = levelBlocks.size();
+		FreeLevel();
+		arenaMs += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+	}
+
+	std::printf("Level load over %zu maps, %zu entities:\n", MAP_ROTATION, MAP_ENTITIES);
+	std::printf("  TagMalloc per block  %.3f ms/map  %zu bytes in %zu blocks\n", mallocMs / MAP_ROTATION, mallocBytes, mallocBlocks);
+	std::printf("  level arena          %.3f ms/map  %zu bytes in %zu blocks\n", arenaMs / MAP_ROTATION, arenaBytes, arenaBlocks);
+}
+
+/*
+=============
+main
+=============
+*/
+int main() {
+	gi.Com_Print = &PrintToStdout;
+	gi.TagMalloc = &TestTagMalloc;
+
+	CheckAllocation();
+	CheckContainers();
+
+	G_LevelArenaMapLoaded("q2dm1", 12.5);
+	G_LevelArenaMapLoaded("mgu3m4", 40.0);
+	assert(arena.mapLoads == 2);
+	assert(!std::strcmp(arena.maps[1].mapName.data(), "mgu3m4"));
+	G_LevelArenaPrint();
+
+	RunBenchmark();
+	return 0;
+}
@@ -0,0 +1,454 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+test_pellet_batch.cpp implementation.*/
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "server/gameplay/g_combat.cpp"
+#include "server/gameplay/g_weapon_lead.cpp"
+
+constexpr size_t ENTITY_COUNT = 64;
+constexpr float WALL_X = 1024.f;
+constexpr int PELLET_DAMAGE = 4;
+constexpr int PELLET_KICK = 8;
+constexpr int PELLET_COUNT = 20;
+
+static std::unique_ptr<gentity_t[]> entities;
+
+static size_t multicasts;
+static size_t painCalls;
+static std::vector<Vector3> effectPositions;
+static size_t effectsBeforeFree;
+
+static cvar_t ai_damage_scale_storage{};
+cvar_t* ai_damage_scale = &ai_damage_scale_storage;
+static cvar_t deathmatch_storage{};
+cvar_t* deathmatch = &deathmatch_storage;
+static cvar_t g_arenaSelfDmgArmor_storage{};
+cvar_t* g_arenaSelfDmgArmor = &g_arenaSelfDmgArmor_storage;
+static cvar_t g_damage_scale_storage{};
+cvar_t* g_damage_scale = &g_damage_scale_storage;
+static cvar_t g_friendlyFireScale_storage{};
+cvar_t* g_friendlyFireScale = &g_friendlyFireScale_storage;
+static cvar_t g_instaGib_storage{};
+cvar_t* g_instaGib = &g_instaGib_storage;
+static cvar_t g_knockbackScale_storage{};
+cvar_t* g_knockbackScale = &g_knockbackScale_storage;
+static cvar_t g_quadhog_storage{};
+cvar_t* g_quadhog = &g_quadhog_storage;
+static cvar_t g_selfDamage_storage{};
+cvar_t* g_selfDamage = &g_selfDamage_storage;
+static cvar_t g_teamplay_armor_protect_storage{};
+cvar_t* g_teamplay_armor_protect = &g_teamplay_armor_protect_storage;
+static cvar_t g_vampiric_damage_storage{};
+cvar_t* g_vampiric_damage = &g_vampiric_damage_storage;
+static cvar_t g_vampiric_health_max_storage{};
+cvar_t* g_vampiric_health_max = &g_vampiric_health_max_storage;
+static cvar_t g_vampiric_percentile_storage{};
+cvar_t* g_vampiric_percentile = &g_vampiric_percentile_storage;
+static cvar_t skill_storage{};
+cvar_t* skill = &skill_storage;
+
+/*
+=============
+Stubs
+
+The parts of the game g_combat.cpp reaches into that these shots do not
+exercise.
+=============
+*/
+MatchStatsColumns matchStatsColumns{};
+item_id_t ArmorIndex(gentity_t*) { return IT_NULL; }
+item_id_t PowerArmorType(gentity_t*) { return IT_NULL; }
+void CheckPowerArmorState(gentity_t*) {}
+bool CombatIsDisabled() { return false; }
+bool CooperativeModeOn() { return false; }
+gentity_t* FindRadius(gentity_t*, const Vector3&, float) { return nullptr; }
+void FoundTarget(gentity_t*) {}
+void FreezeTag_ForceRespawn(gentity_t*) {}
+void G_AddHitMarker(gentity_t*, int32_t) {}
+void G_AdjustPlayerScore(gclient_t*, int32_t, bool, int32_t) {}
+void G_PlayerNoise(gentity_t*, const Vector3&, PlayerNoise) {}
+bool G_ShouldPlayersCollide(bool) { return true; }
+Item* GetItemByIndex(item_id_t) { return nullptr; }
+void HM_AddEvent(const Vector3&, float) {}
+bool LogAccuracyHit(gentity_t*, gentity_t*) { return false; }
+void M_CleanupHealTarget(gentity_t*) {}
+void M_PromoteLOD(gentity_t*) {}
+bool MarkTeslaArea(gentity_t*, gentity_t*) { return false; }
+void TargetTesla(gentity_t*, gentity_t*) {}
+bool Teams() { return false; }
+const char* Teams_TeamName(Team) { return ""; }
+int Tech_ApplyDisruptorShield(gentity_t*, int dmg) { return dmg; }
+float realrange(gentity_t*, gentity_t*) { return 0.f; }
+bool visible(gentity_t*, gentity_t*, bool) { return true; }
+const save_data_list_t* save_data_list_t::fetch(const void*, save_data_tag_t) { return nullptr; }
+
+/*
+=============
+Import stubs
+=============
+*/
+static void IgnoreByte(int) {}
+static void IgnoreVector(gvec3_cref_t) {}
+static void CountMulticast(gvec3_cref_t, multicast_t, bool) { multicasts++; }
+static void IgnoreLink(gentity_t*) {}
+static contents_t NoContents(gvec3_cref_t) { return CONTENTS_NONE; }
+static void PrintToStdout(const char* message) { std::fputs(message, stdout); }
+
+/*
+=============
+TraceBoxes
+
+A world that is a wall at WALL_X, with every solid entity an axial box.
+=============
+*/
+static trace_t TraceBoxes(gvec3_cref_t start, gvec3_cptr_t, gvec3_cptr_t, gvec3_cref_t end, const gentity_t* passent, contents_t mask) {
+	trace_t tr{};
+	tr.fraction = 1.f;
+	tr.endPos = end;
+
+	const float delta[3] = { end[0] - start[0], end[1] - start[1], end[2] - start[2] };
+
+	if (end[0] > WALL_X && delta[0] > 0.f) {
+		tr.fraction = (WALL_X - start[0]) / delta[0];
+		tr.ent = world;
+		tr.contents = CONTENTS_SOLID;
+		tr.plane.normal = { -1.f, 0.f, 0.f };
+	}
+
+	if (!(mask & (CONTENTS_MONSTER | CONTENTS_SOLID)))
+		return tr;
+
+	for (size_t i = 1; i < ENTITY_COUNT; i++) {
+		gentity_t* ent = &entities[i];
+
+		if (!ent->inUse || ent == passent || ent->solid == SOLID_NOT)
+			continue;
+
+		float enter = 0.f, leave = 1.f;
+		int axis = -1;
+		bool miss = false;
+
+		for (int a = 0; a < 3 && !miss; a++) {
+			const float lo = ent->s.origin[a] + ent->mins[a];
+			const float hi = ent->s.origin[a] + ent->maxs[a];
+
+			if (delta[a] == 0.f) {
+				miss = start[a] < lo || start[a] > hi;
+				continue;
+			}
+
+			float t0 = (lo - start[a]) / delta[a];
+			float t1 = (hi - start[a]) / delta[a];
+			if (t0 > t1)
+				std::swap(t0, t1);
+			if (t0 > enter) {
+				enter = t0;
+				axis = a;
+			}
+			leave = std::min(leave, t1);
+			miss = enter > leave;
+		}
+
+		if (miss || axis < 0 || enter >= tr.fraction)
+			continue;
+
+		tr.fraction = enter;
+		tr.ent = ent;
+		tr.contents = CONTENTS_MONSTER;
+		tr.plane.normal = {};
+		tr.plane.normal[axis] = delta[axis] > 0.f ? -1.f : 1.f;
+	}
+
+	for (int a = 0; a < 3; a++)
+		tr.endPos[a] = start[a] + delta[a] * tr.fraction;
+	return tr;
+}
+
+struct target_spec_t {
+	float	x, y;
+	int		health;
+	bool	monster;
+};
+
+struct target_state_t {
+	int		health;
+	Vector3	velocity;
+	int		blood;
+	int		knockback;
+};
+
+/*
+=============
+CountPain
+=============
+*/
+static void CountPain(gentity_t*, gentity_t*, float, int, const MeansOfDeath&) {
+	painCalls++;
+}
+
+/*
+=============
+MarkDead
+=============
+*/
+static void MarkDead(gentity_t* self, gentity_t*, gentity_t*, int, const Vector3&, const MeansOfDeath&) {
+	self->takeDamage = false;
+}
+
+/*
+=============
+FreeOnDeath
+
+What FreeEntity does to the slot of a target that is removed as it dies.
+=============
+*/
+static void FreeOnDeath(gentity_t* self, gentity_t*, gentity_t*, int, const Vector3&, const MeansOfDeath&) {
+	effectsBeforeFree = effectPositions.size();
+	std::memset(static_cast<void*>(self), 0, sizeof(*self));
+}
+
+/*
+=============
+RecordPosition
+=============
+*/
+static void RecordPosition(gvec3_cref_t position) {
+	effectPositions.push_back(position);
+}
+
+/*
+=============
+ResetWorld
+
+A shooter at the origin facing down +X at the given targets. It is not a
+monster, so the targets do not react to it: monster reactions draw random
+numbers, which would move the later pellets of a per-pellet shot.
+=============
+*/
+static gentity_t* ResetWorld(const std::vector<target_spec_t>& targets) {
+	entities = std::make_unique<gentity_t[]>(ENTITY_COUNT);
+
+	g_entities = entities.get();
+	game.maxEntities = ENTITY_COUNT;
+	game.maxClients = 1;
+	globals.numEntities = ENTITY_COUNT;
+	level.time = 10_sec;
+
+	world->inUse = true;
+
+	gentity_t* shooter = &entities[2];
+	shooter->inUse = true;
+	shooter->className = "turret_breach";
+	shooter->solid = SOLID_BBOX;
+	shooter->mins = { -16.f, -16.f, -24.f };
+	shooter->maxs = { 16.f, 16.f, 32.f };
+
+	for (size_t i = 0; i < targets.size(); i++) {
+		gentity_t* ent = &entities[3 + i];
+		const target_spec_t& spec = targets[i];
+
+		ent->inUse = true;
+		ent->className = spec.monster ? "monster_gunner" : "misc_explobox";
+		ent->svFlags = spec.monster ? SVF_MONSTER : SVF_NONE;
+		ent->solid = SOLID_BBOX;
+		ent->takeDamage = true;
+		ent->health = spec.health;
+		ent->gibHealth = -40;
+		ent->mass = 200;
+		ent->moveType = MoveType::Step;
+		ent->s.origin = { spec.x, spec.y, 0.f };
+		ent->mins = { -16.f, -16.f, -24.f };
+		ent->maxs = { 16.f, 16.f, 32.f };
+		ent->pain = CountPain;
+		ent->die = MarkDead;
+	}
+
+	return shooter;
+}
+
+/*
+=============
+Snapshot
+=============
+*/
+static std::vector<target_state_t> Snapshot(size_t count) {
+	std::vector<target_state_t> states;
+
+	for (size_t i = 0; i < count; i++) {
+		const gentity_t* ent = &entities[3 + i];
+		states.push_back({ ent->health, ent->velocity, ent->monsterInfo.damage.blood, ent->monsterInfo.damage.knockback });
+	}
+
+	return states;
+}
+
+/*
+=============
+FireShots
+
+Fires a volley of shots, one pellet at a time as fire_shotgun used to or
+batched, and returns what became of the targets.
+=============
+*/
+static std::vector<target_state_t> FireShots(const std::vector<target_spec_t>& targets, bool batched, int shots, double& ms) {
+	gentity_t* shooter = ResetWorld(targets);
+	const Vector3 start = { 16.f, 0.f, 0.f };
+	const Vector3 aim = { 1.f, 0.f, 0.f };
+	const MeansOfDeath mod{ ModID::Shotgun };
+
+	mt_rand.seed(4242);
+	multicasts = painCalls = 0;
+
+	const auto begin = std::chrono::steady_clock::now();
+	for (int shot = 0; shot < shots; shot++) {
+		if (batched) {
+			fire_shotgun(shooter, start, aim, PELLET_DAMAGE, PELLET_KICK, 1000, 500, PELLET_COUNT, mod);
+			continue;
+		}
+
+		for (int i = 0; i < PELLET_COUNT; i++)
+			fire_lead(shooter, start, aim, PELLET_DAMAGE, PELLET_KICK, TE_SHOTGUN, 1000, 500, mod);
+	}
+	ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+	return Snapshot(targets.size());
+}
+
+/*
+=============
+Compare
+
+Both ways of firing must leave every target with the same health and
+damage totals, and the same push, while sending fewer effects and
+fewer pain calls.
+=============
+*/
+static void Compare(const char* name, const std::vector<target_spec_t>& targets, int shots) {
+	double legacyMs = 0.0, batchedMs = 0.0;
+
+	const std::vector<target_state_t> legacy = FireShots(targets, false, shots, legacyMs);
+	const size_t legacyMulticasts = multicasts, legacyPain = painCalls;
+
+	const std::vector<target_state_t> batched = FireShots(targets, true, shots, batchedMs);
+
+	int batchedBlood = 0;
+	for (size_t i = 0; i < targets.size(); i++) {
+		batchedBlood += batched[i].blood;
+
+		assert(legacy[i].health == batched[i].health);
+		assert(legacy[i].blood == batched[i].blood);
+		assert(legacy[i].knockback == batched[i].knockback);
+		assert((legacy[i].velocity - batched[i].velocity).length() < 0.01f);
+	}
+	assert(multicasts <= legacyMulticasts);
+	assert(painCalls <= legacyPain);
+
+	std::printf("%s (%d shots): %d damage dealt\n", name, shots, batchedBlood);
+	for (size_t i = 0; i < targets.size(); i++)
+		std::printf("  target %zu health %d -> %d\n", i, targets[i].health, batched[i].health);
+	std::printf("  per pellet  %.3f ms  %zu multicasts  %zu pain calls\n", legacyMs, legacyMulticasts, legacyPain);
+	std::printf("  batched     %.3f ms  %zu multicasts  %zu pain calls\n", batchedMs, multicasts, painCalls);
+}
+
+/*
+=============
+CheckCrushed
+
+Crushers and the like hit a target at its own origin, by reference. A
+single hit sends its effects before the target dies, as Damage always
+has; several hits send theirs after, and must still use the origin the
+target had when it was hit.
+=============
+*/
+static void CheckCrushed(int hits) {
+	ResetWorld({ { 200.f, 0.f, 10, false } });
+
+	gentity_t* targ = &entities[3];
+	const Vector3 origin = targ->s.origin;
+	targ->die = FreeOnDeath;
+
+	effectPositions.clear();
+	effectsBeforeFree = 0;
+	multicasts = 0;
+
+	if (hits == 1)
+		Damage(targ, world, world, { 1.f, 0.f, 0.f }, targ->s.origin, vec3_origin, 100, 0, DamageFlags::Normal, ModID::Crushed);
+	else
+		DamageHits(targ, world, world, { 1.f, 0.f, 0.f }, targ->s.origin, vec3_origin, 100, 0, hits, DamageFlags::Normal, ModID::Crushed);
+
+	assert(!targ->inUse);
+	assert(!effectPositions.empty());
+	for (const Vector3& position : effectPositions)
+		assert(position == origin);
+
+	if (hits == 1)
+		assert(effectsBeforeFree == effectPositions.size());
+}
+
+/*
+=============
+main
+=============
+*/
+int main() {
+	game_import_t& base = gi;
+	base.linkEntity = &IgnoreLink;
+	base.unlinkEntity = &IgnoreLink;
+	base.trace = &TraceBoxes;
+	base.pointContents = &NoContents;
+	base.WriteByte = &IgnoreByte;
+	base.WritePosition = &IgnoreVector;
+	base.WriteDir = &IgnoreVector;
+	base.multicast = &CountMulticast;
+	gi.Com_Print = &PrintToStdout;
+
+	ai_damage_scale_storage.value = 1.f;
+	g_damage_scale_storage.value = 1.f;
+	g_knockbackScale_storage.value = 1.f;
+	g_friendlyFireScale_storage.value = 1.f;
+	skill_storage.integer = 1;
+	deathmatch_storage.integer = 1;
+
+	// everyone survives; some pellets miss and mark the wall
+	Compare("surviving targets", {
+		{ 200.f, 0.f, 10000, true },
+		{ 300.f, 28.f, 10000, true },
+		{ 260.f, -28.f, 10000, false },
+	}, 1);
+
+	// the front monster dies part way through the shot and the rest of its
+	// pellets carry on into the one behind it
+	Compare("killed mid-shot", {
+		{ 200.f, 0.f, 30, true },
+		{ 400.f, 0.f, 10000, true },
+	}, 1);
+
+	// a barrel that stops being shootable when it dies
+	Compare("barrel", {
+		{ 200.f, 0.f, 30, false },
+		{ 400.f, 0.f, 10000, true },
+	}, 1);
+
+	// sustained fire into a crowd
+	Compare("crowd", {
+		{ 150.f, 0.f, 400, true },
+		{ 200.f, 24.f, 400, true },
+		{ 200.f, -24.f, 400, true },
+		{ 300.f, 0.f, 10000, true },
+		{ 350.f, 48.f, 10000, false },
+	}, 200);
+
+	base.WritePosition = &RecordPosition;
+	CheckCrushed(1);
+	CheckCrushed(3);
+
+	return 0;
+}
@@ -0,0 +1,125 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+test_string_arena.cpp implementation.*/
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "server/gameplay/g_level_arena.cpp"
+#include "server/gameplay/g_string_arena.cpp"
+
+static std::vector<void*> levelBlocks;
+
+/*
+=============
+StubComPrint
+=============
+*/
+static void StubComPrint(const char* message) {
+	(void)message;
+}
+
+/*
+=============
+TestTagMalloc
+
+Tracks TAG_LEVEL blocks so the test can stand in for FreeTags.
+=============
+*/
+static void* TestTagMalloc(size_t size, int tag) {
+	void* block = std::malloc(size);
+	if (tag == TAG_LEVEL)
+		levelBlocks.push_back(block);
+	return block;
+}
+
+/*
+=============
+FreeLevel
+
+What SpawnEntities does between maps.
+=============
+*/
+static void FreeLevel() {
+	for (void* block : levelBlocks)
+		std::free(block);
+	levelBlocks.clear();
+	G_LevelArenaReset();
+}
+
+/*
+=============
+CheckInterning
+
+Equal text yields the same pointer regardless of where the caller's copy
+lives; different text does not.
+=============
+*/
+static void CheckInterning() {
+	std::string target = "door1";
+	const char* a = G_InternString(target);
+	target[4] = '2';
+	const char* b = G_InternString(target);
+	const char* c = G_InternString("door1");
+
+	assert(a != b);
+	assert(a == c);
+	assert(!std::strcmp(a, "door1"));
+	assert(!std::strcmp(b, "door2"));
+
+	assert(G_InternString("") == G_InternString(std::string_view("x", 0)));
+	assert(strings.requests == 5);
+	assert(strings.interned.size() == 3);
+	assert(strings.storedBytes == 6 + 6 + 1);
+
+	FreeLevel();
+}
+
+/*
+=============
+CheckLevelStorage
+
+Strings are packed into the level arena and forgotten with it.
+=============
+*/
+static void CheckLevelStorage() {
+	for (int i = 0; i < 4000; i++)
+		G_InternString("t" + std::to_string(i));
+
+	assert(levelBlocks.size() == 1);
+	assert(arena.owners[static_cast<size_t>(LevelMem::Strings)].liveBytes == strings.storedBytes);
+
+	const std::string message(LEVEL_CHUNK_SIZE, 'm');
+	const char* stored = G_InternString(message);
+	assert(std::strlen(stored) == message.length());
+	assert(levelBlocks.size() == 2);
+
+	FreeLevel();
+	assert(strings.interned.empty() && strings.requests == 0);
+
+	// a fresh level starts over rather than handing back freed pointers
+	const char* again = G_InternString("t0");
+	assert(!std::strcmp(again, "t0"));
+	assert(strings.requests == 1);
+
+	FreeLevel();
+}
+
+/*
+=============
+main
+=============
+*/
+int main() {
+	gi.Com_Print = &StubComPrint;
+	gi.TagMalloc = &TestTagMalloc;
+
+	CheckInterning();
+	CheckLevelStorage();
+	G_StringArenaPrint();
+	return 0;
+}
@@ -0,0 +1,413 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+test_target_laser.cpp implementation.*/
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "server/gameplay/g_target_laser.cpp"
+#include "server/gameplay/g_weapon_lead.cpp"
+
+constexpr size_t ENTITY_COUNT = 16;
+constexpr size_t LASER = 1;
+constexpr size_t DOOR = 2;
+constexpr size_t MONSTER = 3;
+constexpr size_t BYSTANDER = 4;
+constexpr size_t BLADE = 5;
+constexpr float BLADE_X = 800.f;
+constexpr float WALL_X = 1024.f;
+constexpr size_t FRAMES = 200;
+
+static std::unique_ptr<gentity_t[]> entities;
+static size_t traces;
+static size_t laserLinks;
+static std::vector<size_t> damageFrames;
+static size_t frameNumber;
+
+GameTime FRAME_TIME_S = 25_ms;
+GameTime FRAME_TIME_MS = 25_ms;
+
+static cvar_t deathmatch_storage{};
+cvar_t* deathmatch = &deathmatch_storage;
+
+/*
+=============
+Stubs
+
+The parts of the game the laser reaches into that these beams do not
+exercise.
+=============
+*/
+void Damage(gentity_t* targ, gentity_t*, gentity_t*, const Vector3&, const Vector3&, const Vector3&, int, int, DamageFlags, MeansOfDeath) {
+	assert(targ == &entities[MONSTER]);
+	damageFrames.push_back(frameNumber);
+}
+int DamageHits(gentity_t*, gentity_t*, gentity_t*, const Vector3&, const Vector3&, const Vector3&, int, int, int, DamageFlags, MeansOfDeath) { return 0; }
+bool G_ShouldPlayersCollide(bool) { return true; }
+bool LogAccuracyHit(gentity_t*, gentity_t*) { return false; }
+void G_PlayerNoise(gentity_t*, const Vector3&, PlayerNoise) {}
+void SetMoveDir(Vector3& angles, Vector3& moveDir) {
+	AngleVectors(angles, moveDir, nullptr, nullptr);
+	angles = {};
+}
+gentity_t* FindEntity(gentity_t*, std::function<bool(gentity_t* e)>) { return nullptr; }
+int Q_strncasecmp(const char* s1, const char* s2, size_t n) { return strncmp(s1, s2, n); }
+save_data_list_t::save_data_list_t(const char* name_in, save_data_tag_t tag_in, const void* ptr_in) :
+	name(name_in), tag(tag_in), ptr(ptr_in), next(nullptr) {}
+const save_data_list_t* save_data_list_t::fetch(const void*, save_data_tag_t) { return nullptr; }
+
+/*
+=============
+Import stubs
+=============
+*/
+static void IgnoreByte(int) {}
+static void IgnoreVector(gvec3_cref_t) {}
+static void IgnoreMulticast(gvec3_cref_t, multicast_t, bool) {}
+static contents_t NoContents(gvec3_cref_t) { return CONTENTS_NONE; }
+
+/*
+=============
+LinkBox
+=============
+*/
+static void LinkBox(gentity_t* ent) {
+	ent->absMin = ent->s.origin + ent->mins;
+	ent->absMax = ent->s.origin + ent->maxs;
+	ent->linked = true;
+	if (ent == &entities[LASER])
+		laserLinks++;
+}
+
+/*
+=============
+BoxesInBounds
+
+The broadphase: solid, linked entities whose bounds overlap the box.
+=============
+*/
+static size_t BoxesInBounds(gvec3_cref_t mins, gvec3_cref_t maxs, gentity_t** list, size_t maxCount, solidity_area_t, BoxEntitiesFilter_t filter, void* data) {
+	size_t count = 0;
+
+	for (size_t i = 1; i < ENTITY_COUNT && count < maxCount; i++) {
+		gentity_t* ent = &entities[i];
+
+		if (!ent->inUse || !ent->linked || ent->solid == SOLID_NOT || ent->solid == SOLID_TRIGGER)
+			continue;
+
+		bool overlaps = true;
+		for (int a = 0; a < 3; a++)
+			overlaps &= ent->absMin[a] <= maxs[a] && ent->absMax[a] >= mins[a];
+		if (!overlaps)
+			continue;
+
+		const BoxEntitiesResult_t result = filter ? filter(ent, data) : BoxEntitiesResult_t::Keep;
+		if (!static_cast<uint32_t>(result & BoxEntitiesResult_t::Skip))
+			list[count++] = ent;
+		if (static_cast<uint32_t>(result & BoxEntitiesResult_t::End))
+			break;
+	}
+
+	return count;
+}
+
+/*
+=============
+TraceBoxes
+
+A wall at WALL_X, with every solid entity an axial box. The blade is
+linked with a box that covers every angle it turns through, but only
+blocks while it lies across the beam.
+=============
+*/
+static trace_t TraceBoxes(gvec3_cref_t start, gvec3_cptr_t, gvec3_cptr_t, gvec3_cref_t end, const gentity_t* passent, contents_t) {
+	trace_t tr{};
+	tr.fraction = 1.f;
+	tr.endPos = end;
+	traces++;
+
+	const float delta[3] = { end[0] - start[0], end[1] - start[1], end[2] - start[2] };
+
+	if (end[0] > WALL_X && delta[0] > 0.f) {
+		tr.fraction = (WALL_X - start[0]) / delta[0];
+		tr.ent = world;
+		tr.contents = CONTENTS_SOLID;
+		tr.plane.normal = { -1.f, 0.f, 0.f };
+	}
+
+	for (size_t i = 1; i < ENTITY_COUNT; i++) {
+		gentity_t* ent = &entities[i];
+
+		if (!ent->inUse || ent == passent || ent->solid == SOLID_NOT || ent->solid == SOLID_TRIGGER)
+			continue;
+
+		if (i == BLADE && std::fmod(ent->s.angles[YAW], 180.f) >= 90.f)
+			continue;
+
+		float enter = 0.f, leave = 1.f;
+		int axis = -1;
+		bool miss = false;
+
+		for (int a = 0; a < 3 && !miss; a++) {
+			const float lo = ent->absMin[a];
+			const float hi = ent->absMax[a];
+
+			if (delta[a] == 0.f) {
+				miss = start[a] < lo || start[a] > hi;
+				continue;
+			}
+
+			float t0 = (lo - start[a]) / delta[a];
+			float t1 = (hi - start[a]) / delta[a];
+			if (t0 > t1)
+				std::swap(t0, t1);
+			if (t0 > enter) {
+				enter = t0;
+				axis = a;
+			}
+			leave = std::min(leave, t1);
+			miss = enter > leave;
+		}
+
+		if (miss || axis < 0 || enter >= tr.fraction)
+			continue;
+
+		tr.fraction = enter;
+		tr.ent = ent;
+		tr.contents = CONTENTS_MONSTER;
+		tr.plane.normal = {};
+		tr.plane.normal[axis] = delta[axis] > 0.f ? -1.f : 1.f;
+	}
+
+	for (int a = 0; a < 3; a++)
+		tr.endPos[a] = start[a] + delta[a] * tr.fraction;
+	return tr;
+}
+
+/*
+=============
+SpawnBox
+=============
+*/
+static gentity_t* SpawnBox(size_t index, const Vector3& origin) {
+	gentity_t* ent = &entities[index];
+
+	ent->inUse = true;
+	ent->solid = SOLID_BBOX;
+	ent->s.origin = origin;
+	ent->mins = { -16.f, -16.f, -24.f };
+	ent->maxs = { 16.f, 16.f, 32.f };
+	LinkBox(ent);
+	return ent;
+}
+
+/*
+=============
+ResetWorld
+
+A laser at the origin firing down +X at a wall, a door that can swing
+across it, a monster that can walk through it, and a bystander well
+off to the side that the beam never touches.
+=============
+*/
+static gentity_t* ResetWorld() {
+	entities = std::make_unique<gentity_t[]>(ENTITY_COUNT);
+
+	g_entities = entities.get();
+	game.maxEntities = ENTITY_COUNT;
+	game.maxClients = 1;
+	globals.numEntities = ENTITY_COUNT;
+	level.time = 10_sec;
+	laserBeams.clear();
+
+	world->inUse = true;
+
+	gentity_t* laser = &entities[LASER];
+	laser->inUse = true;
+	laser->spawnFlags = SPAWNFLAG_LASER_ON;
+	SP_target_laser(laser);
+	laser->think(laser);
+
+	SpawnBox(DOOR, { 600.f, 300.f, 0.f });
+
+	gentity_t* monster = SpawnBox(MONSTER, { 300.f, -300.f, 0.f });
+	monster->svFlags = SVF_MONSTER;
+	monster->takeDamage = true;
+
+	SpawnBox(BYSTANDER, { 300.f, 600.f, 0.f });
+	return laser;
+}
+
+/*
+=============
+MoveBox
+=============
+*/
+static void MoveBox(size_t index, const Vector3& origin) {
+	entities[index].s.origin = origin;
+	LinkBox(&entities[index]);
+}
+
+/*
+=============
+AdvanceFrame
+
+The monster walks in and out of the beam, the door shuts across it and
+opens again, and the bystander fidgets throughout.
+=============
+*/
+static void AdvanceFrame(size_t frame) {
+	level.time += FRAME_TIME_S;
+
+	if (frame == 40)
+		MoveBox(MONSTER, { 300.f, 0.f, 0.f });
+	if (frame == 80)
+		MoveBox(MONSTER, { 300.f, -300.f, 0.f });
+	if (frame == 100)
+		MoveBox(DOOR, { 600.f, 0.f, 0.f });
+	if (frame == 140)
+		MoveBox(DOOR, { 600.f, 300.f, 0.f });
+
+	MoveBox(BYSTANDER, { 300.f + static_cast<float>(frame % 7), 600.f, 0.f });
+}
+
+/*
+=============
+SpawnBlade
+
+A func_rotating-style blade across the beam, linked once with bounds
+that do not change as it turns.
+=============
+*/
+static void SpawnBlade() {
+	gentity_t* blade = SpawnBox(BLADE, { BLADE_X, 0.f, 0.f });
+
+	blade->solid = SOLID_BSP;
+	blade->mins = { -48.f, -48.f, -48.f };
+	blade->maxs = { 48.f, 48.f, 48.f };
+	blade->aVelocity = { 0.f, 400.f, 0.f };
+	LinkBox(blade);
+}
+
+/*
+=============
+TurnBlade
+
+Turns 10 degrees a frame, without relinking, and stops at frame 160.
+=============
+*/
+static void TurnBlade(size_t frame) {
+	gentity_t* blade = &entities[BLADE];
+
+	if (frame >= 160) {
+		blade->aVelocity = {};
+		return;
+	}
+
+	blade->s.angles[YAW] = static_cast<float>(frame * 10 % 360);
+}
+
+struct laser_run_t {
+	std::vector<Vector3>	ends;
+	std::vector<size_t>		damage;
+	size_t					traces = 0;
+	size_t					relinks = 0;
+};
+
+/*
+=============
+RunLaser
+
+Thinks the laser once a frame. `persistent` false forgets the beam
+before every think, which traces it every time as lasers used to.
+=============
+*/
+static laser_run_t RunLaser(bool persistent, bool blade = false) {
+	gentity_t* laser = ResetWorld();
+	if (blade)
+		SpawnBlade();
+	damageFrames.clear();
+	traces = laserLinks = 0;
+
+	laser_run_t run;
+
+	for (frameNumber = 0; frameNumber < FRAMES; frameNumber++) {
+		AdvanceFrame(frameNumber);
+		if (blade)
+			TurnBlade(frameNumber);
+
+		if (!persistent)
+			laserBeams.clear();
+		assert(laser->nextThink <= level.time);
+		laser->think(laser);
+
+		run.ends.push_back(laser->s.oldOrigin);
+	}
+
+	run.damage = damageFrames;
+	run.traces = traces;
+	run.relinks = laserLinks;
+	return run;
+}
+
+/*
+=============
+main
+=============
+*/
+int main() {
+	game_import_t& base = gi;
+	base.trace = &TraceBoxes;
+	base.linkEntity = &LinkBox;
+	base.unlinkEntity = &LinkBox;
+	base.BoxEntities = &BoxesInBounds;
+	base.pointContents = &NoContents;
+	base.WriteByte = &IgnoreByte;
+	base.WritePosition = &IgnoreVector;
+	base.WriteDir = &IgnoreVector;
+	base.multicast = &IgnoreMulticast;
+
+	const laser_run_t legacy = RunLaser(false);
+	const laser_run_t persistent = RunLaser(true);
+
+	// the beam ends in the same place and hurts on the same frames
+	assert(legacy.ends == persistent.ends);
+	assert(legacy.damage == persistent.damage);
+
+	// passes through the monster to the wall, is shut off by the door, then opens again
+	assert(persistent.ends[40][0] == WALL_X);
+	assert(persistent.ends[99][0] == WALL_X);
+	assert(persistent.ends[100][0] == 600.f - 16.f);
+	assert(persistent.ends[139][0] == 600.f - 16.f);
+	assert(persistent.ends[140][0] == WALL_X);
+
+	// hurt from the frame it stepped in, every 100 ms while it stayed
+	assert(!persistent.damage.empty());
+	assert(persistent.damage.front() == 40);
+	assert(persistent.damage.back() < 80);
+	assert(persistent.damage.size() == 10);
+
+	// retraced every think only while the monster stands in it, otherwise
+	// just when the door or monster moves across it
+	assert(persistent.traces <= 40 * 2 + 4);
+	assert(persistent.traces * 2 < legacy.traces);
+
+	// a blade turning inside unchanged bounds is traced every think it turns
+	const laser_run_t legacyBlade = RunLaser(false, true);
+	const laser_run_t persistentBlade = RunLaser(true, true);
+	assert(legacyBlade.ends == persistentBlade.ends);
+	assert(persistentBlade.ends[0][0] == BLADE_X - 48.f);
+	assert(persistentBlade.ends[9][0] == WALL_X);
+	assert(persistentBlade.ends[18][0] == BLADE_X - 48.f);
+	assert(persistentBlade.traces < legacyBlade.traces);
+
+	std::printf("target_laser over %zu frames:\n", FRAMES);
+	std::printf("  traced every think  %zu traces  %zu relinks\n", legacy.traces, legacy.relinks);
+	std::printf("  persistent beam     %zu traces  %zu relinks\n", persistent.traces, persistent.relinks);
+	std::printf("  rotating blocker    %zu traces every think, %zu persistent\n", legacyBlade.traces, persistentBlade.traces);
+	return 0;
+}
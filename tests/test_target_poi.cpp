@@ -0,0 +1,288 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+test_target_poi.cpp implementation.*/
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "server/gameplay/g_target_poi.cpp"
+
+constexpr size_t POI_COUNT = 12;
+constexpr size_t FIRST_POI = 2;
+constexpr size_t DOOR = FIRST_POI + POI_COUNT;
+constexpr size_t ENTITY_COUNT = DOOR + 1;
+constexpr float DOOR_X = 1000.f;
+constexpr size_t FRAMES = 300;
+constexpr size_t ACTIVATIONS_PER_FRAME = 8;
+
+static std::unique_ptr<gentity_t[]> entities;
+static std::vector<gentity_t*> movers;
+static size_t queries;
+static bool navAvailable = true;
+
+static cvar_t deathmatch_storage{};
+cvar_t* deathmatch = &deathmatch_storage;
+spawn_temp_t st;
+GameTime FRAME_TIME_MS = 25_ms;
+
+/*
+=============
+Stubs
+=============
+*/
+std::span<gentity_t* const> G_RegistryMembers(EntityRegistry) { return movers; }
+void G_EntityClassResolve(const gentity_t* ent) {
+	ent->classTagName = ent->className;
+	ent->classTag = EntityClass::TargetPoi;
+}
+void FreeEntity(gentity_t*) {}
+save_data_list_t::save_data_list_t(const char* name_in, save_data_tag_t tag_in, const void* ptr_in) :
+	name(name_in), tag(tag_in), ptr(ptr_in), next(nullptr) {}
+const save_data_list_t* save_data_list_t::fetch(const void*, save_data_tag_t) { return nullptr; }
+
+/*
+=============
+DoorOpen
+=============
+*/
+static bool DoorOpen() {
+	return entities[DOOR].moveInfo.state == MoveState::Top;
+}
+
+/*
+=============
+PathLengthSqr
+
+Paths run along the axes, so they are longer than the straight line
+between their ends, and cannot pass the door at DOOR_X while it is shut.
+=============
+*/
+static float PathLengthSqr(const Vector3& start, const Vector3& goal) {
+	if (!DoorOpen() && (start[0] < DOOR_X) != (goal[0] < DOOR_X))
+		return std::numeric_limits<float>::infinity();
+
+	const float length = std::fabs(goal[0] - start[0]) + std::fabs(goal[1] - start[1]);
+	return length * length;
+}
+
+/*
+=============
+PathToGoal
+=============
+*/
+static bool PathToGoal(const PathRequest& request, PathInfo& info) {
+	queries++;
+
+	if (!navAvailable) {
+		info.returnCode = PathReturnCode::NoNavAvailable;
+		return false;
+	}
+
+	const float length = PathLengthSqr(request.start, request.goal);
+	if (std::isinf(length)) {
+		info.returnCode = PathReturnCode::NoPathFound;
+		return false;
+	}
+
+	info.returnCode = PathReturnCode::ReachedGoal;
+	info.pathDistSqr = length;
+	return true;
+}
+
+/*
+=============
+ResetLevel
+
+A NEAREST team of POIs spread either side of a door, and a player.
+=============
+*/
+static void ResetLevel() {
+	entities = std::make_unique<gentity_t[]>(ENTITY_COUNT);
+
+	g_entities = entities.get();
+	game.maxEntities = ENTITY_COUNT;
+	game.maxClients = 1;
+	globals.numEntities = ENTITY_COUNT;
+	level.time = 10_sec;
+	level.poi = {};
+	G_PoiPathsClear();
+
+	entities[1].inUse = true;
+
+	for (size_t i = 0; i < POI_COUNT; i++) {
+		gentity_t* poi = &entities[FIRST_POI + i];
+
+		poi->inUse = true;
+		poi->s.number = static_cast<int32_t>(FIRST_POI + i);
+		poi->className = "target_poi";
+		poi->team = "objective";
+		poi->spawnFlags = SPAWNFLAG_POI_NEAREST;
+		poi->teamMaster = &entities[FIRST_POI];
+		poi->teamChain = i + 1 < POI_COUNT ? &entities[FIRST_POI + i + 1] : nullptr;
+		poi->s.origin = { -400.f + 200.f * static_cast<float>(i), static_cast<float>(i % 3) * 300.f - 300.f, 0.f };
+		poi->use = target_poi_use;
+	}
+
+	gentity_t* door = &entities[DOOR];
+	door->inUse = true;
+	door->s.number = static_cast<int32_t>(DOOR);
+	door->svFlags = SVF_DOOR;
+	door->moveInfo.state = MoveState::Top;
+	movers = { door };
+}
+
+/*
+=============
+NearestByPath
+
+The POI an uncached search would choose from `start`.
+=============
+*/
+static const gentity_t* NearestByPath(const Vector3& start) {
+	const gentity_t* best = nullptr;
+	float bestLength = std::numeric_limits<float>::infinity();
+
+	for (size_t i = 0; i < POI_COUNT; i++) {
+		const gentity_t* poi = &entities[FIRST_POI + i];
+		const float length = navAvailable ? PathLengthSqr(start, poi->s.origin) : (poi->s.origin - start).lengthSquared();
+
+		if (length < bestLength) {
+			best = poi;
+			bestLength = length;
+		}
+	}
+
+	return best;
+}
+
+/*
+=============
+RunThinks
+
+Deferred activations, run at the start of the frame as G_RunFrame does.
+=============
+*/
+static void RunThinks() {
+	for (size_t i = 0; i < ENTITY_COUNT; i++) {
+		gentity_t* ent = &entities[i];
+
+		if (!ent->think || !ent->nextThink || ent->nextThink > level.time)
+			continue;
+		ent->nextThink = 0_ms;
+		ent->think(ent);
+	}
+}
+
+/*
+=============
+PlayerSpot
+
+The player stands at one of a few spots on either side of the door,
+moving on every 50 frames; the door shuts at 120 and opens at 220.
+=============
+*/
+static Vector3 PlayerSpot(size_t frame) {
+	static const std::array<Vector3, 6> spots = { {
+		{ 0.f, 0.f, 0.f }, { 900.f, 200.f, 0.f }, { 1100.f, -250.f, 0.f },
+		{ 1900.f, 150.f, 0.f }, { 500.f, -300.f, 0.f }, { 1300.f, 300.f, 0.f },
+	} };
+
+	return spots[frame / 50];
+}
+
+/*
+=============
+main
+=============
+*/
+int main() {
+	game_import_t& base = gi;
+	base.GetPathToGoal = &PathToGoal;
+
+	ResetLevel();
+	gentity_t* player = &entities[1];
+
+	size_t maxFrameQueries = 0;
+	size_t matched = 0;
+	size_t settleFrame = 0;
+
+	for (size_t frame = 0; frame < FRAMES; frame++) {
+		level.time += 25_ms;
+
+		const Vector3 spot = PlayerSpot(frame);
+		if (frame == 0 || spot != player->s.origin)
+			settleFrame = frame;
+		player->s.origin = spot;
+
+		if (frame == 120 || frame == 220) {
+			entities[DOOR].moveInfo.state = frame == 120 ? MoveState::Bottom : MoveState::Top;
+			settleFrame = frame;
+		}
+
+		const size_t before = queries;
+		const Vector3 previous = level.poi.current;
+		RunThinks();
+		for (size_t i = 0; i < ACTIVATIONS_PER_FRAME; i++)
+			target_poi_use(&entities[FIRST_POI + i % POI_COUNT], player, player);
+		maxFrameQueries = std::max(maxFrameQueries, queries - before);
+
+		// whenever the pick changes, it is the true nearest from here
+		if (level.poi.valid && level.poi.current != previous)
+			assert(level.poi.current == NearestByPath(player->s.origin)->s.origin);
+
+		// once every POI has been measured from here, the pick is the true nearest
+		if (frame >= settleFrame + (POI_COUNT + POI_PATH_QUERIES_PER_FRAME - 1) / POI_PATH_QUERIES_PER_FRAME) {
+			const gentity_t* nearest = NearestByPath(player->s.origin);
+			assert(nearest && level.poi.valid && level.poi.current == nearest->s.origin);
+			matched++;
+		}
+	}
+
+	// never more than the budget in one frame, and nothing repeated while nothing changed
+	assert(maxFrameQueries <= POI_PATH_QUERIES_PER_FRAME);
+	assert(matched > FRAMES * 3 / 4);
+
+	const size_t legacyQueries = FRAMES * ACTIVATIONS_PER_FRAME * POI_COUNT;
+	const size_t cachedQueries = queries;
+	assert(cachedQueries <= 8 * POI_COUNT);
+
+	// a single activation with the door shut: the closest POI in a straight
+	// line is behind the door, so nothing is picked until every member has
+	// been measured, a few frames on
+	ResetLevel();
+	entities[DOOR].moveInfo.state = MoveState::Bottom;
+	player = &entities[1];
+	player->s.origin = { 900.f, 200.f, 0.f };
+	target_poi_use(&entities[FIRST_POI], player, player);
+	size_t deferredFrames = 0;
+	while (!level.poi.valid) {
+		assert(deferredFrames++ < POI_COUNT);
+		level.time += 25_ms;
+		RunThinks();
+	}
+	assert(deferredFrames == (POI_COUNT - 1) / POI_PATH_QUERIES_PER_FRAME);
+	assert(level.poi.current == NearestByPath(player->s.origin)->s.origin);
+	assert(level.poi.current[0] < DOOR_X);
+
+	// without a nav file, one failed request and then straight lines only
+	ResetLevel();
+	navAvailable = false;
+	queries = 0;
+	player = &entities[1];
+	player->s.origin = { 1500.f, 400.f, 0.f };
+	for (size_t frame = 0; frame < 20; frame++) {
+		level.time += 25_ms;
+		target_poi_use(&entities[FIRST_POI], player, player);
+		assert(level.poi.current == NearestByPath(player->s.origin)->s.origin);
+	}
+	assert(queries == 1);
+
+	std::printf("target_poi, %zu-member NEAREST team, %zu activations/frame over %zu frames:\n", POI_COUNT, ACTIVATIONS_PER_FRAME, FRAMES);
+	std::printf("  path every activation  %zu path requests\n", legacyQueries);
+	std::printf("  cached + budgeted      %zu path requests, at most %zu in a frame\n", cachedQueries, maxFrameQueries);
+	return 0;
+}
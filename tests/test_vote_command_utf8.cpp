@@ -103,6 +103,30 @@ void PrintUsage(gentity_t*, const CommandArgs&, std::string_view, std::string_vi
 	++g_usageCount;
 }
 
+/*
+=============
+G_CastVote
+
+Mirrors the vote tally for the mocked client and level.
+=============
+*/
+bool G_CastVote(gclient_t* cl, bool yes) {
+	if (!level.vote.time || !cl || cl->pers.voted) {
+		return false;
+	}
+
+	if (yes) {
+		level.vote.countYes++;
+		cl->pers.voted = 1;
+	}
+	else {
+		level.vote.countNo++;
+		cl->pers.voted = -1;
+	}
+
+	return true;
+}
+
 namespace Commands {
 #include "server/commands/command_voting_vote.inl"
 }
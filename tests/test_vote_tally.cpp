@@ -0,0 +1,259 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+test_vote_tally.cpp implementation.*/
+
+#include <cassert>
+#include <cstdio>
+#include <memory>
+#include <random>
+
+#include "server/commands/command_voting_tally.cpp"
+
+constexpr size_t CLIENT_COUNT = 64;
+constexpr size_t BOT_COUNT = 8;
+constexpr size_t FRAMES = 2000;
+
+static std::unique_ptr<gentity_t[]> entities;
+static std::unique_ptr<gclient_t[]> clients;
+static size_t cancels;
+
+static cvar_t g_allowSpecVote_storage{};
+cvar_t* g_allowSpecVote = &g_allowSpecVote_storage;
+
+/*
+=============
+ClientIsPlaying
+=============
+*/
+bool ClientIsPlaying(gclient_t* cl) {
+	return cl && cl->sess.team != Team::Spectator && cl->sess.team != Team::None;
+}
+
+/*
+=============
+CountBroadcast
+=============
+*/
+static void CountBroadcast(print_type_t, const char*) {
+	cancels++;
+}
+
+/*
+=============
+RankPass
+
+The vote lines of CalculateRanks, run whenever a client joins, leaves
+or changes team.
+=============
+*/
+static void RankPass() {
+	level.pop.num_voting_clients = 0;
+
+	for (gentity_t* ec : active_clients()) {
+		if (G_ClientCanVote(ec->client))
+			level.pop.num_voting_clients++;
+		else if (ec->client->pers.voted)
+			G_WithdrawVote(ec->client);
+	}
+}
+
+struct recount_t {
+	int yes = 0;
+	int no = 0;
+	int voters = 0;
+};
+
+/*
+=============
+Recount
+
+The tally from scratch: every connected client who may vote, and what
+they voted.
+=============
+*/
+static recount_t Recount() {
+	recount_t out;
+
+	for (gentity_t* ec : active_clients()) {
+		if (!G_ClientCanVote(ec->client))
+			continue;
+
+		out.voters++;
+		out.yes += ec->client->pers.voted > 0;
+		out.no += ec->client->pers.voted < 0;
+	}
+
+	return out;
+}
+
+/*
+=============
+Outcome
+
+CheckVote's rule: 1 passes, -1 fails, 0 is still open.
+=============
+*/
+static int Outcome(int yes, int no, int voters) {
+	const int halfpoint = voters / 2;
+
+	if (yes > halfpoint)
+		return 1;
+	if (no >= halfpoint)
+		return -1;
+	return 0;
+}
+
+/*
+=============
+ResetServer
+
+Everyone connected and playing, the last few as bots, with the first
+client calling a vote.
+=============
+*/
+static void ResetServer() {
+	entities = std::make_unique<gentity_t[]>(CLIENT_COUNT + 1);
+	clients = std::make_unique<gclient_t[]>(CLIENT_COUNT);
+
+	g_entities = entities.get();
+	game.clients = clients.get();
+	game.maxClients = CLIENT_COUNT;
+	game.maxEntities = CLIENT_COUNT + 1;
+	globals.numEntities = CLIENT_COUNT + 1;
+	level.time = 10_sec;
+	level.vote = {};
+
+	for (size_t i = 1; i <= CLIENT_COUNT; i++) {
+		gentity_t* ent = &entities[i];
+		gclient_t* cl = &clients[i - 1];
+
+		ent->inUse = true;
+		ent->client = cl;
+		cl->pers.connected = true;
+		cl->sess.team = i % 2 ? Team::Red : Team::Blue;
+		cl->sess.is_a_bot = i > CLIENT_COUNT - BOT_COUNT;
+	}
+
+	RankPass();
+
+	level.vote.client = &clients[0];
+	level.vote.time = level.time;
+	G_CastVote(&clients[0], true);
+}
+
+struct run_stats_t {
+	size_t casts = 0;
+	size_t refused = 0;
+	size_t withdrawn = 0;
+	size_t outcomes[3] = {};
+};
+
+/*
+=============
+RunServer
+
+Clients vote, swap between spectating and playing, and drop and come
+back at random; the running counts are checked against a recount every
+frame.
+=============
+*/
+static run_stats_t RunServer(bool allowSpecVote, unsigned seed) {
+	g_allowSpecVote_storage.integer = allowSpecVote;
+	ResetServer();
+
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<size_t> pick(2, CLIENT_COUNT);
+	std::uniform_int_distribution<int> action(0, 9);
+	run_stats_t stats;
+
+	for (size_t frame = 0; frame < FRAMES; frame++) {
+		level.time += 25_ms;
+
+		for (int n = 0; n < 4; n++) {
+			gentity_t* ent = &entities[pick(rng)];
+			gclient_t* cl = ent->client;
+			const int act = action(rng);
+
+			if (act < 5) {
+				if (!cl->pers.connected)
+					continue;
+				if (G_CastVote(cl, act < 3))
+					stats.casts++;
+				else
+					stats.refused++;
+			}
+			else if (act < 8) {
+				if (!cl->pers.connected)
+					continue;
+				const int8_t voted = cl->pers.voted;
+				cl->sess.team = ClientIsPlaying(cl) ? Team::Spectator : (act == 5 ? Team::Red : Team::Blue);
+				RankPass();
+				stats.withdrawn += voted && !cl->pers.voted;
+			}
+			else if (cl->pers.connected) {
+				G_RevertVote(cl);
+				cl->pers.connected = false;
+				ent->inUse = false;
+				RankPass();
+			}
+			else {
+				ent->inUse = true;
+				cl->pers.connected = true;
+				cl->sess.team = Team::Spectator;
+				RankPass();
+			}
+		}
+
+		const recount_t recount = Recount();
+		assert(level.vote.countYes == recount.yes);
+		assert(level.vote.countNo == recount.no);
+		assert(level.pop.num_voting_clients == recount.voters);
+
+		const int outcome = Outcome(level.vote.countYes, level.vote.countNo, level.pop.num_voting_clients);
+		assert(outcome == Outcome(recount.yes, recount.no, recount.voters));
+		stats.outcomes[outcome + 1]++;
+	}
+
+	// the caller never left, so the vote was never cancelled
+	assert(level.vote.time && level.vote.client == &clients[0]);
+	return stats;
+}
+
+/*
+=============
+main
+=============
+*/
+int main() {
+	game_import_t& base = gi;
+	base.Broadcast_Print = &CountBroadcast;
+
+	const run_stats_t players = RunServer(false, 50);
+	const run_stats_t everyone = RunServer(true, 51);
+
+	// spectators could not vote, and took their votes with them when they left the game
+	assert(players.refused > 0);
+	assert(players.withdrawn > 0);
+	assert(cancels == 0);
+
+	// with g_allowSpecVote, spectators' votes count too
+	assert(everyone.casts > players.casts);
+
+	// the caller dropping cancels the vote and clears every vote
+	level.vote.countNo = 1;
+	clients[1].pers.voted = -1;
+	G_RevertVote(&clients[0]);
+	assert(cancels == 1);
+	assert(!level.vote.time && !level.vote.countYes && !level.vote.countNo);
+	assert(!clients[0].pers.voted && !clients[1].pers.voted);
+	assert(!G_CastVote(&clients[1], true));
+
+	std::printf("Vote tally, %zu clients over %zu frames, checked against a recount every frame:\n", CLIENT_COUNT, FRAMES);
+	std::printf("  players only   %zu cast  %zu refused  %zu withdrawn on leaving the game\n", players.casts, players.refused, players.withdrawn);
+	std::printf("  spectators too %zu cast  %zu refused  %zu withdrawn on leaving the game\n", everyone.casts, everyone.refused, everyone.withdrawn);
+	std::printf("  outcomes (fail/open/pass frames)  %zu/%zu/%zu  %zu/%zu/%zu\n",
+		players.outcomes[0], players.outcomes[1], players.outcomes[2],
+		everyone.outcomes[0], everyone.outcomes[1], everyone.outcomes[2]);
+	return 0;
+}
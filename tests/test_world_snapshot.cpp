@@ -0,0 +1,622 @@
+/*Copyright (c) 2024 The DarkMatter Project
+Licensed under the GNU General Public License 2.0.
+
+test_world_snapshot.cpp implementation.*/
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "server/gameplay/g_entity_hot.cpp"
+#include "server/gameplay/g_headhunters.cpp"
+#include "server/gameplay/g_world_snapshot.cpp"
+
+constexpr size_t CLIENT_COUNT = 8;
+constexpr size_t BODY_SLOTS = CLIENT_COUNT + BODY_QUEUE_SIZE + 1;
+constexpr size_t MAP_SIZES[] = { 512, 2048, 6000 };
+constexpr size_t RESETS = 20;
+
+static std::unique_ptr<gentity_t[]> entities;
+static std::unique_ptr<gclient_t[]> clients;
+static std::set<std::string, std::less<>> levelStrings;
+static std::vector<size_t> linkSerials;
+static size_t linkSerial;
+static std::string entityString;
+
+static cvar_t deathmatch_storage{};
+cvar_t* deathmatch = &deathmatch_storage;
+static cvar_t coop_storage{};
+cvar_t* coop = &coop_storage;
+static cvar_t skill_storage{};
+cvar_t* skill = &skill_storage;
+static cvar_t g_instaGib_storage{};
+cvar_t* g_instaGib = &g_instaGib_storage;
+static cvar_t g_nadeFest_storage{};
+cvar_t* g_nadeFest = &g_nadeFest_storage;
+static cvar_t g_quadhog_storage{};
+cvar_t* g_quadhog = &g_quadhog_storage;
+static cvar_t g_vampiric_damage_storage{};
+cvar_t* g_vampiric_damage = &g_vampiric_damage_storage;
+static cvar_t g_no_items_storage{};
+cvar_t* g_no_items = &g_no_items_storage;
+static cvar_t g_no_mines_storage{};
+cvar_t* g_no_mines = &g_no_mines_storage;
+static cvar_t g_no_nukes_storage{};
+cvar_t* g_no_nukes = &g_no_nukes_storage;
+static cvar_t g_no_spheres_storage{};
+cvar_t* g_no_spheres = &g_no_spheres_storage;
+static cvar_t g_no_armor_storage{};
+cvar_t* g_no_armor = &g_no_armor_storage;
+static cvar_t g_no_powerups_storage{};
+cvar_t* g_no_powerups = &g_no_powerups_storage;
+static cvar_t g_no_health_storage{};
+cvar_t* g_no_health = &g_no_health_storage;
+static cvar_t g_mapspawn_no_bfg_storage{};
+cvar_t* g_mapspawn_no_bfg = &g_mapspawn_no_bfg_storage;
+static cvar_t g_mapspawn_no_plasmabeam_storage{};
+cvar_t* g_mapspawn_no_plasmabeam = &g_mapspawn_no_plasmabeam_storage;
+static cvar_t g_fallingDamage_storage{};
+cvar_t* g_fallingDamage = &g_fallingDamage_storage;
+static cvar_t g_selfDamage_storage{};
+cvar_t* g_selfDamage = &g_selfDamage_storage;
+static cvar_t match_weaponsStay_storage{};
+cvar_t* match_weaponsStay = &match_weaponsStay_storage;
+static cvar_t g_itemBobbing_storage{};
+cvar_t* g_itemBobbing = &g_itemBobbing_storage;
+static cvar_t match_powerupMinPlayerLock_storage{};
+cvar_t* match_powerupMinPlayerLock = &match_powerupMinPlayerLock_storage;
+static cvar_t g_dm_random_items_storage{};
+cvar_t* g_dm_random_items = &g_dm_random_items_storage;
+
+/*
+=============
+PrintToStdout
+=============
+*/
+static void PrintToStdout(const char* message) {
+	std::fputs(message, stdout);
+}
+
+/*
+=============
+TestLinkEntity
+
+Stands in for the server: bumps the link count and records when the
+entity joined its area list.
+=============
+*/
+static void TestLinkEntity(gentity_t* ent) {
+	if (!ent->linked)
+		linkSerials[ent->s.number] = ++linkSerial;
+	ent->linked = true;
+	ent->linkCount++;
+}
+
+/*
+=============
+TestUnlinkEntity
+=============
+*/
+static void TestUnlinkEntity(gentity_t* ent) {
+	ent->linked = false;
+}
+
+/*
+=============
+AreaList
+
+Linked entities in the order the area lists would hold them.
+=============
+*/
+static std::vector<int32_t> AreaList() {
+	std::vector<int32_t> list;
+	for (size_t i = 0; i < globals.numEntities; i++) {
+		if (g_entities[i].linked)
+			list.push_back(static_cast<int32_t>(i));
+	}
+
+	std::sort(list.begin(), list.end(), [](int32_t a, int32_t b) { return linkSerials[a] < linkSerials[b]; });
+	return list;
+}
+
+/*
+=============
+Stubs
+
+Gametype state the snapshot test does not set up.
+=============
+*/
+void Domination_ClearState() {}
+void ProBall::ClearState() {}
+const spawn_temp_t& ED_GetSpawnTemp() {
+	static spawn_temp_t temp{};
+	return temp;
+}
+gentity_t* Spawn() { return nullptr; }
+bool ClientIsPlaying(gclient_t*) { return true; }
+bool ScoringIsDisabled() { return true; }
+void G_AdjustPlayerScore(gclient_t*, int32_t, bool, int32_t) {}
+const save_data_list_t* save_data_list_t::fetch(const void*, save_data_tag_t) { return nullptr; }
+
+/*
+=============
+G_RegistryRebuild
+=============
+*/
+void G_RegistryRebuild() {
+}
+
+/*
+=============
+G_EventListRebuild
+=============
+*/
+void G_EventListRebuild() {
+}
+
+/*
+=============
+G_EntityShiftTimes
+
+The timestamps the synthetic map sets; the game walks the save tables.
+=============
+*/
+void G_EntityShiftTimes(gentity_t* ent, GameTime delta) {
+	if (ent->nextThink)
+		ent->nextThink += delta;
+	if (ent->timeStamp)
+		ent->timeStamp += delta;
+}
+
+/*
+=============
+G_LevelShiftTimes
+=============
+*/
+void G_LevelShiftTimes(LevelLocals* locals, GameTime delta) {
+	locals->time += delta;
+}
+
+/*
+=============
+FreeEntity
+
+What the game's FreeEntity does to a slot.
+=============
+*/
+void FreeEntity(gentity_t* ed) {
+	if (!ed->inUse)
+		return;
+
+	gi.unlinkEntity(ed);
+
+	const int32_t id = ed->spawn_count + 1;
+	std::memset(static_cast<void*>(ed), 0, sizeof(*ed));
+	ed->s.number = static_cast<int32_t>(ed - g_entities);
+	ed->className = "freed";
+	ed->freeTime = level.time;
+	ed->spawn_count = id;
+
+	G_EntityHotSync(ed);
+}
+
+/*
+=============
+SpawnSlot
+
+InitGEntity on the next slot, as Spawn hands them out while a map loads.
+=============
+*/
+static gentity_t* SpawnSlot(size_t slot) {
+	gentity_t* ent = &g_entities[slot];
+	const int32_t id = ent->spawn_count;
+
+	std::memset(static_cast<void*>(ent), 0, sizeof(*ent));
+	ent->inUse = true;
+	ent->className = "noClass";
+	ent->gravity = 1.0f;
+	ent->s.number = static_cast<int32_t>(slot);
+	ent->spawn_count = id;
+	ent->gravityVector = { 0.0f, 0.0f, -1.0f };
+
+	globals.numEntities = std::max<uint32_t>(globals.numEntities, static_cast<uint32_t>(slot + 1));
+	G_EntityHotSync(ent);
+	return ent;
+}
+
+/*
+=============
+LevelString
+
+Interned, as G_InternString does.
+=============
+*/
+static const char* LevelString(const char* text) {
+	return levelStrings.emplace(text).first->c_str();
+}
+
+/*
+=============
+BuildEntityString
+
+A map of count entities: doors in teams, triggers targeting them, items
+and lights, with every seventh entity inhibited in deathmatch.
+=============
+*/
+static void BuildEntityString(size_t count) {
+	static const char* const classes[] = { "func_door", "trigger_multiple", "item_health", "light", "misc_teleporter" };
+
+	entityString = "{\n\"classname\" \"worldspawn\"\n\"message\" \"Snapshot Test\"\n}\n";
+	for (size_t i = 1; i < count; i++) {
+		entityString += "{\n\"classname\" \"";
+		entityString += classes[i % std::size(classes)];
+		entityString += "\"\n\"origin\" \"" + std::to_string(i * 8 % 4096) + " " + std::to_string(i * 13 % 4096) + " 64\"\n";
+		entityString += "\"targetname\" \"t" + std::to_string(i) + "\"\n";
+		entityString += "\"target\" \"t" + std::to_string(i + 1) + "\"\n";
+		if (i % 3 == 0)
+			entityString += "\"team\" \"team" + std::to_string(i / 12) + "\"\n";
+		if (i % 7 == 0)
+			entityString += "\"notdeathmatch\" \"1\"\n";
+		entityString += "\"wait\" \"" + std::to_string(i % 5) + "\"\n}\n";
+	}
+}
+
+/*
+=============
+ParseMap
+
+What a reset did before snapshots: free the world, tokenize the entity
+string, run the spawn functions and tie up the teams.
+=============
+*/
+static void ParseMap() {
+	for (size_t i = BODY_SLOTS; i < globals.numEntities; i++)
+		FreeEntity(&g_entities[i]);
+	for (size_t i = CLIENT_COUNT + 1; i < BODY_SLOTS; i++) {
+		TestUnlinkEntity(&g_entities[i]);
+		SpawnSlot(i)->className = "bodyque";
+	}
+	TestUnlinkEntity(world);
+	globals.numEntities = BODY_SLOTS;
+
+	const char* data = entityString.c_str();
+	size_t slot = 0;
+
+	while (true) {
+		const char* token = COM_Parse(&data);
+		if (!data)
+			break;
+		assert(token[0] == '{');
+
+		gentity_t* ent = SpawnSlot(slot);
+		bool inhibit = false;
+
+		while (true) {
+			std::string key = COM_Parse(&data);
+			if (key[0] == '}')
+				break;
+			const std::string value = COM_Parse(&data);
+
+			if (key == "classname")
+				ent->className = LevelString(value.c_str());
+			else if (key == "targetname")
+				ent->targetName = LevelString(value.c_str());
+			else if (key == "target")
+				ent->target = LevelString(value.c_str());
+			else if (key == "team")
+				ent->team = LevelString(value.c_str());
+			else if (key == "message")
+				ent->message = LevelString(value.c_str());
+			else if (key == "wait")
+				ent->wait = std::stof(value);
+			else if (key == "notdeathmatch")
+				inhibit = true;
+			else if (key == "origin") {
+				float x = 0, y = 0, z = 0;
+				std::sscanf(value.c_str(), "%f %f %f", &x, &y, &z);
+				ent->s.origin = { x, y, z };
+			}
+		}
+
+		slot = slot ? slot + 1 : BODY_SLOTS;
+
+		if (inhibit) {
+			FreeEntity(ent);
+			continue;
+		}
+
+		if (ent != world) {
+			ent->mins = { -16, -16, -16 };
+			ent->maxs = { 16, 16, 16 };
+			ent->solid = (slot % 2) ? SOLID_TRIGGER : SOLID_BSP;
+			ent->nextThink = level.time + GameTime::from_ms(100 * (slot % 10 + 1));
+			ent->timeStamp = level.time;
+			gi.linkEntity(ent);
+		}
+	}
+
+	// G_FindTeams
+	for (size_t i = BODY_SLOTS; i < globals.numEntities; i++) {
+		gentity_t* master = &g_entities[i];
+		if (!master->inUse || !master->team || master->teamMaster)
+			continue;
+
+		master->teamMaster = master;
+		gentity_t* chain = master;
+		for (size_t j = i + 1; j < globals.numEntities; j++) {
+			gentity_t* ent = &g_entities[j];
+			if (ent->inUse && ent->team && !std::strcmp(ent->team, master->team)) {
+				chain->teamChain = ent;
+				ent->teamMaster = master;
+				chain = ent;
+			}
+		}
+	}
+}
+
+/*
+=============
+PlayMatch
+
+Churn a warmup leaves behind: projectiles and gibs in new and recycled
+slots, moved, changed and unlinked map entities, and later think times.
+=============
+*/
+static void PlayMatch() {
+	for (size_t i = BODY_SLOTS; i < globals.numEntities; i += 5) {
+		gentity_t* ent = &g_entities[i];
+		if (!ent->inUse)
+			continue;
+
+		ent->wait += 1.0f;
+		ent->s.origin = { 0.0f, 0.0f, 128.0f };
+		ent->nextThink = level.time + 3_sec;
+		gi.unlinkEntity(ent);
+		if (i % 2)
+			gi.linkEntity(ent);
+	}
+
+	for (size_t i = 0; i < globals.numEntities / 10; i++) {
+		const size_t slot = G_EntityHotFindFree(BODY_SLOTS);
+		gentity_t* ent = SpawnSlot(slot < globals.numEntities ? slot : globals.numEntities);
+		ent->className = (i % 2) ? "gib" : "rocket";
+		ent->svFlags = (i % 2) ? SVF_NONE : SVF_PROJECTILE;
+		gi.linkEntity(ent);
+	}
+
+	g_entities[BODY_SLOTS - 1].className = "player corpse";
+	gi.linkEntity(&g_entities[BODY_SLOTS - 1]);
+}
+
+/*
+=============
+SameEntity
+
+Byte comparison with spawn_count, which a reset is expected to bump,
+left out.
+=============
+*/
+static bool SameEntity(const void* restored, const void* expected) {
+	alignas(gentity_t) unsigned char a[sizeof(gentity_t)];
+	alignas(gentity_t) unsigned char b[sizeof(gentity_t)];
+
+	std::memcpy(a, restored, sizeof(gentity_t));
+	std::memcpy(b, expected, sizeof(gentity_t));
+	reinterpret_cast<gentity_t*>(a)->spawn_count = 0;
+	reinterpret_cast<gentity_t*>(b)->spawn_count = 0;
+	return !std::memcmp(a, b, sizeof(gentity_t));
+}
+
+/*
+=============
+CheckIdentical
+
+A world restored at time T matches one freshly parsed at time T, slot for
+slot and field for field, and links in the same order.
+=============
+*/
+static void CheckIdentical(size_t count) {
+	entities = std::make_unique<gentity_t[]>(count + count / 4);
+	std::memset(static_cast<void*>(entities.get()), 0, sizeof(gentity_t) * (count + count / 4));
+	g_entities = entities.get();
+	game.maxEntities = static_cast<uint32_t>(count + count / 4);
+	game.maxClients = CLIENT_COUNT;
+	globals.numEntities = CLIENT_COUNT + 1;
+	linkSerials.assign(game.maxEntities, 0);
+	G_EntityHotClear();
+	BuildEntityString(count - BODY_SLOTS);
+
+	// the reference: parsed straight at the reset time
+	level.time = 47_sec;
+	ParseMap();
+	const uint32_t referenceCount = globals.numEntities;
+	const std::vector<int32_t> referenceAreas = AreaList();
+	std::vector<unsigned char> reference(sizeof(gentity_t) * referenceCount);
+	std::memcpy(reference.data(), static_cast<const void*>(entities.get()), reference.size());
+
+	// load, capture, play, restore
+	for (size_t i = 0; i < globals.numEntities; i++)
+		FreeEntity(&g_entities[i]);
+	level.time = 2_sec;
+	ParseMap();
+	G_WorldSnapshotCapture();
+	assert(G_WorldSnapshotValid());
+
+	level.time = 30_sec;
+	PlayMatch();
+	const int32_t heldSpawnCount = g_entities[BODY_SLOTS].spawn_count;
+	level.time = 47_sec;
+	G_WorldSnapshotRestore();
+
+	assert(globals.numEntities == referenceCount);
+	assert(AreaList() == referenceAreas);
+	assert(G_EntityHotVerify(true));
+
+	for (size_t i = 0; i < referenceCount; i++) {
+		const gentity_t& restored = g_entities[i];
+		const gentity_t* expected = reinterpret_cast<const gentity_t*>(reference.data() + i * sizeof(gentity_t));
+
+		assert(restored.inUse == expected->inUse);
+		if (!expected->inUse) {
+			if (i >= BODY_SLOTS)
+				assert(restored.freeTime == expected->freeTime);
+			continue;
+		}
+
+		assert(SameEntity(&restored, expected));
+	}
+
+	// a handle taken before the reset does not resolve to the restored entity
+	assert(g_entities[BODY_SLOTS].spawn_count != heldSpawnCount);
+
+	// nothing spawned during the match survives past the map's entities
+	for (size_t i = referenceCount; i < game.maxEntities; i++)
+		assert(!g_entities[i].inUse);
+}
+
+/*
+=============
+CheckAttachedHeads
+
+A HeadHunters head carried across a reset, in a slot a map entity held at
+capture time, must not take that map entity with it when its carrier
+respawns. G_WorldSnapshotRestore is the whole snapshot half of
+RestoreWorldSnapshot, release included.
+=============
+*/
+static void CheckAttachedHeads(size_t count) {
+	entities = std::make_unique<gentity_t[]>(count + count / 4);
+	std::memset(static_cast<void*>(entities.get()), 0, sizeof(gentity_t) * (count + count / 4));
+	g_entities = entities.get();
+	game.maxEntities = static_cast<uint32_t>(count + count / 4);
+	game.maxClients = CLIENT_COUNT;
+	globals.numEntities = CLIENT_COUNT + 1;
+	linkSerials.assign(game.maxEntities, 0);
+	G_EntityHotClear();
+	BuildEntityString(count - BODY_SLOTS);
+
+	level.time = 2_sec;
+	ParseMap();
+	G_WorldSnapshotCapture();
+
+	// a map entity is picked up and freed, and a head is spawned into its slot
+	const size_t slot = BODY_SLOTS + 1;
+	assert(g_entities[slot].inUse);
+	const char* mapClass = g_entities[slot].className;
+
+	level.time = 30_sec;
+	FreeEntity(&g_entities[slot]);
+	gentity_t* head = SpawnSlot(slot);
+	head->className = "headhunters_carried_head";
+
+	gclient_t* carrier = &clients[0];
+	carrier->headhunter.attachments[0] = head;
+	carrier->headhunter.carried = 1;
+
+	level.time = 47_sec;
+	G_WorldSnapshotRestore();
+	assert(level.time == 47_sec);
+	assert(!carrier->headhunter.attachments[0]);
+
+	HeadHunters::ResetPlayerState(carrier);
+	assert(g_entities[slot].inUse);
+	assert(!std::strcmp(g_entities[slot].className, mapClass));
+}
+
+/*
+=============
+CheckSpawnInputs
+
+A snapshot only stands in for a re-parse under the ruleset, gametype
+and spawn cvars it was captured with; voting in instagib or another
+ruleset has to parse the map again.
+=============
+*/
+static void CheckSpawnInputs() {
+	level.time = 2_sec;
+	ParseMap();
+	G_WorldSnapshotCapture();
+	assert(G_WorldSnapshotValid());
+
+	g_instaGib_storage.modifiedCount++;
+	assert(!G_WorldSnapshotValid());
+
+	// what the reset does after re-parsing
+	G_WorldSnapshotCapture();
+	assert(G_WorldSnapshotValid());
+
+	const Ruleset ruleset = game.ruleset;
+	game.ruleset = Ruleset::Quake3Arena;
+	assert(!G_WorldSnapshotValid());
+	game.ruleset = ruleset;
+	assert(G_WorldSnapshotValid());
+}
+
+/*
+=============
+RunBenchmark
+
+Resets the same world both ways.
+=============
+*/
+static void RunBenchmark(size_t count) {
+	using clock = std::chrono::steady_clock;
+
+	level.time = 2_sec;
+	ParseMap();
+	G_WorldSnapshotCapture();
+
+	double parseMs = 0.0;
+	double restoreMs = 0.0;
+	for (size_t i = 0; i < RESETS; i++) {
+		level.time += 30_sec;
+		PlayMatch();
+		auto start = clock::now();
+		ParseMap();
+		parseMs += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+
+		level.time += 30_sec;
+		PlayMatch();
+		start = clock::now();
+		G_WorldSnapshotRestore();
+		restoreMs += std::chrono::duration<double, std::milli>(clock::now() - start).count();
+	}
+
+	std::printf("World reset, %zu entities (%zu bytes of entity string):\n", count, entityString.length());
+	std::printf("  re-parse          %.3f ms/reset\n", parseMs / RESETS);
+	std::printf("  snapshot restore  %.3f ms/reset\n", restoreMs / RESETS);
+}
+
+/*
+=============
+main
+=============
+*/
+int main() {
+	game_import_t& base = gi;
+	base.Com_Print = &PrintToStdout;
+	base.linkEntity = &TestLinkEntity;
+	base.unlinkEntity = &TestUnlinkEntity;
+
+	clients = std::make_unique<gclient_t[]>(CLIENT_COUNT);
+	game.clients = clients.get();
+
+	CheckAttachedHeads(MAP_SIZES[0]);
+	CheckSpawnInputs();
+
+	for (size_t count : MAP_SIZES) {
+		CheckIdentical(count);
+		RunBenchmark(count);
+	}
+
+	G_WorldSnapshotPrint();
+	G_WorldSnapshotClear();
+	assert(!G_WorldSnapshotValid() && !G_WorldSnapshotLevel());
+	return 0;
+}
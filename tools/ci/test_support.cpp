@@ -380,3 +380,69 @@ std::string FileTimeStamp()
 {
 	return "19700101-000000";
 }
+
+/*
+=============
+G_Trace
+
+Forwards traces straight to the import table without call-site accounting.
+=============
+*/
+TEST_WEAK trace_t G_Trace(const Vector3& start, const Vector3* mins, const Vector3* maxs, const Vector3& end, const gentity_t* passent, contents_t contentmask, const std::source_location&)
+{
+	if (static_cast<const game_import_t&>(gi).trace)
+		return static_cast<const game_import_t&>(gi).trace(start, mins, maxs, end, passent, contentmask);
+
+	trace_t tr{};
+	tr.fraction = 1.0f;
+	tr.endPos = end;
+	return tr;
+}
+
+/*
+=============
+G_TraceWorldChanged
+=============
+*/
+TEST_WEAK void G_TraceWorldChanged()
+{
+}
+
+/*
+=============
+G_RegistrySync
+=============
+*/
+TEST_WEAK void G_RegistrySync(gentity_t*)
+{
+}
+
+/*
+=============
+G_LevelMemTrack
+=============
+*/
+TEST_WEAK void G_LevelMemTrack(LevelMem, ptrdiff_t)
+{
+}
+
+/*
+=============
+G_WorldSnapshotClear
+=============
+*/
+TEST_WEAK void G_WorldSnapshotClear()
+{
+}
+
+/*
+=============
+G_EntityClassResolve
+=============
+*/
+TEST_WEAK void G_EntityClassResolve(const gentity_t* ent)
+{
+	ent->classTag = EntityClass::Other;
+	ent->classGroups = EntityClassGroup::None;
+	ent->classTagName = ent->className;
+}